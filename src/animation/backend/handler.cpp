@@ -111,6 +111,17 @@ void Handler::setBlendedClipAnimatorRunning(const HBlendedClipAnimator &handle,
     }
 }
 
+// Running animators are evaluated on every frame, dirty ones on the next one
+bool Handler::needsNextFrame() const
+{
+    QMutexLocker lock(&m_mutex);
+    return !m_runningClipAnimators.isEmpty()
+            || !m_runningBlendedClipAnimators.isEmpty()
+            || !m_dirtyAnimationClips.isEmpty()
+            || !m_dirtyClipAnimators.isEmpty()
+            || !m_dirtyBlendedAnimators.isEmpty();
+}
+
 // The vectors may get outdated when the application removes/deletes an
 // animator component in the meantime. Recognize this. This should be
 // relatively infrequent so in most cases the vectors will not change at all.
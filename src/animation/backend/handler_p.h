@@ -87,13 +87,14 @@ public:
     SkeletonManager *skeletonManager() const noexcept { return m_skeletonManager.data(); }
 
     std::vector<Qt3DCore::QAspectJobPtr> jobsToExecute(qint64 time);
+    bool needsNextFrame() const;
 
     void cleanupHandleList(QVector<HAnimationClip> *clips);
     void cleanupHandleList(QVector<HClipAnimator> *animators);
     void cleanupHandleList(QVector<HBlendedClipAnimator> *animators);
 
 private:
-    QMutex m_mutex;
+    mutable QMutex m_mutex;
     QScopedPointer<AnimationClipLoaderManager> m_animationClipLoaderManager;
     QScopedPointer<ClockManager> m_clockManager;
     QScopedPointer<ClipAnimatorManager> m_clipAnimatorManager;
@@ -33,6 +33,11 @@ QAnimationAspectPrivate::QAnimationAspectPrivate()
 {
 }
 
+bool QAnimationAspectPrivate::needsNextFrame() const
+{
+    return m_handler->needsNextFrame() || hasPendingSingleShotJobs();
+}
+
 /*!
     \class Qt3DAnimation::QAnimationAspect
     \inherits Qt3DCore::QAbstractAspect
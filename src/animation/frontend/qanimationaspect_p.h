@@ -34,6 +34,8 @@ public:
 
     Q_DECLARE_PUBLIC(QAnimationAspect)
 
+    bool needsNextFrame() const override;
+
     QScopedPointer<Animation::Handler> m_handler;
 };
 
@@ -40,6 +40,12 @@ void QCoreAspectPrivate::frameDone()
 
 }
 
+bool QCoreAspectPrivate::needsNextFrame() const
+{
+    // Bounding volumes are only computed in response to frontend changes
+    return hasPendingSingleShotJobs();
+}
+
 QCoreAspect::QCoreAspect(QObject *parent)
     : Qt3DCore::QAbstractAspect(*new QCoreAspectPrivate, parent)
 {
@@ -39,6 +39,7 @@ public:
 
     void jobsDone() override;
     void frameDone() override;
+    bool needsNextFrame() const override;
 
     bool m_initialized;
     CalculateBoundingVolumeJobPtr m_calculateBoundingVolumeJob;
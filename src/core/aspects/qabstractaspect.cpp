@@ -312,6 +312,21 @@ std::vector<QAspectJobPtr> QAbstractAspectPrivate::jobsToExecute(qint64 time)
     return res;
 }
 
+void QAbstractAspectPrivate::jobsEnqueued()
+{
+}
+
+bool QAbstractAspectPrivate::needsNextFrame() const
+{
+    return true;
+}
+
+bool QAbstractAspectPrivate::hasPendingSingleShotJobs() const
+{
+    QMutexLocker lock(&m_singleShotMutex);
+    return !m_singleShotJobs.empty();
+}
+
 void QAbstractAspectPrivate::jobsDone()
 {
 }
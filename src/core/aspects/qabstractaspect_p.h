@@ -90,6 +90,7 @@ public:
     QAbstractAspectJobManager *jobManager() const;
 
     std::vector<QAspectJobPtr> jobsToExecute(qint64 time) override;
+    void jobsEnqueued() override;  // called once the jobs are enqueued, while the threadpool runs them
     void jobsDone() override;      // called when all the jobs are completed
     void frameDone() override;     // called when frame is completed (after the jobs), safe to wait until next frame here
 
@@ -101,6 +102,12 @@ public:
 
     virtual void onEngineAboutToShutdown();
 
+    // Called in the main thread after a frame. When no aspect needs another
+    // one, an automatic simulation loop idles until something wakes it up.
+    // Aspects which don't know are assumed to always need frames
+    virtual bool needsNextFrame() const;
+    bool hasPendingSingleShotJobs() const;
+
     // TODO: Make these public in 5.8
     template<class Frontend>
     void unregisterBackendType();
@@ -116,7 +123,7 @@ public:
     QAbstractAspectJobManager *m_jobManager;
     QChangeArbiter *m_arbiter;
     QHash<const QMetaObject*, QBackendNodeMapperPtr> m_backendCreatorFunctors;
-    QMutex m_singleShotMutex;
+    mutable QMutex m_singleShotMutex;
     std::vector<QAspectJobPtr> m_singleShotJobs;
 
     static QAbstractAspectPrivate *get(QAbstractAspect *aspect);
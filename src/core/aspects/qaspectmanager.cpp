@@ -20,6 +20,8 @@
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
 #include <Qt3DCore/private/qaspectjob_p.h>
 #include <Qt3DCore/private/qchangearbiter_p.h>
+#include <Qt3DCore/private/qdownloadhelperservice_p.h>
+#include <Qt3DCore/private/qeventfilterservice_p.h>
 #include <Qt3DCore/private/qscheduler_p.h>
 #include <Qt3DCore/private/qservicelocator_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p_p.h>
@@ -97,6 +99,8 @@ QAspectManager::QAspectManager(QAspectEngine *parent)
 #endif
     , m_jobsInLastFrame(0)
     , m_dumpJobs(false)
+    , m_idle(false)
+    , m_frameSkipped(false)
 {
     qRegisterMetaType<QSurface *>("QSurface*");
     qCDebug(Aspects) << Q_FUNC_INFO;
@@ -144,11 +148,21 @@ void QAspectManager::enterSimulationLoop()
             m_simulationAnimation = new RequestFrameAnimation(this);
             connect(m_simulationAnimation, &QAbstractAnimation::finished, this, [this]() {
                 processFrame();
-                if (m_simulationLoopRunning && m_driveMode == QAspectEngine::Automatic)
-                    requestNextFrame();
+                continueSimulationLoop();
             });
         }
 #endif
+        // Anything that may require a new frame wakes up an idle loop
+        m_wakeUpConnections.push_back(connect(m_changeArbiter, &QChangeArbiter::receivedChange,
+                                              this, &QAspectManager::wakeUp));
+        if (QEventFilterService *eventFilterService = m_serviceLocator->eventFilterService())
+            m_wakeUpConnections.push_back(connect(eventFilterService, &QEventFilterService::inputEventReceived,
+                                                  this, &QAspectManager::wakeUp));
+        if (QDownloadHelperService *downloadService = m_serviceLocator->downloadHelperService())
+            m_wakeUpConnections.push_back(connect(downloadService, &QDownloadHelperService::requestCompleted,
+                                                  this, &QAspectManager::wakeUp));
+
+        m_idle = false;
         requestNextFrame();
     }
 }
@@ -169,6 +183,11 @@ void QAspectManager::exitSimulationLoop()
         m_simulationAnimation->stop();
 #endif
 
+    for (const QMetaObject::Connection &connection : qAsConst(m_wakeUpConnections))
+        disconnect(connection);
+    m_wakeUpConnections.clear();
+    m_idle = false;
+
     QAbstractFrameAdvanceService *frameAdvanceService =
             m_serviceLocator->service<QAbstractFrameAdvanceService>(QServiceLocator::FrameAdvanceService);
     if (frameAdvanceService)
@@ -262,6 +281,8 @@ void QAspectManager::setRootEntity(Qt3DCore::QEntity *root, const QList<QNode *>
         for (QAbstractAspect *aspect : qAsConst(m_aspects))
             aspect->d_func()->setRootAndCreateNodes(m_root, nodeTreeChanges);
     }
+
+    wakeUp();
 }
 
 
@@ -284,6 +305,7 @@ void QAspectManager::addNodes(const QList<QNode *> &nodes)
     }
 
     m_nodeTreeChanges += treeChanges;
+    wakeUp();
 }
 
 // Main Thread -> immediately following node destruction (call from QNode dtor)
@@ -311,6 +333,8 @@ void QAspectManager::removeNodes(const QList<QNode *> &nodes)
                                       NodeTreeChange::Removed,
                                       nullptr });
     }
+
+    wakeUp();
 }
 
 /*!
@@ -442,8 +466,7 @@ bool QAspectManager::event(QEvent *e)
 
         // Request next frame if we are still running and if Qt3D is driving
         // the loop
-        if (m_simulationLoopRunning && m_driveMode == QAspectEngine::Automatic)
-            requestNextFrame();
+        continueSimulationLoop();
 
         return true;
     }
@@ -464,6 +487,51 @@ void QAspectManager::requestNextFrame()
 #endif
 }
 
+/*!
+    \internal
+
+    Requests the next frame of an automatic simulation loop unless no aspect
+    needs one, in which case the loop idles until wakeUp() is called.
+ */
+void QAspectManager::continueSimulationLoop()
+{
+    if (!m_simulationLoopRunning || m_driveMode != QAspectEngine::Automatic)
+        return;
+
+    if (canIdle()) {
+        qCDebug(Aspects) << "Simulation loop idling";
+        m_idle = true;
+        return;
+    }
+    requestNextFrame();
+}
+
+bool QAspectManager::canIdle() const
+{
+    if (m_frameSkipped || !m_nodeTreeChanges.isEmpty() || m_changeArbiter->hasPendingChanges())
+        return false;
+
+    return std::none_of(m_aspects.cbegin(), m_aspects.cend(), [] (QAbstractAspect *aspect) {
+        return QAbstractAspectPrivate::get(aspect)->needsNextFrame();
+    });
+}
+
+/*!
+    \internal
+
+    Restarts an idle simulation loop. Called on frontend changes, input events
+    and completed downloads.
+ */
+void QAspectManager::wakeUp()
+{
+    if (!m_idle || !m_simulationLoopRunning || m_driveMode != QAspectEngine::Automatic)
+        return;
+
+    qCDebug(Aspects) << "Simulation loop woken up";
+    m_idle = false;
+    requestNextFrame();
+}
+
 void QAspectManager::processFrame()
 {
     qCDebug(Aspects) << "Processing Frame";
@@ -473,7 +541,8 @@ void QAspectManager::processFrame()
             m_serviceLocator->service<QAbstractFrameAdvanceService>(QServiceLocator::FrameAdvanceService);
 
     const qint64 t = frameAdvanceService->waitForNextFrame();
-    if (t < 0)
+    m_frameSkipped = t < 0;
+    if (m_frameSkipped)
         return;
 
     // Distribute accumulated changes. This includes changes sent from the frontend
@@ -90,11 +90,16 @@ public:
     int jobsInLastFrame() const { return m_jobsInLastFrame; }
     void dumpJobsOnNextFrame();
 
+    bool isIdle() const { return m_idle; }
+    void wakeUp();
+
 private:
 #if !QT_CONFIG(animation)
     bool event(QEvent *event) override;
 #endif
     void requestNextFrame();
+    void continueSimulationLoop();
+    bool canIdle() const;
 
     QAspectEngine *m_engine;
     QList<QAbstractAspect *> m_aspects;
@@ -114,6 +119,9 @@ private:
 #endif
     int m_jobsInLastFrame;
     bool m_dumpJobs;
+    bool m_idle;
+    bool m_frameSkipped;
+    QList<QMetaObject::Connection> m_wakeUpConnections;
 };
 
 } // namespace Qt3DCore
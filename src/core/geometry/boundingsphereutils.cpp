@@ -0,0 +1,288 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "boundingsphereutils_p.h"
+
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace {
+
+// Streams smaller than this are processed on the calling thread
+constexpr uint ChunkSize = 1 << 15;
+
+struct DirectFetcher
+{
+    const float *positions;
+    uint stride;
+
+    const float *at(uint i) const { return positions + size_t(i) * stride; }
+};
+
+template<typename Index>
+struct IndexedFetcher
+{
+    const float *positions;
+    uint stride;
+    const Index *indices;
+    bool primitiveRestartEnabled;
+    int primitiveRestartIndex;
+
+    // Returns nullptr for primitive restart entries
+    const float *at(uint i) const
+    {
+        const Index index = indices[i];
+        if (primitiveRestartEnabled && static_cast<int>(index) == primitiveRestartIndex)
+            return nullptr;
+        return positions + size_t(index) * stride;
+    }
+};
+
+inline float distanceSquared(const float *p, const float *ref)
+{
+    const float dx = p[0] - ref[0];
+    const float dy = p[1] - ref[1];
+    const float dz = p[2] - ref[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+struct FarthestPoint
+{
+    const float *point = nullptr;
+    float distanceSquared = -1.f;
+
+    // Ties go to the later point, chunks being merged in order this gives the
+    // same result whether the stream was split or not
+    void merge(const FarthestPoint &other)
+    {
+        if (other.point && other.distanceSquared >= distanceSquared)
+            *this = other;
+    }
+};
+
+struct ExtentAndFarthestPoint
+{
+    float min[4] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max(), 0.f };
+    float max[4] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest(), 0.f };
+    FarthestPoint farthest;
+
+    void merge(const ExtentAndFarthestPoint &other)
+    {
+        for (int i = 0; i < 3; ++i) {
+            min[i] = std::min(min[i], other.min[i]);
+            max[i] = std::max(max[i], other.max[i]);
+        }
+        farthest.merge(other.farthest);
+    }
+};
+
+template<typename Fetcher>
+void findExtentAndFarthestPoint(const Fetcher &fetcher, uint begin, uint end,
+                                const float *reference, ExtentAndFarthestPoint &result)
+{
+#ifdef __SSE2__
+    __m128 vmin = _mm_loadu_ps(result.min);
+    __m128 vmax = _mm_loadu_ps(result.max);
+#endif
+    FarthestPoint farthest;
+    for (uint i = begin; i < end; ++i) {
+        const float *p = fetcher.at(i);
+        if (!p)
+            continue;
+#ifdef __SSE2__
+        // Not loading 4 floats at once as the last position may end the buffer
+        const __m128 v = _mm_setr_ps(p[0], p[1], p[2], 0.f);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+#else
+        for (int c = 0; c < 3; ++c) {
+            result.min[c] = std::min(result.min[c], p[c]);
+            result.max[c] = std::max(result.max[c], p[c]);
+        }
+#endif
+        const float d = distanceSquared(p, reference);
+        if (d >= farthest.distanceSquared) {
+            farthest.distanceSquared = d;
+            farthest.point = p;
+        }
+    }
+#ifdef __SSE2__
+    _mm_storeu_ps(result.min, vmin);
+    _mm_storeu_ps(result.max, vmax);
+#endif
+    result.farthest = farthest;
+}
+
+template<typename Fetcher>
+void findFarthestPoint(const Fetcher &fetcher, uint begin, uint end,
+                       const float *reference, FarthestPoint &result)
+{
+    FarthestPoint farthest;
+    for (uint i = begin; i < end; ++i) {
+        const float *p = fetcher.at(i);
+        if (!p)
+            continue;
+        const float d = distanceSquared(p, reference);
+        if (d >= farthest.distanceSquared) {
+            farthest.distanceSquared = d;
+            farthest.point = p;
+        }
+    }
+    result = farthest;
+}
+
+// Runs func over consecutive chunks of [0, count) and merges the partial
+// results in chunk order
+template<typename Partial, typename Func>
+Partial mapChunks(uint count, Func func)
+{
+    const uint chunkCount = std::max(1u, (count + ChunkSize - 1) / ChunkSize);
+    std::vector<Partial> partials(chunkCount);
+    auto processChunk = [&](uint chunk) {
+        const uint begin = chunk * ChunkSize;
+        const uint end = std::min(count, begin + ChunkSize);
+        func(begin, end, partials[chunk]);
+    };
+
+#if QT_CONFIG(concurrent)
+    if (chunkCount > 1 && QAspectJobManager::idealThreadCount() > 1) {
+        std::vector<uint> chunks(chunkCount);
+        std::iota(chunks.begin(), chunks.end(), 0u);
+        QtConcurrent::blockingMap(chunks, [&](uint chunk) { processChunk(chunk); });
+    } else
+#endif
+    {
+        for (uint chunk = 0; chunk < chunkCount; ++chunk)
+            processChunk(chunk);
+    }
+
+    Partial result = partials.front();
+    for (uint chunk = 1; chunk < chunkCount; ++chunk)
+        result.merge(partials[chunk]);
+    return result;
+}
+
+template<typename Fetcher>
+FarthestPoint farthestPointFrom(const Fetcher &fetcher, uint count, const float *reference)
+{
+    return mapChunks<FarthestPoint>(count, [&](uint begin, uint end, FarthestPoint &partial) {
+        findFarthestPoint(fetcher, begin, end, reference, partial);
+    });
+}
+
+template<typename Fetcher>
+BoundingSphereResult computeSphere(const Fetcher &fetcher, uint count)
+{
+    const float *first = nullptr;
+    for (uint i = 0; i < count && !first; ++i)
+        first = fetcher.at(i);
+    if (!first)
+        return {};
+
+    // Extent and point y, the farthest from the first point
+    const ExtentAndFarthestPoint extent =
+            mapChunks<ExtentAndFarthestPoint>(count, [&](uint begin, uint end, ExtentAndFarthestPoint &partial) {
+        findExtentAndFarthestPoint(fetcher, begin, end, first, partial);
+    });
+    const float *y = extent.farthest.point;
+
+    // Point z, the farthest from y
+    const float *z = farthestPointFrom(fetcher, count, y).point;
+    const float center[3] = { (y[0] + z[0]) * .5f, (y[1] + z[1]) * .5f, (y[2] + z[2]) * .5f };
+
+    // Grow the sphere to enclose the point farthest from its center
+    const FarthestPoint farthest = farthestPointFrom(fetcher, count, center);
+
+    BoundingSphereResult result;
+    result.min = QVector3D(extent.min[0], extent.min[1], extent.min[2]);
+    result.max = QVector3D(extent.max[0], extent.max[1], extent.max[2]);
+    result.center = QVector3D(center[0], center[1], center[2]);
+    result.radius = std::sqrt(farthest.distanceSquared);
+    return result;
+}
+
+template<typename Fetcher>
+BoundingSphereResult computeSphereFromExtent(const Fetcher &fetcher, uint count,
+                                             const QVector3D &min, const QVector3D &max)
+{
+    const QVector3D c = (min + max) * .5f;
+    const float center[3] = { c.x(), c.y(), c.z() };
+    const FarthestPoint farthest = farthestPointFrom(fetcher, count, center);
+    if (!farthest.point)
+        return {};
+
+    BoundingSphereResult result;
+    result.min = min;
+    result.max = max;
+    result.center = c;
+    result.radius = std::sqrt(farthest.distanceSquared);
+    return result;
+}
+
+template<typename Func>
+BoundingSphereResult visitStream(const PositionStream &stream, Func func)
+{
+    if (!stream.positions)
+        return {};
+
+    const uint stride = stream.byteStride ? stream.byteStride / sizeof(float) : 3;
+    if (!stream.indices)
+        return func(DirectFetcher { stream.positions, stride });
+
+    switch (stream.indexType) {
+    case QAttribute::UnsignedByte:
+        return func(IndexedFetcher<quint8> { stream.positions, stride,
+                                             reinterpret_cast<const quint8 *>(stream.indices),
+                                             stream.primitiveRestartEnabled,
+                                             stream.primitiveRestartIndex });
+    case QAttribute::UnsignedShort:
+        return func(IndexedFetcher<quint16> { stream.positions, stride,
+                                              reinterpret_cast<const quint16 *>(stream.indices),
+                                              stream.primitiveRestartEnabled,
+                                              stream.primitiveRestartIndex });
+    case QAttribute::UnsignedInt:
+        return func(IndexedFetcher<quint32> { stream.positions, stride,
+                                              reinterpret_cast<const quint32 *>(stream.indices),
+                                              stream.primitiveRestartEnabled,
+                                              stream.primitiveRestartIndex });
+    default:
+        return {};
+    }
+}
+
+} // anonymous
+
+BoundingSphereResult computeBoundingSphere(const PositionStream &stream)
+{
+    return visitStream(stream, [&stream](const auto &fetcher) {
+        return computeSphere(fetcher, stream.count);
+    });
+}
+
+BoundingSphereResult computeBoundingSphere(const PositionStream &stream,
+                                           const QVector3D &min,
+                                           const QVector3D &max)
+{
+    return visitStream(stream, [&](const auto &fetcher) {
+        return computeSphereFromExtent(fetcher, stream.count, min, max);
+    });
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
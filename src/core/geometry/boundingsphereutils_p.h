@@ -0,0 +1,66 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DCORE_BOUNDINGSPHEREUTILS_P_H
+#define QT3DCORE_BOUNDINGSPHEREUTILS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+#include <QtGui/qvector3d.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+// Describes where the positions to bound are, reading them directly from
+// the buffer data instead of going through a BufferVisitor
+struct PositionStream
+{
+    const float *positions = nullptr;   // First position, byte offset applied
+    uint byteStride = 0;                // 0 means tightly packed vec3
+    const char *indices = nullptr;      // First index, byte offset applied. Null when not indexed
+    QAttribute::VertexBaseType indexType = QAttribute::UnsignedInt;
+    uint count = 0;                     // Number of vertices or indices to visit
+    bool primitiveRestartEnabled = false;
+    int primitiveRestartIndex = -1;
+};
+
+struct BoundingSphereResult
+{
+    QVector3D min;
+    QVector3D max;
+    QVector3D center;
+    float radius = -1.f;
+
+    bool isValid() const { return radius >= 0.f; }
+};
+
+// Computes the extent and bounding sphere of the positions. The sphere is
+// centered between the two most distant points found from an arbitrary
+// point, then grown to enclose every point. Large streams are split across
+// threads.
+Q_3DCORE_PRIVATE_EXPORT BoundingSphereResult computeBoundingSphere(const PositionStream &stream);
+
+// Same as above when the extent of the positions is already known, for
+// instance from the min/max of a glTF accessor. The sphere is then centered
+// on the extent and only one pass over the positions is needed.
+Q_3DCORE_PRIVATE_EXPORT BoundingSphereResult computeBoundingSphere(const PositionStream &stream,
+                                                                   const QVector3D &min,
+                                                                   const QVector3D &max);
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_BOUNDINGSPHEREUTILS_P_H
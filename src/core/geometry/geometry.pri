@@ -13,10 +13,12 @@ HEADERS += \
     $$PWD/qgeometryfactory_p.h \
     $$PWD/qgeometryview_p.h \
     $$PWD/qgeometryview.h \
+    $$PWD/boundingsphereutils_p.h \
     $$PWD/bufferutils_p.h \
     $$PWD/buffervisitor_p.h
 
 SOURCES += \
+    $$PWD/boundingsphereutils.cpp \
     $$PWD/qabstractfunctor.cpp \
     $$PWD/qattribute.cpp \
     $$PWD/qboundingvolume.cpp \
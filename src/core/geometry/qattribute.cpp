@@ -20,6 +20,7 @@ QAttributePrivate::QAttributePrivate()
     , m_byteOffset(0)
     , m_divisor(0)
     , m_attributeType(QAttribute::VertexAttribute)
+    , m_hasBounds(false)
     , m_dirty(false)
 {
 }
@@ -36,6 +37,24 @@ QAttributePrivate *QAttributePrivate::get(QAttribute *q)
     return q->d_func();
 }
 
+void QAttributePrivate::setBounds(const QVector3D &minBound, const QVector3D &maxBound)
+{
+    if (m_hasBounds && m_minBound == minBound && m_maxBound == maxBound)
+        return;
+    m_minBound = minBound;
+    m_maxBound = maxBound;
+    m_hasBounds = true;
+    update();
+}
+
+void QAttributePrivate::clearBounds()
+{
+    if (!m_hasBounds)
+        return;
+    m_hasBounds = false;
+    update();
+}
+
 /*!
  * \qmltype Attribute
  * \instantiates Qt3DCore::QAttribute
@@ -273,8 +292,10 @@ void QAttribute::setBuffer(QBuffer *buffer)
     if (d->m_buffer == buffer)
         return;
 
-    if (d->m_buffer)
+    if (d->m_buffer) {
         d->unregisterDestructionHelper(d->m_buffer);
+        QObject::disconnect(d->m_bufferDataConnection);
+    }
 
     // We need to add it as a child of the current node if it has been declared inline
     // Or not previously added as a child of the current node so that
@@ -284,10 +305,14 @@ void QAttribute::setBuffer(QBuffer *buffer)
         buffer->setParent(this);
 
     d->m_buffer = buffer;
+    d->clearBounds();
 
     // Ensures proper bookkeeping
-    if (d->m_buffer)
+    if (d->m_buffer) {
         d->registerDestructionHelper(d->m_buffer, &QAttribute::setBuffer, d->m_buffer);
+        d->m_bufferDataConnection = QObject::connect(d->m_buffer, &QBuffer::dataChanged,
+                                                     this, [d] { d->clearBounds(); });
+    }
 
     emit bufferChanged(buffer);
 }
@@ -310,6 +335,7 @@ void QAttribute::setVertexBaseType(VertexBaseType type)
         return;
 
     d->m_vertexBaseType = type;
+    d->clearBounds();
     emit vertexBaseTypeChanged(type);
     emit dataTypeChanged(type);
 }
@@ -321,6 +347,7 @@ void QAttribute::setVertexSize(uint size)
         return;
     Q_ASSERT((size >= 1 && size <= 4) || (size == 9) || (size == 16));
     d->m_vertexSize = size;
+    d->clearBounds();
     emit vertexSizeChanged(size);
     emit dataSizeChanged(size);
 }
@@ -332,6 +359,7 @@ void QAttribute::setCount(uint count)
         return;
 
     d->m_count = count;
+    d->clearBounds();
     emit countChanged(count);
 }
 
@@ -342,6 +370,7 @@ void QAttribute::setByteStride(uint byteStride)
         return;
 
     d->m_byteStride = byteStride;
+    d->clearBounds();
     emit byteStrideChanged(byteStride);
 }
 
@@ -352,6 +381,7 @@ void QAttribute::setByteOffset(uint byteOffset)
         return;
 
     d->m_byteOffset = byteOffset;
+    d->clearBounds();
     emit byteOffsetChanged(byteOffset);
 }
 
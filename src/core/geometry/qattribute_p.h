@@ -19,6 +19,7 @@
 #include <Qt3DCore/QBuffer>
 #include <private/qnode_p.h>
 #include <private/qt3dcore_global_p.h>
+#include <QtGui/qvector3d.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +37,13 @@ public:
 
     static QAttributePrivate *get(QAttribute *q);
 
+    // Extent of the attribute's values when known upfront, e.g. from the
+    // min/max of a glTF accessor. Spares a pass over the data when
+    // computing bounding volumes. The bounds are cleared as soon as the
+    // buffer, its data or the layout of the attribute changes.
+    void setBounds(const QVector3D &minBound, const QVector3D &maxBound);
+    void clearBounds();
+
     QBuffer *m_buffer;
     QString m_name;
     QAttribute::VertexBaseType m_vertexBaseType;
@@ -45,7 +53,11 @@ public:
     uint m_byteOffset;
     uint m_divisor;
     QAttribute::AttributeType m_attributeType;
+    QVector3D m_minBound;
+    QVector3D m_maxBound;
+    bool m_hasBounds;
     bool m_dirty;
+    QMetaObject::Connection m_bufferDataConnection;
 };
 
 } // Qt3DCore
@@ -4,99 +4,17 @@
 #include "qgeometryview.h"
 #include "qgeometryview_p.h"
 #include "qgeometry_p.h"
-#include "buffervisitor_p.h"
+#include "qattribute_p.h"
+#include "boundingsphereutils_p.h"
+#include "bufferutils_p.h"
 
 #include <Qt3DCore/QAttribute>
 #include <Qt3DCore/QBuffer>
-#include <Qt3DCore/private/vector3d_p.h>
 
 QT_BEGIN_NAMESPACE
 
 using namespace Qt3DCore;
 
-namespace {
-
-class FindExtremePoints : public Buffer3fVisitor
-{
-public:
-    FindExtremePoints()
-        : Buffer3fVisitor()
-          , xMin(0.0f), xMax(0.0f), yMin(0.0f), yMax(0.0f), zMin(0.0f), zMax(0.0f)
-    { }
-
-    float xMin, xMax, yMin, yMax, zMin, zMax;
-    Vector3D xMinPt, xMaxPt, yMinPt, yMaxPt, zMinPt, zMaxPt;
-
-    void visit(uint ndx, float x, float y, float z) override
-    {
-        if (ndx) {
-            if (x < xMin) {
-                xMin = x;
-                xMinPt = Vector3D(x, y, z);
-            }
-            if (x > xMax) {
-                xMax = x;
-                xMaxPt = Vector3D(x, y, z);
-            }
-            if (y < yMin) {
-                yMin = y;
-                yMinPt = Vector3D(x, y, z);
-            }
-            if (y > yMax) {
-                yMax = y;
-                yMaxPt = Vector3D(x, y, z);
-            }
-            if (z < zMin) {
-                zMin = z;
-                zMinPt = Vector3D(x, y, z);
-            }
-            if (z > zMax) {
-                zMax = z;
-                zMaxPt = Vector3D(x, y, z);
-            }
-        } else {
-            xMin = xMax = x;
-            yMin = yMax = y;
-            zMin = zMax = z;
-            xMinPt = xMaxPt = yMinPt = yMaxPt = zMinPt = zMaxPt = Vector3D(x, y, z);
-        }
-    }
-};
-
-class FindMaxDistantPoint : public Buffer3fVisitor
-{
-public:
-    FindMaxDistantPoint()
-        : Buffer3fVisitor()
-    { }
-
-    float maxLengthSquared = 0.0f;
-    bool setReferencePoint = false;
-    bool hasNoPoints = true;
-    Vector3D maxDistPt;
-    Vector3D referencePt;
-
-    void visit(uint ndx, float x, float y, float z) override
-    {
-        Q_UNUSED(ndx);
-        const Vector3D p = Vector3D(x, y, z);
-
-        if (hasNoPoints && setReferencePoint) {
-            maxLengthSquared = 0.0f;
-            referencePt = p;
-        }
-        const float lengthSquared = (p - referencePt).lengthSquared();
-        if ( lengthSquared >= maxLengthSquared ) {
-            maxDistPt = p;
-            maxLengthSquared = lengthSquared;
-        }
-        hasNoPoints = false;
-    }
-};
-
-}
-
-
 bool BoundingVolumeCalculator::apply(QAttribute *positionAttribute,
                                      QAttribute *indexAttribute,
                                      int drawVertexCount,
@@ -105,50 +23,37 @@ bool BoundingVolumeCalculator::apply(QAttribute *positionAttribute,
 {
     m_radius = -1.f;
 
-    FindExtremePoints findExtremePoints;
-    if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                 primitiveRestartEnabled, primitiveRestartIndex)) {
+    if (positionAttribute->vertexBaseType() != QAttribute::Float
+            || positionAttribute->vertexSize() < 3)
         return false;
-    }
-
-    m_min = QVector3D(findExtremePoints.xMin, findExtremePoints.yMin, findExtremePoints.zMin);
-    m_max = QVector3D(findExtremePoints.xMax, findExtremePoints.yMax, findExtremePoints.zMax);
 
-    FindMaxDistantPoint maxDistantPointY;
-    maxDistantPointY.setReferencePoint = true;
-    if (!maxDistantPointY.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                primitiveRestartEnabled, primitiveRestartIndex)) {
-        return false;
+    // Keep the data alive while the positions are read
+    const QByteArray positionData = positionAttribute->buffer()->data();
+    QByteArray indexData;
+
+    PositionStream stream;
+    stream.positions = BufferTypeInfo::castToType<QAttribute::Float>(positionData, positionAttribute->byteOffset());
+    stream.byteStride = positionAttribute->byteStride();
+    stream.count = uint(drawVertexCount);
+    if (indexAttribute) {
+        indexData = indexAttribute->buffer()->data();
+        stream.indices = indexData.constData() + indexAttribute->byteOffset();
+        stream.indexType = indexAttribute->vertexBaseType();
+        stream.primitiveRestartEnabled = primitiveRestartEnabled;
+        stream.primitiveRestartIndex = primitiveRestartIndex;
     }
-    if (maxDistantPointY.hasNoPoints)
-        return false;
-
-    //const Vector3D x = maxDistantPointY.referencePt;
-    const Vector3D y = maxDistantPointY.maxDistPt;
-
-    FindMaxDistantPoint maxDistantPointZ;
-    maxDistantPointZ.setReferencePoint = false;
-    maxDistantPointZ.referencePt = y;
-    if (!maxDistantPointZ.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                primitiveRestartEnabled, primitiveRestartIndex))
-        return false;
-    const Vector3D z = maxDistantPointZ.maxDistPt;
-    const Vector3D center = (y + z) * .5f;
-
-    FindMaxDistantPoint maxDistantPointCenter;
-    maxDistantPointCenter.setReferencePoint = false;
-    maxDistantPointCenter.referencePt = center;
-    if (!maxDistantPointCenter.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                     primitiveRestartEnabled, primitiveRestartIndex))
-        return false;
-
-    const float radius = (center - maxDistantPointCenter.maxDistPt).length();
 
-    if (center == Vector3D{} && radius < 0.f)
+    const QAttributePrivate *dPosition = QAttributePrivate::get(positionAttribute);
+    const BoundingSphereResult result = dPosition->m_hasBounds
+            ? computeBoundingSphere(stream, dPosition->m_minBound, dPosition->m_maxBound)
+            : computeBoundingSphere(stream);
+    if (!result.isValid())
         return false;
 
-    m_radius = radius;
-    m_center = QVector3D{ center.x(), center.y(), center.z() };
+    m_min = result.min;
+    m_max = result.max;
+    m_center = result.center;
+    m_radius = result.radius;
 
     return true;
 }
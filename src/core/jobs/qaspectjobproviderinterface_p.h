@@ -32,6 +32,7 @@ public:
 
 private:
     virtual std::vector<QAspectJobPtr> jobsToExecute(qint64 time) = 0;
+    virtual void jobsEnqueued() = 0;
     virtual void jobsDone() = 0;
     virtual void frameDone() = 0;
 
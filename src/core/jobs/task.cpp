@@ -7,6 +7,7 @@
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QMutexLocker>
 
+#include <Qt3DCore/private/qresourcemanager_p.h>
 #include <Qt3DCore/private/qthreadpooler_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p_p.h>
 
@@ -42,6 +43,8 @@ void AspectTaskRunnable::run()
     if (m_job) {
         QAspectJobPrivate *jobD = QAspectJobPrivate::get(m_job.data());
         QTaskLogger logger(m_pooler ? m_service : nullptr, jobD->m_jobId, QTaskLogger::AspectJob);
+        // Jobs are all done before the lookup tables get published again
+        QLookupTableReadScope lookupTableScope;
         m_job->run();
     }
 
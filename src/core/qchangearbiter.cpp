@@ -74,6 +74,11 @@ QList<ComponentRelationshipChange> QChangeArbiter::takeDirtyEntityComponentNodes
     return Qt3DCore::moveAndClear(m_dirtyEntityComponentNodeChanges);
 }
 
+bool QChangeArbiter::hasPendingChanges() const
+{
+    return !m_dirtyFrontEndNodes.isEmpty() || !m_dirtyEntityComponentNodeChanges.isEmpty();
+}
+
 } // namespace Qt3DCore
 
 QT_END_NAMESPACE
@@ -67,6 +67,7 @@ public:
     void removeDirtyFrontEndNode(QNode *node);
     QList<QNode *> takeDirtyFrontEndNodes();
     QList<ComponentRelationshipChange> takeDirtyEntityComponentNodes();
+    bool hasPendingChanges() const;
 
     void setScene(Qt3DCore::QScene *scene);
 
@@ -45,6 +45,12 @@
     read and write operations at the same time.
 
     It provides two convenience classes WriteLocker and ReadLocker that behave like QReadLocker and QWriteLocker.
+
+    When writes only happen at well known points in time, the owner of the manager can call
+    QResourceManager::publishLookupTable() once they are done. Key lookups made from aspect jobs
+    then go through an immutable copy of the table without taking the read lock, which keeps
+    highly parallel readers from contending on it. Releasing a resource withdraws the copy until
+    the next publication, and lookups from outside aspect jobs always take the lock.
 */
 
 #include "qresourcemanager_p.h"
@@ -77,6 +83,28 @@ void AlignedAllocator::release(void *p)
 #endif
 }
 
+namespace {
+
+thread_local bool lookupTableReadScopeActive = false;
+
+} // anonymous
+
+QLookupTableReadScope::QLookupTableReadScope()
+    : m_wasActive(lookupTableReadScopeActive)
+{
+    lookupTableReadScopeActive = true;
+}
+
+QLookupTableReadScope::~QLookupTableReadScope()
+{
+    lookupTableReadScopeActive = m_wasActive;
+}
+
+bool QLookupTableReadScope::isActive()
+{
+    return lookupTableReadScopeActive;
+}
+
 } // Qt3DCore
 
 QT_END_NAMESPACE
@@ -15,12 +15,15 @@
 // We mean it.
 //
 
+#include <QtCore/QAtomicPointer>
 #include <QtCore/QHash>
 #include <QtCore/QMutex>
 #include <QtCore/QReadLocker>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QtGlobal>
+#include <algorithm>
 #include <limits>
+#include <memory>
 
 #include <Qt3DCore/private/qhandle_p.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
@@ -168,6 +171,8 @@ template<typename T>
 class QHandleData : public QHandle<T>::Data
 {
 public:
+    // Position of the handle in the allocator's list of active handles
+    int activeIndex = -1;
     T data;
 };
 
@@ -184,12 +189,46 @@ public:
     static void release(void *p);
 };
 
+// Marks the current thread as running an aspect job for the lifetime of the
+// scope. Only lookups made within such a scope go through the published
+// lookup tables, which can then be freed as soon as the jobs of a frame are
+// done. Lookups from any other thread, e.g. one submitting a previous frame,
+// take the manager's lock.
+class Q_3DCORE_PRIVATE_EXPORT QLookupTableReadScope
+{
+public:
+    QLookupTableReadScope();
+    ~QLookupTableReadScope();
+
+    static bool isActive();
+
+private:
+    Q_DISABLE_COPY(QLookupTableReadScope)
+    bool m_wasActive;
+};
+
+// Buckets are only returned to the system when the allocator is destroyed.
+// A released handle is detected as stale by comparing its counter with the
+// one of its entry, which requires the entry to stay readable. Stale handles
+// are kept all over the backend (cached component handles on entities,
+// published lookup tables, dirty node queues...), so the memory used by
+// the entries themselves is reused but never shrinks. What the released
+// resources still hold on to is given back by trim().
 template <typename T>
 class ArrayAllocatingPolicy
 {
 public:
     typedef QHandleData<T> HandleData;
     typedef QHandle<T> Handle;
+
+    struct MemoryStatistics
+    {
+        int activeCount = 0;
+        int capacity = 0;
+        int bucketCount = 0;
+        size_t allocatedBytes = 0;
+    };
+
     ArrayAllocatingPolicy()
     {
     }
@@ -204,21 +243,39 @@ public:
     {
         if (!freeList)
             allocateBucket();
+        m_allocatedSinceFrame = true;
         typename Handle::Data *d = freeList;
         freeList = freeList->nextFree;
         d->counter = allocCounter;
         allocCounter += 2; // ensure this will never clash with a pointer in nextFree by keeping the lowest bit set
         Handle handle(d);
+        static_cast<HandleData *>(d)->activeIndex = int(m_activeHandles.size());
         m_activeHandles.push_back(handle);
         return handle;
     }
 
     void releaseResource(const Handle &handle)
     {
-        m_activeHandles.erase(std::remove(m_activeHandles.begin(), m_activeHandles.end(), handle), m_activeHandles.end());
+        // Ignore null and stale handles, releasing them twice would corrupt the free list
+        if (handle.data() == nullptr)
+            return;
         typename Handle::Data *d = handle.data_ptr();
+
+        // Swap the released handle with the last active one so that the
+        // active list stays dense and releasing is O(1)
+        HandleData *hd = static_cast<HandleData *>(d);
+        const int idx = hd->activeIndex;
+        Q_ASSERT(idx >= 0 && idx < int(m_activeHandles.size()));
+        const Handle last = m_activeHandles.back();
+        m_activeHandles[idx] = last;
+        static_cast<HandleData *>(last.data_ptr())->activeIndex = idx;
+        m_activeHandles.pop_back();
+        hd->activeIndex = -1;
+
         d->nextFree = freeList;
         freeList = d;
+        // Can't exceed the number of free entries, which also keeps it from overflowing
+        m_releasedSinceTrim = qMin(m_releasedSinceTrim + 1, m_bucketCount * int(Bucket::NumEntries));
         performCleanup(&static_cast<QHandleData<T> *>(d)->data, std::integral_constant<bool, QResourceInfo<T>::needsCleanup>{});
     }
 
@@ -242,6 +299,48 @@ public:
     int count() const { return int(m_activeHandles.size()); }
     const std::vector<Handle> &activeHandles() const { return m_activeHandles; }
 
+    // Default constructs the resources released since the last trim again, so
+    // that the memory they kept after their cleanup (container capacities...)
+    // is returned, and gives back the spare capacity of the active list.
+    // Released entries are pushed to the front of the free list and entries
+    // are allocated from its front, so the ones to reset are always its first
+    // m_releasedSinceTrim entries at most.
+    void trim()
+    {
+        typename Handle::Data *d = freeList;
+        for (int i = 0; d != nullptr && i < m_releasedSinceTrim; ++i) {
+            T *t = &static_cast<HandleData *>(d)->data;
+            t->~T();
+            new (t) T();
+            d = d->nextFree;
+        }
+        m_releasedSinceTrim = 0;
+        m_activeHandles.shrink_to_fit();
+    }
+
+    // Meant to be called once per frame: trims after a frame that allocated
+    // nothing, once resources were released, i.e. when a scene stopped
+    // shrinking. Returns whether trimming happened.
+    bool trimIfIdle()
+    {
+        const bool idle = !m_allocatedSinceFrame && m_releasedSinceTrim > 0;
+        m_allocatedSinceFrame = false;
+        if (idle)
+            trim();
+        return idle;
+    }
+
+    MemoryStatistics memoryStatistics() const
+    {
+        MemoryStatistics stats;
+        stats.activeCount = int(m_activeHandles.size());
+        stats.bucketCount = m_bucketCount;
+        stats.capacity = m_bucketCount * Bucket::NumEntries;
+        stats.allocatedBytes = size_t(m_bucketCount) * sizeof(Bucket)
+                + m_activeHandles.capacity() * sizeof(Handle);
+        return stats;
+    }
+
 private:
     Q_DISABLE_COPY(ArrayAllocatingPolicy)
     struct Bucket
@@ -261,6 +360,9 @@ private:
     std::vector<Handle> m_activeHandles;
     typename Handle::Data *freeList = nullptr;
     int allocCounter = 1;
+    int m_bucketCount = 0;
+    bool m_allocatedSinceFrame = false;
+    int m_releasedSinceTrim = 0;
 
     void allocateBucket()
     {
@@ -273,6 +375,7 @@ private:
 
         b->header.next = firstBucket;
         firstBucket = b;
+        ++m_bucketCount;
         for (int i = 0; i < Bucket::NumEntries - 1; ++i) {
             b->data[i].nextFree = &b->data[i + 1];
         }
@@ -291,6 +394,10 @@ private:
             AlignedAllocator::release(b);
             b = n;
         }
+        firstBucket = nullptr;
+        freeList = nullptr;
+        m_bucketCount = 0;
+        m_releasedSinceTrim = 0;
     }
 
     template<typename Q = T>
@@ -352,16 +459,22 @@ public:
     {
         typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
         Allocator::releaseResource(handle);
+        withdrawPublishedTable();
     }
 
     bool contains(const KeyType &id) const
     {
+        if (!lookupPublishedHandle(id).isNull())
+            return true;
         typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
         return m_keyToHandleMap.contains(id);
     }
 
     Handle getOrAcquireHandle(const KeyType &id)
     {
+        const Handle publishedHandle = lookupPublishedHandle(id);
+        if (!publishedHandle.isNull())
+            return publishedHandle;
         typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
         Handle handle = m_keyToHandleMap.value(id);
         if (handle.isNull()) {
@@ -371,6 +484,7 @@ public:
             Handle &handleToSet = m_keyToHandleMap[id];
             if (handleToSet.isNull()) {
                 handleToSet = Allocator::allocateResource();
+                m_lookupTableDirty = true;
             }
             return handleToSet;
         }
@@ -379,14 +493,21 @@ public:
 
     Handle lookupHandle(const KeyType &id)
     {
+        const Handle publishedHandle = lookupPublishedHandle(id);
+        if (!publishedHandle.isNull())
+            return publishedHandle;
         typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
         return m_keyToHandleMap.value(id);
     }
 
     ValueType *lookupResource(const KeyType &id)
     {
-        ValueType* ret = nullptr;
-        {
+        // Published handles are live, no need to check their counter
+        const Handle publishedHandle = lookupPublishedHandle(id);
+        ValueType* ret = publishedHandle.isNull()
+                ? nullptr
+                : &static_cast<QHandleData<ValueType> *>(publishedHandle.data_ptr())->data;
+        if (!ret) {
             typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
             Handle handle = m_keyToHandleMap.value(id);
             if (!handle.isNull())
@@ -405,8 +526,10 @@ public:
     {
         typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
         Handle handle = m_keyToHandleMap.take(id);
-        if (!handle.isNull())
+        if (!handle.isNull()) {
             Allocator::releaseResource(handle);
+            withdrawPublishedTable();
+        }
     }
 
     // Releases all resources referenced by a key
@@ -420,12 +543,86 @@ public:
             Allocator::releaseResource(h);
         // Clear Key to Handle Map
         m_keyToHandleMap.clear();
+        withdrawPublishedTable();
+    }
+
+    // Publishes a read-only copy of the key to handle table. Lookups made
+    // from aspect jobs (see QLookupTableReadScope) first go through it without
+    // taking any lock, and fall back to the locked table for keys added since
+    // the last publication. Releasing any resource withdraws the published
+    // table until the next publication, so that its handles are always live
+    // and their entries never need to be read without the lock.
+    // Must be called while no aspect job runs, i.e. before jobs are launched:
+    // since all the jobs of a frame are done before the next one is published,
+    // the previous table can be freed right away.
+    void publishLookupTable()
+    {
+        typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
+        if (!m_lookupTableDirty && m_publishedTable)
+            return;
+        m_lookupTableDirty = false;
+        // QHash is implicitly shared, the copy only detaches on the next write.
+        // Keys whose handle was released directly are left out.
+        const bool hasStaleHandles = std::any_of(m_keyToHandleMap.cbegin(), m_keyToHandleMap.cend(),
+                                                 [] (const Handle &h) { return h.data() == nullptr; });
+        if (hasStaleHandles) {
+            QHash<KeyType, Handle> liveHandles;
+            for (auto it = m_keyToHandleMap.cbegin(), end = m_keyToHandleMap.cend(); it != end; ++it) {
+                if (it.value().data() != nullptr)
+                    liveHandles.insert(it.key(), it.value());
+            }
+            m_publishedTable.reset(new QHash<KeyType, Handle>(std::move(liveHandles)));
+        } else {
+            m_publishedTable.reset(new QHash<KeyType, Handle>(m_keyToHandleMap));
+        }
+        m_publishedTablePtr.storeRelease(m_publishedTable.get());
+    }
+
+    void trim()
+    {
+        typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
+        Allocator::trim();
+    }
+
+    bool trimIfIdle()
+    {
+        typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
+        return Allocator::trimIfIdle();
+    }
+
+    typename Allocator::MemoryStatistics memoryStatistics() const
+    {
+        typename LockingPolicy<QResourceManager>::ReadLocker lock(this);
+        return Allocator::memoryStatistics();
     }
 
 protected:
     QHash<KeyType, Handle > m_keyToHandleMap;
 
 private:
+    // Returns a null handle if the key isn't in the published table, if it
+    // was withdrawn or if not called from an aspect job
+    Handle lookupPublishedHandle(const KeyType &id) const
+    {
+        if (!QLookupTableReadScope::isActive())
+            return Handle();
+        const QHash<KeyType, Handle> *table = m_publishedTablePtr.loadAcquire();
+        if (!table)
+            return Handle();
+        return table->value(id);
+    }
+
+    // Must be called with the write lock held
+    void withdrawPublishedTable()
+    {
+        m_publishedTablePtr.storeRelease(nullptr);
+        m_lookupTableDirty = true;
+    }
+
+    QAtomicPointer<const QHash<KeyType, Handle>> m_publishedTablePtr;
+    std::unique_ptr<const QHash<KeyType, Handle>> m_publishedTable;
+    bool m_lookupTableDirty = false;
+
     friend QDebug operator<< <>(QDebug dbg, const QResourceManager<ValueType, KeyType, LockingPolicy> &manager);
 };
 
@@ -436,7 +633,9 @@ template <typename ValueType, typename KeyType,
 QDebug operator<<(QDebug dbg, const QResourceManager<ValueType, KeyType, LockingPolicy> &manager)
 {
     QDebugStateSaver saver(dbg);
-    dbg << "Contains" << manager.count() << "items" << Qt::endl;
+    const auto stats = manager.Allocator::memoryStatistics();
+    dbg << "Contains" << stats.activeCount << "items in" << stats.bucketCount << "buckets"
+        << "(" << stats.allocatedBytes << "bytes )" << Qt::endl;
 
     dbg << "Key to Handle Map:" << Qt::endl;
     const auto end = manager.m_keyToHandleMap.cend();
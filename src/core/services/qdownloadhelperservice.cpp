@@ -87,7 +87,9 @@ void QDownloadHelperServicePrivate::shutdown()
 // Executed in AspectThread (queued signal connected to download thread)
 void QDownloadHelperServicePrivate::_q_onRequestCompleted(const Qt3DCore::QDownloadRequestPtr &request)
 {
+    Q_Q(QDownloadHelperService);
     request->onCompleted();
+    emit q->requestCompleted();
 }
 
 
@@ -78,6 +78,10 @@ public:
     static bool isLocal(const QUrl &url);
     static QDownloadHelperService *getService(QAspectEngine *engine);
 
+Q_SIGNALS:
+    // Emitted once a completed request has been handed back to its issuer
+    void requestCompleted();
+
 private:
     Q_DECLARE_PRIVATE(QDownloadHelperService)
     Q_PRIVATE_SLOT(d_func(), void _q_onRequestCompleted(const Qt3DCore::QDownloadRequestPtr &))
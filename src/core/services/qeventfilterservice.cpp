@@ -139,6 +139,9 @@ InternalEventListener::InternalEventListener(QEventFilterServicePrivate *filterS
 
 bool InternalEventListener::eventFilter(QObject *obj, QEvent *e)
 {
+    if (e->isInputEvent())
+        emit m_filterService->q_func()->inputEventReceived();
+
     for (auto i = m_filterService->m_eventFilters.size(); i > 0; --i) {
         const FilterPriorityPair &fPPair = m_filterService->m_eventFilters[i - 1];
         if (fPPair.filter->eventFilter(obj, e))
@@ -38,6 +38,10 @@ public:
     void registerEventFilter(QObject *eventFilter, int priority);
     void unregisterEventFilter(QObject *eventFilter);
 
+Q_SIGNALS:
+    // Emitted for user input events received by the event source
+    void inputEventReceived();
+
 private:
     Q_DECLARE_PRIVATE(QEventFilterService)
 };
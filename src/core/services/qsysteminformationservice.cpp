@@ -118,6 +118,21 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
 
     using JobRunStats = QSystemInformationServicePrivate::JobRunStats;
 
+    if (m_frameStatsHandler) {
+        QList<JobRunStats> jobStats;
+        QList<JobRunStats> submissionStats;
+        QMutexLocker lock(&m_localStoragesMutex);
+        for (QList<JobRunStats> *storage : qAsConst(m_localStorages)) {
+            jobStats += *storage;
+            storage->clear();
+        }
+        if (m_submissionStorage != nullptr)
+            submissionStats.swap(*m_submissionStorage);
+        m_frameStatsHandler(m_frameId, jobStats, submissionStats);
+        ++m_frameId;
+        return;
+    }
+
     if (!m_traceFile) {
         const QString fileName = QStringLiteral("trace_") + QCoreApplication::applicationName() +
                                  QDateTime::currentDateTime().toString(QStringLiteral("_yyMMdd-hhmmss_")) +
@@ -172,6 +187,12 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
     ++m_frameId;
 }
 
+void QSystemInformationServicePrivate::setFrameStatsHandler(FrameStatsHandler handler)
+{
+    QMutexLocker lock(&m_localStoragesMutex);
+    m_frameStatsHandler = std::move(handler);
+}
+
 void QSystemInformationServicePrivate::updateTracing()
 {
     if (m_traceEnabled || m_graphicsTraceEnabled) {
@@ -20,6 +20,8 @@
 #include <QtCore/QFile>
 #include <QtCore/QMutex>
 
+#include <functional>
+
 #include <Qt3DCore/qt3dcore_global.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
 #include <Qt3DCore/private/qabstractserviceprovider_p.h>
@@ -70,6 +72,12 @@ public:
     void writeFrameJobLogStats();
     void updateTracing();
 
+    // When set, the stats of each frame are handed over instead of being written to the trace file
+    using FrameStatsHandler = std::function<void(quint32 frameId,
+                                                 const QList<JobRunStats> &jobStats,
+                                                 const QList<JobRunStats> &submissionStats)>;
+    void setFrameStatsHandler(FrameStatsHandler handler);
+
     QAspectEngine *m_aspectEngine;
     bool m_traceEnabled;
     bool m_graphicsTraceEnabled;
@@ -86,6 +94,7 @@ public:
     quint32 m_frameId;
 
     Debug::AspectCommandDebugger *m_commandDebugger;
+    FrameStatsHandler m_frameStatsHandler;
 
     Q_DECLARE_PUBLIC(QSystemInformationService)
 };
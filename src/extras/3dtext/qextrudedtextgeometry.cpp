@@ -11,6 +11,14 @@
 #include <QTextLayout>
 #include <QTime>
 #include <QPainterPath>
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtGui/qglyphrun.h>
+#include <QtGui/qrawfont.h>
+#include <QtGui/private/qrawfont_p.h>
+
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -22,6 +30,11 @@ static float edgeSplitAngle = 90.f * 0.1f;
 
 using IndexType = unsigned int;
 
+struct Vertex {
+    QVector3D position;
+    QVector3D normal;
+};
+
 struct TriangulationData {
     struct Outline {
         int begin;
@@ -35,25 +48,20 @@ struct TriangulationData {
     bool inverted;
 };
 
-TriangulationData triangulate(const QString &text, const QFont &font)
+TriangulationData triangulate(const QPainterPath &glyphPath)
 {
     TriangulationData result;
     int beginOutline = 0;
 
-    // Initialize path with text and extract polygons
-    QPainterPath path;
-    path.setFillRule(Qt::WindingFill);
-    path.addText(0, 0, font, text);
-    QList<QPolygonF> polygons = path.toSubpathPolygons(QTransform().scale(1., -1.));
+    // Extract polygons, flipped so that the y axis points up
+    QList<QPolygonF> polygons = glyphPath.toSubpathPolygons(QTransform().scale(1., -1.));
 
     // maybe glyph has no geometry
     if (polygons.size() == 0)
         return result;
 
-    const size_t prevNumIndices = result.indices.size();
-
-    // Reset path and add previously extracted polygons (which where spatially transformed)
-    path = QPainterPath();
+    // Add previously extracted polygons (which where spatially transformed)
+    QPainterPath path;
     path.setFillRule(Qt::WindingFill);
     for (QPolygonF &p : polygons)
         path.addPolygon(p);
@@ -79,16 +87,12 @@ TriangulationData triangulate(const QString &text, const QFont &font)
     // Triangulate path
     const QTriangleSet triangles = qTriangulate(path);
 
-    // Append new indices to result.indices buffer
-    result.indices.resize(result.indices.size() + size_t(triangles.indices.size()));
-    memcpy(&result.indices[prevNumIndices], triangles.indices.data(), size_t(triangles.indices.size()) * sizeof(IndexType));
-    for (size_t i = prevNumIndices, m = result.indices.size(); i < m; ++i)
-        result.indices[i] += IndexType(result.vertices.size());
+    result.indices.resize(size_t(triangles.indices.size()));
+    memcpy(result.indices.data(), triangles.indices.data(), size_t(triangles.indices.size()) * sizeof(IndexType));
 
-    // Append new triangles to result.vertices
     result.vertices.reserve(size_t(triangles.vertices.size()) / 2);
     for (int i = 0, m = triangles.vertices.size(); i < m; i += 2)
-        result.vertices.push_back(QVector3D(triangles.vertices[i] / font.pointSizeF(), triangles.vertices[i + 1] / font.pointSizeF(), 0.0f));
+        result.vertices.push_back(QVector3D(triangles.vertices[i], triangles.vertices[i + 1], 0.0f));
 
     return result;
 }
@@ -98,8 +102,176 @@ inline QVector3D mix(const QVector3D &a, const QVector3D &b, float ratio)
     return a + (b - a) * ratio;
 }
 
+// Mesh of a single glyph, in font units and extruded along z from 0 to 1.
+// Normals of the side walls face outward for a positive extrusion depth.
+struct ExtrudedGlyph
+{
+    std::vector<Vertex> vertices;
+    std::vector<IndexType> indices;
+    size_t sideVerticesBegin = 0;
+};
+
+ExtrudedGlyph extrudeGlyph(const QPainterPath &glyphPath)
+{
+    TriangulationData data = triangulate(glyphPath);
+
+    const IndexType numVertices = IndexType(data.vertices.size());
+    const size_t numIndices = data.indices.size();
+
+    ExtrudedGlyph glyph;
+    std::vector<IndexType> &indices = glyph.indices;
+    std::vector<Vertex> &vertices = glyph.vertices;
+
+    // TODO: keep 'vertices.size()' small when extruding
+    vertices.reserve(data.vertices.size() * 2);
+    for (QVector3D &v : data.vertices) // front face
+        vertices.push_back({ v, // vertex
+                             QVector3D(0.0f, 0.0f, -1.0f) }); // normal
+    for (QVector3D &v : data.vertices) // front face
+        vertices.push_back({ QVector3D(v.x(), v.y(), 1.0f), // vertex
+                             QVector3D(0.0f, 0.0f, 1.0f) }); // normal
+    glyph.sideVerticesBegin = vertices.size();
+
+    int verticesIndex = int(vertices.size());
+    for (size_t i = 0; i < data.outlines.size(); ++i) {
+        const int begin = data.outlines[i].begin;
+        const int end = data.outlines[i].end;
+        const int verticesIndexBegin = verticesIndex;
+
+        if (begin == end)
+            continue;
+
+        QVector3D prevNormal = QVector3D::crossProduct(
+                                   vertices[data.outlineIndices[end - 1] + numVertices].position - vertices[data.outlineIndices[end - 1]].position,
+                                   vertices[data.outlineIndices[begin]].position - vertices[data.outlineIndices[end - 1]].position).normalized();
+
+        for (int j = begin; j < end; ++j) {
+            const bool isLastIndex = (j == end - 1);
+            const IndexType cur = data.outlineIndices[j];
+            const IndexType next = data.outlineIndices[((j - begin + 1) % (end - begin)) + begin]; // normalize, bring in range and adjust
+            const QVector3D normal = QVector3D::crossProduct(vertices[cur + numVertices].position - vertices[cur].position, vertices[next].position - vertices[cur].position).normalized();
+
+            // use smooth normals in case of a short angle
+            const bool smooth = QVector3D::dotProduct(prevNormal, normal) > (90.0f - edgeSplitAngle) / 90.0f;
+            const QVector3D resultNormal = smooth ? mix(prevNormal, normal, 0.5f) : normal;
+            if (!smooth)             {
+                vertices.push_back({vertices[cur].position,               prevNormal});
+                vertices.push_back({vertices[cur + numVertices].position, prevNormal});
+                verticesIndex += 2;
+            }
+
+            vertices.push_back({vertices[cur].position,               resultNormal});
+            vertices.push_back({vertices[cur + numVertices].position, resultNormal});
+
+            const int v0 = verticesIndex;
+            const int v1 = verticesIndex + 1;
+            const int v2 = isLastIndex ? verticesIndexBegin     : verticesIndex + 2;
+            const int v3 = isLastIndex ? verticesIndexBegin + 1 : verticesIndex + 3;
+
+            indices.push_back(v0);
+            indices.push_back(v1);
+            indices.push_back(v2);
+            indices.push_back(v2);
+            indices.push_back(v1);
+            indices.push_back(v3);
+
+            verticesIndex += 2;
+            prevNormal = normal;
+        }
+    }
+
+    // resize for following insertions
+    const int indicesOffset = int(indices.size());
+    indices.resize(indices.size() + numIndices * 2);
+
+    // copy values for back faces
+    IndexType *indicesFaces = indices.data() + indicesOffset;
+    memcpy(indicesFaces, data.indices.data(), numIndices * sizeof(IndexType));
+
+    // insert values for front face and flip triangles
+    for (size_t j = 0; j < numIndices; j += 3) {
+        indicesFaces[numIndices + j    ] = indicesFaces[j    ] + numVertices;
+        indicesFaces[numIndices + j + 1] = indicesFaces[j + 2] + numVertices;
+        indicesFaces[numIndices + j + 2] = indicesFaces[j + 1] + numVertices;
+    }
+
+    return glyph;
+}
+
+using ExtrudedGlyphPtr = std::shared_ptr<const ExtrudedGlyph>;
+
+struct GlyphKey
+{
+    QString font;
+    quint32 glyph;
+
+    bool operator==(const GlyphKey &other) const
+    {
+        return glyph == other.glyph && font == other.font;
+    }
+};
+
+size_t qHash(const GlyphKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.font, key.glyph);
+}
+
+// Glyph outlines only depend on the font face, which the family and style
+// names don't identify, and on the pixel size of the raw font
+QString glyphFontKey(const QRawFont &font)
+{
+    const QFontEngine *fontEngine = QRawFontPrivate::get(font)->fontEngine;
+    const QFontEngine::FaceId faceId = fontEngine->faceId();
+    QByteArray face = faceId.filename.isEmpty() ? faceId.uuid : faceId.filename;
+    if (face.isEmpty()) {
+        return QStringLiteral("%1 %2 %3 %4 %5").arg(font.familyName(), font.styleName())
+                .arg(font.pixelSize()).arg(font.weight()).arg(int(font.style()));
+    }
+    face += ' ' + QByteArray::number(faceId.index)
+            + ' ' + QByteArray::number(fontEngine->synthesized())
+            + ' ' + QByteArray::number(font.pixelSize());
+    return QString::fromUtf8(face);
+}
+
+// Extruded glyphs shared by all the geometries. Entries cost their number
+// of vertices, a few thousand glyphs of a detailed font fit in the cache
+struct ExtrudedGlyphCache
+{
+    QMutex mutex;
+    QCache<GlyphKey, ExtrudedGlyphPtr> glyphs { 1 << 20 };
+
+    ExtrudedGlyphPtr find(const GlyphKey &key)
+    {
+        QMutexLocker lock(&mutex);
+        const ExtrudedGlyphPtr *glyph = glyphs.object(key);
+        return glyph ? *glyph : ExtrudedGlyphPtr();
+    }
+
+    void insert(const GlyphKey &key, const ExtrudedGlyphPtr &glyph)
+    {
+        QMutexLocker lock(&mutex);
+        glyphs.insert(key, new ExtrudedGlyphPtr(glyph), qMax(qsizetype(1), qsizetype(glyph->vertices.size())));
+    }
+};
+
+Q_GLOBAL_STATIC(ExtrudedGlyphCache, extrudedGlyphCache)
+
 } // anonymous namespace
 
+struct ExtrudedTextGlyph
+{
+    GlyphKey key;
+    QPointF position;
+    ExtrudedGlyphPtr mesh;
+};
+
+// Lets triangulation jobs post their results to the geometry while it exists
+struct ExtrudedTextUpdateTarget
+{
+    QMutex mutex;
+    QExtrudedTextGeometry *geometry = nullptr;
+};
+
 QExtrudedTextGeometryPrivate::QExtrudedTextGeometryPrivate()
     : QGeometryPrivate()
     , m_font(QFont(QStringLiteral("Arial")))
@@ -109,6 +281,8 @@ QExtrudedTextGeometryPrivate::QExtrudedTextGeometryPrivate()
     , m_indexAttribute(nullptr)
     , m_vertexBuffer(nullptr)
     , m_indexBuffer(nullptr)
+    , m_updateSerial(0)
+    , m_updateTarget(std::make_shared<ExtrudedTextUpdateTarget>())
 {
     m_font.setPointSize(4);
 }
@@ -121,6 +295,7 @@ void QExtrudedTextGeometryPrivate::init()
     m_indexAttribute = new Qt3DCore::QAttribute(q);
     m_vertexBuffer = new Qt3DCore::QBuffer(q);
     m_indexBuffer = new Qt3DCore::QBuffer(q);
+    m_updateTarget->geometry = q;
 
     const quint32 elementSize = 3 + 3;
     const quint32 stride = elementSize * sizeof(float);
@@ -247,120 +422,138 @@ QExtrudedTextGeometry::QExtrudedTextGeometry(QExtrudedTextGeometryPrivate &dd, Q
  * \internal
  */
 QExtrudedTextGeometry::~QExtrudedTextGeometry()
-{}
+{
+    Q_D(QExtrudedTextGeometry);
+    QMutexLocker lock(&d->m_updateTarget->mutex);
+    d->m_updateTarget->geometry = nullptr;
+}
 
 /*!
  * \internal
  * Updates vertices based on text, font, extrusionLength and smoothAngle properties.
+ *
+ * Glyphs are triangulated and extruded once per font and shared by all the
+ * geometries. Glyphs that are not in that cache yet are triangulated on
+ * worker threads, the geometry keeps its previous content until they are
+ * ready.
  */
 void QExtrudedTextGeometryPrivate::update()
 {
     if (m_text.trimmed().isEmpty()) // save enough?
         return;
 
-    TriangulationData data = triangulate(m_text, m_font);
-
-    const IndexType numVertices = IndexType(data.vertices.size());
-    const size_t numIndices = data.indices.size();
-
-    struct Vertex {
-        QVector3D position;
-        QVector3D normal;
-    };
-
-    std::vector<IndexType> indices;
-    std::vector<Vertex> vertices;
-
-    // TODO: keep 'vertices.size()' small when extruding
-    vertices.reserve(data.vertices.size() * 2);
-    for (QVector3D &v : data.vertices) // front face
-        vertices.push_back({ v, // vertex
-                             QVector3D(0.0f, 0.0f, -1.0f) }); // normal
-    for (QVector3D &v : data.vertices) // front face
-        vertices.push_back({ QVector3D(v.x(), v.y(), m_depth), // vertex
-                             QVector3D(0.0f, 0.0f, 1.0f) }); // normal
-
-    int verticesIndex = int(vertices.size());
-    for (size_t i = 0; i < data.outlines.size(); ++i) {
-        const int begin = data.outlines[i].begin;
-        const int end = data.outlines[i].end;
-        const int verticesIndexBegin = verticesIndex;
-
-        if (begin == end)
-            continue;
-
-        QVector3D prevNormal = QVector3D::crossProduct(
-                                   vertices[data.outlineIndices[end - 1] + numVertices].position - vertices[data.outlineIndices[end - 1]].position,
-                                   vertices[data.outlineIndices[begin]].position - vertices[data.outlineIndices[end - 1]].position).normalized();
-
-        for (int j = begin; j < end; ++j) {
-            const bool isLastIndex = (j == end - 1);
-            const IndexType cur = data.outlineIndices[j];
-            const IndexType next = data.outlineIndices[((j - begin + 1) % (end - begin)) + begin]; // normalize, bring in range and adjust
-            const QVector3D normal = QVector3D::crossProduct(vertices[cur + numVertices].position - vertices[cur].position, vertices[next].position - vertices[cur].position).normalized();
-
-            // use smooth normals in case of a short angle
-            const bool smooth = QVector3D::dotProduct(prevNormal, normal) > (90.0f - edgeSplitAngle) / 90.0f;
-            const QVector3D resultNormal = smooth ? mix(prevNormal, normal, 0.5f) : normal;
-            if (!smooth)             {
-                vertices.push_back({vertices[cur].position,               prevNormal});
-                vertices.push_back({vertices[cur + numVertices].position, prevNormal});
-                verticesIndex += 2;
-            }
-
-            vertices.push_back({vertices[cur].position,               resultNormal});
-            vertices.push_back({vertices[cur + numVertices].position, resultNormal});
-
-            const int v0 = verticesIndex;
-            const int v1 = verticesIndex + 1;
-            const int v2 = isLastIndex ? verticesIndexBegin     : verticesIndex + 2;
-            const int v3 = isLastIndex ? verticesIndexBegin + 1 : verticesIndex + 3;
-
-            indices.push_back(v0);
-            indices.push_back(v1);
-            indices.push_back(v2);
-            indices.push_back(v2);
-            indices.push_back(v1);
-            indices.push_back(v3);
-
-            verticesIndex += 2;
-            prevNormal = normal;
+    const quint64 serial = ++m_updateSerial;
+    auto glyphs = std::make_shared<std::vector<ExtrudedTextGlyph>>();
+    QHash<GlyphKey, QPainterPath> missingGlyphs;
+
+    QTextLayout layout(m_text, m_font);
+    layout.beginLayout();
+    const QTextLine line = layout.createLine();
+    layout.endLayout();
+
+    const QList<QGlyphRun> glyphRuns = layout.glyphRuns();
+    for (const QGlyphRun &glyphRun : glyphRuns) {
+        const QRawFont rawFont = glyphRun.rawFont();
+        const QString fontKey = glyphFontKey(rawFont);
+        const QList<quint32> indexes = glyphRun.glyphIndexes();
+        const QList<QPointF> positions = glyphRun.positions();
+        for (qsizetype i = 0, m = qMin(indexes.size(), positions.size()); i < m; ++i) {
+            GlyphKey key { fontKey, indexes[i] };
+            // The origin of the text is on its baseline
+            const QPointF position(positions[i].x(), positions[i].y() - line.ascent());
+            ExtrudedGlyphPtr mesh = extrudedGlyphCache()->find(key);
+            if (!mesh && !missingGlyphs.contains(key))
+                missingGlyphs.insert(key, rawFont.pathForGlyph(key.glyph));
+            glyphs->push_back({ std::move(key), position, std::move(mesh) });
         }
     }
 
-    { // upload vertices
-        QByteArray data;
-        data.resize(vertices.size() * sizeof(Vertex));
-        memcpy(data.data(), vertices.data(), vertices.size() * sizeof(Vertex));
+    if (missingGlyphs.isEmpty()) {
+        updateGeometry(*glyphs);
+        return;
+    }
 
-        m_vertexBuffer->setData(data);
-        m_positionAttribute->setCount(int(vertices.size()));
-        m_normalAttribute->setCount(int(vertices.size()));
+    auto remainingJobs = std::make_shared<std::atomic<qsizetype>>(missingGlyphs.size());
+    const std::shared_ptr<ExtrudedTextUpdateTarget> target = m_updateTarget;
+    for (auto it = missingGlyphs.cbegin(), end = missingGlyphs.cend(); it != end; ++it) {
+        QThreadPool::globalInstance()->start([=, key = it.key(), path = it.value()] {
+            const ExtrudedGlyphPtr mesh = std::make_shared<const ExtrudedGlyph>(extrudeGlyph(path));
+            extrudedGlyphCache()->insert(key, mesh);
+            // Each job only writes the glyphs of its own key
+            for (ExtrudedTextGlyph &glyph : *glyphs) {
+                if (glyph.key == key)
+                    glyph.mesh = mesh;
+            }
+            if (remainingJobs->fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            QMutexLocker lock(&target->mutex);
+            if (target->geometry == nullptr)
+                return;
+            // Pending calls are dropped if the geometry is destroyed meanwhile
+            QExtrudedTextGeometry *geometry = target->geometry;
+            QMetaObject::invokeMethod(geometry, [geometry, serial, glyphs] {
+                QExtrudedTextGeometryPrivate *d = QExtrudedTextGeometryPrivate::get(geometry);
+                if (d->m_updateSerial == serial)
+                    d->updateGeometry(*glyphs);
+            }, Qt::QueuedConnection);
+        });
     }
+}
 
-    // resize for following insertions
-    const int indicesOffset = int(indices.size());
-    indices.resize(indices.size() + numIndices * 2);
+QExtrudedTextGeometryPrivate *QExtrudedTextGeometryPrivate::get(QExtrudedTextGeometry *q)
+{
+    return q->d_func();
+}
 
-    // copy values for back faces
-    IndexType *indicesFaces = indices.data() + indicesOffset;
-    memcpy(indicesFaces, data.indices.data(), numIndices * sizeof(IndexType));
+/*!
+ * \internal
+ * Assembles the extruded \a glyphs into the vertex and index buffers.
+ */
+void QExtrudedTextGeometryPrivate::updateGeometry(const std::vector<ExtrudedTextGlyph> &glyphs)
+{
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    for (const ExtrudedTextGlyph &glyph : glyphs) {
+        numVertices += glyph.mesh->vertices.size();
+        numIndices += glyph.mesh->indices.size();
+    }
 
-    // insert values for front face and flip triangles
-    for (size_t j = 0; j < numIndices; j += 3) {
-        indicesFaces[numIndices + j    ] = indicesFaces[j    ] + numVertices;
-        indicesFaces[numIndices + j + 1] = indicesFaces[j + 2] + numVertices;
-        indicesFaces[numIndices + j + 2] = indicesFaces[j + 1] + numVertices;
+    // The geometry is normalized by the point size of the font
+    const float scale = 1.0f / float(m_font.pointSizeF());
+    // The side walls face the other way for negative depths
+    const float sideNormalSign = m_depth > 0.0f ? 1.0f : (m_depth < 0.0f ? -1.0f : 0.0f);
+
+    QByteArray vertexData;
+    vertexData.resize(numVertices * sizeof(Vertex));
+    QByteArray indexData;
+    indexData.resize(numIndices * sizeof(IndexType));
+    Vertex *vertices = reinterpret_cast<Vertex *>(vertexData.data());
+    IndexType *indices = reinterpret_cast<IndexType *>(indexData.data());
+
+    IndexType baseVertex = 0;
+    for (const ExtrudedTextGlyph &glyph : glyphs) {
+        const ExtrudedGlyph &mesh = *glyph.mesh;
+        const float x = float(glyph.position.x());
+        const float y = float(glyph.position.y());
+        for (size_t i = 0, m = mesh.vertices.size(); i < m; ++i) {
+            const Vertex &v = mesh.vertices[i];
+            *vertices++ = { QVector3D((v.position.x() + x) * scale,
+                                      (v.position.y() - y) * scale,
+                                      v.position.z() * m_depth),
+                            i < mesh.sideVerticesBegin ? v.normal : v.normal * sideNormalSign };
+        }
+        for (const IndexType index : mesh.indices)
+            *indices++ = index + baseVertex;
+        baseVertex += IndexType(mesh.vertices.size());
     }
 
-    { // upload indices
-        QByteArray data;
-        data.resize(indices.size() * sizeof(IndexType));
-        memcpy(data.data(), indices.data(), indices.size() * sizeof(IndexType));
+    m_vertexBuffer->setData(vertexData);
+    m_positionAttribute->setCount(uint(numVertices));
+    m_normalAttribute->setCount(uint(numVertices));
 
-        m_indexBuffer->setData(data);
-        m_indexAttribute->setCount(uint(indices.size()));
-    }
+    m_indexBuffer->setData(indexData);
+    m_indexAttribute->setCount(uint(numIndices));
 }
 
 void QExtrudedTextGeometry::setText(const QString &text)
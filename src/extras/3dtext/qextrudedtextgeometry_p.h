@@ -19,6 +19,9 @@
 #include <Qt3DExtras/qextrudedtextgeometry.h>
 #include <QFont>
 
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -31,6 +34,8 @@ class QBuffer;
 namespace Qt3DExtras {
 
 class QExtrudedTextGeometry;
+struct ExtrudedTextGlyph;
+struct ExtrudedTextUpdateTarget;
 
 class QExtrudedTextGeometryPrivate : public Qt3DCore::QGeometryPrivate
 {
@@ -38,6 +43,9 @@ public:
     QExtrudedTextGeometryPrivate();
     void init();
     void update() override;
+    void updateGeometry(const std::vector<ExtrudedTextGlyph> &glyphs);
+
+    static QExtrudedTextGeometryPrivate *get(QExtrudedTextGeometry *q);
 
     QString m_text;
     QFont m_font;
@@ -50,6 +58,9 @@ public:
     Qt3DCore::QBuffer *m_vertexBuffer;
     Qt3DCore::QBuffer *m_indexBuffer;
 
+    quint64 m_updateSerial;
+    std::shared_ptr<ExtrudedTextUpdateTarget> m_updateTarget;
+
     Q_DECLARE_PUBLIC(QExtrudedTextGeometry)
 };
 
@@ -22,7 +22,8 @@ HEADERS += \
     $$PWD/qcuboidgeometryview.h \
     $$PWD/qplanegeometry.h \
     $$PWD/qplanegeometry_p.h \
-    $$PWD/qplanegeometryview.h
+    $$PWD/qplanegeometryview.h \
+    $$PWD/sharedgeometrybuffer_p.h
 
 SOURCES += \
     $$PWD/qconegeometry.cpp \
@@ -42,6 +43,7 @@ SOURCES += \
     $$PWD/qcuboidgeometry.cpp \
     $$PWD/qcuboidgeometryview.cpp \
     $$PWD/qplanegeometry.cpp \
-    $$PWD/qplanegeometryview.cpp
+    $$PWD/qplanegeometryview.cpp \
+    $$PWD/sharedgeometrybuffer.cpp
 
 INCLUDEPATH += $$PWD
@@ -201,8 +201,6 @@ QConeGeometryPrivate::QConeGeometryPrivate()
     , m_texCoordAttribute(nullptr)
     , m_indexAttribute(nullptr)
     , m_positionBuffer(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -213,8 +211,6 @@ void QConeGeometryPrivate::init()
     m_normalAttribute = new QAttribute(q);
     m_texCoordAttribute = new QAttribute(q);
     m_indexAttribute = new QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
 
     // vec3 pos, vec2 tex, vec3 normal
     const quint32 elementSize = 3 + 2 + 3;
@@ -226,7 +222,6 @@ void QConeGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -234,7 +229,6 @@ void QConeGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -243,19 +237,17 @@ void QConeGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     m_indexAttribute->setCount(faces * 3);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -305,6 +297,31 @@ QByteArray QConeGeometryPrivate::generateIndexData() const
     return indicesBytes;
 }
 
+void QConeGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QConeGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("cone vertices", m_hasTopEndcap, m_hasBottomEndcap, m_rings, m_slices, m_topRadius, m_bottomRadius, m_length),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute });
+}
+
+void QConeGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QConeGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("cone indices", m_hasTopEndcap, m_hasBottomEndcap, m_rings, m_slices),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QConeGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 /*!
  * \qmltype ConeGeometry
  * \instantiates Qt3DExtras::QConeGeometry
@@ -400,6 +417,9 @@ QConeGeometry::QConeGeometry(QConeGeometryPrivate &dd, QNode *parent)
 /*! \internal */
 QConeGeometry::~QConeGeometry()
 {
+    Q_D(QConeGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -414,7 +434,7 @@ void QConeGeometry::updateVertices()
     d->m_positionAttribute->setCount(nVerts);
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_normalAttribute->setCount(nVerts);
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 /*!
@@ -427,7 +447,7 @@ void QConeGeometry::updateIndices()
                                 (d->m_hasTopEndcap + d->m_hasBottomEndcap));
 
     d->m_indexAttribute->setCount(faces * 3);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 }
 
 /*!
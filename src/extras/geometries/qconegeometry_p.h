@@ -16,6 +16,7 @@
 //
 
 #include <Qt3DCore/private/qgeometry_p.h>
+#include <Qt3DExtras/private/sharedgeometrybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,6 +35,7 @@ public:
     QConeGeometryPrivate();
 
     void init();
+    void setScene(Qt3DCore::QScene *scene) override;
 
     Q_DECLARE_PUBLIC(QConeGeometry)
 
@@ -49,11 +51,13 @@ public:
     Qt3DCore::QAttribute *m_texCoordAttribute;
     Qt3DCore::QAttribute *m_indexAttribute;
     Qt3DCore::QBuffer *m_positionBuffer;
-    Qt3DCore::QBuffer *m_vertexBuffer;
-    Qt3DCore::QBuffer *m_indexBuffer;
+    SharedGeometryBuffer m_vertexBuffer;
+    SharedGeometryBuffer m_indexBuffer;
 
     QByteArray generateVertexData() const;
     QByteArray generateIndexData() const;
+    void updateVertexBuffer();
+    void updateIndexBuffer();
 };
 
 } // Qt3DExtras
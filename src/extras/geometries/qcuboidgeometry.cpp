@@ -362,8 +362,6 @@ QCuboidGeometryPrivate::QCuboidGeometryPrivate()
     , m_texCoordAttribute(nullptr)
     , m_tangentAttribute(nullptr)
     , m_indexAttribute(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -375,8 +373,6 @@ void QCuboidGeometryPrivate::init()
     m_texCoordAttribute = new Qt3DCore::QAttribute(q);
     m_tangentAttribute = new Qt3DCore::QAttribute(q);
     m_indexAttribute = new Qt3DCore::QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
 
     // vec3 pos vec2 tex vec3 normal vec4 tangent
     const quint32 stride = (3 + 2 + 3 + 4) * sizeof(float);
@@ -394,7 +390,6 @@ void QCuboidGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -402,7 +397,6 @@ void QCuboidGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -411,7 +405,6 @@ void QCuboidGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
@@ -420,19 +413,17 @@ void QCuboidGeometryPrivate::init()
     m_tangentAttribute->setVertexBaseType(QAttribute::Float);
     m_tangentAttribute->setVertexSize(4);
     m_tangentAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_tangentAttribute->setBuffer(m_vertexBuffer);
     m_tangentAttribute->setByteStride(stride);
     m_tangentAttribute->setByteOffset(8 * sizeof(float));
     m_tangentAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     m_indexAttribute->setCount(indexCount);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -452,6 +443,31 @@ QByteArray QCuboidGeometryPrivate::generateIndexData() const
     return createCuboidIndexData(m_yzFaceResolution, m_xzFaceResolution, m_xyFaceResolution);
 }
 
+void QCuboidGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QCuboidGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("cuboid vertices", m_xExtent, m_yExtent, m_zExtent, m_yzFaceResolution, m_xzFaceResolution, m_xyFaceResolution),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute, m_tangentAttribute });
+}
+
+void QCuboidGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QCuboidGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("cuboid indices", m_yzFaceResolution, m_xzFaceResolution, m_xyFaceResolution),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QCuboidGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 /*!
  * \qmltype CuboidGeometry
  * \instantiates Qt3DExtras::QCuboidGeometry
@@ -573,6 +589,9 @@ QCuboidGeometry::QCuboidGeometry(QCuboidGeometryPrivate &dd, QNode *parent)
  */
 QCuboidGeometry::~QCuboidGeometry()
 {
+    Q_D(QCuboidGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -587,7 +606,7 @@ void QCuboidGeometry::updateIndices()
     const int indexCount = 2 * (yzIndices + xzIndices + xyIndices);
 
     d->m_indexAttribute->setCount(indexCount);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 }
 
 /*!
@@ -606,7 +625,7 @@ void QCuboidGeometry::updateVertices()
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_tangentAttribute->setCount(nVerts);
 
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 void QCuboidGeometry::setXExtent(float xExtent)
@@ -154,8 +154,6 @@ QCylinderGeometryPrivate::QCylinderGeometryPrivate()
     , m_normalAttribute(nullptr)
     , m_texCoordAttribute(nullptr)
     , m_indexAttribute(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -166,8 +164,6 @@ void QCylinderGeometryPrivate::init()
     m_normalAttribute = new QAttribute(q);
     m_texCoordAttribute = new QAttribute(q);
     m_indexAttribute = new QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
 
     // vec3 pos, vec2 tex, vec3 normal
     const quint32 elementSize = 3 + 2 + 3;
@@ -179,7 +175,6 @@ void QCylinderGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -187,7 +182,6 @@ void QCylinderGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -196,19 +190,17 @@ void QCylinderGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     m_indexAttribute->setCount(faces * 3);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -252,6 +244,31 @@ QByteArray QCylinderGeometryPrivate::generateIndexData() const
     return indicesBytes;
 }
 
+void QCylinderGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QCylinderGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("cylinder vertices", m_rings, m_slices, m_radius, m_length),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute });
+}
+
+void QCylinderGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QCylinderGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("cylinder indices", m_rings, m_slices, m_length),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QCylinderGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 /*!
  * \qmltype CylinderGeometry
  * \instantiates Qt3DExtras::QCylinderGeometry
@@ -349,6 +366,9 @@ QCylinderGeometry::QCylinderGeometry(QCylinderGeometryPrivate &dd, QNode *parent
  */
 QCylinderGeometry::~QCylinderGeometry()
 {
+    Q_D(QCylinderGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -362,7 +382,7 @@ void QCylinderGeometry::updateVertices()
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_normalAttribute->setCount(nVerts);
 
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 /*!
@@ -373,7 +393,7 @@ void QCylinderGeometry::updateIndices()
     Q_D(QCylinderGeometry);
     const int faces = faceCount(d->m_slices, d->m_rings);
     d->m_indexAttribute->setCount(faces * 3);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 }
 
 void QCylinderGeometry::setRings(int rings)
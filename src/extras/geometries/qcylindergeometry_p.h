@@ -17,6 +17,7 @@
 
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DExtras/qcylindergeometry.h>
+#include <Qt3DExtras/private/sharedgeometrybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -35,6 +36,7 @@ public:
     QCylinderGeometryPrivate();
 
     void init();
+    void setScene(Qt3DCore::QScene *scene) override;
 
     Q_DECLARE_PUBLIC(QCylinderGeometry)
 
@@ -46,11 +48,13 @@ public:
     Qt3DCore::QAttribute *m_normalAttribute;
     Qt3DCore::QAttribute *m_texCoordAttribute;
     Qt3DCore::QAttribute *m_indexAttribute;
-    Qt3DCore::QBuffer *m_vertexBuffer;
-    Qt3DCore::QBuffer *m_indexBuffer;
+    SharedGeometryBuffer m_vertexBuffer;
+    SharedGeometryBuffer m_indexBuffer;
 
     QByteArray generateVertexData() const;
     QByteArray generateIndexData() const;
+    void updateVertexBuffer();
+    void updateIndexBuffer();
 };
 
 } // Qt3DExtras
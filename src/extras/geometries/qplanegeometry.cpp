@@ -214,6 +214,9 @@ QPlaneGeometry::QPlaneGeometry(QPlaneGeometryPrivate &dd, QNode *parent)
  */
 QPlaneGeometry::~QPlaneGeometry()
 {
+    Q_D(QPlaneGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -228,7 +231,7 @@ void QPlaneGeometry::updateVertices()
     d->m_normalAttribute->setCount(nVerts);
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_tangentAttribute->setCount(nVerts);
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 /*!
@@ -240,7 +243,7 @@ void QPlaneGeometry::updateIndices()
     const int faces = 2 * (d->m_meshResolution.width() - 1) * (d->m_meshResolution.height() - 1);
     // Each primitive has 3 vertices
     d->m_indexAttribute->setCount(faces * 3);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 
 }
 
@@ -396,8 +399,6 @@ QPlaneGeometryPrivate::QPlaneGeometryPrivate()
     , m_texCoordAttribute(nullptr)
     , m_tangentAttribute(nullptr)
     , m_indexAttribute(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -409,8 +410,6 @@ void QPlaneGeometryPrivate::init()
     m_texCoordAttribute = new QAttribute(q);
     m_tangentAttribute = new QAttribute(q);
     m_indexAttribute = new QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
 
     const int nVerts = m_meshResolution.width() * m_meshResolution.height();
     const int stride = (3 + 2 + 3 + 4) * sizeof(float);
@@ -420,7 +419,6 @@ void QPlaneGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -428,7 +426,6 @@ void QPlaneGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -437,7 +434,6 @@ void QPlaneGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
@@ -446,20 +442,18 @@ void QPlaneGeometryPrivate::init()
     m_tangentAttribute->setVertexBaseType(QAttribute::Float);
     m_tangentAttribute->setVertexSize(4);
     m_tangentAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_tangentAttribute->setBuffer(m_vertexBuffer);
     m_tangentAttribute->setByteStride(stride);
     m_tangentAttribute->setByteOffset(8 * sizeof(float));
     m_tangentAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     // Each primitive has 3 vertives
     m_indexAttribute->setCount(faces * 3);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -478,6 +472,31 @@ QByteArray QPlaneGeometryPrivate::generateIndexData() const
     return createPlaneIndexData(m_meshResolution);
 }
 
+void QPlaneGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QPlaneGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("plane vertices", m_width, m_height, m_meshResolution, m_mirrored),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute, m_tangentAttribute });
+}
+
+void QPlaneGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QPlaneGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("plane indices", m_meshResolution),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QPlaneGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 } //  Qt3DExtras
 
 QT_END_NAMESPACE
@@ -19,6 +19,7 @@
 
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DExtras/qplanegeometry.h>
+#include <Qt3DExtras/private/sharedgeometrybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +37,7 @@ class QPlaneGeometryPrivate : public Qt3DCore::QGeometryPrivate
 public:
     QPlaneGeometryPrivate();
     void init();
+    void setScene(Qt3DCore::QScene *scene) override;
 
     float m_width;
     float m_height;
@@ -46,13 +48,15 @@ public:
     Qt3DCore::QAttribute *m_texCoordAttribute;
     Qt3DCore::QAttribute *m_tangentAttribute;
     Qt3DCore::QAttribute *m_indexAttribute;
-    Qt3DCore::QBuffer *m_vertexBuffer;
-    Qt3DCore::QBuffer *m_indexBuffer;
+    SharedGeometryBuffer m_vertexBuffer;
+    SharedGeometryBuffer m_indexBuffer;
 
     Q_DECLARE_PUBLIC(QPlaneGeometry)
 
     QByteArray generateVertexData() const;
     QByteArray generateIndexData() const;
+    void updateVertexBuffer();
+    void updateIndexBuffer();
 };
 
 } // Qt3DExtras
@@ -141,8 +141,6 @@ QSphereGeometryPrivate::QSphereGeometryPrivate()
     , m_texCoordAttribute(nullptr)
     , m_tangentAttribute(nullptr)
     , m_indexAttribute(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -154,8 +152,6 @@ void QSphereGeometryPrivate::init()
     m_texCoordAttribute = new QAttribute(q);
     m_tangentAttribute = new QAttribute(q);
     m_indexAttribute = new QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
 
     // vec3 pos, vec2 tex, vec3 normal, vec4 tangent
     const quint32 elementSize = 3 + 2 + 3 + 4;
@@ -167,7 +163,6 @@ void QSphereGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -175,7 +170,6 @@ void QSphereGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -184,7 +178,6 @@ void QSphereGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
@@ -193,19 +186,17 @@ void QSphereGeometryPrivate::init()
     m_tangentAttribute->setVertexBaseType(QAttribute::Float);
     m_tangentAttribute->setVertexSize(4);
     m_tangentAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_tangentAttribute->setBuffer(m_vertexBuffer);
     m_tangentAttribute->setByteStride(stride);
     m_tangentAttribute->setByteOffset(8 * sizeof(float));
     m_tangentAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     m_indexAttribute->setCount(faces * 3);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -225,6 +216,31 @@ QByteArray QSphereGeometryPrivate::generateIndexData() const
     return createSphereMeshIndexData(m_rings, m_slices);
 }
 
+void QSphereGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QSphereGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("sphere vertices", m_radius, m_rings, m_slices),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute, m_tangentAttribute });
+}
+
+void QSphereGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QSphereGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("sphere indices", m_rings, m_slices),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QSphereGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 /*!
  * \qmltype SphereGeometry
  * \instantiates Qt3DExtras::QSphereGeometry
@@ -329,6 +345,9 @@ QSphereGeometry::QSphereGeometry(QSphereGeometryPrivate &dd, QNode *parent)
  */
 QSphereGeometry::~QSphereGeometry()
 {
+    Q_D(QSphereGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -342,7 +361,7 @@ void QSphereGeometry::updateVertices()
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_normalAttribute->setCount(nVerts);
     d->m_tangentAttribute->setCount(nVerts);
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 /*!
@@ -353,7 +372,7 @@ void QSphereGeometry::updateIndices()
     Q_D(QSphereGeometry);
     const int faces = (d->m_slices * 2) * (d->m_rings - 2) + (2 * d->m_slices);
     d->m_indexAttribute->setCount(faces * 3);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 }
 
 void QSphereGeometry::setRings(int rings)
@@ -17,6 +17,7 @@
 
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DExtras/qspheregeometry.h>
+#include <Qt3DExtras/private/sharedgeometrybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,6 +35,7 @@ class QSphereGeometryPrivate : public Qt3DCore::QGeometryPrivate
 public:
     QSphereGeometryPrivate();
     void init();
+    void setScene(Qt3DCore::QScene *scene) override;
 
     bool m_generateTangents;
     int m_rings;
@@ -44,13 +46,15 @@ public:
     Qt3DCore::QAttribute *m_texCoordAttribute;
     Qt3DCore::QAttribute *m_tangentAttribute;
     Qt3DCore::QAttribute *m_indexAttribute;
-    Qt3DCore::QBuffer *m_vertexBuffer;
-    Qt3DCore::QBuffer *m_indexBuffer;
+    SharedGeometryBuffer m_vertexBuffer;
+    SharedGeometryBuffer m_indexBuffer;
 
     Q_DECLARE_PUBLIC(QSphereGeometry)
 
     QByteArray generateVertexData() const;
     QByteArray generateIndexData() const;
+    void updateVertexBuffer();
+    void updateIndexBuffer();
 };
 
 } // Qt3DExtras
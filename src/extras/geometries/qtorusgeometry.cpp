@@ -127,8 +127,6 @@ QTorusGeometryPrivate::QTorusGeometryPrivate()
     , m_texCoordAttribute(nullptr)
     , m_tangentAttribute(nullptr)
     , m_indexAttribute(nullptr)
-    , m_vertexBuffer(nullptr)
-    , m_indexBuffer(nullptr)
 {
 }
 
@@ -140,8 +138,6 @@ void QTorusGeometryPrivate::init()
     m_texCoordAttribute = new QAttribute(q);
     m_tangentAttribute = new QAttribute(q);
     m_indexAttribute = new QAttribute(q);
-    m_vertexBuffer = new Qt3DCore::QBuffer(q);
-    m_indexBuffer = new Qt3DCore::QBuffer(q);
     // vec3 pos, vec2 tex, vec3 normal, vec4 tangent
     const quint32 elementSize = 3 + 2 + 3 + 4;
     const quint32 stride = elementSize * sizeof(float);
@@ -152,7 +148,6 @@ void QTorusGeometryPrivate::init()
     m_positionAttribute->setVertexBaseType(QAttribute::Float);
     m_positionAttribute->setVertexSize(3);
     m_positionAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_positionAttribute->setBuffer(m_vertexBuffer);
     m_positionAttribute->setByteStride(stride);
     m_positionAttribute->setCount(nVerts);
 
@@ -160,7 +155,6 @@ void QTorusGeometryPrivate::init()
     m_texCoordAttribute->setVertexBaseType(QAttribute::Float);
     m_texCoordAttribute->setVertexSize(2);
     m_texCoordAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_texCoordAttribute->setBuffer(m_vertexBuffer);
     m_texCoordAttribute->setByteStride(stride);
     m_texCoordAttribute->setByteOffset(3 * sizeof(float));
     m_texCoordAttribute->setCount(nVerts);
@@ -169,7 +163,6 @@ void QTorusGeometryPrivate::init()
     m_normalAttribute->setVertexBaseType(QAttribute::Float);
     m_normalAttribute->setVertexSize(3);
     m_normalAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_normalAttribute->setBuffer(m_vertexBuffer);
     m_normalAttribute->setByteStride(stride);
     m_normalAttribute->setByteOffset(5 * sizeof(float));
     m_normalAttribute->setCount(nVerts);
@@ -178,19 +171,17 @@ void QTorusGeometryPrivate::init()
     m_tangentAttribute->setVertexBaseType(QAttribute::Float);
     m_tangentAttribute->setVertexSize(4);
     m_tangentAttribute->setAttributeType(QAttribute::VertexAttribute);
-    m_tangentAttribute->setBuffer(m_vertexBuffer);
     m_tangentAttribute->setByteStride(stride);
     m_tangentAttribute->setByteOffset(8 * sizeof(float));
     m_tangentAttribute->setCount(nVerts);
 
     m_indexAttribute->setAttributeType(QAttribute::IndexAttribute);
     m_indexAttribute->setVertexBaseType(QAttribute::UnsignedShort);
-    m_indexAttribute->setBuffer(m_indexBuffer);
 
     m_indexAttribute->setCount(triangles * 3);
 
-    m_vertexBuffer->setData(generateVertexData());
-    m_indexBuffer->setData(generateIndexData());
+    updateVertexBuffer();
+    updateIndexBuffer();
 
     q->addAttribute(m_positionAttribute);
     q->addAttribute(m_texCoordAttribute);
@@ -209,6 +200,31 @@ QByteArray QTorusGeometryPrivate::generateIndexData() const
     return createTorusIndexData(m_rings, m_slices);
 }
 
+void QTorusGeometryPrivate::updateVertexBuffer()
+{
+    Q_Q(QTorusGeometry);
+    m_vertexBuffer.acquire(q, sharedGeometryBufferKey("torus vertices", m_radius, m_minorRadius, m_rings, m_slices),
+                           [this] { return generateVertexData(); },
+                           { m_positionAttribute, m_texCoordAttribute, m_normalAttribute, m_tangentAttribute });
+}
+
+void QTorusGeometryPrivate::updateIndexBuffer()
+{
+    Q_Q(QTorusGeometry);
+    m_indexBuffer.acquire(q, sharedGeometryBufferKey("torus indices", m_rings, m_slices),
+                          [this] { return generateIndexData(); },
+                          { m_indexAttribute });
+}
+
+void QTorusGeometryPrivate::setScene(Qt3DCore::QScene *scene)
+{
+    QGeometryPrivate::setScene(scene);
+    if (m_vertexBuffer.buffer() != nullptr) {
+        updateVertexBuffer();
+        updateIndexBuffer();
+    }
+}
+
 /*!
  * \qmltype TorusGeometry
  * \instantiates Qt3DExtras::QTorusGeometry
@@ -306,6 +322,9 @@ QTorusGeometry::QTorusGeometry(QTorusGeometryPrivate &dd, QNode *parent)
  */
 QTorusGeometry::~QTorusGeometry()
 {
+    Q_D(QTorusGeometry);
+    d->m_vertexBuffer.release();
+    d->m_indexBuffer.release();
 }
 
 /*!
@@ -318,7 +337,7 @@ void QTorusGeometry::updateVertices()
     d->m_positionAttribute->setCount(nVerts);
     d->m_texCoordAttribute->setCount(nVerts);
     d->m_normalAttribute->setCount(nVerts);
-    d->m_vertexBuffer->setData(d->generateVertexData());
+    d->updateVertexBuffer();
 }
 
 /*!
@@ -329,7 +348,7 @@ void QTorusGeometry::updateIndices()
     Q_D(QTorusGeometry);
     const int triangles = triangleCount(d->m_rings, d->m_slices);
     d->m_indexAttribute->setCount(triangles * 3);
-    d->m_indexBuffer->setData(d->generateIndexData());
+    d->updateIndexBuffer();
 }
 
 void QTorusGeometry::setRings(int rings)
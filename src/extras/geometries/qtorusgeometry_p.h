@@ -17,6 +17,7 @@
 
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DExtras/qtorusgeometry.h>
+#include <Qt3DExtras/private/sharedgeometrybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,6 +35,7 @@ class QTorusGeometryPrivate : public Qt3DCore::QGeometryPrivate
 public:
     QTorusGeometryPrivate();
     void init();
+    void setScene(Qt3DCore::QScene *scene) override;
 
     int m_rings;
     int m_slices;
@@ -44,13 +46,15 @@ public:
     Qt3DCore::QAttribute *m_texCoordAttribute;
     Qt3DCore::QAttribute *m_tangentAttribute;
     Qt3DCore::QAttribute *m_indexAttribute;
-    Qt3DCore::QBuffer *m_vertexBuffer;
-    Qt3DCore::QBuffer *m_indexBuffer;
+    SharedGeometryBuffer m_vertexBuffer;
+    SharedGeometryBuffer m_indexBuffer;
 
     Q_DECLARE_PUBLIC(QTorusGeometry)
 
     QByteArray generateVertexData() const;
     QByteArray generateIndexData() const;
+    void updateVertexBuffer();
+    void updateIndexBuffer();
 };
 
 } // Qt3DExtras
@@ -0,0 +1,107 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "sharedgeometrybuffer_p.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DExtras {
+
+namespace {
+
+struct SharedBufferEntry
+{
+    Qt3DCore::QBuffer *buffer = nullptr;
+    std::vector<Qt3DCore::QNode *> geometries;
+};
+
+// Buffers are only shared within a scene, geometries that aren't part of a
+// scene yet share them under a null scene
+using SharedBufferKey = std::pair<Qt3DCore::QScene *, QByteArray>;
+
+struct SharedBufferCache
+{
+    QMutex mutex;
+    QHash<SharedBufferKey, SharedBufferEntry> entries;
+};
+
+Q_GLOBAL_STATIC(SharedBufferCache, sharedBufferCache)
+
+} // anonymous
+
+SharedGeometryBuffer::~SharedGeometryBuffer()
+{
+    Q_ASSERT_X(m_buffer == nullptr, Q_FUNC_INFO, "Geometry destroyed without releasing its buffer");
+}
+
+void SharedGeometryBuffer::acquire(Qt3DCore::QNode *geometry, const QByteArray &key,
+                                   const std::function<QByteArray()> &generator,
+                                   std::initializer_list<Qt3DCore::QAttribute *> attributes)
+{
+    Qt3DCore::QScene *scene = Qt3DCore::QNodePrivate::get(geometry)->scene();
+    if (m_buffer != nullptr && m_key == key && m_scene == scene)
+        return;
+
+    Qt3DCore::QBuffer *buffer = nullptr;
+    {
+        SharedBufferCache *cache = sharedBufferCache();
+        QMutexLocker lock(&cache->mutex);
+        SharedBufferEntry &entry = cache->entries[{ scene, key }];
+        if (entry.buffer == nullptr) {
+            entry.buffer = new Qt3DCore::QBuffer(geometry);
+            // No need to generate the data again when moving to another scene
+            entry.buffer->setData(m_buffer != nullptr && m_key == key ? m_buffer->data() : generator());
+        }
+        entry.geometries.push_back(geometry);
+        buffer = entry.buffer;
+    }
+
+    for (Qt3DCore::QAttribute *attribute : attributes)
+        attribute->setBuffer(buffer);
+
+    release();
+    m_geometry = geometry;
+    m_buffer = buffer;
+    m_scene = scene;
+    m_key = key;
+}
+
+void SharedGeometryBuffer::release()
+{
+    if (m_buffer == nullptr)
+        return;
+
+    SharedBufferCache *cache = sharedBufferCache();
+    QMutexLocker lock(&cache->mutex);
+    const auto it = cache->entries.find({ m_scene, m_key });
+    Q_ASSERT(it != cache->entries.end());
+    std::vector<Qt3DCore::QNode *> &geometries = it->geometries;
+    geometries.erase(std::find(geometries.begin(), geometries.end(), m_geometry));
+
+    if (geometries.empty()) {
+        cache->entries.erase(it);
+        delete m_buffer;
+    } else if (m_buffer->parent() == m_geometry) {
+        // Keep the buffer alive, and in the scene, for the remaining geometries
+        m_buffer->setParent(geometries.front());
+    }
+
+    m_geometry = nullptr;
+    m_buffer = nullptr;
+    m_scene = nullptr;
+    m_key.clear();
+}
+
+} // namespace Qt3DExtras
+
+QT_END_NAMESPACE
@@ -0,0 +1,87 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DEXTRAS_SHAREDGEOMETRYBUFFER_P_H
+#define QT3DEXTRAS_SHAREDGEOMETRYBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <Qt3DExtras/qt3dextras_global.h>
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QAttribute;
+class QBuffer;
+class QNode;
+class QScene;
+
+} // Qt3DCore
+
+namespace Qt3DExtras {
+
+// Buffer of a primitive geometry, shared with every other geometry of the
+// same scene whose buffer was generated with the same parameters, so that
+// identical primitives are generated and uploaded once. The buffer is
+// parented to one of the geometries using it and handed over to another one
+// when that geometry releases it or moves to another scene. Must be released
+// before the geometry is destroyed.
+class SharedGeometryBuffer
+{
+public:
+    SharedGeometryBuffer() = default;
+    ~SharedGeometryBuffer();
+
+    // Points \a attributes at the buffer holding the data generated for \a key
+    // in the scene of \a geometry, \a generator is only called if no geometry
+    // holds that buffer yet. Geometries call it again from their setScene()
+    // override, to share the buffers of their new scene, unless buffer()
+    // is null because they were already released on destruction
+    void acquire(Qt3DCore::QNode *geometry, const QByteArray &key,
+                 const std::function<QByteArray()> &generator,
+                 std::initializer_list<Qt3DCore::QAttribute *> attributes);
+    void release();
+
+    Qt3DCore::QBuffer *buffer() const { return m_buffer; }
+
+private:
+    Q_DISABLE_COPY(SharedGeometryBuffer)
+
+    Qt3DCore::QNode *m_geometry = nullptr;
+    Qt3DCore::QBuffer *m_buffer = nullptr;
+    Qt3DCore::QScene *m_scene = nullptr;
+    QByteArray m_key;
+};
+
+// Builds the key of the data \a generator produces out of the parameters
+// it is generated from
+template<typename... Args>
+QByteArray sharedGeometryBufferKey(const char *generator, const Args &... args)
+{
+    static_assert((std::is_trivially_copyable_v<Args> && ...));
+    QByteArray key(generator);
+    key.append('\0');
+    (key.append(reinterpret_cast<const char *>(&args), sizeof(args)), ...);
+    return key;
+}
+
+} // namespace Qt3DExtras
+
+QT_END_NAMESPACE
+
+#endif // QT3DEXTRAS_SHAREDGEOMETRYBUFFER_P_H
@@ -27,6 +27,7 @@ DistanceFieldTextRendererPrivate::DistanceFieldTextRendererPrivate()
     , m_vertexBuffer(nullptr)
     , m_indexBuffer(nullptr)
     , m_material(nullptr)
+    , m_indexedQuadCount(0)
 {
 }
 
@@ -109,6 +110,53 @@ void DistanceFieldTextRenderer::setGlyphData(Qt3DRender::QAbstractTexture *glyph
     d->m_material->setDistanceFieldTexture(glyphTexture);
 }
 
+void DistanceFieldTextRenderer::setQuadData(Qt3DRender::QAbstractTexture *glyphTexture,
+                                            const std::vector<float> &vertexData)
+{
+    Q_D(DistanceFieldTextRenderer);
+
+    const uint vertexCount = uint(vertexData.size() / 5);
+    const uint quadCount = vertexCount / 4;
+
+    // Indices only depend on the number of quads, 32 bit since a batch
+    // easily goes over 65536 vertices
+    if (quadCount != d->m_indexedQuadCount) {
+        QByteArray indexData(int(quadCount * 6 * sizeof(quint32)), Qt::Uninitialized);
+        quint32 *indices = reinterpret_cast<quint32 *>(indexData.data());
+        for (uint quad = 0; quad < quadCount; ++quad) {
+            const quint32 first = quad * 4;
+            *indices++ = first;
+            *indices++ = first + 3;
+            *indices++ = first + 1;
+            *indices++ = first;
+            *indices++ = first + 2;
+            *indices++ = first + 3;
+        }
+        d->m_indexBuffer->setData(indexData);
+        d->m_indexAttr->setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+        d->m_indexAttr->setCount(quadCount * 6);
+        d->m_indexedQuadCount = quadCount;
+    }
+
+    d->m_vertexBuffer->setData(QByteArray(reinterpret_cast<const char *>(vertexData.data()),
+                                          int(vertexData.size() * sizeof(float))));
+    d->m_positionAttr->setCount(vertexCount);
+    d->m_texCoordAttr->setCount(vertexCount);
+
+    d->m_material->setDistanceFieldTexture(glyphTexture);
+}
+
+void DistanceFieldTextRenderer::updateQuadData(uint firstQuad, const float *vertexData, uint quadCount)
+{
+    Q_D(DistanceFieldTextRenderer);
+    Q_ASSERT(firstQuad + quadCount <= d->m_indexedQuadCount);
+
+    const int quadByteSize = 4 * 5 * sizeof(float);
+    d->m_vertexBuffer->updateData(int(firstQuad) * quadByteSize,
+                                  QByteArray(reinterpret_cast<const char *>(vertexData),
+                                             int(quadCount) * quadByteSize));
+}
+
 void DistanceFieldTextRenderer::setColor(const QColor &color)
 {
     Q_D(DistanceFieldTextRenderer);
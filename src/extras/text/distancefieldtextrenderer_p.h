@@ -42,6 +42,12 @@ public:
                       const std::vector<float> &vertexData,
                       const std::vector<quint16> &indexData);
 
+    // Batched mode: the vertex data holds quads of 4 vertices, the index
+    // buffer is generated for all of them and quads can be rewritten in place
+    void setQuadData(Qt3DRender::QAbstractTexture *glyphTexture,
+                     const std::vector<float> &vertexData);
+    void updateQuadData(uint firstQuad, const float *vertexData, uint quadCount);
+
     void setColor(const QColor &color);
 
     Q_DECLARE_PRIVATE(DistanceFieldTextRenderer)
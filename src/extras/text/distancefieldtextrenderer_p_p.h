@@ -53,6 +53,7 @@ public:
     Qt3DCore::QBuffer *m_vertexBuffer;
     Qt3DCore::QBuffer *m_indexBuffer;
     QText2DMaterial *m_material;
+    uint m_indexedQuadCount;
 };
 
 } // namespace Qt3DExtras
@@ -8,6 +8,15 @@
 #include "qdistancefieldglyphcache_p.h"
 #include "qtextureatlas_p.h"
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
 #include <QtGui/qpainterpath.h>
 #include <QtGui/qfont.h>
 #include <QtGui/qpainterpath.h>
@@ -23,6 +32,85 @@ using namespace Qt3DCore;
 
 namespace Qt3DExtras {
 
+namespace {
+
+const quint32 DistanceFieldFileMagic = 0x51334446; // Q3DF
+const quint32 DistanceFieldFileVersion = 1;
+
+// Completed distance fields are stored at most once per frame
+const int StoreDistanceFieldsInterval = 16;
+
+bool isDiskCacheDisabled()
+{
+    return qEnvironmentVariableIsSet("QT3D_DISABLE_DISTANCEFIELD_CACHE");
+}
+
+QImage loadDistanceField(const QString &filePath, const QSize &size)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    stream >> magic >> version >> width >> height;
+    if (magic != DistanceFieldFileMagic || version != DistanceFieldFileVersion
+            || QSize(width, height) != size)
+        return {};
+
+    QImage image(size, QImage::Format_Alpha8);
+    for (int y = 0; y < height; ++y) {
+        if (stream.readRawData(reinterpret_cast<char *>(image.scanLine(y)), width) != width)
+            return {};
+    }
+    return image;
+}
+
+void saveDistanceField(const QString &filePath, const QImage &image)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream << DistanceFieldFileMagic << DistanceFieldFileVersion
+           << qint32(image.width()) << qint32(image.height());
+    for (int y = 0; y < image.height(); ++y)
+        stream.writeRawData(reinterpret_cast<const char *>(image.constScanLine(y)), image.width());
+    file.commit();
+}
+
+// Size of the image QDistanceField generates for a glyph, the atlas area is
+// reserved with it before the distance field is available
+QSize distanceFieldSize(const QRectF &pathBound, bool doubleResolution)
+{
+    const int margin = QT_DISTANCEFIELD_RADIUS(doubleResolution) / QT_DISTANCEFIELD_SCALE(doubleResolution);
+    return QSize(qCeil(pathBound.width() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + 2 * margin,
+                 qCeil(pathBound.height() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + 2 * margin);
+}
+
+// Crops or pads \a image with empty distance field to \a size
+QImage fitDistanceField(const QImage &image, const QSize &size)
+{
+    if (image.size() == size)
+        return image;
+
+    QImage fitted(size, QImage::Format_Alpha8);
+    fitted.fill(0);
+    const int width = qMin(size.width(), image.width());
+    const int height = qMin(size.height(), image.height());
+    for (int y = 0; y < height; ++y)
+        memcpy(fitted.scanLine(y), image.constScanLine(y), width);
+    return fitted;
+}
+
+} // anonymous
+
 // ref-count glyphs and keep track of where they are stored
 class StoredGlyph {
 public:
@@ -37,15 +125,26 @@ public:
     void removeFromTextureAtlas();
 
     QTextureAtlas *atlas() const { return m_atlas; }
+    QTextureAtlas::TextureId atlasEntry() const { return m_atlasEntry; }
     QRectF glyphPathBoundingRect() const { return m_glyphPathBoundingRect; }
     QRectF texCoords() const;
 
+    QPainterPath path() const { return m_path; }
+    void releasePath() { m_path = QPainterPath(); }
+    QSize imageSize() const { return m_imageSize; }
+
+    // Distance field being generated for the glyph, 0 once stored in the atlas
+    quint32 pendingJob() const { return m_pendingJob; }
+    void setPendingJob(quint32 job) { m_pendingJob = job; }
+
 private:
     quint32 m_ref = 0;
+    quint32 m_pendingJob = 0;
     QTextureAtlas *m_atlas = nullptr;
     QTextureAtlas::TextureId m_atlasEntry = QTextureAtlas::InvalidTexture;
     QRectF m_glyphPathBoundingRect;
-    QImage m_distanceFieldImage;    // only used until added to texture atlas
+    QPainterPath m_path;    // only used until the distance field is requested
+    QSize m_imageSize;
 };
 
 // A DistanceFieldFont stores all glyphs for a given QRawFont.
@@ -55,18 +154,25 @@ private:
 class DistanceFieldFont
 {
 public:
-    DistanceFieldFont(const QRawFont &font, bool doubleRes, Qt3DCore::QNode *parent);
+    DistanceFieldFont(QDistanceFieldGlyphCache *cache, const QString &key,
+                      const QRawFont &font, bool doubleRes, Qt3DCore::QNode *parent);
     ~DistanceFieldFont();
 
     StoredGlyph findGlyph(quint32 glyph) const;
     StoredGlyph refGlyph(quint32 glyph);
     void derefGlyph(quint32 glyph);
+    QTextureAtlas *setDistanceField(quint32 glyph, quint32 job, const QImage &image);
 
+    QString key() const { return m_key; }
     bool doubleGlyphResolution() const { return m_doubleGlyphResolution; }
+    QString diskCacheDirectory() const { return m_diskCacheDirectory; }
 
 private:
+    QDistanceFieldGlyphCache *m_cache;
+    QString m_key;
     QRawFont m_font;
     bool m_doubleGlyphResolution;
+    QString m_diskCacheDirectory;
     Qt3DCore::QNode *m_parentNode; // parent node for the QTextureAtlasses
 
     QHash<quint32, StoredGlyph> m_glyphs;
@@ -78,28 +184,27 @@ StoredGlyph::StoredGlyph(const QRawFont &font, quint32 glyph, bool doubleResolut
     : m_ref(1)
     , m_atlas(nullptr)
     , m_atlasEntry(QTextureAtlas::InvalidTexture)
+    , m_path(font.pathForGlyph(glyph))
 {
-    // create new single-channel distance field image for given glyph
-    const QPainterPath path = font.pathForGlyph(glyph);
-    const QDistanceField dfield(font, glyph, doubleResolution);
-    m_distanceFieldImage = dfield.toImage(QImage::Format_Alpha8);
-
     // scale bounding rect down (as in QSGDistanceFieldGlyphCache::glyphData())
-    const QRectF pathBound = path.boundingRect();
+    const QRectF pathBound = m_path.boundingRect();
     float f = 1.0f / QT_DISTANCEFIELD_SCALE(doubleResolution);
     m_glyphPathBoundingRect = QRectF(pathBound.left() * f, -pathBound.top() * f, pathBound.width() * f, pathBound.height() * f);
+    m_imageSize = distanceFieldSize(pathBound, doubleResolution);
 }
 
+// Reserves the area of the glyph, left blank until its distance field is set
 bool StoredGlyph::addToTextureAtlas(QTextureAtlas *atlas)
 {
-    if (m_atlas || m_distanceFieldImage.isNull())
+    if (m_atlas || m_imageSize.isEmpty())
         return false;
 
-    const auto texId = atlas->addImage(m_distanceFieldImage, DEFAULT_IMAGE_PADDING);
+    QImage placeholder(m_imageSize, QImage::Format_Alpha8);
+    placeholder.fill(0);
+    const auto texId = atlas->addImage(placeholder, DEFAULT_IMAGE_PADDING);
     if (texId != QTextureAtlas::InvalidTexture) {
         m_atlas = atlas;
         m_atlasEntry = texId;
-        m_distanceFieldImage = QImage();    // free glyph image data
         return true;
     }
 
@@ -120,9 +225,13 @@ QRectF StoredGlyph::texCoords() const
     return m_atlas ? m_atlas->imageTexCoords(m_atlasEntry) : QRectF();
 }
 
-DistanceFieldFont::DistanceFieldFont(const QRawFont &font, bool doubleRes, Qt3DCore::QNode *parent)
-    : m_font(font)
+DistanceFieldFont::DistanceFieldFont(QDistanceFieldGlyphCache *cache, const QString &key,
+                                     const QRawFont &font, bool doubleRes, Qt3DCore::QNode *parent)
+    : m_cache(cache)
+    , m_key(key)
+    , m_font(font)
     , m_doubleGlyphResolution(doubleRes)
+    , m_diskCacheDirectory(QDistanceFieldGlyphCache::diskCacheDirectory(font, doubleRes))
     , m_parentNode(parent)
 {
 }
@@ -174,10 +283,28 @@ StoredGlyph DistanceFieldFont::refGlyph(quint32 glyph)
             qWarning() << Q_FUNC_INFO << "Couldn't add glyph to newly allocated atlas. Glyph could be huge?";
     }
 
+    if (storedGlyph.atlas())
+        storedGlyph.setPendingJob(m_cache->requestDistanceField(this, glyph, storedGlyph.path(), storedGlyph.imageSize()));
+    storedGlyph.releasePath();
+
     m_glyphs.insert(glyph, storedGlyph);
     return storedGlyph;
 }
 
+// Returns the atlas updated with the distance field, if any
+QTextureAtlas *DistanceFieldFont::setDistanceField(quint32 glyph, quint32 job, const QImage &image)
+{
+    // The glyph might have been released, or released and requested again,
+    // since the job was started
+    auto it = m_glyphs.find(glyph);
+    if (it == m_glyphs.end() || it.value().pendingJob() != job)
+        return nullptr;
+
+    it.value().atlas()->updateImage(it.value().atlasEntry(), image);
+    it.value().setPendingJob(0);
+    return it.value().atlas();
+}
+
 void DistanceFieldFont::derefGlyph(quint32 glyph)
 {
     auto it = m_glyphs.find(glyph);
@@ -230,6 +357,36 @@ QString QDistanceFieldGlyphCache::fontKey(const QRawFont &font)
     }
 }
 
+// Distance fields are only stored for fonts loaded from a file. The font
+// file size and modification time are part of the key so that distance
+// fields of an updated font file aren't used, same for the face index of
+// font collections. Stored in the same location as the shader cache.
+QString QDistanceFieldGlyphCache::diskCacheDirectory(const QRawFont &font, bool doubleResolution)
+{
+    if (isDiskCacheDisabled())
+        return {};
+
+    const QFontEngine::FaceId faceId = QRawFontPrivate::get(font)->fontEngine->faceId();
+    if (faceId.filename.isEmpty())
+        return {};
+
+    const QFileInfo fontFile(QFile::decodeName(faceId.filename));
+    if (!fontFile.exists())
+        return {};
+
+    const QByteArray userProvidedPath = qgetenv("QT3D_WRITABLE_CACHE_PATH");
+    const QDir cacheDir(userProvidedPath.isEmpty()
+                        ? QStandardPaths::writableLocation(QStandardPaths::TempLocation)
+                        : QString::fromUtf8(userProvidedPath));
+    const QByteArray key = fontKey(font).toUtf8()
+            + ' ' + QByteArray::number(faceId.index)
+            + ' ' + QByteArray::number(fontFile.size())
+            + ' ' + QByteArray::number(fontFile.lastModified().toMSecsSinceEpoch())
+            + (doubleResolution ? QByteArrayLiteral(" double") : QByteArrayLiteral(" single"));
+    const QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+    return cacheDir.absoluteFilePath(QStringLiteral("qt3d_distancefields/") + QString::fromLatin1(hash));
+}
+
 DistanceFieldFont* QDistanceFieldGlyphCache::getOrCreateDistanceFieldFont(const QRawFont &font)
 {
     // return, if font already exists (make sure to only create one DistanceFieldFont for
@@ -251,18 +408,98 @@ DistanceFieldFont* QDistanceFieldGlyphCache::getOrCreateDistanceFieldFont(const
     // create new font cache
     // we set the parent node to nullptr, since the parent node of QTextureAtlasses
     // will be set when we pass them to QText2DMaterial later
-    DistanceFieldFont *dff = new DistanceFieldFont(actualFont, useDoubleRes, nullptr);
+    DistanceFieldFont *dff = new DistanceFieldFont(this, key, actualFont, useDoubleRes, nullptr);
     m_fonts.insert(key, dff);
     return dff;
 }
 
+quint32 QDistanceFieldGlyphCache::requestDistanceField(DistanceFieldFont *font, quint32 glyph,
+                                                       const QPainterPath &path, const QSize &size)
+{
+    if (++m_lastJob == 0) // 0 means no pending job
+        ++m_lastJob;
+    const quint32 job = m_lastJob;
+
+    const QString key = font->key();
+    const bool doubleResolution = font->doubleGlyphResolution();
+    const QString directory = font->diskCacheDirectory();
+    const QString filePath = directory.isEmpty()
+            ? QString()
+            : directory + QLatin1Char('/') + QString::number(glyph);
+
+    // QRawFont isn't thread safe, the worker only gets the glyph outline
+    m_workers.start([=] {
+        QImage image;
+        if (!filePath.isEmpty())
+            image = loadDistanceField(filePath, size);
+
+        if (image.isNull()) {
+            const QDistanceField dfield(path, glyph, doubleResolution);
+            image = fitDistanceField(dfield.toImage(QImage::Format_Alpha8), size);
+            if (!filePath.isEmpty())
+                saveDistanceField(filePath, image);
+        }
+
+        {
+            QMutexLocker lock(&m_completedMutex);
+            m_completedDistanceFields.push_back({ key, glyph, job, image });
+            if (m_completedDistanceFields.size() > 1)
+                return;
+        }
+
+        // First distance field completed since they were last stored. The
+        // cache waits for its workers before being destroyed
+        QMetaObject::invokeMethod(this, [this] {
+            if (!m_storeTimer.isActive())
+                m_storeTimer.start();
+        }, Qt::QueuedConnection);
+    });
+
+    return job;
+}
+
+// Writes the completed distance fields in their atlases, each updated atlas
+// is then uploaded once
+void QDistanceFieldGlyphCache::storeDistanceFields()
+{
+    m_completedMutex.lock();
+    const QList<CompletedDistanceField> completed = std::move(m_completedDistanceFields);
+    m_completedDistanceFields.clear();
+    m_completedMutex.unlock();
+
+    QList<QTextureAtlas *> updatedAtlases;
+    for (const CompletedDistanceField &c : completed) {
+        DistanceFieldFont *dff = m_fonts.value(c.fontKey);
+        QTextureAtlas *atlas = dff ? dff->setDistanceField(c.glyph, c.job, c.image) : nullptr;
+        if (atlas && !updatedAtlases.contains(atlas))
+            updatedAtlases.push_back(atlas);
+    }
+
+    for (QTextureAtlas *atlas : qAsConst(updatedAtlases))
+        atlas->commitImageUpdates();
+}
+
+void QDistanceFieldGlyphCache::waitForPendingGlyphs()
+{
+    m_workers.waitForDone();
+    m_storeTimer.stop();
+    storeDistanceFields();
+}
+
 QDistanceFieldGlyphCache::QDistanceFieldGlyphCache()
     : m_rootNode(nullptr)
+    , m_lastJob(0)
 {
+    m_storeTimer.setSingleShot(true);
+    m_storeTimer.setInterval(StoreDistanceFieldsInterval);
+    QObject::connect(&m_storeTimer, &QTimer::timeout,
+                     this, &QDistanceFieldGlyphCache::storeDistanceFields);
 }
 
 QDistanceFieldGlyphCache::~QDistanceFieldGlyphCache()
 {
+    m_workers.clear();
+    m_workers.waitForDone();
 }
 
 void QDistanceFieldGlyphCache::setRootNode(QNode *rootNode)
@@ -333,3 +570,5 @@ void QDistanceFieldGlyphCache::derefGlyph(const QRawFont &font, quint32 glyph)
 } // namespace Qt3DExtras
 
 QT_END_NAMESPACE
+
+#include "moc_qdistancefieldglyphcache_p.cpp"
@@ -16,6 +16,11 @@
 //
 
 #include <QtCore/QRectF>
+#include <QtGui/qimage.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qtimer.h>
 #include <Qt3DCore/qnode.h>
 #include <Qt3DExtras/qt3dextras_global.h>
 #include <private/qglobal_p.h>
@@ -24,6 +29,8 @@ QT_BEGIN_NAMESPACE
 
 class QRawFont;
 class QGlyphRun;
+class QImage;
+class QPainterPath;
 
 namespace Qt3DCore {
 class QNode;
@@ -38,8 +45,15 @@ namespace Qt3DExtras {
 class DistanceFieldFont;
 class QDistanceFieldGlyphCachePrivate;
 
-class QDistanceFieldGlyphCache
+// Distance fields are generated on worker threads. Until they are ready,
+// glyphs are blank areas of their atlas, so text can be laid out right away
+// and shows up once the atlas is updated. Completed distance fields are
+// written to their atlases together, at most once per frame interval.
+// Generated distance fields are stored on disk and loaded back by subsequent
+// runs.
+class Q_AUTOTEST_EXPORT QDistanceFieldGlyphCache : public QObject
 {
+    Q_OBJECT
 public:
     QDistanceFieldGlyphCache();
     ~QDistanceFieldGlyphCache();
@@ -61,12 +75,40 @@ public:
     void derefGlyphs(const QGlyphRun &run);
     void derefGlyph(const QRawFont &font, quint32 glyph);
 
+    // Waits for the distance fields being generated and stores them
+    void waitForPendingGlyphs();
+
+    // Directory the distance fields of \a font are stored in, empty if they
+    // aren't stored on disk
+    static QString diskCacheDirectory(const QRawFont &font, bool doubleResolution);
+
 private:
+    friend class DistanceFieldFont;
+
     DistanceFieldFont* getOrCreateDistanceFieldFont(const QRawFont &font);
     static QString fontKey(const QRawFont &font);
 
+    quint32 requestDistanceField(DistanceFieldFont *font, quint32 glyph,
+                                 const QPainterPath &path, const QSize &size);
+    void storeDistanceFields();
+
+    struct CompletedDistanceField
+    {
+        QString fontKey;
+        quint32 glyph;
+        quint32 job;
+        QImage image;
+    };
+
     QHash<QString, DistanceFieldFont*> m_fonts;
     Qt3DCore::QNode *m_rootNode;
+    QThreadPool m_workers;
+    quint32 m_lastJob;
+
+    // Filled by the workers, emptied by storeDistanceFields()
+    QMutex m_completedMutex;
+    QList<CompletedDistanceField> m_completedDistanceFields;
+    QTimer m_storeTimer;
 };
 
 } // namespace Qt3DExtras
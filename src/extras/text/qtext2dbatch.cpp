@@ -0,0 +1,253 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtext2dbatch.h"
+#include "qtext2dbatch_p.h"
+#include "qtext2dentity.h"
+#include "distancefieldtextrenderer_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DExtras {
+
+/*!
+ * \qmltype Text2DBatch
+ * \instantiates Qt3DExtras::QText2DBatch
+ * \inqmlmodule Qt3D.Extras
+ * \since 6.5
+ * \brief Text2DBatch renders many Text2DEntity labels with a few draw calls.
+ *
+ * Text2DEntity labels whose \l {Text2DEntity::batch}{batch} property is set
+ * to a Text2DBatch don't render themselves. Their glyphs are merged into
+ * vertex buffers owned by the batch, one per glyph atlas texture and text
+ * color, and drawn with one draw call each.
+ *
+ * The position of a batched label is given by its Transform component,
+ * relative to the batch. Transforms of the entities between the label and
+ * the batch are ignored. Only the glyphs of labels that change are uploaded
+ * again.
+ */
+
+/*!
+ * \qmlproperty int Text2DBatch::labelCount
+ * \readonly
+ *
+ * Holds the number of labels rendered by the batch.
+ */
+
+/*!
+ * \class Qt3DExtras::QText2DBatch
+ * \inheaderfile Qt3DExtras/QText2DBatch
+ * \inmodule Qt3DExtras
+ * \since 6.5
+ *
+ * \brief QText2DBatch renders many QText2DEntity labels with a few draw calls.
+ *
+ * QText2DEntity labels whose \l {QText2DEntity::batch}{batch} property is
+ * set to a QText2DBatch don't render themselves. Their glyphs are merged into
+ * vertex buffers owned by the batch, one per glyph atlas texture and text
+ * color, and drawn with one draw call each.
+ *
+ * The position of a batched label is given by its Qt3DCore::QTransform
+ * component, relative to the batch. Transforms of the entities between the
+ * label and the batch are ignored. Only the glyphs of labels that change are
+ * uploaded again.
+ *
+ * \sa QText2DEntity
+ */
+
+QText2DBatchPrivate::QText2DBatchPrivate()
+{
+}
+
+QText2DBatchPrivate::~QText2DBatchPrivate()
+{
+}
+
+QText2DBatchPrivate *QText2DBatchPrivate::get(QText2DBatch *q)
+{
+    return q->d_func();
+}
+
+void QText2DBatchPrivate::addLabel(QText2DEntity *label)
+{
+    Q_Q(QText2DBatch);
+    m_labels.push_back(label);
+    emit q->labelCountChanged(int(m_labels.size()));
+}
+
+void QText2DBatchPrivate::removeLabel(QText2DEntity *label)
+{
+    Q_Q(QText2DBatch);
+    setLabelGlyphs(label, QColor(), {});
+    m_labels.erase(std::remove(m_labels.begin(), m_labels.end(), label), m_labels.end());
+    emit q->labelCountChanged(int(m_labels.size()));
+}
+
+void QText2DBatchPrivate::setLabelGlyphs(QText2DEntity *label, const QColor &color,
+                                         const std::vector<LabelGlyphs> &glyphs)
+{
+    // Release the slots of the buckets the label no longer uses
+    for (const std::unique_ptr<Bucket> &bucket : m_buckets) {
+        if (!bucket->slots.contains(label))
+            continue;
+        const bool stillUsed = bucket->color == color
+                && std::any_of(glyphs.begin(), glyphs.end(), [&bucket] (const LabelGlyphs &g) {
+                       return g.texture == bucket->texture && !g.vertices.empty();
+                   });
+        if (!stillUsed)
+            releaseSlot(bucket.get(), label);
+    }
+
+    for (const LabelGlyphs &g : glyphs) {
+        const uint quadCount = uint(g.vertices.size() / FloatsPerQuad);
+        if (quadCount == 0)
+            continue;
+
+        Bucket *bucket = findOrCreateBucket(g.texture, color);
+        auto it = bucket->slots.find(label);
+
+        // Rewrite the label quads in place if they fit in its slot
+        if (it != bucket->slots.end() && quadCount <= it->capacity) {
+            it->count = quadCount;
+            writeSlot(bucket, *it, g.vertices.data());
+            continue;
+        }
+
+        if (it != bucket->slots.end())
+            releaseSlot(bucket, label);
+
+        Slot slot;
+        slot.first = bucket->usedQuads;
+        slot.capacity = quadCount;
+        slot.count = quadCount;
+        bucket->slots.insert(label, slot);
+        bucket->usedQuads += quadCount;
+
+        const size_t requiredSize = size_t(bucket->usedQuads) * FloatsPerQuad;
+        if (requiredSize > bucket->vertices.size()) {
+            // Grow geometrically so that appending labels doesn't upload the
+            // whole batch every time
+            bucket->vertices.resize(std::max(requiredSize, bucket->vertices.size() * 2), 0.0f);
+            std::copy(g.vertices.begin(), g.vertices.end(),
+                      bucket->vertices.begin() + size_t(slot.first) * FloatsPerQuad);
+            upload(bucket);
+        } else {
+            writeSlot(bucket, slot, g.vertices.data());
+        }
+    }
+
+    // Drop buckets no label uses anymore
+    auto it = std::remove_if(m_buckets.begin(), m_buckets.end(),
+                             [] (const std::unique_ptr<Bucket> &bucket) {
+                                 if (!bucket->slots.isEmpty())
+                                     return false;
+                                 delete bucket->renderer;
+                                 return true;
+                             });
+    m_buckets.erase(it, m_buckets.end());
+}
+
+QText2DBatchPrivate::Bucket *QText2DBatchPrivate::findOrCreateBucket(Qt3DRender::QAbstractTexture *texture,
+                                                                    const QColor &color)
+{
+    Q_Q(QText2DBatch);
+    for (const std::unique_ptr<Bucket> &bucket : m_buckets) {
+        if (bucket->texture == texture && bucket->color == color)
+            return bucket.get();
+    }
+
+    auto bucket = std::make_unique<Bucket>();
+    bucket->texture = texture;
+    bucket->color = color;
+    bucket->renderer = new DistanceFieldTextRenderer(q);
+    bucket->renderer->setColor(color);
+    m_buckets.push_back(std::move(bucket));
+    return m_buckets.back().get();
+}
+
+void QText2DBatchPrivate::writeSlot(Bucket *bucket, const Slot &slot, const float *vertices)
+{
+    // Unused quads of the slot are made degenerate
+    float *dst = bucket->vertices.data() + size_t(slot.first) * FloatsPerQuad;
+    std::copy(vertices, vertices + size_t(slot.count) * FloatsPerQuad, dst);
+    std::fill(dst + size_t(slot.count) * FloatsPerQuad, dst + size_t(slot.capacity) * FloatsPerQuad, 0.0f);
+    bucket->renderer->updateQuadData(slot.first, dst, slot.capacity);
+}
+
+void QText2DBatchPrivate::releaseSlot(Bucket *bucket, QText2DEntity *label)
+{
+    Slot slot = bucket->slots.take(label);
+    bucket->freeQuads += slot.capacity;
+
+    // The next label of an empty bucket starts over at its first quad
+    if (bucket->slots.isEmpty()) {
+        bucket->usedQuads = 0;
+        bucket->freeQuads = 0;
+        return;
+    }
+
+    // Compact once half of the quads are unused
+    if (bucket->freeQuads * 2 > bucket->usedQuads) {
+        compact(bucket);
+    } else {
+        slot.count = 0;
+        writeSlot(bucket, slot, nullptr);
+    }
+}
+
+void QText2DBatchPrivate::compact(Bucket *bucket)
+{
+    std::vector<float> vertices(size_t(bucket->usedQuads - bucket->freeQuads) * FloatsPerQuad, 0.0f);
+    uint first = 0;
+    for (Slot &slot : bucket->slots) {
+        const auto src = bucket->vertices.begin() + size_t(slot.first) * FloatsPerQuad;
+        std::copy(src, src + size_t(slot.count) * FloatsPerQuad,
+                  vertices.begin() + size_t(first) * FloatsPerQuad);
+        slot.first = first;
+        first += slot.capacity;
+    }
+    bucket->vertices = std::move(vertices);
+    bucket->usedQuads = first;
+    bucket->freeQuads = 0;
+    upload(bucket);
+}
+
+void QText2DBatchPrivate::upload(Bucket *bucket)
+{
+    bucket->renderer->setQuadData(bucket->texture, bucket->vertices);
+}
+
+QText2DBatch::QText2DBatch(Qt3DCore::QNode *parent)
+    : Qt3DCore::QEntity(*new QText2DBatchPrivate(), parent)
+{
+}
+
+/*! \internal */
+QText2DBatch::~QText2DBatch()
+{
+    Q_D(QText2DBatch);
+    // Labels go back to rendering themselves
+    const std::vector<QText2DEntity *> labels = d->m_labels;
+    for (QText2DEntity *label : labels)
+        label->setBatch(nullptr);
+}
+
+/*!
+  \property QText2DBatch::labelCount
+
+  Holds the number of labels rendered by the batch.
+*/
+int QText2DBatch::labelCount() const
+{
+    Q_D(const QText2DBatch);
+    return int(d->m_labels.size());
+}
+
+} // namespace Qt3DExtras
+
+QT_END_NAMESPACE
+
+#include "moc_qtext2dbatch.cpp"
@@ -0,0 +1,38 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DEXTRAS_QTEXT2DBATCH_H
+#define QT3DEXTRAS_QTEXT2DBATCH_H
+
+#include <Qt3DCore/qentity.h>
+#include <Qt3DExtras/qt3dextras_global.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DExtras {
+
+class QText2DBatchPrivate;
+
+class Q_3DEXTRASSHARED_EXPORT QText2DBatch : public Qt3DCore::QEntity
+{
+    Q_OBJECT
+    Q_PROPERTY(int labelCount READ labelCount NOTIFY labelCountChanged)
+
+public:
+    explicit QText2DBatch(Qt3DCore::QNode *parent = nullptr);
+    ~QText2DBatch();
+
+    int labelCount() const;
+
+Q_SIGNALS:
+    void labelCountChanged(int labelCount);
+
+private:
+    Q_DECLARE_PRIVATE(QText2DBatch)
+};
+
+} // namespace Qt3DExtras
+
+QT_END_NAMESPACE
+
+#endif // QT3DEXTRAS_QTEXT2DBATCH_H
@@ -0,0 +1,98 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DEXTRAS_QTEXT2DBATCH_P_H
+#define QT3DEXTRAS_QTEXT2DBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/private/qentity_p.h>
+#include <Qt3DExtras/qtext2dbatch.h>
+#include <QtCore/qhash.h>
+#include <QtGui/qcolor.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+class QAbstractTexture;
+}
+
+namespace Qt3DExtras {
+
+class DistanceFieldTextRenderer;
+class QText2DEntity;
+
+class QText2DBatchPrivate : public Qt3DCore::QEntityPrivate
+{
+public:
+    QText2DBatchPrivate();
+    ~QText2DBatchPrivate();
+
+    Q_DECLARE_PUBLIC(QText2DBatch)
+
+    static QText2DBatchPrivate *get(QText2DBatch *q);
+
+    // 4 vertices of 5 floats (position, texture coordinates) per glyph quad
+    static constexpr int FloatsPerQuad = 4 * 5;
+
+    // Range of quads of a bucket owned by a label. Quads between count and
+    // capacity are degenerate, so that a label can shrink in place.
+    struct Slot
+    {
+        uint first = 0;
+        uint capacity = 0;
+        uint count = 0;
+    };
+
+    // Labels quads sharing a glyph texture and a color, drawn with a single
+    // DistanceFieldTextRenderer
+    struct Bucket
+    {
+        Qt3DRender::QAbstractTexture *texture = nullptr;
+        QColor color;
+        DistanceFieldTextRenderer *renderer = nullptr;
+        std::vector<float> vertices;
+        QHash<QText2DEntity *, Slot> slots;
+        uint usedQuads = 0;
+        uint freeQuads = 0;
+    };
+
+    struct LabelGlyphs
+    {
+        Qt3DRender::QAbstractTexture *texture = nullptr;
+        std::vector<float> vertices; // in the batch coordinate system
+    };
+
+    void addLabel(QText2DEntity *label);
+    void removeLabel(QText2DEntity *label);
+    void setLabelGlyphs(QText2DEntity *label, const QColor &color,
+                        const std::vector<LabelGlyphs> &glyphs);
+
+    std::vector<QText2DEntity *> m_labels;
+    std::vector<std::unique_ptr<Bucket>> m_buckets;
+
+private:
+    Bucket *findOrCreateBucket(Qt3DRender::QAbstractTexture *texture, const QColor &color);
+    void writeSlot(Bucket *bucket, const Slot &slot, const float *vertices);
+    void releaseSlot(Bucket *bucket, QText2DEntity *label);
+    void compact(Bucket *bucket);
+    void upload(Bucket *bucket);
+};
+
+} // namespace Qt3DExtras
+
+QT_END_NAMESPACE
+
+#endif // QT3DEXTRAS_QTEXT2DBATCH_P_H
@@ -4,6 +4,7 @@
 #include "qtext2dentity.h"
 #include "qtext2dentity_p.h"
 #include "qtext2dmaterial_p.h"
+#include "qtext2dbatch.h"
 
 #include <QtGui/qtextlayout.h>
 #include <QtGui/qglyphrun.h>
@@ -15,6 +16,7 @@
 #include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qattribute.h>
 #include <Qt3DCore/qgeometry.h>
+#include <Qt3DCore/qtransform.h>
 #include <Qt3DRender/qmaterial.h>
 #include <Qt3DRender/qgeometryrenderer.h>
 
@@ -80,6 +82,14 @@ namespace Qt3DExtras {
  * Holds the height of the text's bounding rectangle.
  */
 
+/*!
+ * \qmlproperty Text2DBatch Text2DEntity::batch
+ * \since 6.5
+ *
+ * Holds the batch rendering the text. When set, the text isn't rendered by
+ * the entity itself but merged with the other labels of the batch.
+ */
+
 
 /*!
  * \class Qt3DExtras::QText2DEntity
@@ -108,6 +118,8 @@ QText2DEntityPrivate::QText2DEntityPrivate()
     , m_color(QColor(255, 255, 255, 255))
     , m_width(0.0f)
     , m_height(0.0f)
+    , m_batch(nullptr)
+    , m_batchTransform(nullptr)
 {
 }
 
@@ -162,6 +174,15 @@ QText2DEntity::QText2DEntity(QNode *parent)
 /*! \internal */
 QText2DEntity::~QText2DEntity()
 {
+    Q_D(QText2DEntity);
+    if (d->m_batch) {
+        d->unregisterDestructionHelper(d->m_batch);
+        QText2DBatchPrivate::get(d->m_batch)->removeLabel(this);
+        // Components are removed by ~QEntity, don't submit these changes
+        QObject::disconnect(d->m_batchTransformConnection);
+        QObject::disconnect(d->m_batchTransformRemovedConnection);
+        d->m_batch = nullptr;
+    }
 }
 
 qreal QText2DEntityPrivate::computeActualScale() const
@@ -266,6 +287,18 @@ void QText2DEntityPrivate::setCurrentGlyphRuns(const QList<QGlyphRun> &runs)
         m_glyphCache->derefGlyphs(m_currentGlyphRuns[i]);
     m_currentGlyphRuns = runs;
 
+    if (m_batch) {
+        qDeleteAll(m_renderers);
+        m_renderers.clear();
+
+        m_batchGlyphs.clear();
+        for (auto it = renderData.begin(); it != renderData.end(); ++it)
+            m_batchGlyphs.push_back({ it.key(), std::move(it.value().vertex) });
+        submitToBatch();
+        return;
+    }
+    m_batchGlyphs.clear();
+
     // make sure we have the correct number of DistanceFieldTextRenderers
     // TODO: we might keep one renderer at all times, so we won't delete and
     // re-allocate one every time the text changes from an empty to a non-empty string
@@ -287,6 +320,55 @@ void QText2DEntityPrivate::setCurrentGlyphRuns(const QList<QGlyphRun> &runs)
         m_renderers[rendererIdx++]->setGlyphData(it.key(), it.value().vertex, it.value().index);
 }
 
+void QText2DEntityPrivate::submitToBatch(const Qt3DCore::QTransform *removedTransform)
+{
+    Q_Q(QText2DEntity);
+
+    // The label transform places its quads relative to the batch
+    Qt3DCore::QTransform *transform = batchTransform(removedTransform);
+    if (transform != m_batchTransform) {
+        QObject::disconnect(m_batchTransformConnection);
+        QObject::disconnect(m_batchTransformRemovedConnection);
+        m_batchTransform = transform;
+        if (transform) {
+            m_batchTransformConnection = QObject::connect(transform, &Qt3DCore::QTransform::matrixChanged,
+                                                          q, [this] { submitToBatch(); });
+            // Emitted while the transform is still listed in the components
+            // of the label, or while it is being destroyed
+            m_batchTransformRemovedConnection = QObject::connect(transform, &Qt3DCore::QComponent::removedFromEntity,
+                                                                 q, [this, q] (Qt3DCore::QEntity *entity) {
+                if (entity == q && m_batch)
+                    submitToBatch(m_batchTransform);
+            });
+        }
+    }
+
+    std::vector<QText2DBatchPrivate::LabelGlyphs> glyphs = m_batchGlyphs;
+    if (transform) {
+        const QMatrix4x4 matrix = transform->matrix();
+        for (QText2DBatchPrivate::LabelGlyphs &g : glyphs) {
+            for (size_t i = 0, m = g.vertices.size(); i < m; i += 5) {
+                const QVector3D p = matrix.map(QVector3D(g.vertices[i], g.vertices[i + 1], g.vertices[i + 2]));
+                g.vertices[i] = p.x();
+                g.vertices[i + 1] = p.y();
+                g.vertices[i + 2] = p.z();
+            }
+        }
+    }
+
+    QText2DBatchPrivate::get(m_batch)->setLabelGlyphs(q, m_color, glyphs);
+}
+
+Qt3DCore::QTransform *QText2DEntityPrivate::batchTransform(const Qt3DCore::QTransform *removedTransform) const
+{
+    const QList<Qt3DCore::QTransform *> transforms = componentsOfType<Qt3DCore::QTransform>();
+    for (Qt3DCore::QTransform *transform : transforms) {
+        if (transform != removedTransform)
+            return transform;
+    }
+    return nullptr;
+}
+
 void QText2DEntityPrivate::clearCurrentGlyphRuns()
 {
     for (int i = 0; i < m_currentGlyphRuns.size(); i++)
@@ -380,6 +462,8 @@ void QText2DEntity::setColor(const QColor &color)
 
         emit colorChanged(color);
 
+        if (d->m_batch)
+            d->submitToBatch();
         for (DistanceFieldTextRenderer *renderer : qAsConst(d->m_renderers))
             renderer->setColor(color);
     }
@@ -451,6 +535,53 @@ void QText2DEntity::setHeight(float height)
     }
 }
 
+/*!
+  \property QText2DEntity::batch
+  \since 6.5
+
+  Holds the batch rendering the text. When set, the text isn't rendered by
+  the entity itself but merged with the other labels of the batch. Its
+  position is given by its Qt3DCore::QTransform component, relative to the
+  batch. A transform added once the label is batched is only taken into
+  account with the next change of the label, it should be added first.
+  Defaults to \c nullptr.
+
+  \sa QText2DBatch
+*/
+QText2DBatch *QText2DEntity::batch() const
+{
+    Q_D(const QText2DEntity);
+    return d->m_batch;
+}
+
+void QText2DEntity::setBatch(QText2DBatch *batch)
+{
+    Q_D(QText2DEntity);
+    if (d->m_batch == batch)
+        return;
+
+    if (d->m_batch) {
+        d->unregisterDestructionHelper(d->m_batch);
+        QText2DBatchPrivate::get(d->m_batch)->removeLabel(this);
+        QObject::disconnect(d->m_batchTransformConnection);
+        QObject::disconnect(d->m_batchTransformRemovedConnection);
+        d->m_batchTransform = nullptr;
+        d->m_batchGlyphs.clear();
+    }
+
+    d->m_batch = batch;
+
+    // Ensures proper bookkeeping
+    if (d->m_batch) {
+        d->registerDestructionHelper(d->m_batch, &QText2DEntity::setBatch, d->m_batch);
+        QText2DBatchPrivate::get(d->m_batch)->addLabel(this);
+    }
+
+    emit batchChanged(batch);
+
+    d->updateGlyphs();
+}
+
 } // namespace Qt3DExtras
 
 QT_END_NAMESPACE
@@ -14,6 +14,7 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DExtras {
 
+class QText2DBatch;
 class QText2DEntityPrivate;
 
 class Q_3DEXTRASSHARED_EXPORT QText2DEntity : public Qt3DCore::QEntity
@@ -24,6 +25,7 @@ class Q_3DEXTRASSHARED_EXPORT QText2DEntity : public Qt3DCore::QEntity
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
     Q_PROPERTY(float width READ width WRITE setWidth NOTIFY widthChanged)
     Q_PROPERTY(float height READ height WRITE setHeight NOTIFY heightChanged)
+    Q_PROPERTY(Qt3DExtras::QText2DBatch *batch READ batch WRITE setBatch NOTIFY batchChanged)
 
 public:
     explicit QText2DEntity(Qt3DCore::QNode *parent = nullptr);
@@ -44,12 +46,16 @@ public:
     void setWidth(float width);
     void setHeight(float height);
 
+    QText2DBatch *batch() const;
+    void setBatch(QText2DBatch *batch);
+
 Q_SIGNALS:
     void fontChanged(const QFont &font);
     void colorChanged(const QColor &color);
     void textChanged(const QString &text);
     void widthChanged(float width);
     void heightChanged(float height);
+    void batchChanged(Qt3DExtras::QText2DBatch *batch);
 
 private:
     Q_DECLARE_PRIVATE(QText2DEntity)
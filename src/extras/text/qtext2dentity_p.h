@@ -18,12 +18,14 @@
 #include <Qt3DCore/private/qentity_p.h>
 #include <Qt3DExtras/private/distancefieldtextrenderer_p.h>
 #include <Qt3DExtras/private/qdistancefieldglyphcache_p.h>
+#include <Qt3DExtras/private/qtext2dbatch_p.h>
 #include <QFont>
 
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 class QScene;
+class QTransform;
 }
 
 namespace Qt3DRender {
@@ -65,11 +67,21 @@ public:
 
     QList<DistanceFieldTextRenderer*> m_renderers;
 
+    // Batched labels hand their glyph quads, in local coordinates, over to
+    // m_batch instead of using m_renderers
+    QText2DBatch *m_batch;
+    std::vector<QText2DBatchPrivate::LabelGlyphs> m_batchGlyphs;
+    Qt3DCore::QTransform *m_batchTransform;
+    QMetaObject::Connection m_batchTransformConnection;
+    QMetaObject::Connection m_batchTransformRemovedConnection;
+
     qreal computeActualScale() const;
 
     void setCurrentGlyphRuns(const QList<QGlyphRun> &runs);
     void clearCurrentGlyphRuns();
     void updateGlyphs();
+    void submitToBatch(const Qt3DCore::QTransform *removedTransform = nullptr);
+    Qt3DCore::QTransform *batchTransform(const Qt3DCore::QTransform *removedTransform = nullptr) const;
 
     struct CacheEntry
     {
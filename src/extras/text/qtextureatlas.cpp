@@ -196,13 +196,42 @@ QTextureAtlas::TextureId QTextureAtlas::addImage(const QImage &image, int paddin
     d->m_textures[id] = tex;
     d->m_data->addImage(tex, image);
 
-    // update data functor
+    // update data functor, this also uploads uncommitted image updates
+    d->m_hasUncommittedUpdates = false;
     d->m_currGen++;
     d->setDataFunctor(QTextureAtlasGeneratorPtr::create(d));
 
     return id;
 }
 
+// Replaces the content of the image \a id, \a image must have the same
+// size and format as the image it was added with. The texture is only
+// regenerated by commitImageUpdates(), so that many images can be updated
+// with a single upload
+void QTextureAtlas::updateImage(TextureId id, const QImage &image)
+{
+    Q_D(QTextureAtlas);
+    const auto it = d->m_textures.constFind(id);
+    if (it == d->m_textures.cend())
+        return;
+
+    Q_ASSERT(image.size() == it->position.size());
+    d->m_data->addImage(*it, image);
+    d->m_hasUncommittedUpdates = true;
+}
+
+void QTextureAtlas::commitImageUpdates()
+{
+    Q_D(QTextureAtlas);
+    if (!d->m_hasUncommittedUpdates)
+        return;
+    d->m_hasUncommittedUpdates = false;
+
+    // update data functor
+    d->m_currGen++;
+    d->setDataFunctor(QTextureAtlasGeneratorPtr::create(d));
+}
+
 void QTextureAtlas::removeImage(TextureId id)
 {
     Q_D(QTextureAtlas);
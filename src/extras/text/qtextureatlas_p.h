@@ -25,7 +25,7 @@ namespace Qt3DExtras {
 
 class QTextureAtlasPrivate;
 
-class QTextureAtlas : public Qt3DRender::QAbstractTexture
+class Q_AUTOTEST_EXPORT QTextureAtlas : public Qt3DRender::QAbstractTexture
 {
     Q_OBJECT
 
@@ -40,6 +40,8 @@ public:
     void setPixelFormat(QOpenGLTexture::PixelFormat fmt);
 
     TextureId addImage(const QImage &image, int padding);
+    void updateImage(TextureId id, const QImage &image);
+    void commitImageUpdates();
     void removeImage(TextureId id);
 
     int imageCount() const;
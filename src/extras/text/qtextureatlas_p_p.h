@@ -70,6 +70,7 @@ public:
 
     QTextureAtlas::TextureId m_currId = 1;  // IDs for new sub-textures
     int m_currGen = 0;
+    bool m_hasUncommittedUpdates = false;
 
     QTextureAtlasDataPtr m_data;
     QScopedPointer<AreaAllocator> m_allocator;
@@ -77,7 +78,7 @@ public:
     QHash<QTextureAtlas::TextureId, AtlasTexture> m_textures;
 };
 
-class QTextureAtlasGenerator : public Qt3DRender::QTextureGenerator
+class Q_AUTOTEST_EXPORT QTextureAtlasGenerator : public Qt3DRender::QTextureGenerator
 {
 public:
     QTextureAtlasGenerator(const QTextureAtlasPrivate *texAtlas);
@@ -5,6 +5,8 @@ HEADERS += \
     $$PWD/qdistancefieldglyphcache_p.h \
     $$PWD/qtextureatlas_p_p.h \
     $$PWD/qtextureatlas_p.h \
+    $$PWD/qtext2dbatch.h \
+    $$PWD/qtext2dbatch_p.h \
     $$PWD/qtext2dentity_p.h \
     $$PWD/qtext2dentity.h \
     $$PWD/qtext2dmaterial_p_p.h \
@@ -15,6 +17,7 @@ SOURCES += \
     $$PWD/qdistancefieldglyphcache.cpp \
     $$PWD/distancefieldtextrenderer.cpp \
     $$PWD/areaallocator.cpp \
+    $$PWD/qtext2dbatch.cpp \
     $$PWD/qtext2dentity.cpp \
     $$PWD/qtext2dmaterial.cpp
 
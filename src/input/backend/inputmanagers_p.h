@@ -169,6 +169,7 @@ public:
 
     void addPendingProxyToLoad(Qt3DCore::QNodeId id) { m_pendingProxies.push_back(id); }
     QList<Qt3DCore::QNodeId> takePendingProxiesToLoad() { return std::move(m_pendingProxies); }
+    bool hasPendingProxiesToLoad() const { return !m_pendingProxies.isEmpty(); }
 
 private:
     QList<Qt3DCore::QNodeId> m_pendingProxies;
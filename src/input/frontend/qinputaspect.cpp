@@ -138,6 +138,40 @@ QInputAspect::~QInputAspect()
 {
 }
 
+/*
+   Keyboard and mouse changes come with events which wake up an idle simulation
+   loop. Held buttons and keys, moving accumulators and polled devices still
+   need frames while no new event arrives.
+ */
+bool QInputAspectPrivate::needsNextFrame() const
+{
+    if (hasPendingSingleShotJobs() || m_inputHandler->physicalDeviceProxyManager()->hasPendingProxiesToLoad())
+        return true;
+
+    const auto integrations = m_inputHandler->inputDeviceIntegrations();
+    for (QInputDeviceIntegration *integration : integrations) {
+        if (integration != m_keyboardMouseIntegration.data())
+            return true;
+    }
+
+    for (const Input::HAxis &handle : m_inputHandler->axisManager()->activeHandles()) {
+        const Input::Axis *axis = handle.data();
+        if (axis->isEnabled() && !qFuzzyIsNull(axis->axisValue()))
+            return true;
+    }
+    for (const Input::HAction &handle : m_inputHandler->actionManager()->activeHandles()) {
+        const Input::Action *action = handle.data();
+        if (action->isEnabled() && action->actionTriggered())
+            return true;
+    }
+    for (const Input::HAxisAccumulator &handle : m_inputHandler->axisAccumulatorManager()->activeHandles()) {
+        const Input::AxisAccumulator *accumulator = handle.data();
+        if (accumulator->isEnabled() && !qFuzzyIsNull(accumulator->velocity()))
+            return true;
+    }
+    return false;
+}
+
 /*
    Create each of the detected input device integrations through the Integration Factory
  */
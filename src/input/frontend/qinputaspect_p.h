@@ -33,6 +33,7 @@ class QInputAspectPrivate : public Qt3DCore::QAbstractAspectPrivate
 public:
     QInputAspectPrivate();
     void loadInputDevicePlugins();
+    bool needsNextFrame() const override;
 
     Q_DECLARE_PUBLIC(QInputAspect)
     QScopedPointer<Input::InputHandler> m_inputHandler;
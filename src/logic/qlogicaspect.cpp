@@ -47,6 +47,12 @@ void QLogicAspectPrivate::onEngineAboutToShutdown()
     m_executor->setScene(nullptr);
 }
 
+// QFrameActions are triggered on every frame
+bool QLogicAspectPrivate::needsNextFrame() const
+{
+    return m_manager->hasFrameActions() || hasPendingSingleShotJobs();
+}
+
 void QLogicAspectPrivate::registerBackendTypes()
 {
     Q_Q(QLogicAspect);
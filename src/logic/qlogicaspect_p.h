@@ -36,6 +36,7 @@ class QLogicAspectPrivate : public Qt3DCore::QAbstractAspectPrivate
     Q_DECLARE_PUBLIC(QLogicAspect)
 
     void onEngineAboutToShutdown() override;
+    bool needsNextFrame() const override;
     void registerBackendTypes();
 
     qint64 m_time;
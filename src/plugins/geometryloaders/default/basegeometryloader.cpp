@@ -10,6 +10,10 @@
 #include <Qt3DRender/private/qaxisalignedboundingbox_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
 
+#include <QtCore/QFileDevice>
+
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt3DCore;
@@ -18,6 +22,114 @@ namespace Qt3DRender {
 
 Q_LOGGING_CATEGORY(BaseGeometryLoaderLog, "Qt3D.BaseGeometryLoader", QtWarningMsg)
 
+MappedDevice::MappedDevice(QIODevice *ioDev)
+{
+    ioDev->setTextModeEnabled(false);
+
+    QFileDevice *file = qobject_cast<QFileDevice *>(ioDev);
+    if (file && !file->isSequential()) {
+        const qint64 offset = file->pos();
+        const qint64 size = file->size() - offset;
+        if (size > 0)
+            m_address = file->map(offset, size);
+        if (m_address) {
+            m_file = file;
+            m_begin = reinterpret_cast<const char *>(m_address);
+            m_end = m_begin + size;
+            file->seek(offset + size);
+            return;
+        }
+    }
+
+    // Resources that are compressed can't be mapped for instance
+    m_data = ioDev->readAll();
+    m_begin = m_data.constData();
+    m_end = m_begin + m_data.size();
+}
+
+MappedDevice::~MappedDevice()
+{
+    if (m_file)
+        m_file->unmap(m_address);
+}
+
+float parseFloat(const char *begin, const char *end, const char **next)
+{
+    // Up to 15 significant digits and a power of ten up to 22 are both exact
+    // in a double, so their quotient or product is correctly rounded
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char *p = begin;
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+        ++p;
+
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        mantissa = mantissa * 10 + quint64(*p - '0');
+        significantDigits += mantissa != 0;
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            mantissa = mantissa * 10 + quint64(*p - '0');
+            significantDigits += mantissa != 0;
+            --exponent;
+        }
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char *exponentBegin = p + 1;
+        const char *exponentEnd = exponentBegin;
+        const int value = parseInt(exponentBegin, end, &exponentEnd);
+        if (exponentEnd != exponentBegin && exponentEnd[-1] >= '0' && exponentEnd[-1] <= '9') {
+            // Clamped, out of range exponents go through qstrntod anyway
+            exponent = int(qBound(qint64(std::numeric_limits<int>::min()), qint64(exponent) + value,
+                                  qint64(std::numeric_limits<int>::max())));
+            p = exponentEnd;
+        }
+    }
+
+    if (digits == 0 || significantDigits > 15 || exponent < -22 || exponent > 22) {
+        const char *parsedEnd = nullptr;
+        const double value = qstrntod(begin, end - begin, &parsedEnd, nullptr);
+        if (next)
+            *next = parsedEnd ? parsedEnd : begin;
+        return float(value);
+    }
+
+    double value = double(mantissa);
+    value = exponent < 0 ? value / powersOfTen[-exponent] : value * powersOfTen[exponent];
+    if (next)
+        *next = p;
+    return float(negative ? -value : value);
+}
+
+int parseInt(const char *begin, const char *end, const char **next)
+{
+    const char *p = begin;
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+        ++p;
+
+    // Saturates rather than wrapping around on overflow
+    const quint64 limit = quint64(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+    quint64 value = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        if (value <= limit)
+            value = value * 10 + quint64(*p - '0');
+    }
+    value = qMin(value, limit);
+
+    if (next)
+        *next = p;
+    return negative ? int(-qint64(value)) : int(value);
+}
+
 BaseGeometryLoader::BaseGeometryLoader()
     : m_loadTextureCoords(true)
     , m_generateTangents(true)
@@ -91,31 +203,34 @@ void BaseGeometryLoader::generateGeometry()
         + (hasTangents() ? 4 : 0);
     const quint32 stride = elementSize * sizeof(float);
     bufferBytes.resize(stride * count);
-    float *fptr = reinterpret_cast<float*>(bufferBytes.data());
-
-    for (size_t index = 0; index < count; ++index) {
-        *fptr++ = m_points.at(index).x();
-        *fptr++ = m_points.at(index).y();
-        *fptr++ = m_points.at(index).z();
-
-        if (hasTextureCoordinates()) {
-            *fptr++ = m_texCoords.at(index).x();
-            *fptr++ = m_texCoords.at(index).y();
-        }
-
-        if (hasNormals()) {
-            *fptr++ = m_normals.at(index).x();
-            *fptr++ = m_normals.at(index).y();
-            *fptr++ = m_normals.at(index).z();
-        }
-
-        if (hasTangents()) {
-            *fptr++ = m_tangents.at(index).x();
-            *fptr++ = m_tangents.at(index).y();
-            *fptr++ = m_tangents.at(index).z();
-            *fptr++ = m_tangents.at(index).w();
+    float *const vbufferContent = reinterpret_cast<float*>(bufferBytes.data());
+
+    parallelForChunks(count, [&] (size_t begin, size_t end) {
+        float *fptr = vbufferContent + begin * elementSize;
+        for (size_t index = begin; index < end; ++index) {
+            *fptr++ = m_points[index].x();
+            *fptr++ = m_points[index].y();
+            *fptr++ = m_points[index].z();
+
+            if (hasTextureCoordinates()) {
+                *fptr++ = m_texCoords[index].x();
+                *fptr++ = m_texCoords[index].y();
+            }
+
+            if (hasNormals()) {
+                *fptr++ = m_normals[index].x();
+                *fptr++ = m_normals[index].y();
+                *fptr++ = m_normals[index].z();
+            }
+
+            if (hasTangents()) {
+                *fptr++ = m_tangents[index].x();
+                *fptr++ = m_tangents[index].y();
+                *fptr++ = m_tangents[index].z();
+                *fptr++ = m_tangents[index].w();
+            }
         }
-    } // of buffer filling loop
+    }); // of buffer filling loop
 
     auto *buf = new Qt3DCore::QBuffer();
     buf->setData(bufferBytes);
@@ -16,6 +16,7 @@
 //
 
 #include <QtCore/QObject>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include <QtGui/QVector2D>
 #include <QtGui/QVector3D>
@@ -29,6 +30,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QFileDevice;
 class QIODevice;
 class QString;
 
@@ -94,6 +96,77 @@ protected:
     Qt3DCore::QGeometry *m_geometry;
 };
 
+/*
+ * The remaining content of a device a mesh is loaded from. Files are memory
+ * mapped when possible, other devices are read at once. Text mode is turned
+ * off, parsers have to handle CRLF line endings.
+ */
+class MappedDevice
+{
+public:
+    explicit MappedDevice(QIODevice *ioDev);
+    ~MappedDevice();
+
+    const char *begin() const { return m_begin; }
+    const char *end() const { return m_end; }
+    qsizetype size() const { return m_end - m_begin; }
+
+private:
+    Q_DISABLE_COPY(MappedDevice)
+
+    QFileDevice *m_file = nullptr;
+    uchar *m_address = nullptr;
+    QByteArray m_data;
+    const char *m_begin = nullptr;
+    const char *m_end = nullptr;
+};
+
+/*
+ * Parse the number at the beginning of [begin, end) and set *next to the
+ * position after it. Numbers written in a usual way are parsed directly, the
+ * others go through qstrntod.
+ */
+float parseFloat(const char *begin, const char *end, const char **next = nullptr);
+int parseInt(const char *begin, const char *end, const char **next = nullptr);
+
+inline const char *skipSpaces(const char *begin, const char *end)
+{
+    while (begin != end && *begin == ' ')
+        ++begin;
+    return begin;
+}
+
+inline const char *findSpace(const char *begin, const char *end)
+{
+    while (begin != end && *begin != ' ')
+        ++begin;
+    return begin;
+}
+
+/*
+ * Calls f(begin, end) on the ranges [begin, end) of chunkSize elements
+ * covering [0, count), f isn't called when count is 0. The chunks are spread
+ * over the global thread pool.
+ */
+template<typename F>
+void parallelForChunks(size_t count, F &&f, size_t chunkSize = 16384)
+{
+    if (count == 0)
+        return;
+    if (count <= chunkSize) {
+        f(size_t(0), count);
+        return;
+    }
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    chunks.reserve((count + chunkSize - 1) / chunkSize);
+    for (size_t begin = 0; begin < count; begin += chunkSize)
+        chunks.push_back({ begin, qMin(begin + chunkSize, count) });
+    QtConcurrent::blockingMap(chunks, [&f] (const std::pair<size_t, size_t> &chunk) {
+        f(chunk.first, chunk.second);
+    });
+}
+
 struct FaceIndices
 {
     FaceIndices()
@@ -168,12 +241,14 @@ public:
 
     float floatAt(int index) const
     {
-        return qstrntod(m_input + m_entries[index].start, m_entries[index].size, nullptr, nullptr);
+        const char *begin = m_input + m_entries[index].start;
+        return parseFloat(begin, begin + m_entries[index].size);
     }
 
     int intAt(int index) const
     {
-        return strtol(m_input + m_entries[index].start, nullptr, 10);
+        const char *begin = m_input + m_entries[index].start;
+        return parseInt(begin, begin + m_entries[index].size);
     }
 
     QString stringAt(int index) const
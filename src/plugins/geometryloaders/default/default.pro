@@ -1,5 +1,5 @@
 TARGET = defaultgeometryloader
-QT += core-private 3dcore 3dcore-private 3drender 3drender-private
+QT += core-private concurrent 3dcore 3dcore-private 3drender 3drender-private
 
 HEADERS += \
     basegeometryloader_p.h \
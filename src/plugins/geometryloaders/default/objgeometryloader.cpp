@@ -7,6 +7,9 @@
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QIODevice>
+#include <QtCore/QVarLengthArray>
+
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -14,28 +17,104 @@ namespace Qt3DRender {
 
 Q_LOGGING_CATEGORY(ObjGeometryLoaderLog, "Qt3D.ObjGeometryLoader", QtWarningMsg)
 
-static void addFaceVertex(const FaceIndices &faceIndices,
-                          QList<FaceIndices> &faceIndexVector,
-                          QHash<FaceIndices, unsigned int> &faceIndexMap);
+inline size_t qHash(const FaceIndices &faceIndices, size_t seed = 0)
+{
+    return qHashMulti(seed, faceIndices.positionIndex, faceIndices.texCoordIndex,
+                      faceIndices.normalIndex);
+}
+
+namespace {
+
+struct LineRange
+{
+    const char *begin;
+    const char *end;
+};
+
+struct FaceLine
+{
+    LineRange values;
+    int positionsOffset;
+    int texCoordsOffset;
+    int normalsOffset;
+};
+
+// Counts the space separated tokens of line, up to max
+int countTokens(LineRange line, int max)
+{
+    int count = 0;
+    for (const char *p = skipSpaces(line.begin, line.end); p != line.end && count < max;
+         p = skipSpaces(findSpace(p, line.end), line.end))
+        ++count;
+    return count;
+}
+
+template<int Count>
+void parseFloats(LineRange line, float *values)
+{
+    const char *p = line.begin;
+    for (int i = 0; i < Count; ++i) {
+        p = skipSpaces(p, line.end);
+        const char *tokenEnd = findSpace(p, line.end);
+        values[i] = parseFloat(p, tokenEnd);
+        p = tokenEnd;
+    }
+}
+
+FaceIndices parseFaceIndices(const char *begin, const char *end, const FaceLine &line)
+{
+    FaceIndices faceIndices;
+    const char *slash1 = static_cast<const char *>(memchr(begin, '/', end - begin));
+    const char *slash2 = slash1 ? static_cast<const char *>(memchr(slash1 + 1, '/', end - slash1 - 1)) : nullptr;
+    if (slash2 && memchr(slash2 + 1, '/', end - slash2 - 1)) {
+        qCWarning(ObjGeometryLoaderLog) << "Unsupported number of indices in face element";
+        return faceIndices;
+    }
+
+    faceIndices.positionIndex = parseInt(begin, slash1 ? slash1 : end) - 1 - line.positionsOffset;
+    if (slash1)
+        faceIndices.texCoordIndex = parseInt(slash1 + 1, slash2 ? slash2 : end) - 1 - line.texCoordsOffset;
+    if (slash2)
+        faceIndices.normalIndex = parseInt(slash2 + 1, end) - 1 - line.normalsOffset;
+    return faceIndices;
+}
+
+// Appends the face corners of lines, faces with more than 3 edges being
+// decomposed into triangle fans
+void parseFaces(const FaceLine *lines, size_t count, std::vector<FaceIndices> &corners)
+{
+    QVarLengthArray<FaceIndices, 4> face; // try to avoid allocations in the common case of triangulated data
+    for (size_t i = 0; i < count; ++i) {
+        const FaceLine &line = lines[i];
+        face.clear();
+        for (const char *p = skipSpaces(line.values.begin, line.values.end); p != line.values.end;) {
+            const char *tokenEnd = findSpace(p, line.values.end);
+            face.append(parseFaceIndices(p, tokenEnd, line));
+            p = skipSpaces(tokenEnd, line.values.end);
+        }
 
-inline uint qHash(const FaceIndices &faceIndices)
+        for (int j = 2; j < face.size(); ++j) {
+            corners.push_back(face[0]);
+            corners.push_back(face[j - 1]);
+            corners.push_back(face[j]);
+        }
+    }
+}
+
+bool isKeyword(const char *begin, const char *end, const char *keyword, qsizetype size)
 {
-    return faceIndices.positionIndex
-            + 10 * faceIndices.texCoordIndex
-            + 100 * faceIndices.normalIndex;
+    return end - begin == size && memcmp(begin, keyword, size_t(size)) == 0;
 }
 
+} // anonymous
+
 bool ObjGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
 {
     // Parse faces taking into account each vertex in a face can index different indices
     // for the positions, normals and texture coords;
     // Generate unique vertices (in OpenGL parlance) and output to points, texCoords,
     // normals and calculate mapping from faces to unique indices
-    QList<QVector3D> positions;
-    QList<QVector3D> normals;
-    QList<QVector2D> texCoords;
-    QHash<FaceIndices, unsigned int> faceIndexMap;
-    QList<FaceIndices> faceIndexVector;
+    const MappedDevice source(ioDev);
 
     bool skipping = false;
     int positionsOffset = 0;
@@ -47,181 +126,145 @@ bool ObjGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
         subMeshMatch.setPattern(QLatin1String("^(") + subMesh + QLatin1String(")$"));
     Q_ASSERT(subMeshMatch.isValid());
 
-    char lineBuffer[1024];
-    const char *line;
-    QByteArray longLine;
-    while (!ioDev->atEnd()) {
-        // try to read into lineBuffer first, if the line fits (common case) we can do this without expensive allocations
-        // if not, fall back to dynamically allocated QByteArrays
-        auto lineSize = ioDev->readLine(lineBuffer, sizeof(lineBuffer));
-        if (lineSize == sizeof(lineBuffer) - 1 && lineBuffer[lineSize - 1] != '\n') {
-            longLine = QByteArray(lineBuffer, lineSize);
-            longLine += ioDev->readLine();
-            line = longLine.constData();
-            lineSize = longLine.size();
-        } else {
-            line = lineBuffer;
-        }
+    // Go over the lines to follow the selected sub mesh and find where each
+    // value is, so that the values can then be parsed in parallel
+    std::vector<LineRange> positionLines;
+    std::vector<LineRange> texCoordLines;
+    std::vector<LineRange> normalLines;
+    std::vector<FaceLine> faceLines;
+
+    for (const char *next = source.begin(); next < source.end();) {
+        const char *line = next;
+        const char *lineEnd = static_cast<const char *>(memchr(line, '\n', source.end() - line));
+        if (lineEnd == nullptr)
+            lineEnd = source.end();
+        next = lineEnd + 1;
+
+        if (line == lineEnd || line[0] == '#')
+            continue;
+        if (lineEnd[-1] == '\r')
+            --lineEnd; // chop newline also for CRLF format
+        while (lineEnd != line && (lineEnd[-1] == ' ' || lineEnd[-1] == '\t'))
+            --lineEnd; // chop trailing spaces
 
-        if (lineSize > 0 && line[0] != '#') {
-            if (line[lineSize - 1] == '\n')
-                --lineSize; // chop newline
-            if (line[lineSize - 1] == '\r')
-                --lineSize; // chop newline also for CRLF format
-            while (line[lineSize - 1] == ' ' || line[lineSize - 1] == '\t')
-                --lineSize; // chop trailing spaces
-
-            const ByteArraySplitter tokens(line, line + lineSize, ' ', Qt::SkipEmptyParts);
-
-            if (qstrncmp(tokens.charPtrAt(0), "v ", 2) == 0) {
-                if (tokens.size() < 4) {
-                    qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex";
-                } else {
-                    if (!skipping) {
-                        const float x = tokens.floatAt(1);
-                        const float y = tokens.floatAt(2);
-                        const float z = tokens.floatAt(3);
-                        positions.append(QVector3D(x, y, z));
-                    } else {
-                        positionsOffset++;
-                    }
-                }
-            } else if (m_loadTextureCoords && qstrncmp(tokens.charPtrAt(0), "vt ", 3) == 0) {
-                if (tokens.size() < 3) {
-                    qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in texture coordinate";
-                } else {
-                    if (!skipping) {
-                        // Process texture coordinate
-                        const float s = tokens.floatAt(1);
-                        const float t = tokens.floatAt(2);
-                        texCoords.append(QVector2D(s, t));
-                    } else {
-                        ++texCoordsOffset;
-                    }
-                }
-            } else if (qstrncmp(tokens.charPtrAt(0), "vn ", 3) == 0) {
-                if (tokens.size() < 4) {
-                    qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex normal";
-                } else {
-                    if (!skipping) {
-                        const float x = tokens.floatAt(1);
-                        const float y = tokens.floatAt(2);
-                        const float z = tokens.floatAt(3);
-                        normals.append(QVector3D(x, y, z));
-                    } else {
-                        ++normalsOffset;
-                    }
-                }
-            } else if (!skipping && tokens.size() >= 4 && qstrncmp(tokens.charPtrAt(0), "f ", 2) == 0) {
-                // Process face
-                int faceVertices = tokens.size() - 1;
-
-                QVarLengthArray<FaceIndices, 4> face; // try to avoid allocations in the common case of triangulated data
-                face.reserve(faceVertices);
-
-                for (int i = 0; i < faceVertices; i++) {
-                    FaceIndices faceIndices;
-                    const ByteArraySplitter indices = tokens.splitterAt(i + 1, '/', Qt::KeepEmptyParts);
-                    switch (indices.size()) {
-                    case 3:
-                        faceIndices.normalIndex = indices.intAt(2) - 1 - normalsOffset;  // fall through
-                        Q_FALLTHROUGH();
-                    case 2:
-                        faceIndices.texCoordIndex = indices.intAt(1) - 1 - texCoordsOffset; // fall through
-                        Q_FALLTHROUGH();
-                    case 1:
-                        faceIndices.positionIndex = indices.intAt(0) - 1 - positionsOffset;
-                        break;
-                    default:
-                        qCWarning(ObjGeometryLoaderLog) << "Unsupported number of indices in face element";
-                    }
-
-                    face.append(faceIndices);
-                }
-
-                // If number of edges in face is greater than 3,
-                // decompose into triangles as a triangle fan.
-                FaceIndices v0 = face[0];
-                FaceIndices v1 = face[1];
-                FaceIndices v2 = face[2];
-
-                // First face
-                addFaceVertex(v0, faceIndexVector, faceIndexMap);
-                addFaceVertex(v1, faceIndexVector, faceIndexMap);
-                addFaceVertex(v2, faceIndexVector, faceIndexMap);
-
-                for (int i = 3; i < face.size(); ++i) {
-                    v1 = v2;
-                    v2 = face[i];
-                    addFaceVertex(v0, faceIndexVector, faceIndexMap);
-                    addFaceVertex(v1, faceIndexVector, faceIndexMap);
-                    addFaceVertex(v2, faceIndexVector, faceIndexMap);
-                }
-
-                // end of face
-            } else if (qstrncmp(tokens.charPtrAt(0), "o ", 2) == 0) {
-                if (tokens.size() < 2) {
-                    qCWarning(ObjGeometryLoaderLog) << "Missing submesh name";
-                } else {
-                    if (!subMesh.isEmpty() ) {
-                        const QString objName = tokens.stringAt(1);
-                        QRegularExpressionMatch match = subMeshMatch.match(objName);
-                        skipping = !match.hasMatch();
-                    }
-                }
+        const char *keyword = skipSpaces(line, lineEnd);
+        const char *keywordEnd = findSpace(keyword, lineEnd);
+        const LineRange values = { keywordEnd, lineEnd };
+
+        if (isKeyword(keyword, keywordEnd, "v", 1)) {
+            if (countTokens(values, 3) < 3)
+                qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex";
+            else if (!skipping)
+                positionLines.push_back(values);
+            else
+                ++positionsOffset;
+        } else if (m_loadTextureCoords && isKeyword(keyword, keywordEnd, "vt", 2)) {
+            if (countTokens(values, 2) < 2)
+                qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in texture coordinate";
+            else if (!skipping)
+                texCoordLines.push_back(values);
+            else
+                ++texCoordsOffset;
+        } else if (isKeyword(keyword, keywordEnd, "vn", 2)) {
+            if (countTokens(values, 3) < 3)
+                qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex normal";
+            else if (!skipping)
+                normalLines.push_back(values);
+            else
+                ++normalsOffset;
+        } else if (isKeyword(keyword, keywordEnd, "f", 1)) {
+            if (!skipping && countTokens(values, 3) >= 3)
+                faceLines.push_back({ values, positionsOffset, texCoordsOffset, normalsOffset });
+        } else if (isKeyword(keyword, keywordEnd, "o", 1)) {
+            if (countTokens(values, 1) < 1) {
+                qCWarning(ObjGeometryLoaderLog) << "Missing submesh name";
+            } else if (!subMesh.isEmpty()) {
+                const char *name = skipSpaces(values.begin, values.end);
+                const QString objName = QString::fromLatin1(name, findSpace(name, values.end) - name);
+                QRegularExpressionMatch match = subMeshMatch.match(objName);
+                skipping = !match.hasMatch();
             }
-        } // empty input line
-    } // while (!ioDev->atEnd())
+        }
+    }
+
+    std::vector<QVector3D> positions(positionLines.size());
+    std::vector<QVector2D> texCoords(texCoordLines.size());
+    std::vector<QVector3D> normals(normalLines.size());
+
+    parallelForChunks(positionLines.size(), [&] (size_t begin, size_t end) {
+        float values[3];
+        for (size_t i = begin; i < end; ++i) {
+            parseFloats<3>(positionLines[i], values);
+            positions[i] = QVector3D(values[0], values[1], values[2]);
+        }
+    });
+    parallelForChunks(texCoordLines.size(), [&] (size_t begin, size_t end) {
+        float values[2];
+        for (size_t i = begin; i < end; ++i) {
+            parseFloats<2>(texCoordLines[i], values);
+            texCoords[i] = QVector2D(values[0], values[1]);
+        }
+    });
+    parallelForChunks(normalLines.size(), [&] (size_t begin, size_t end) {
+        float values[3];
+        for (size_t i = begin; i < end; ++i) {
+            parseFloats<3>(normalLines[i], values);
+            normals[i] = QVector3D(values[0], values[1], values[2]);
+        }
+    });
+
+    // Faces are parsed by chunks of lines, each chunk being triangulated
+    // into its own list of corners
+    constexpr size_t facesPerChunk = 4096;
+    std::vector<std::vector<FaceIndices>> faceCorners((faceLines.size() + facesPerChunk - 1) / facesPerChunk);
+    parallelForChunks(faceLines.size(), [&] (size_t begin, size_t end) {
+        std::vector<FaceIndices> &corners = faceCorners[begin / facesPerChunk];
+        corners.reserve((end - begin) * 3);
+        parseFaces(faceLines.data() + begin, end - begin, corners);
+    }, facesPerChunk);
+
+    // Generate unique vertices of data (by OpenGL definition) as they are
+    // first referenced by a face
+    const bool hasTexCoords = !texCoords.empty();
+    const bool hasNormals = !normals.empty();
 
-    // Iterate over the faceIndexMap and pull out pos, texCoord and normal data
-    // thereby generating unique vertices of data (by OpenGL definition)
-    const int vertexCount = faceIndexMap.size();
-    const bool hasTexCoords = !texCoords.isEmpty();
-    const bool hasNormals = !normals.isEmpty();
+    size_t cornerCount = 0;
+    for (const std::vector<FaceIndices> &corners : faceCorners)
+        cornerCount += corners.size();
 
-    m_points.resize(vertexCount);
+    QHash<FaceIndices, unsigned int> faceIndexMap;
+    faceIndexMap.reserve(qsizetype(qMin(cornerCount, positions.size() * 2)));
+    m_points.clear();
     m_texCoords.clear();
-    if (hasTexCoords)
-        m_texCoords.resize(vertexCount);
     m_normals.clear();
-    if (hasNormals)
-        m_normals.resize(vertexCount);
-
-    for (auto it = faceIndexMap.cbegin(), endIt = faceIndexMap.cend(); it != endIt; ++it) {
-        const uint positionIndex = it.key().positionIndex;
-        const uint texCoordIndex = it.key().texCoordIndex;
-        const uint normalIndex = it.key().normalIndex;
-
-        m_points[it.value()] = (positionIndex < uint(positions.size())) ? positions[positionIndex] : QVector3D();
-        if (hasTexCoords)
-            m_texCoords[it.value()] = (texCoordIndex < uint(texCoords.size())) ? texCoords[texCoordIndex] : QVector2D();
-        if (hasNormals)
-            m_normals[it.value()] = (normalIndex < uint(normals.size())) ? normals[normalIndex] : QVector3D();
-    }
-
-    // Now iterate over the face indices and lookup the unique vertex index
-    const int indexCount = faceIndexVector.size();
     m_indices.clear();
-    m_indices.reserve(indexCount);
-    for (const FaceIndices &faceIndices : qAsConst(faceIndexVector)) {
-        const unsigned int i = faceIndexMap.value(faceIndices);
-        m_indices.push_back(i);
-    }
+    m_indices.reserve(cornerCount);
 
-    return true;
-}
+    for (const std::vector<FaceIndices> &corners : faceCorners) {
+        for (const FaceIndices &faceIndices : corners) {
+            if (faceIndices.positionIndex == std::numeric_limits<unsigned int>::max()) {
+                qCWarning(ObjGeometryLoaderLog) << "Missing position index";
+                continue;
+            }
 
-static void addFaceVertex(const FaceIndices &faceIndices,
-                          QList<FaceIndices> &faceIndexVector,
-                          QHash<FaceIndices, unsigned int> &faceIndexMap)
-{
-    if (faceIndices.positionIndex != std::numeric_limits<unsigned int>::max()) {
-        faceIndexVector.append(faceIndices);
-        if (!faceIndexMap.contains(faceIndices))
-            faceIndexMap.insert(faceIndices, faceIndexMap.size());
-    } else {
-        qCWarning(ObjGeometryLoaderLog) << "Missing position index";
+            auto it = faceIndexMap.find(faceIndices);
+            if (it == faceIndexMap.end()) {
+                const uint positionIndex = faceIndices.positionIndex;
+                const uint texCoordIndex = faceIndices.texCoordIndex;
+                const uint normalIndex = faceIndices.normalIndex;
+
+                it = faceIndexMap.insert(faceIndices, uint(m_points.size()));
+                m_points.push_back(positionIndex < positions.size() ? positions[positionIndex] : QVector3D());
+                if (hasTexCoords)
+                    m_texCoords.push_back(texCoordIndex < texCoords.size() ? texCoords[texCoordIndex] : QVector2D());
+                if (hasNormals)
+                    m_normals.push_back(normalIndex < normals.size() ? normals[normalIndex] : QVector3D());
+            }
+            m_indices.push_back(it.value());
+        }
     }
+
+    return true;
 }
 
 } // namespace Qt3DRender
@@ -3,9 +3,13 @@
 
 #include "plygeometryloader.h"
 
-#include <QtCore/QDataStream>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QIODevice>
+#include <QtCore/QTextStream>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QtEndian>
+
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -27,37 +31,56 @@ public:
 class AsciiPlyDataReader : public PlyDataReader
 {
 public:
-    AsciiPlyDataReader(QIODevice *ioDev)
-        : m_stream(ioDev)
+    AsciiPlyDataReader(const char *begin, const char *end)
+        : m_data(begin)
+        , m_end(end)
     { }
 
     int readIntValue(PlyGeometryLoader::DataType) override
     {
-        int value;
-        m_stream >> value;
+        const char *tokenEnd = nextToken();
+        const int value = parseInt(m_data, tokenEnd);
+        m_data = tokenEnd;
         return value;
     }
 
     float readFloatValue(PlyGeometryLoader::DataType) override
     {
-        float value;
-        m_stream >> value;
+        const char *tokenEnd = nextToken();
+        const float value = parseFloat(m_data, tokenEnd);
+        m_data = tokenEnd;
         return value;
     }
 
 private:
-    QTextStream m_stream;
+    static bool isWhiteSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // Skips the white spaces before the next token and returns its end
+    const char *nextToken()
+    {
+        while (m_data != m_end && isWhiteSpace(*m_data))
+            ++m_data;
+        const char *tokenEnd = m_data;
+        while (tokenEnd != m_end && !isWhiteSpace(*tokenEnd))
+            ++tokenEnd;
+        return tokenEnd;
+    }
+
+    const char *m_data;
+    const char *m_end;
 };
 
+template <QSysInfo::Endian ByteOrder>
 class BinaryPlyDataReader : public PlyDataReader
 {
 public:
-    BinaryPlyDataReader(QIODevice *ioDev, QDataStream::ByteOrder byteOrder)
-        : m_stream(ioDev)
-    {
-        ioDev->setTextModeEnabled(false);
-        m_stream.setByteOrder(byteOrder);
-    }
+    BinaryPlyDataReader(const char *begin, const char *end)
+        : m_data(reinterpret_cast<const uchar *>(begin))
+        , m_end(reinterpret_cast<const uchar *>(end))
+    { }
 
     int readIntValue(PlyGeometryLoader::DataType type) override
     {
@@ -70,67 +93,47 @@ public:
     }
 
 private:
+    template <typename T, typename V>
+    T read()
+    {
+        if (m_end - m_data < qptrdiff(sizeof(V))) {
+            m_data = m_end;
+            return 0;
+        }
+
+        const V value = ByteOrder == QSysInfo::LittleEndian ? qFromLittleEndian<V>(m_data)
+                                                            : qFromBigEndian<V>(m_data);
+        m_data += sizeof(V);
+        return T(value);
+    }
+
     template <typename T>
     T readValue(PlyGeometryLoader::DataType type)
     {
         switch (type) {
         case PlyGeometryLoader::Int8:
-        {
-            qint8 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, qint8>();
 
         case PlyGeometryLoader::Uint8:
-        {
-            quint8 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, quint8>();
 
         case PlyGeometryLoader::Int16:
-        {
-            qint16 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, qint16>();
 
         case PlyGeometryLoader::Uint16:
-        {
-            quint16 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, quint16>();
 
         case PlyGeometryLoader::Int32:
-        {
-            qint32 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, qint32>();
 
         case PlyGeometryLoader::Uint32:
-        {
-            quint32 value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, quint32>();
 
         case PlyGeometryLoader::Float32:
-        {
-            m_stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-            float value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, float>();
 
         case PlyGeometryLoader::Float64:
-        {
-            m_stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-            double value;
-            m_stream >> value;
-            return value;
-        }
+            return read<T, double>();
 
         default:
             break;
@@ -139,7 +142,8 @@ private:
         return 0;
     }
 
-    QDataStream m_stream;
+    const uchar *m_data;
+    const uchar *m_end;
 };
 
 }
@@ -173,28 +177,39 @@ bool PlyGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
 {
     Q_UNUSED(subMesh);
 
-    if (!parseHeader(ioDev))
+    const MappedDevice source(ioDev);
+    const char *body = source.begin();
+
+    if (!parseHeader(body, source.end()))
         return false;
 
-    if (!parseMesh(ioDev))
+    if (!parseMesh(body, source.end()))
         return false;
 
     return true;
 }
 
 /*!
-    Read and parse the header of the PLY format file.
+    Read and parse the header of the PLY format file starting at \a data,
+    which is then moved to the start of the body.
     Returns \c false if one of the lines is wrongly
     formatted.
 */
-bool PlyGeometryLoader::parseHeader(QIODevice *ioDev)
+bool PlyGeometryLoader::parseHeader(const char *&data, const char *end)
 {
     Format format = FormatUnknown;
 
+    m_format = FormatUnknown;
     m_hasNormals = m_hasTexCoords = false;
 
-    while (!ioDev->atEnd()) {
-        QByteArray lineBuffer = ioDev->readLine();
+    while (data < end) {
+        const char *line = data;
+        const char *lineEnd = static_cast<const char *>(memchr(line, '\n', end - line));
+        if (lineEnd == nullptr)
+            lineEnd = end;
+        data = qMin(lineEnd + 1, end);
+
+        const QByteArray lineBuffer = QByteArray::fromRawData(line, lineEnd - line);
         QTextStream textStream(lineBuffer, QIODevice::ReadOnly);
 
         QString token;
@@ -301,24 +316,26 @@ bool PlyGeometryLoader::parseHeader(QIODevice *ioDev)
     return true;
 }
 
-bool PlyGeometryLoader::parseMesh(QIODevice *ioDev)
+bool PlyGeometryLoader::parseMesh(const char *data, const char *end)
 {
     QScopedPointer<PlyDataReader> dataReader;
 
     switch (m_format) {
     case FormatAscii:
-        dataReader.reset(new AsciiPlyDataReader(ioDev));
+        dataReader.reset(new AsciiPlyDataReader(data, end));
         break;
 
     case FormatBinaryLittleEndian:
-        dataReader.reset(new BinaryPlyDataReader(ioDev, QDataStream::LittleEndian));
+        dataReader.reset(new BinaryPlyDataReader<QSysInfo::LittleEndian>(data, end));
         break;
 
     default:
-        dataReader.reset(new BinaryPlyDataReader(ioDev, QDataStream::BigEndian));
+        dataReader.reset(new BinaryPlyDataReader<QSysInfo::BigEndian>(data, end));
         break;
     }
 
+    QVarLengthArray<unsigned int, 8> faceIndices;
+
     for (auto &element : qAsConst(m_elements)) {
         if (element.type == ElementVertex) {
             m_points.reserve(element.count);
@@ -328,6 +345,8 @@ bool PlyGeometryLoader::parseMesh(QIODevice *ioDev)
 
             if (m_hasTexCoords)
                 m_texCoords.reserve(element.count);
+        } else if (element.type == ElementFace) {
+            m_indices.reserve(m_indices.size() + size_t(element.count) * 3);
         }
 
         for (int i = 0; i < element.count; ++i) {
@@ -335,15 +354,12 @@ bool PlyGeometryLoader::parseMesh(QIODevice *ioDev)
             QVector3D normal;
             QVector2D texCoord;
 
-            QList<unsigned int> faceIndices;
+            faceIndices.clear();
 
             for (auto &property : element.properties) {
                 if (property.dataType == TypeList) {
                     const int listSize = dataReader->readIntValue(property.listSizeType);
 
-                    if (element.type == ElementFace)
-                        faceIndices.reserve(listSize);
-
                     for (int j = 0; j < listSize; ++j) {
                         const unsigned int value = dataReader->readIntValue(property.listElementType);
 
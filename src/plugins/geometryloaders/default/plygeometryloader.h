@@ -82,8 +82,8 @@ protected:
     bool doLoad(QIODevice *ioDev, const QString &subMesh) final;
 
 private:
-    bool parseHeader(QIODevice *ioDev);
-    bool parseMesh(QIODevice *ioDev);
+    bool parseHeader(const char *&data, const char *end);
+    bool parseMesh(const char *data, const char *end);
 
     Format m_format;
     QList<Element> m_elements;
@@ -3,9 +3,11 @@
 
 #include "stlgeometryloader.h"
 
-#include <QtCore/QDataStream>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
+
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -17,87 +19,102 @@ bool StlGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
 {
     Q_UNUSED(subMesh);
 
-    if (loadBinary(ioDev))
+    const MappedDevice source(ioDev);
+
+    if (loadBinary(source))
         return true;
 
-    return loadAscii(ioDev);
+    return loadAscii(source);
 }
 
-bool StlGeometryLoader::loadAscii(QIODevice *ioDev)
+bool StlGeometryLoader::loadAscii(const MappedDevice &source)
 {
     // TODO stricter syntax checking
 
-    ioDev->setTextModeEnabled(true);
-    if (!ioDev->seek(0))
+    if (source.size() < 5 || qstrncmp(source.begin(), "solid", 5) != 0)
         return false;
 
-    char signature[5];
-    if (ioDev->peek(signature, sizeof(signature)) != sizeof(signature))
-        return false;
-
-    if (qstrncmp(signature, "solid", 5) != 0)
-        return false;
-
-    while (!ioDev->atEnd()) {
-        QByteArray lineBuffer = ioDev->readLine();
-
-        const char *begin = lineBuffer.constData();
-        const char *end = begin + lineBuffer.size();
-
-        const ByteArraySplitter tokens(begin, end, ' ', Qt::SkipEmptyParts);
+    // Find the vertex lines first so that they can be parsed in parallel
+    std::vector<const char *> vertexLines;
+    for (const char *next = source.begin(); next < source.end();) {
+        const char *line = next;
+        const char *lineEnd = static_cast<const char *>(memchr(line, '\n', source.end() - line));
+        if (lineEnd == nullptr)
+            lineEnd = source.end();
+        next = lineEnd + 1;
+
+        const char *keyword = skipSpaces(line, lineEnd);
+        if (lineEnd - keyword > 7 && qstrncmp(keyword, "vertex ", 7) == 0)
+            vertexLines.push_back(keyword + 7);
+    }
 
-        if (qstrncmp(tokens.charPtrAt(0), "vertex ", 7) == 0) {
-            if (tokens.size() < 4) {
-                qCWarning(StlGeometryLoaderLog) << "Unsupported number of components in vertex";
-            } else {
-                const float x = tokens.floatAt(1);
-                const float y = tokens.floatAt(2);
-                const float z = tokens.floatAt(3);
-                m_points.push_back(QVector3D(x, y, z));
-                m_indices.push_back(uint(m_indices.size()));
+    std::vector<QVector3D> points(vertexLines.size());
+    std::vector<char> valid(vertexLines.size());
+    parallelForChunks(vertexLines.size(), [&] (size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const char *p = vertexLines[i];
+            const char *lineEnd = static_cast<const char *>(memchr(p, '\n', source.end() - p));
+            if (lineEnd == nullptr)
+                lineEnd = source.end();
+            if (lineEnd != p && lineEnd[-1] == '\r')
+                --lineEnd;
+
+            float values[3];
+            int count = 0;
+            for (p = skipSpaces(p, lineEnd); p != lineEnd && count < 3; p = skipSpaces(p, lineEnd)) {
+                const char *tokenEnd = findSpace(p, lineEnd);
+                values[count++] = parseFloat(p, tokenEnd);
+                p = tokenEnd;
             }
+            if (count == 3)
+                points[i] = QVector3D(values[0], values[1], values[2]);
+            valid[i] = count == 3;
+        }
+    });
+
+    m_points.reserve(points.size());
+    m_indices.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!valid[i]) {
+            qCWarning(StlGeometryLoaderLog) << "Unsupported number of components in vertex";
+        } else {
+            m_points.push_back(points[i]);
+            m_indices.push_back(uint(m_indices.size()));
         }
     }
 
     return true;
 }
 
-bool StlGeometryLoader::loadBinary(QIODevice *ioDev)
+bool StlGeometryLoader::loadBinary(const MappedDevice &source)
 {
     static const int headerSize = 80;
+    static const int triangleSize = 50;
 
-    if (ioDev->read(headerSize).size() != headerSize)
+    if (source.size() < qsizetype(headerSize + sizeof(quint32)))
         return false;
 
-    ioDev->setTextModeEnabled(false);
-
-    QDataStream stream(ioDev);
-    stream.setByteOrder(QDataStream::LittleEndian);
-    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    const uchar *data = reinterpret_cast<const uchar *>(source.begin());
+    const quint32 triangleCount = qFromLittleEndian<quint32>(data + headerSize);
 
-    quint32 triangleCount;
-    stream >> triangleCount;
-
-    if (quint64(ioDev->size()) != headerSize + sizeof(quint32) + (triangleCount * 50))
+    if (quint64(source.size()) != headerSize + sizeof(quint32) + (quint64(triangleCount) * triangleSize))
         return false;
 
-    m_points.reserve(triangleCount * 3);
-    m_indices.reserve(triangleCount * 3);
-
-    for (unsigned i = 0; i < triangleCount; ++i) {
-        QVector3D normal;
-        stream >> normal;
-
-        for (int j = 0; j < 3; ++j) {
-            QVector3D point;
-            stream >> point;
-            m_points.push_back(point);
-            m_indices.push_back((i * 3) + j);
+    // Each triangle is a normal, 3 points and an attribute count
+    const uchar *triangles = data + headerSize + sizeof(quint32);
+    m_points.resize(size_t(triangleCount) * 3);
+    m_indices.resize(size_t(triangleCount) * 3);
+    parallelForChunks(triangleCount, [&] (size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uchar *point = triangles + i * triangleSize + 3 * sizeof(float);
+            for (size_t j = 0; j < 3; ++j, point += 3 * sizeof(float)) {
+                m_points[i * 3 + j] = QVector3D(qFromLittleEndian<float>(point),
+                                                qFromLittleEndian<float>(point + sizeof(float)),
+                                                qFromLittleEndian<float>(point + 2 * sizeof(float)));
+                m_indices[i * 3 + j] = uint(i * 3 + j);
+            }
         }
-
-        quint16 attributeCount;
-        stream >> attributeCount;
-    }
+    });
 
     return true;
 }
@@ -29,8 +29,8 @@ protected:
     bool doLoad(QIODevice *ioDev, const QString &subMesh) final;
 
 private:
-    bool loadAscii(QIODevice *ioDev);
-    bool loadBinary(QIODevice *ioDev);
+    bool loadAscii(const MappedDevice &source);
+    bool loadBinary(const MappedDevice &source);
 };
 
 } // namespace Qt3DRender
@@ -13,6 +13,7 @@
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DCore/QGeometry>
 #include <Qt3DCore/private/qloadgltf_p.h>
+#include <Qt3DCore/private/qattribute_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +37,8 @@ Q_LOGGING_CATEGORY(GLTFGeometryLoaderLog, "Qt3D.GLTFGeometryLoader", QtWarningMs
 #define KEY_BYTE_OFFSET  QLatin1String("byteOffset")
 #define KEY_BYTE_STRIDE  QLatin1String("byteStride")
 #define KEY_COUNT        QLatin1String("count")
+#define KEY_MIN          QLatin1String("min")
+#define KEY_MAX          QLatin1String("max")
 #define KEY_INDICES      QLatin1String("indices")
 #define KEY_MATERIAL     QLatin1String("material")
 #define KEY_MESHES       QLatin1String("meshes")
@@ -107,6 +110,7 @@ GLTFGeometryLoader::AccessorData::AccessorData()
     , count(0)
     , offset(0)
     , stride(0)
+    , hasBounds(false)
 {
 
 }
@@ -119,6 +123,7 @@ GLTFGeometryLoader::AccessorData::AccessorData(const QJsonObject &json)
     , count(json.value(KEY_COUNT).toInt())
     , offset(0)
     , stride(0)
+    , hasBounds(false)
 {
     const auto byteOffset = json.value(KEY_BYTE_OFFSET);
     if (!byteOffset.isUndefined())
@@ -126,6 +131,15 @@ GLTFGeometryLoader::AccessorData::AccessorData(const QJsonObject &json)
     const auto byteStride = json.value(KEY_BYTE_STRIDE);
     if (!byteStride.isUndefined())
         stride = byteStride.toInt();
+
+    // Extent of the values, used to speed up bounding volume computations
+    const QJsonArray minArray = json.value(KEY_MIN).toArray();
+    const QJsonArray maxArray = json.value(KEY_MAX).toArray();
+    if (type == QAttribute::Float && dataSize == 3 && minArray.size() == 3 && maxArray.size() == 3) {
+        minBound = QVector3D(minArray[0].toDouble(), minArray[1].toDouble(), minArray[2].toDouble());
+        maxBound = QVector3D(maxArray[0].toDouble(), maxArray[1].toDouble(), maxArray[2].toDouble());
+        hasBounds = true;
+    }
 }
 
 void GLTFGeometryLoader::setBasePath(const QString &path)
@@ -390,6 +404,8 @@ void GLTFGeometryLoader::processJSONMesh(const QString &id, const QJsonObject &j
                                                    accessorIt->offset,
                                                    accessorIt->stride);
             attribute->setAttributeType(QAttribute::VertexAttribute);
+            if (accessorIt->hasBounds)
+                QAttributePrivate::get(attribute)->setBounds(accessorIt->minBound, accessorIt->maxBound);
             meshGeometry->addAttribute(attribute);
         }
 
@@ -465,6 +481,8 @@ void GLTFGeometryLoader::processJSONMeshV2(const QJsonObject &json)
                                                    accessor.offset,
                                                    accessor.stride);
             attribute->setAttributeType(QAttribute::VertexAttribute);
+            if (accessor.hasBounds)
+                QAttributePrivate::get(attribute)->setBounds(accessor.minBound, accessor.maxBound);
             meshGeometry->addAttribute(attribute);
         }
 
@@ -17,6 +17,7 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QJsonDocument>
+#include <QtGui/QVector3D>
 
 #include <Qt3DRender/private/qgeometryloaderinterface_p.h>
 #include <Qt3DCore/qattribute.h>
@@ -84,6 +85,9 @@ class GLTFGeometryLoader : public QGeometryLoaderInterface
         int count;
         int offset;
         int stride;
+        QVector3D minBound;
+        QVector3D maxBound;
+        bool hasBounds;
     };
 
     struct Gltf1
@@ -29,6 +29,7 @@
 #include <glshader_p.h>
 #include <openglvertexarrayobject_p.h>
 #include <QOpenGLShaderProgram>
+#include <QOpenGLExtraFunctions>
 
 #if !QT_CONFIG(opengles2)
 #include <QOpenGLFunctions_2_0>
@@ -54,6 +55,7 @@
 #else
 #include <QOpenGLDebugLogger>
 #endif
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -65,6 +67,14 @@ QT_BEGIN_NAMESPACE
 #define GL_DRAW_FRAMEBUFFER 0x8CA9
 #endif
 
+#ifndef GL_COPY_READ_BUFFER
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+
+#ifndef GL_COPY_WRITE_BUFFER
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+
 using namespace Qt3DCore;
 
 namespace Qt3DRender {
@@ -600,17 +610,12 @@ QSize SubmissionContext::renderTargetSize(const QSize &surfaceSize) const
     return renderTargetSize;
 }
 
-QImage SubmissionContext::readFramebuffer(const QRect &rect)
+bool SubmissionContext::framebufferReadFormat(const QRect &rect, FramebufferReadFormat *readFormat) const
 {
-    QImage img;
     const unsigned int area = rect.width() * rect.height();
-    unsigned int bytes;
-    GLenum format, type;
-    QImage::Format imageFormat;
-    uint stride;
 
     /* format value should match GL internalFormat */
-    GLenum internalFormat = m_renderTargetFormat;
+    readFormat->internalFormat = m_renderTargetFormat;
 
     switch (m_renderTargetFormat) {
     case QAbstractTexture::RGBAFormat:
@@ -619,65 +624,65 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
     case QAbstractTexture::RGBA8U:
     case QAbstractTexture::SRGB8_Alpha8:
 #if QT_CONFIG(opengles2)
-        format = GL_RGBA;
-        imageFormat = QImage::Format_RGBA8888_Premultiplied;
+        readFormat->format = GL_RGBA;
+        readFormat->imageFormat = QImage::Format_RGBA8888_Premultiplied;
 #else
-        format = GL_BGRA;
-        imageFormat = QImage::Format_ARGB32_Premultiplied;
-        internalFormat = GL_RGBA8;
+        readFormat->format = GL_BGRA;
+        readFormat->imageFormat = QImage::Format_ARGB32_Premultiplied;
+        readFormat->internalFormat = GL_RGBA8;
 #endif
-        type = GL_UNSIGNED_BYTE;
-        bytes = area * 4;
-        stride = rect.width() * 4;
+        readFormat->type = GL_UNSIGNED_BYTE;
+        readFormat->bytes = area * 4;
+        readFormat->stride = rect.width() * 4;
         break;
     case QAbstractTexture::SRGB8:
     case QAbstractTexture::RGBFormat:
     case QAbstractTexture::RGB8U:
     case QAbstractTexture::RGB8_UNorm:
 #if QT_CONFIG(opengles2)
-        format = GL_RGBA;
-        imageFormat = QImage::Format_RGBX8888;
+        readFormat->format = GL_RGBA;
+        readFormat->imageFormat = QImage::Format_RGBX8888;
 #else
-        format = GL_BGRA;
-        imageFormat = QImage::Format_RGB32;
-        internalFormat = GL_RGB8;
+        readFormat->format = GL_BGRA;
+        readFormat->imageFormat = QImage::Format_RGB32;
+        readFormat->internalFormat = GL_RGB8;
 #endif
-        type = GL_UNSIGNED_BYTE;
-        bytes = area * 4;
-        stride = rect.width() * 4;
+        readFormat->type = GL_UNSIGNED_BYTE;
+        readFormat->bytes = area * 4;
+        readFormat->stride = rect.width() * 4;
         break;
 #if !QT_CONFIG(opengles2)
     case QAbstractTexture::RG11B10F:
-        bytes = area * 4;
-        format = GL_RGB;
-        type = GL_UNSIGNED_INT_10F_11F_11F_REV;
-        imageFormat = QImage::Format_RGB30;
-        stride = rect.width() * 4;
+        readFormat->bytes = area * 4;
+        readFormat->format = GL_RGB;
+        readFormat->type = GL_UNSIGNED_INT_10F_11F_11F_REV;
+        readFormat->imageFormat = QImage::Format_RGB30;
+        readFormat->stride = rect.width() * 4;
         break;
     case QAbstractTexture::RGB10A2:
-        bytes = area * 4;
-        format = GL_RGBA;
-        type = GL_UNSIGNED_INT_2_10_10_10_REV;
-        imageFormat = QImage::Format_A2BGR30_Premultiplied;
-        stride = rect.width() * 4;
+        readFormat->bytes = area * 4;
+        readFormat->format = GL_RGBA;
+        readFormat->type = GL_UNSIGNED_INT_2_10_10_10_REV;
+        readFormat->imageFormat = QImage::Format_A2BGR30_Premultiplied;
+        readFormat->stride = rect.width() * 4;
         break;
     case QAbstractTexture::R5G6B5:
-        bytes = area * 2;
-        format = GL_RGB;
-        type = GL_UNSIGNED_SHORT;
-        internalFormat = GL_UNSIGNED_SHORT_5_6_5_REV;
-        imageFormat = QImage::Format_RGB16;
-        stride = rect.width() * 2;
+        readFormat->bytes = area * 2;
+        readFormat->format = GL_RGB;
+        readFormat->type = GL_UNSIGNED_SHORT;
+        readFormat->internalFormat = GL_UNSIGNED_SHORT_5_6_5_REV;
+        readFormat->imageFormat = QImage::Format_RGB16;
+        readFormat->stride = rect.width() * 2;
         break;
     case QAbstractTexture::RGBA16F:
     case QAbstractTexture::RGBA16U:
     case QAbstractTexture::RGBA32F:
     case QAbstractTexture::RGBA32U:
-        bytes = area * 16;
-        format = GL_RGBA;
-        type = GL_FLOAT;
-        imageFormat = QImage::Format_ARGB32_Premultiplied;
-        stride = rect.width() * 16;
+        readFormat->bytes = area * 16;
+        readFormat->format = GL_RGBA;
+        readFormat->type = GL_FLOAT;
+        readFormat->imageFormat = QImage::Format_ARGB32_Premultiplied;
+        readFormat->stride = rect.width() * 16;
         break;
 #endif
     default:
@@ -685,21 +690,24 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
         warning << "Unable to convert";
         QtDebugUtils::formatQEnum(warning, m_renderTargetFormat);
         warning << "render target texture format to QImage.";
-        return img;
+        return false;
     }
 
+    return true;
+}
+
+// Reads the pixels of \a rect from the bound read framebuffer into \a data,
+// which is an offset in the bound pixel pack buffer if there is one
+bool SubmissionContext::readPixels(const QRect &rect, const FramebufferReadFormat &readFormat, void *data)
+{
     GLint samples = 0;
     m_gl->functions()->glGetIntegerv(GL_SAMPLES, &samples);
     if (samples > 0 && !m_glHelper->supportsFeature(GraphicsHelperInterface::BlitFramebuffer)) {
         qCWarning(Backend) << Q_FUNC_INFO << "Unable to capture multisampled framebuffer; "
                                              "Required feature BlitFramebuffer is missing.";
-        return img;
+        return false;
     }
 
-    img = QImage(rect.width(), rect.height(), imageFormat);
-
-    QScopedArrayPointer<uchar> data(new uchar [bytes]);
-
     if (samples > 0) {
         // resolve multisample-framebuffer to renderbuffer and read pixels from it
         GLuint fbo, rb;
@@ -708,7 +716,7 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
         gl->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
         gl->glGenRenderbuffers(1, &rb);
         gl->glBindRenderbuffer(GL_RENDERBUFFER, rb);
-        gl->glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, rect.width(), rect.height());
+        gl->glRenderbufferStorage(GL_RENDERBUFFER, readFormat.internalFormat, rect.width(), rect.height());
         gl->glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rb);
 
         const GLenum status = gl->glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
@@ -716,16 +724,14 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
             gl->glDeleteRenderbuffers(1, &rb);
             gl->glDeleteFramebuffers(1, &fbo);
             qCWarning(Backend) << Q_FUNC_INFO << "Copy-framebuffer not complete: " << status;
-            return img;
+            return false;
         }
 
         m_glHelper->blitFramebuffer(rect.x(), rect.y(), rect.x() + rect.width(), rect.y() + rect.height(),
                                     0, 0, rect.width(), rect.height(),
                                     GL_COLOR_BUFFER_BIT, GL_NEAREST);
         gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
-        gl->glReadPixels(0,0,rect.width(), rect.height(), format, type, data.data());
-
-        copyGLFramebufferDataToImage(img, data.data(), stride, rect.width(), rect.height(), m_renderTargetFormat);
+        gl->glReadPixels(0,0,rect.width(), rect.height(), readFormat.format, readFormat.type, data);
 
         gl->glBindRenderbuffer(GL_RENDERBUFFER, rb);
         gl->glDeleteRenderbuffers(1, &rb);
@@ -733,13 +739,142 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
         gl->glDeleteFramebuffers(1, &fbo);
     } else {
         // read pixels directly from framebuffer
-        m_gl->functions()->glReadPixels(rect.x(), rect.y(), rect.width(), rect.height(), format, type, data.data());
-        copyGLFramebufferDataToImage(img, data.data(), stride, rect.width(), rect.height(), m_renderTargetFormat);
+        m_gl->functions()->glReadPixels(rect.x(), rect.y(), rect.width(), rect.height(), readFormat.format, readFormat.type, data);
     }
+    return true;
+}
 
+QImage SubmissionContext::FramebufferReadback::toImage() const
+{
+    if (data.isEmpty())
+        return QImage();
+    QImage img(rect.width(), rect.height(), imageFormat);
+    copyGLFramebufferDataToImage(img, reinterpret_cast<const uchar *>(data.constData()),
+                                 stride, rect.width(), rect.height(), format);
     return img;
 }
 
+QImage SubmissionContext::readFramebuffer(const QRect &rect)
+{
+    return readFramebufferData(rect).toImage();
+}
+
+SubmissionContext::FramebufferReadback SubmissionContext::readFramebufferData(const QRect &rect)
+{
+    FramebufferReadback readback;
+    FramebufferReadFormat readFormat;
+    if (!framebufferReadFormat(rect, &readFormat))
+        return readback;
+
+    QByteArray data(readFormat.bytes, Qt::Uninitialized);
+    if (!readPixels(rect, readFormat, data.data()))
+        return readback;
+
+    readback.rect = rect;
+    readback.data = std::move(data);
+    readback.stride = readFormat.stride;
+    readback.format = m_renderTargetFormat;
+    readback.imageFormat = readFormat.imageFormat;
+    return readback;
+}
+
+// Reads \a rect of the bound read framebuffer into a pixel pack buffer and
+// inserts a fence after it. The pixels are retrieved by
+// takeCompletedFramebufferReads() once the fence was signaled. Returns false
+// if the read can't be done asynchronously, in which case
+// readFramebufferData() has to be used instead.
+bool SubmissionContext::readFramebufferAsync(const QRect &rect, Qt3DCore::QNodeId renderCaptureId,
+                                             const QRenderCaptureRequest &request)
+{
+    if (!m_glHelper->supportsFeature(GraphicsHelperInterface::Fences))
+        return false;
+
+    if (m_freePixelPackBuffers.empty() && m_pendingFramebufferReads.size() >= MaxPixelPackBuffers)
+        return false;
+
+    FramebufferReadFormat readFormat;
+    if (!framebufferReadFormat(rect, &readFormat))
+        return false;
+
+    PendingFramebufferRead pendingRead;
+    if (!m_freePixelPackBuffers.empty()) {
+        pendingRead.pixelBuffer = std::move(m_freePixelPackBuffers.back());
+        m_freePixelPackBuffers.pop_back();
+    } else if (!pendingRead.pixelBuffer.buffer.create(this)) {
+        qCWarning(Io) << Q_FUNC_INFO << "pixel pack buffer creation failed";
+        return false;
+    }
+
+    ReadbackBuffer &pixelBuffer = pendingRead.pixelBuffer;
+    pixelBuffer.buffer.bind(this, GLBuffer::PixelPackBuffer);
+    if (pixelBuffer.size < readFormat.bytes) {
+        pixelBuffer.buffer.allocateForReadback(this, readFormat.bytes);
+        pixelBuffer.size = readFormat.bytes;
+    }
+    const bool pixelsRead = readPixels(rect, readFormat, nullptr);
+    pixelBuffer.buffer.release(this);
+
+    if (!pixelsRead) {
+        m_freePixelPackBuffers.push_back(std::move(pendingRead.pixelBuffer));
+        return false;
+    }
+
+    FramebufferReadback &readback = pendingRead.readback;
+    readback.renderCaptureId = renderCaptureId;
+    readback.request = request;
+    readback.rect = rect;
+    readback.stride = readFormat.stride;
+    readback.format = m_renderTargetFormat;
+    readback.imageFormat = readFormat.imageFormat;
+    pendingRead.bytes = readFormat.bytes;
+    pendingRead.fence = fenceSync();
+    m_pendingFramebufferReads.push_back(std::move(pendingRead));
+    return true;
+}
+
+// Returns the pixels of the reads that have completed, in the order they were
+// issued. Their pixel pack buffers are recycled.
+std::vector<SubmissionContext::FramebufferReadback> SubmissionContext::takeCompletedFramebufferReads()
+{
+    std::vector<FramebufferReadback> completed;
+    auto it = m_pendingFramebufferReads.begin();
+    const auto end = m_pendingFramebufferReads.end();
+    for (; it != end; ++it) {
+        PendingFramebufferRead &pendingRead = *it;
+        if (!wasSyncSignaled(pendingRead.fence))
+            break;
+        deleteSync(pendingRead.fence);
+
+        GLBuffer &buffer = pendingRead.pixelBuffer.buffer;
+        buffer.bind(this, GLBuffer::PixelPackBuffer);
+        pendingRead.readback.data = buffer.download(this, pendingRead.bytes);
+        buffer.release(this);
+
+        completed.push_back(std::move(pendingRead.readback));
+        m_freePixelPackBuffers.push_back(std::move(pendingRead.pixelBuffer));
+    }
+    m_pendingFramebufferReads.erase(m_pendingFramebufferReads.begin(), it);
+    return completed;
+}
+
+// Returns the reads that were still in flight, without any pixels, so that
+// their captures can be completed anyway.
+std::vector<SubmissionContext::FramebufferReadback> SubmissionContext::releaseFramebufferReads()
+{
+    std::vector<FramebufferReadback> abandoned;
+    abandoned.reserve(m_pendingFramebufferReads.size());
+    for (PendingFramebufferRead &pendingRead : m_pendingFramebufferReads) {
+        deleteSync(pendingRead.fence);
+        pendingRead.pixelBuffer.buffer.destroy(this);
+        abandoned.push_back(std::move(pendingRead.readback));
+    }
+    m_pendingFramebufferReads.clear();
+    for (ReadbackBuffer &pixelBuffer : m_freePixelPackBuffers)
+        pixelBuffer.buffer.destroy(this);
+    m_freePixelPackBuffers.clear();
+    return abandoned;
+}
+
 void SubmissionContext::setViewport(const QRectF &viewport, const QSize &surfaceSize)
 {
     //    // save for later use; this has nothing to do with the viewport but it is
@@ -770,6 +905,11 @@ void SubmissionContext::setViewport(const QRectF &viewport, const QSize &surface
 void SubmissionContext::releaseOpenGL()
 {
     m_renderBufferHash.clear();
+    m_pendingBufferDownloads.clear();
+    m_freeStagingBuffers.clear();
+    m_readableBuffersBoundAsStorage.clear();
+    m_pendingFramebufferReads.clear();
+    m_freePixelPackBuffers.clear();
 
     // Stop and destroy the OpenGL logger
 #ifdef QT_OPENGL_LIB
@@ -1273,6 +1413,11 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack, GLShad
         bindGLBuffer(ssbo, GLBuffer::ShaderStorageBuffer);
         ssbo->bindBufferBase(this, b.m_bindingIndex, GLBuffer::ShaderStorageBuffer);
         // TO DO: Make sure that there's enough binding points
+
+        if ((cpuBuffer->access() & Qt3DCore::QBuffer::Read) && !ssbo->isDownloadQueued()) {
+            ssbo->setDownloadQueued(true);
+            m_readableBuffersBoundAsStorage.push_back(cpuBuffer->peerId());
+        }
     }
 
     // Bind UniformBlocks to UBO and update UBO from Buffer
@@ -1420,6 +1565,111 @@ QByteArray SubmissionContext::downloadBufferContent(Buffer *buffer)
     return QByteArray();
 }
 
+// Copies the content of the buffer into a staging buffer and inserts a fence
+// after the copy. The staging buffer is only mapped by
+// takeCompletedBufferDownloads() once the fence was signaled, so that reading
+// back doesn't stall the pipeline. Returns false if the context can't do that,
+// in which case downloadBufferContent() has to be used instead.
+bool SubmissionContext::downloadBufferContentAsync(Buffer *buffer)
+{
+    if (!m_glHelper->supportsFeature(GraphicsHelperInterface::Fences))
+        return false;
+
+    const QHash<Qt3DCore::QNodeId, HGLBuffer>::iterator it = m_renderBufferHash.find(buffer->peerId());
+    if (it == m_renderBufferHash.end())
+        return false;
+
+    const uint size = uint(buffer->data().size());
+    GLBuffer *source = m_renderer->glResourceManagers()->glBufferManager()->data(it.value());
+    if (source == nullptr || size == 0)
+        return false;
+
+    PendingBufferDownload download;
+    download.bufferId = buffer->peerId();
+    download.size = size;
+    if (!m_freeStagingBuffers.empty()) {
+        // Prefer a staging buffer that is large enough already
+        auto stagingIt = std::find_if(m_freeStagingBuffers.begin(), m_freeStagingBuffers.end(),
+                                      [size] (const ReadbackBuffer &b) { return b.size >= size; });
+        if (stagingIt == m_freeStagingBuffers.end())
+            stagingIt = m_freeStagingBuffers.end() - 1;
+        download.stagingBuffer = std::move(*stagingIt);
+        m_freeStagingBuffers.erase(stagingIt);
+    } else if (!download.stagingBuffer.buffer.create(this)) {
+        qCWarning(Io) << Q_FUNC_INFO << "staging buffer creation failed";
+        return false;
+    }
+
+    ReadbackBuffer &stagingBuffer = download.stagingBuffer;
+    stagingBuffer.buffer.bind(this, GLBuffer::CopyWriteBuffer);
+    if (stagingBuffer.size < size) {
+        stagingBuffer.buffer.allocateForReadback(this, size);
+        stagingBuffer.size = size;
+    }
+
+    // Bind the source directly, going through GLBuffer::bind would change
+    // the target it was last bound to and invalidate m_boundArrayBuffer
+    QOpenGLFunctions *f = m_gl->functions();
+    f->glBindBuffer(GL_COPY_READ_BUFFER, source->bufferId());
+    m_gl->extraFunctions()->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+    f->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    stagingBuffer.buffer.release(this);
+
+    download.fence = fenceSync();
+    m_pendingBufferDownloads.push_back(std::move(download));
+    return true;
+}
+
+// Returns the content of the buffers whose copy has completed, in the order
+// the downloads were issued
+std::vector<QPair<Qt3DCore::QNodeId, QByteArray>> SubmissionContext::takeCompletedBufferDownloads()
+{
+    std::vector<QPair<Qt3DCore::QNodeId, QByteArray>> completed;
+    auto it = m_pendingBufferDownloads.begin();
+    const auto end = m_pendingBufferDownloads.end();
+    for (; it != end; ++it) {
+        PendingBufferDownload &download = *it;
+        if (!wasSyncSignaled(download.fence))
+            break;
+        deleteSync(download.fence);
+        GLBuffer &buffer = download.stagingBuffer.buffer;
+        buffer.bind(this, GLBuffer::CopyReadBuffer);
+        completed.push_back({ download.bufferId, buffer.download(this, download.size) });
+        buffer.release(this);
+        if (m_freeStagingBuffers.size() < MaxFreeStagingBuffers)
+            m_freeStagingBuffers.push_back(std::move(download.stagingBuffer));
+        else
+            buffer.destroy(this);
+    }
+    m_pendingBufferDownloads.erase(m_pendingBufferDownloads.begin(), it);
+    return completed;
+}
+
+void SubmissionContext::releaseBufferDownloads()
+{
+    for (PendingBufferDownload &download : m_pendingBufferDownloads) {
+        deleteSync(download.fence);
+        download.stagingBuffer.buffer.destroy(this);
+    }
+    m_pendingBufferDownloads.clear();
+    for (ReadbackBuffer &stagingBuffer : m_freeStagingBuffers)
+        stagingBuffer.buffer.destroy(this);
+    m_freeStagingBuffers.clear();
+}
+
+// Buffers with Read access bound as SSBO since the last call, the only
+// buffers the GPU can have written to
+std::vector<Qt3DCore::QNodeId> SubmissionContext::takeReadableBuffersBoundAsStorage()
+{
+    GLBufferManager *glBufferManager = m_renderer->glResourceManagers()->glBufferManager();
+    for (const Qt3DCore::QNodeId &bufferId : m_readableBuffersBoundAsStorage) {
+        const auto it = m_renderBufferHash.constFind(bufferId);
+        if (it != m_renderBufferHash.cend())
+            glBufferManager->data(it.value())->setDownloadQueued(false);
+    }
+    return Qt3DCore::moveAndClear(m_readableBuffersBoundAsStorage);
+}
+
 void SubmissionContext::releaseBuffer(Qt3DCore::QNodeId bufferId)
 {
     auto it = m_renderBufferHash.find(bufferId);
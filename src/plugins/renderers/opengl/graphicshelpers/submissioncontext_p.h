@@ -25,6 +25,7 @@
 #include <Qt3DRender/qclearbuffers.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/attachmentpack_p.h>
+#include <Qt3DRender/private/qrendercapture_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -81,6 +82,24 @@ public:
     void releaseRenderTargets();
     QSize renderTargetSize(const QSize &surfaceSize) const;
     QImage readFramebuffer(const QRect &rect);
+
+    // Pixels read back from the framebuffer, tightly packed, bottom row first
+    struct FramebufferReadback {
+        Qt3DCore::QNodeId renderCaptureId;
+        QRenderCaptureRequest request;
+        QRect rect;
+        QByteArray data;
+        uint stride = 0;
+        QAbstractTexture::TextureFormat format = QAbstractTexture::NoFormat;
+        QImage::Format imageFormat = QImage::Format_Invalid;
+
+        QImage toImage() const;
+    };
+    FramebufferReadback readFramebufferData(const QRect &rect);
+    bool readFramebufferAsync(const QRect &rect, Qt3DCore::QNodeId renderCaptureId, const QRenderCaptureRequest &request);
+    std::vector<FramebufferReadback> takeCompletedFramebufferReads();
+    size_t pendingFramebufferReadCount() const { return m_pendingFramebufferReads.size(); }
+    std::vector<FramebufferReadback> releaseFramebufferReads();
     void blitFramebuffer(Qt3DCore::QNodeId outputRenderTargetId, Qt3DCore::QNodeId inputRenderTargetId,
                          QRect inputRect,
                          QRect outputRect, uint defaultFboId,
@@ -97,6 +116,12 @@ public:
     // Buffer
     void updateBuffer(Buffer *buffer);
     QByteArray downloadBufferContent(Buffer *buffer);
+    bool downloadBufferContentAsync(Buffer *buffer);
+    std::vector<QPair<Qt3DCore::QNodeId, QByteArray>> takeCompletedBufferDownloads();
+    size_t pendingBufferDownloadCount() const { return m_pendingBufferDownloads.size(); }
+    size_t freeStagingBufferCount() const { return m_freeStagingBuffers.size(); }
+    void releaseBufferDownloads();
+    std::vector<Qt3DCore::QNodeId> takeReadableBuffersBoundAsStorage();
     void releaseBuffer(Qt3DCore::QNodeId bufferId);
     bool hasGLBufferForBuffer(Buffer *buffer);
     GLBuffer *glBufferForRenderBuffer(Buffer *buf);
@@ -149,7 +174,43 @@ private:
     GLuint createRenderTarget(Qt3DCore::QNodeId renderTargetNodeId, const AttachmentPack &attachments);
     GLuint updateRenderTarget(Qt3DCore::QNodeId renderTargetNodeId, const AttachmentPack &attachments, bool isActiveRenderTarget);
 
+    struct FramebufferReadFormat {
+        GLenum format;
+        GLenum type;
+        GLenum internalFormat;
+        QImage::Format imageFormat;
+        uint bytes;
+        uint stride;
+    };
+    bool framebufferReadFormat(const QRect &rect, FramebufferReadFormat *readFormat) const;
+    bool readPixels(const QRect &rect, const FramebufferReadFormat &readFormat, void *data);
+
+    // Buffers the GPU copies data into for the CPU to read back, recycled
+    // from one read to the next
+    struct ReadbackBuffer {
+        GLBuffer buffer;
+        uint size = 0;
+    };
+
+    // At most MaxPixelPackBuffers framebuffer reads are in flight at any given time
+    static constexpr size_t MaxPixelPackBuffers = 3;
+    struct PendingFramebufferRead {
+        FramebufferReadback readback;
+        ReadbackBuffer pixelBuffer;
+        uint bytes = 0;
+        GLFence fence = nullptr;
+    };
+
     // Buffers
+    // At most MaxFreeStagingBuffers staging buffers are kept for later downloads
+    static constexpr size_t MaxFreeStagingBuffers = 4;
+    struct PendingBufferDownload {
+        Qt3DCore::QNodeId bufferId;
+        ReadbackBuffer stagingBuffer;
+        uint size = 0;
+        GLFence fence = nullptr;
+    };
+
     HGLBuffer createGLBufferFor(Buffer *buffer);
     void uploadDataToGLBuffer(Buffer *buffer, GLBuffer *b, bool releaseBuffer = false);
     QByteArray downloadDataFromGLBuffer(Buffer *buffer, GLBuffer *b);
@@ -163,6 +224,11 @@ private:
     QOpenGLShaderProgram *m_activeShader;
 
     QHash<Qt3DCore::QNodeId, HGLBuffer> m_renderBufferHash;
+    std::vector<PendingBufferDownload> m_pendingBufferDownloads;
+    std::vector<ReadbackBuffer> m_freeStagingBuffers;
+    std::vector<Qt3DCore::QNodeId> m_readableBuffersBoundAsStorage;
+    std::vector<PendingFramebufferRead> m_pendingFramebufferReads;
+    std::vector<ReadbackBuffer> m_freePixelPackBuffers;
 
 
     QHash<Qt3DCore::QNodeId, RenderTargetInfo> m_renderTargets;
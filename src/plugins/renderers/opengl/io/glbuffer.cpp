@@ -25,6 +25,15 @@
 #if !defined(GL_DRAW_INDIRECT_BUFFER)
 #define GL_DRAW_INDIRECT_BUFFER 0x8F3F
 #endif
+#if !defined(GL_COPY_READ_BUFFER)
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+#if !defined(GL_COPY_WRITE_BUFFER)
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+#if !defined(GL_STREAM_READ)
+#define GL_STREAM_READ 0x88E1
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -46,7 +55,9 @@ GLenum glBufferTypes[] = {
     GL_SHADER_STORAGE_BUFFER,
     GL_PIXEL_PACK_BUFFER,
     GL_PIXEL_UNPACK_BUFFER,
-    GL_DRAW_INDIRECT_BUFFER
+    GL_DRAW_INDIRECT_BUFFER,
+    GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER
 };
 
 } // anonymous
@@ -55,6 +66,7 @@ GLBuffer::GLBuffer()
     : m_bufferId(0)
     , m_isCreated(false)
     , m_bound(false)
+    , m_downloadQueued(false)
     , m_lastTarget(GL_ARRAY_BUFFER)
 {
 }
@@ -87,6 +99,7 @@ void GLBuffer::destroy(GraphicsContext *ctx)
 {
     ctx->openGLContext()->functions()->glDeleteBuffers(1, &m_bufferId);
     m_isCreated = false;
+    m_downloadQueued = false;
 }
 
 void GLBuffer::allocate(GraphicsContext *ctx, uint size, bool dynamic)
@@ -101,6 +114,12 @@ void GLBuffer::allocate(GraphicsContext *ctx, const void *data, uint size, bool
     ctx->openGLContext()->functions()->glBufferData(m_lastTarget, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 }
 
+// Allocates storage the GPU writes to once and the CPU reads back from
+void GLBuffer::allocateForReadback(GraphicsContext *ctx, uint size)
+{
+    ctx->openGLContext()->functions()->glBufferData(m_lastTarget, size, NULL, GL_STREAM_READ);
+}
+
 void GLBuffer::update(GraphicsContext *ctx, const void *data, uint size, int offset)
 {
     ctx->openGLContext()->functions()->glBufferSubData(m_lastTarget, offset, size, data);
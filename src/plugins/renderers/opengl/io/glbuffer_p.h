@@ -42,7 +42,9 @@ public:
         ShaderStorageBuffer,
         PixelPackBuffer,
         PixelUnpackBuffer,
-        DrawIndirectBuffer
+        DrawIndirectBuffer,
+        CopyReadBuffer,
+        CopyWriteBuffer
     };
 
     bool bind(GraphicsContext *ctx, Type t);
@@ -51,6 +53,7 @@ public:
     void destroy(GraphicsContext *ctx);
     void allocate(GraphicsContext *ctx, uint size, bool dynamic = true);
     void allocate(GraphicsContext *ctx, const void *data, uint size, bool dynamic = true);
+    void allocateForReadback(GraphicsContext *ctx, uint size);
     void update(GraphicsContext *ctx, const void *data, uint size, int offset = 0);
     QByteArray download(GraphicsContext *ctx, uint size);
     void bindBufferBase(GraphicsContext *ctx, int bindingPoint, Type t);
@@ -60,10 +63,15 @@ public:
     inline bool isCreated() const { return m_isCreated; }
     inline bool isBound() const { return m_bound; }
 
+    // Set while the buffer is queued for downloading its content
+    inline bool isDownloadQueued() const { return m_downloadQueued; }
+    inline void setDownloadQueued(bool queued) { m_downloadQueued = queued; }
+
 private:
     GLuint m_bufferId;
     bool m_isCreated;
     bool m_bound;
+    bool m_downloadQueued;
     GLenum m_lastTarget;
 };
 
@@ -171,6 +171,14 @@ private:
     RendererCache *m_cache;
 };
 
+int frameLatencyFromEnvironment()
+{
+    const int latency = qEnvironmentVariableIntValue("QT3D_FRAME_LATENCY");
+    if (latency > 1)
+        qCWarning(Backend) << "QT3D_FRAME_LATENCY" << latency << "is not supported, using 1 instead";
+    return qBound(0, latency, 1);
+}
+
 } // anonymous
 
 /*!
@@ -222,6 +230,7 @@ Renderer::Renderer()
     , m_introspectShaderJob(CreateSynchronizerPostFramePtr([this] { reloadDirtyShaders(); },
                                                            [this] (Qt3DCore::QAspectManager *m) { sendShaderChangesToFrontend(m); },
                                                            JobTypes::DirtyShaderGathering))
+    , m_renderCaptureConversionJob(CreateSynchronizerJobPtr([this] { convertRenderCaptures(); }, JobTypes::SendRenderCapture, 0))
     , m_ownedContext(false)
     , m_offscreenHelper(nullptr)
     , m_glResourceManagers(nullptr)
@@ -229,6 +238,7 @@ Renderer::Renderer()
     , m_shouldSwapBuffers(true)
     , m_imGuiRenderer(nullptr)
     , m_jobsInLastFrame(0)
+    , m_frameLatency(frameLatencyFromEnvironment())
 {
     // Set renderer as running - it will wait in the context of the
     // RenderThread for RenderViews to be submitted
@@ -310,6 +320,7 @@ void Renderer::setAspect(QRenderAspect *aspect)
 void Renderer::setNodeManagers(NodeManagers *managers)
 {
     m_nodesManager = managers;
+    m_dirtyRenderCommandTracker.setManagers(m_nodesManager);
     m_glResourceManagers = new GLResourceManagers();
     m_scene2DResourceAccessor.reset(new ResourceAccessor(this, m_nodesManager));
 
@@ -506,6 +517,9 @@ void Renderer::shutdown()
     QMutexLocker lockRenderQueue(m_renderQueue.mutex());
     m_renderQueue.reset();
     lockRenderQueue.unlock();
+    Qt3DCore::deleteAll(m_pendingFrame.renderViews);
+    m_pendingFrame = {};
+    m_renderViewPool.clear();
 
     releaseGraphicsResources();
 
@@ -566,6 +580,10 @@ void Renderer::releaseGraphicsResources()
                 GLBuffer *buffer = m_glResourceManagers->glBufferManager()->data(bufferHandle);
                 buffer->destroy(m_submissionContext.data());
             }
+            m_submissionContext->releaseBufferDownloads();
+            m_pendingBufferDownloadCount.storeRelaxed(0);
+            failRenderCaptures(m_submissionContext->releaseFramebufferReads());
+            m_pendingRenderCaptureReadCount.storeRelaxed(0);
 
             // Do the same thing with shaders
             const std::vector<GLShader *> shaders = m_glResourceManagers->glShaderManager()->takeActiveResources();
@@ -661,10 +679,6 @@ RenderSettings *Renderer::settings() const
 // This will wait until renderQueue is ready or shutdown was requested
 void Renderer::render(bool swapBuffers)
 {
-    Renderer::ViewSubmissionResultData submissionData;
-    bool preprocessingComplete = false;
-    bool beganDrawing = false;
-
     // Blocking until RenderQueue is full
     const bool canSubmit = waitUntilReadyToSubmit();
 
@@ -672,72 +686,106 @@ void Renderer::render(bool swapBuffers)
     if (!canSubmit)
         return;
 
+    // The previous frame is normally submitted while the jobs of this one are
+    // running, make sure it's out before preparing this one
+    submitPendingFrame();
+
     m_shouldSwapBuffers = swapBuffers;
-    const std::vector<Render::OpenGL::RenderView *> &renderViews = m_renderQueue.nextFrameQueue();
-    const bool queueIsEmpty = m_renderQueue.targetRenderViewCount() == 0;
 
     // RenderQueue is complete (but that means it may be of size 0)
-    if (!queueIsEmpty) {
-        QTaskLogger submissionStatsPart1(m_services->systemInformation(),
-                                         {JobTypes::FrameSubmissionPart1, 0},
-                                         QTaskLogger::Submission);
+    if (m_renderQueue.targetRenderViewCount() > 0) {
+        m_renderQueue.takeFrameQueue(m_pendingFrame.renderViews);
+        prepareFrameSubmission(m_pendingFrame);
+    } else {
+        // Reset RenderQueue
+        m_renderQueue.reset();
+        // Deliver the readbacks that completed since the last rendered frame
+        pollPendingReadbacks();
+    }
+
+    // When pipelined, the frame is submitted once the jobs of the next one
+    // have been enqueued
+    if (!isFramePipelined())
+        submitPendingFrame();
+
+    // Allow next frame to be built once we are done doing all rendering
+    m_vsyncFrameAdvanceService->proceedToNextFrame();
+}
+
+void Renderer::prepareFrameSubmission(FrameSubmission &frame)
+{
+    QTaskLogger submissionStatsPart1(m_services->systemInformation(),
+                                     {JobTypes::FrameSubmissionPart1, 0},
+                                     QTaskLogger::Submission);
+
+    QSurface *surface = nullptr;
+    for (const RenderView *rv: frame.renderViews) {
+        surface = rv->surface();
+        if (surface)
+            break;
+    }
+
+    SurfaceLocker surfaceLock(surface);
+    const bool surfaceIsValid = (surface && surfaceLock.isSurfaceValid());
+    if (!surfaceIsValid)
+        return;
+
+    // Reset state for each draw if we don't have complete control of the context
+    if (!m_ownedContext)
+        m_submissionContext->setCurrentStateSet(nullptr);
+    frame.beganDrawing = m_submissionContext->beginDrawing(surface);
+    if (!frame.beganDrawing)
+        return;
+
+    // When pipelining, resources are released here rather than after the
+    // submission, as the submission overlaps with jobs reading them
+    if (isFramePipelined())
+        cleanGraphicsResources();
+
+    // 1) Execute commands for buffer uploads, texture updates, shader loading first
+    updateGLResources();
+    // 2) Update VAO and copy data into commands to allow concurrent submission
+    prepareCommandsSubmission(frame.renderViews);
+    frame.preprocessingComplete = true;
+
+    // Purge shader which aren't used any longer
+    static int callCount = 0;
+    ++callCount;
+    const int shaderPurgePeriod = 600;
+    if (callCount % shaderPurgePeriod == 0)
+        m_glResourceManagers->glShaderManager()->purge();
+}
+
+void Renderer::submitFrame(FrameSubmission &frame)
+{
+    Renderer::ViewSubmissionResultData submissionData;
+
+    if (!frame.renderViews.empty()) {
         QTaskLogger submissionStatsPart2(m_services->systemInformation(),
                                          {JobTypes::FrameSubmissionPart2, 0},
                                          QTaskLogger::Submission);
-        { // Scoped to destroy surfaceLock
-            QSurface *surface = nullptr;
-            for (const RenderView *rv: renderViews) {
-                surface = rv->surface();
-                if (surface)
-                    break;
-            }
-
-            SurfaceLocker surfaceLock(surface);
-            const bool surfaceIsValid = (surface && surfaceLock.isSurfaceValid());
-            if (surfaceIsValid) {
-                // Reset state for each draw if we don't have complete control of the context
-                if (!m_ownedContext)
-                    m_submissionContext->setCurrentStateSet(nullptr);
-                beganDrawing = m_submissionContext->beginDrawing(surface);
-                if (beganDrawing) {
-                    // 1) Execute commands for buffer uploads, texture updates, shader loading first
-                    updateGLResources();
-                    // 2) Update VAO and copy data into commands to allow concurrent submission
-                    prepareCommandsSubmission(renderViews);
-                    preprocessingComplete = true;
-
-                    // Purge shader which aren't used any longer
-                    static int callCount = 0;
-                    ++callCount;
-                    const int shaderPurgePeriod = 600;
-                    if (callCount % shaderPurgePeriod == 0)
-                        m_glResourceManagers->glShaderManager()->purge();
-                }
-            }
-        }
 
         // Only try to submit the RenderViews if the preprocessing was successful
-        if (preprocessingComplete) {
-            submissionStatsPart1.end(submissionStatsPart2.restart());
-
+        if (frame.preprocessingComplete) {
             // 3) Submit the render commands for frame n (making sure we never reference something that could be changing)
             // Render using current device state and renderer configuration
-            submissionData = submitRenderViews(renderViews);
+            submissionData = submitRenderViews(frame.renderViews);
 
             // Perform any required cleanup of the Graphics resources (Buffers deleted, Shader deleted...)
-            cleanGraphicsResources();
+            if (!isFramePipelined())
+                cleanGraphicsResources();
         }
 
         // Execute the pending shell commands
-        m_commandExecuter->performAsynchronousCommandExecution(renderViews);
+        m_commandExecuter->performAsynchronousCommandExecution(frame.renderViews);
 
-        if (preprocessingComplete && activeProfiler())
+        if (frame.preprocessingComplete && activeProfiler())
             m_frameProfiler->writeResults();
     }
 
     // Perform the last swapBuffers calls
     // Finish up with last surface used in the list of RenderViews
-    if (beganDrawing) {
+    if (frame.beganDrawing) {
         SurfaceLocker surfaceLock(submissionData.surface);
         // Finish up with last surface used in the list of RenderViews
         const bool swapBuffers = submissionData.lastBoundFBOId == m_submissionContext->defaultFBO()
@@ -746,11 +794,29 @@ void Renderer::render(bool swapBuffers)
         m_submissionContext->endDrawing(swapBuffers);
     }
 
-    // Reset RenderQueue and destroy the renderViews
-    m_renderQueue.reset();
+    // Recycle the renderViews
+    m_renderViewPool.release(frame.renderViews);
+    frame.preprocessingComplete = false;
+    frame.beganDrawing = false;
+}
 
-    // Allow next frame to be built once we are done doing all rendering
-    m_vsyncFrameAdvanceService->proceedToNextFrame();
+void Renderer::submitPendingFrame()
+{
+    if (!m_pendingFrame.renderViews.empty())
+        submitFrame(m_pendingFrame);
+}
+
+// Submitting frame n while the jobs of frame n + 1 run requires Qt3D to be in
+// charge of rendering, the jobs and the submission being on the same thread
+bool Renderer::isFramePipelined() const
+{
+    return m_frameLatency > 0 && m_driver == RenderDriver::Qt3D;
+}
+
+// Aspect thread, while the jobs of the frame are running
+void Renderer::jobsEnqueued()
+{
+    submitPendingFrame();
 }
 
 // Called by RenderViewJobs
@@ -920,6 +986,9 @@ void Renderer::prepareCommandsSubmission(const std::vector<RenderView *> &render
 // Executed in a job
 void Renderer::lookForAbandonedVaos()
 {
+    if (!m_lookForAbandonedVaos)
+        return;
+
     const std::vector<HVao> &activeVaos = m_glResourceManagers->vaoManager()->activeHandles();
     for (HVao handle : activeVaos) {
         OpenGLVertexArrayObject *vao = m_glResourceManagers->vaoManager()->data(handle);
@@ -937,24 +1006,16 @@ void Renderer::lookForAbandonedVaos()
 // Executed in a job
 void Renderer::lookForDirtyBuffers()
 {
-    const std::vector<HBuffer> &activeBufferHandles = m_nodesManager->bufferManager()->activeHandles();
-    for (const HBuffer &handle: activeBufferHandles) {
-        Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
-        if (buffer->isDirty())
+    // Only the buffers which were modified since the last time we looked are
+    // queued. Released buffers have been cleaned up and are no longer dirty
+    BufferManager *bufferManager = m_nodesManager->bufferManager();
+    bufferManager->dirtyNodeQueue().consume([this, bufferManager] (Buffer *buffer) {
+        if (!buffer->isDirty())
+            return;
+        const HBuffer handle = bufferManager->lookupHandle(buffer->peerId());
+        if (!handle.isNull())
             m_dirtyBuffers.push_back(handle);
-    }
-}
-
-// Called in prepareSubmission
-void Renderer::lookForDownloadableBuffers()
-{
-    m_downloadableBuffers.clear();
-    const std::vector<HBuffer> &activeBufferHandles = m_nodesManager->bufferManager()->activeHandles();
-    for (const HBuffer &handle : activeBufferHandles) {
-        Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
-        if (buffer->access() & Qt3DCore::QBuffer::Read)
-            m_downloadableBuffers.push_back(buffer->peerId());
-    }
+    });
 }
 
 // Executed in a job
@@ -965,38 +1026,44 @@ void Renderer::lookForDirtyTextures()
     // image has been updated to then notify textures referencing the image
     // that they need to be updated
     TextureImageManager *imageManager = m_nodesManager->textureImageManager();
-    const std::vector<HTextureImage> &activeTextureImageHandles = imageManager->activeHandles();
-    Qt3DCore::QNodeIdVector dirtyImageIds;
-    for (const HTextureImage &handle: activeTextureImageHandles) {
-        TextureImage *image = imageManager->data(handle);
+    QSet<Qt3DCore::QNodeId> dirtyImageIds;
+    imageManager->dirtyNodeQueue().consume([&dirtyImageIds] (TextureImage *image) {
         if (image->isDirty()) {
-            dirtyImageIds.push_back(image->peerId());
+            dirtyImageIds.insert(image->peerId());
             image->unsetDirty();
         }
-    }
+    });
 
     TextureManager *textureManager = m_nodesManager->textureManager();
-    const std::vector<HTexture> &activeTextureHandles = textureManager->activeHandles();
-    for (const HTexture &handle: activeTextureHandles) {
-        Texture *texture = textureManager->data(handle);
-        const QNodeIdVector imageIds = texture->textureImageIds();
-
-        // Does the texture reference any of the dirty texture images?
-        for (const QNodeId &imageId: imageIds) {
-            if (dirtyImageIds.contains(imageId)) {
-                texture->addDirtyFlag(Texture::DirtyImageGenerators);
-                break;
+    if (!dirtyImageIds.isEmpty()) {
+        const std::vector<HTexture> &activeTextureHandles = textureManager->activeHandles();
+        for (const HTexture &handle : activeTextureHandles) {
+            Texture *texture = textureManager->data(handle);
+            const QNodeIdVector imageIds = texture->textureImageIds();
+
+            // Does the texture reference any of the dirty texture images?
+            for (const QNodeId &imageId : imageIds) {
+                if (dirtyImageIds.contains(imageId)) {
+                    // Queues the texture
+                    texture->addDirtyFlag(Texture::DirtyImageGenerators);
+                    break;
+                }
             }
         }
+    }
 
+    textureManager->dirtyNodeQueue().consume([this, textureManager] (Texture *texture) {
         // Dirty meaning that something has changed on the texture
         // either properties, parameters, shared texture id, generator or a texture image
-        if (texture->dirtyFlags() != Texture::NotDirty)
+        if (texture->dirtyFlags() == Texture::NotDirty)
+            return;
+        const HTexture handle = textureManager->lookupHandle(texture->peerId());
+        if (!handle.isNull())
             m_dirtyTextures.push_back(handle);
         // Note: texture dirty flags are reset when actually updating the
         // textures in updateGLResources() as resetting flags here would make
         // us lose information about what was dirty exactly.
-    }
+    });
 }
 
 // Executed in a job
@@ -1260,6 +1327,11 @@ void Renderer::updateGLResources()
             // (not the underlying GL instance) if required and all things that
             // can take place without a GL context are done here)
             updateTexture(texture);
+
+            // Textures referencing missing images are left dirty, look at
+            // them again the next time textures are gathered
+            if (texture->dirtyFlags() != Texture::NotDirty)
+                m_nodesManager->textureManager()->dirtyNodeQueue().push(texture);
         }
         // We want to upload textures data at this point as the SubmissionThread and
         // AspectThread are locked ensuring no races between Texture/TextureImage and
@@ -1299,9 +1371,6 @@ void Renderer::updateGLResources()
         m_textureIdsToCleanup += m_nodesManager->textureManager()->takeTexturesIdsToCleanup();
     }
 
-    // Record list of buffer that might need uploading
-    lookForDownloadableBuffers();
-
     // Remove destroyed FBOs
     {
         const QNodeIdVector destroyedRenderTargetIds = m_nodesManager->renderTargetManager()->takeRenderTargetIdsToCleanup();
@@ -1330,6 +1399,8 @@ void Renderer::updateTexture(Texture *texture)
     // No GLTexture associated yet -> create it
     if (glTexture == nullptr) {
         glTexture = glTextureManager->getOrCreateResource(texture->peerId());
+        glTexture->setTextureDataManagers(m_nodesManager->textureDataManager(),
+                                          m_nodesManager->textureImageDataManager());
         glTextureManager->texNodeIdForGLTexture.insert(glTexture, texture->peerId());
     }
 
@@ -1396,26 +1467,139 @@ void Renderer::cleanupShader(const Shader *shader)
     GLShaderManager *glShaderManager = m_glResourceManagers->glShaderManager();
     GLShader *glShader = glShaderManager->lookupResource(shader->peerId());
 
-    if (glShader != nullptr)
+    if (glShader != nullptr) {
         glShaderManager->abandon(glShader, shader);
+        m_glShadersAbandoned.storeRelaxed(1);
+    }
 }
 
 // Called by SubmitRenderView
+// Only the readable buffers bound as SSBO since the last download can have
+// been written to by the GPU. When the context supports fences, their content
+// is copied to staging buffers and sent once the copies have completed, see
+// sendCompletedBufferDownloads()
 void Renderer::downloadGLBuffers()
 {
-    const std::vector<Qt3DCore::QNodeId> downloadableHandles = Qt3DCore::moveAndClear(m_downloadableBuffers);
-    for (const Qt3DCore::QNodeId &bufferId : downloadableHandles) {
+    const std::vector<Qt3DCore::QNodeId> downloadableIds = m_submissionContext->takeReadableBuffersBoundAsStorage();
+    for (const Qt3DCore::QNodeId &bufferId : downloadableIds) {
         BufferManager *bufferManager = m_nodesManager->bufferManager();
         BufferManager::ReadLocker locker(const_cast<const BufferManager *>(bufferManager));
         Buffer *buffer = bufferManager->lookupResource(bufferId);
         // Buffer could have been destroyed at this point
         if (!buffer)
             continue;
+        if (m_submissionContext->downloadBufferContentAsync(buffer))
+            continue;
         // locker is protecting us from the buffer being destroy while we're looking
         // up its content
         const QByteArray content = m_submissionContext->downloadBufferContent(buffer);
         m_sendBufferCaptureJob->addRequest(QPair<Qt3DCore::QNodeId, QByteArray>(bufferId, content));
     }
+    m_pendingBufferDownloadCount.storeRelaxed(int(m_submissionContext->pendingBufferDownloadCount()));
+}
+
+// Called by SubmitRenderView
+void Renderer::sendCompletedBufferDownloads()
+{
+    if (m_pendingBufferDownloadCount.loadRelaxed() == 0)
+        return;
+
+    const std::vector<QPair<Qt3DCore::QNodeId, QByteArray>> completedDownloads = m_submissionContext->takeCompletedBufferDownloads();
+    for (const auto &download : completedDownloads)
+        m_sendBufferCaptureJob->addRequest(download);
+    m_pendingBufferDownloadCount.storeRelaxed(int(m_submissionContext->pendingBufferDownloadCount()));
+}
+
+// Called in RenderThread context when there's nothing to render
+// Checks the fences of the buffer downloads and render captures in flight on
+// the offscreen surface, so that they complete without rendering frames
+void Renderer::pollPendingReadbacks()
+{
+    if (!m_ownedContext
+            || (m_pendingBufferDownloadCount.loadRelaxed() == 0
+                && m_pendingRenderCaptureReadCount.loadRelaxed() == 0))
+        return;
+
+    QMutexLocker locker(&m_offscreenSurfaceMutex);
+    QOffscreenSurface *offscreenSurface = m_offscreenHelper ? m_offscreenHelper->offscreenSurface() : nullptr;
+    if (!offscreenSurface || !m_submissionContext->makeCurrent(offscreenSurface))
+        return;
+
+    sendCompletedBufferDownloads();
+    collectCompletedRenderCaptures();
+    m_submissionContext->doneCurrent();
+}
+
+// Called by SubmitRenderView
+void Renderer::collectCompletedRenderCaptures()
+{
+    if (m_submissionContext->pendingFramebufferReadCount() == 0)
+        return;
+
+    std::vector<SubmissionContext::FramebufferReadback> completedReads = m_submissionContext->takeCompletedFramebufferReads();
+    m_pendingRenderCaptureReadCount.storeRelaxed(int(m_submissionContext->pendingFramebufferReadCount()));
+    if (completedReads.empty())
+        return;
+
+    QMutexLocker lock(&m_renderCaptureReadbacksMutex);
+    m_renderCaptureReadbacks.insert(m_renderCaptureReadbacks.end(),
+                                    std::make_move_iterator(completedReads.begin()),
+                                    std::make_move_iterator(completedReads.end()));
+}
+
+// Completes the captures whose pixels were lost with the graphics resources
+// with a null image or empty raw data, rather than leaving their replies
+// waiting forever
+void Renderer::failRenderCaptures(const std::vector<SubmissionContext::FramebufferReadback> &readbacks)
+{
+    for (const SubmissionContext::FramebufferReadback &readback : readbacks) {
+        Render::RenderCapture *renderCapture =
+                static_cast<Render::RenderCapture*>(m_nodesManager->frameGraphManager()->lookupNode(readback.renderCaptureId));
+        if (!renderCapture)
+            continue;
+
+        auto data = RenderCaptureDataPtr::create();
+        data->captureId = readback.request.captureId;
+        data->raw = readback.request.rawData;
+        renderCapture->addRenderCapture(data);
+
+        QMutexLocker sendLock(&m_pendingRenderCaptureSendRequestsMutex);
+        if (!Qt3DCore::contains(m_pendingRenderCaptureSendRequests, readback.renderCaptureId))
+            m_pendingRenderCaptureSendRequests.push_back(readback.renderCaptureId);
+    }
+}
+
+// Executed in a job
+// Converts the captured pixels to images away from the submission thread and
+// hands them to the RenderCapture nodes, they are sent to the frontend in jobsDone
+void Renderer::convertRenderCaptures()
+{
+    QMutexLocker lock(&m_renderCaptureReadbacksMutex);
+    const std::vector<SubmissionContext::FramebufferReadback> readbacks = Qt3DCore::moveAndClear(m_renderCaptureReadbacks);
+    lock.unlock();
+
+    for (const SubmissionContext::FramebufferReadback &readback : readbacks) {
+        Render::RenderCapture *renderCapture =
+                static_cast<Render::RenderCapture*>(m_nodesManager->frameGraphManager()->lookupNode(readback.renderCaptureId));
+        // RenderCapture could have been destroyed at this point
+        if (!renderCapture)
+            continue;
+
+        auto data = RenderCaptureDataPtr::create();
+        data->captureId = readback.request.captureId;
+        if (readback.request.rawData) {
+            data->raw = true;
+            data->rawData = readback.data;
+            data->rect = readback.rect;
+        } else {
+            data->image = readback.toImage();
+        }
+        renderCapture->addRenderCapture(data);
+
+        QMutexLocker sendLock(&m_pendingRenderCaptureSendRequestsMutex);
+        if (!Qt3DCore::contains(m_pendingRenderCaptureSendRequests, readback.renderCaptureId))
+            m_pendingRenderCaptureSendRequests.push_back(readback.renderCaptureId);
+    }
 }
 
 // Happens in RenderThread context when all RenderViewJobs are done
@@ -1591,25 +1775,30 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const std::vector
         // renderViewStateSet or m_defaultRenderStateSet)
         if (!renderView->renderCaptureNodeId().isNull()) {
             const QRenderCaptureRequest request = renderView->renderCaptureRequest();
+            const QNodeId renderCaptureId = renderView->renderCaptureNodeId();
             const QSize size = m_submissionContext->renderTargetSize(renderView->surfaceSize());
             QRect rect(QPoint(0, 0), size);
             if (!request.rect.isEmpty())
                 rect = rect.intersected(request.rect);
-            QImage image;
+            SubmissionContext::FramebufferReadback readback;
+            bool readAsynchronously = false;
             if (!rect.isEmpty()) {
                 // Bind fbo as read framebuffer
                 m_submissionContext->bindFramebuffer(m_submissionContext->activeFBO(), GraphicsHelperInterface::FBORead);
-                image = m_submissionContext->readFramebuffer(rect);
+                readAsynchronously = m_submissionContext->readFramebufferAsync(rect, renderCaptureId, request);
+                if (!readAsynchronously)
+                    readback = m_submissionContext->readFramebufferData(rect);
             } else {
                 qWarning() << "Requested capture rectangle is outside framebuffer";
             }
-            Render::RenderCapture *renderCapture =
-                    static_cast<Render::RenderCapture*>(m_nodesManager->frameGraphManager()->lookupNode(renderView->renderCaptureNodeId()));
-            renderCapture->addRenderCapture(request.captureId, image);
-            const QNodeId renderCaptureId = renderView->renderCaptureNodeId();
-            QMutexLocker lock(&m_pendingRenderCaptureSendRequestsMutex);
-            if (!Qt3DCore::contains(m_pendingRenderCaptureSendRequests, renderCaptureId))
-                m_pendingRenderCaptureSendRequests.push_back(renderView->renderCaptureNodeId());
+            // Asynchronous reads are collected once complete, the conversion
+            // of the pixels happens in a job either way
+            if (!readAsynchronously) {
+                readback.renderCaptureId = renderCaptureId;
+                readback.request = request;
+                QMutexLocker lock(&m_renderCaptureReadbacksMutex);
+                m_renderCaptureReadbacks.push_back(std::move(readback));
+            }
         }
 
         if (renderView->isDownloadBuffersEnable())
@@ -1661,6 +1850,10 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const std::vector
         // defaultRenderStateSet
         if (m_submissionContext->currentStateSet() != m_defaultRenderStateSet)
             m_submissionContext->setCurrentStateSet(m_defaultRenderStateSet);
+
+        // Send the content of the buffers whose GPU copy has completed
+        sendCompletedBufferDownloads();
+        collectCompletedRenderCaptures();
     }
 
     queueElapsed = timer.elapsed() - queueElapsed;
@@ -1677,8 +1870,8 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const std::vector
 
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
-    Q_UNUSED(node);
     m_dirtyBits.marked |= changes;
+    m_dirtyRenderCommandTracker.markDirty(changes, node);
 }
 
 Renderer::BackendNodeDirtySet Renderer::dirtyBits()
@@ -1698,10 +1891,38 @@ bool Renderer::shouldRender() const
 {
     // Only render if something changed during the last frame, or the last frame
     // was not rendered successfully (or render-on-demand is disabled)
+    // Readbacks in flight are otherwise polled by pollPendingReadbacks(), which
+    // needs a context of our own
     return ((m_settings && m_settings->renderPolicy() == QRenderSettings::Always)
             || m_dirtyBits.marked != 0
             || m_dirtyBits.remaining != 0
-            || !m_lastFrameCorrect.loadRelaxed());
+            || !m_lastFrameCorrect.loadRelaxed()
+            || (!m_ownedContext && hasPendingReadbacks()));
+}
+
+bool Renderer::hasPendingReadbacks() const
+{
+    return m_pendingBufferDownloadCount.loadRelaxed() != 0
+            || m_pendingRenderCaptureReadCount.loadRelaxed() != 0;
+}
+
+bool Renderer::needsNextFrame() const
+{
+    // A pipelined frame is only submitted by the next one, readbacks in flight
+    // are polled by the next one and captured renders and buffers are only
+    // sent to the frontend by the next one
+    if (shouldRender()
+            || !m_pendingFrame.renderViews.empty()
+            || hasPendingReadbacks()
+            || m_sendBufferCaptureJob->hasRequests())
+        return true;
+    {
+        QMutexLocker lock(&m_renderCaptureReadbacksMutex);
+        if (!m_renderCaptureReadbacks.empty())
+            return true;
+    }
+    QMutexLocker lock(&m_pendingRenderCaptureSendRequestsMutex);
+    return !m_pendingRenderCaptureSendRequests.empty();
 }
 
 void Renderer::skipNextFrame()
@@ -1760,9 +1981,14 @@ bool Renderer::processKeyEvent(QObject *object, QKeyEvent *event)
 // Jobs we may have to run even if no rendering will happen
 std::vector<QAspectJobPtr> Renderer::preRenderingJobs()
 {
+    std::vector<QAspectJobPtr> jobs;
     if (m_sendBufferCaptureJob->hasRequests())
-        return {m_sendBufferCaptureJob};
-    return {};
+        jobs.push_back(m_sendBufferCaptureJob);
+
+    QMutexLocker lock(&m_renderCaptureReadbacksMutex);
+    if (!m_renderCaptureReadbacks.empty())
+        jobs.push_back(m_renderCaptureConversionJob);
+    return jobs;
 }
 
 // Waits to be told to create jobs for the next frame
@@ -1790,6 +2016,18 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     renderBinJobs.push_back(m_cleanupJob);
 
     // Jobs to prepare GL Resource upload
+    // VAOs are only abandoned once their Geometry or Shader is gone. We keep
+    // looking for an extra frame as a VAO could still be under construction
+    // in the render thread the first time we look
+    const int geometryCount = m_nodesManager->geometryManager()->count();
+    if ((dirtyBitsForFrame & (AbstractRenderer::GeometryDirty|AbstractRenderer::ShadersDirty))
+            || geometryCount != m_lastGeometryCount
+            || m_glShadersAbandoned.fetchAndStoreRelaxed(0) != 0)
+        m_abandonedVaosLookupFrames = 2;
+    m_lastGeometryCount = geometryCount;
+    m_lookForAbandonedVaos = m_abandonedVaosLookupFrames > 0;
+    if (m_lookForAbandonedVaos)
+        --m_abandonedVaosLookupFrames;
     renderBinJobs.push_back(m_vaoGathererJob);
 
     if (dirtyBitsForFrame & AbstractRenderer::BuffersDirty)
@@ -1812,6 +2050,24 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty;
     const bool renderCommandsDirty = materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
 
+    // When all changes can be attributed to GeometryRenderers, Geometries or
+    // Materials, only the RenderCommands of the entities using them are rebuilt
+    // and patched into the cached ones
+    const bool partialCommandRebuild = renderCommandsDirty
+            && !frameGraphDirty && !shadersDirty && !computeableDirty
+            && m_dirtyRenderCommandTracker.canRebuildPartially();
+    if (partialCommandRebuild) {
+        m_cache.dirtyRenderableEntities = m_dirtyRenderCommandTracker.dirtyEntities(m_cache.renderableEntities);
+        m_cache.dirtyComputeEntities = m_dirtyRenderCommandTracker.dirtyEntities(m_cache.computeEntities);
+    } else {
+        m_cache.dirtyRenderableEntities.clear();
+        m_cache.dirtyComputeEntities.clear();
+    }
+    m_dirtyRenderCommandTracker.clear();
+    const bool fullCommandRebuild = renderCommandsDirty && !partialCommandRebuild;
+    const bool commandsToPatch = partialCommandRebuild
+            && !(m_cache.dirtyRenderableEntities.empty() && m_cache.dirtyComputeEntities.empty());
+
     if (renderableDirty)
         renderBinJobs.push_back(m_renderableEntityFilterJob);
 
@@ -1824,6 +2080,7 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     // Sync rendering is synchronous, queue should always be reset
     // when this is called
     Q_ASSERT(m_renderQueue.wasReset());
+    m_cache.pipelinedFrames = isFramePipelined();
     // Traverse the current framegraph. For each leaf node create a
     // RenderView and set its configuration then create a job to
     // populate the RenderView with a set of RenderCommands that get
@@ -1838,6 +2095,12 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             if (!Qt3DCore::contains(m_frameGraphLeaves, leafNode))
                 m_cache.leafNodeCache.remove(leafNode);
         }
+        for (auto it = m_renderViewBuilders.begin(); it != m_renderViewBuilders.end();) {
+            if (!Qt3DCore::contains(m_frameGraphLeaves, it.key()))
+                it = m_renderViewBuilders.erase(it);
+            else
+                ++it;
+        }
 
         // Handle single shot subtree enablers
         const auto subtreeEnablers = visitor.takeEnablersToDisable();
@@ -1860,22 +2123,33 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
     for (size_t i = 0; i < fgBranchCount; ++i) {
         FrameGraphNode *leaf = m_frameGraphLeaves[i];
-        RenderViewBuilder builder(leaf, int(i), this);
-        builder.setOptimalJobCount(leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount);
+        const int optimalJobCount = leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount;
+
+        // Builders and their job hierarchy are kept across frames, they are
+        // only recreated when the leaf moved in the FrameGraph or when the
+        // number of jobs to split the work into changed
+        QSharedPointer<RenderViewBuilder> &builder = m_renderViewBuilders[leaf];
+        if (builder.isNull()
+                || builder->renderViewIndex() != int(i)
+                || builder->optimalJobCount() != optimalJobCount) {
+            builder = QSharedPointer<RenderViewBuilder>::create(leaf, int(i), this);
+            builder->setOptimalJobCount(optimalJobCount);
+        }
 
         // If we have a new RV (wasn't in the cache before, then it contains no cached data)
         const bool isNewRV = !m_cache.leafNodeCache.contains(leaf);
-        builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
-        builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt || isNewRV);
-        builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
-        builder.setLightCacheNeedsToBeRebuilt(lightsDirty);
+        builder->setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
+        builder->setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt || isNewRV);
+        builder->setRenderCommandCacheNeedsToBeRebuilt(fullCommandRebuild || isNewRV);
+        builder->setRenderCommandCacheNeedsToBePatched(commandsToPatch && !isNewRV);
+        builder->setLightCacheNeedsToBeRebuilt(lightsDirty);
 
         // Insert leaf into cache
         if (isNewRV) {
             m_cache.leafNodeCache[leaf] = {};
         }
-        builder.prepareJobs();
-        Qt3DCore::moveAtEnd(renderBinJobs, builder.buildJobHierachy());
+        builder->prepareJobs();
+        Qt3DCore::moveAtEnd(renderBinJobs, builder->buildJobHierachy());
     }
 
     // Set target number of RenderViews
@@ -33,7 +33,9 @@
 #include <Qt3DRender/private/filterentitybycomponentjob_p.h>
 #include <Qt3DRender/private/filtercompatibletechniquejob_p.h>
 #include <Qt3DRender/private/renderqueue_p.h>
+#include <Qt3DRender/private/renderviewpool_p.h>
 #include <Qt3DRender/private/renderercache_p.h>
+#include <Qt3DRender/private/dirtyrendercommandtracker_p.h>
 #include <Qt3DRender/private/renderviewinitializerjob_p.h>
 #include <shaderparameterpack_p.h>
 #include <logging_p.h>
@@ -126,6 +128,7 @@ class RenderCommand;
 class GLShader;
 class GLResourceManagers;
 class RenderView;
+class RenderViewBuilder;
 
 class Q_AUTOTEST_EXPORT Renderer : public AbstractRenderer
 {
@@ -166,6 +169,7 @@ public:
 
     FrameGraphNode *frameGraphRoot() const override;
     RenderQueue<RenderView> *renderQueue() { return &m_renderQueue; }
+    RenderViewPool<RenderView> *renderViewPool() { return &m_renderViewPool; }
 
     void markDirty(BackendNodeDirtySet changes, BackendNode *node) override;
     BackendNodeDirtySet dirtyBits() override;
@@ -174,7 +178,9 @@ public:
     void clearDirtyBits(BackendNodeDirtySet changes) override;
 #endif
     bool shouldRender() const override;
+    bool needsNextFrame() const override;
     void skipNextFrame() override;
+    void jobsEnqueued() override;
     void jobsDone(Qt3DCore::QAspectManager *manager) override;
 
     bool processMouseEvent(QObject *object, QMouseEvent *event) override;
@@ -205,6 +211,10 @@ public:
     void cleanupTexture(Qt3DCore::QNodeId cleanedUpTextureId);
     void cleanupShader(const Shader *shader);
     void downloadGLBuffers();
+    void sendCompletedBufferDownloads();
+    void pollPendingReadbacks();
+    void collectCompletedRenderCaptures();
+    void failRenderCaptures(const std::vector<SubmissionContext::FramebufferReadback> &readbacks);
     void blitFramebuffer(Qt3DCore::QNodeId inputRenderTargetId,
                          Qt3DCore::QNodeId outputRenderTargetId,
                          QRect inputRect,
@@ -258,6 +268,20 @@ public:
 
     ViewSubmissionResultData submitRenderViews(const std::vector<RenderView *> &renderViews);
 
+    // RenderViews of a frame and how far their submission went
+    struct FrameSubmission
+    {
+        std::vector<RenderView *> renderViews;
+        bool preprocessingComplete = false;
+        bool beganDrawing = false;
+    };
+
+    void prepareFrameSubmission(FrameSubmission &frame);
+    void submitFrame(FrameSubmission &frame);
+    void submitPendingFrame();
+    bool isFramePipelined() const;
+    bool hasPendingReadbacks() const;
+
     RendererCache<RenderCommand> *cache() { return &m_cache; }
     void setScreen(QScreen *scr) override;
     QScreen *screen() const override;
@@ -288,6 +312,7 @@ private:
     QSurfaceFormat m_format;
 
     RenderQueue<RenderView> m_renderQueue;
+    RenderViewPool<RenderView> m_renderViewPool;
     QScopedPointer<VSyncFrameAdvanceService> m_vsyncFrameAdvanceService;
 
     QSemaphore m_submitRenderViewsSemaphore;
@@ -323,9 +348,14 @@ private:
     RenderableEntityFilterPtr m_renderableEntityFilterJob;
     ComputableEntityFilterPtr m_computableEntityFilterJob;
 
-    QMutex m_pendingRenderCaptureSendRequestsMutex;
+    mutable QMutex m_pendingRenderCaptureSendRequestsMutex;
     std::vector<Qt3DCore::QNodeId> m_pendingRenderCaptureSendRequests;
 
+    // Captures read back from the framebuffer, waiting to be converted
+    mutable QMutex m_renderCaptureReadbacksMutex;
+    std::vector<SubmissionContext::FramebufferReadback> m_renderCaptureReadbacks;
+    QAtomicInt m_pendingRenderCaptureReadCount;
+
     void performDraw(const RenderCommand *command);
     void performCompute(const RenderView *rv, RenderCommand *command);
     void createOrUpdateVAO(RenderCommand *command,
@@ -336,12 +366,13 @@ private:
     SynchronizerJobPtr m_vaoGathererJob;
     SynchronizerJobPtr m_textureGathererJob;
     SynchronizerPostFramePtr m_introspectShaderJob;
+    SynchronizerJobPtr m_renderCaptureConversionJob;
 
     void lookForAbandonedVaos();
     void lookForDirtyBuffers();
-    void lookForDownloadableBuffers();
     void lookForDirtyTextures();
     void reloadDirtyShaders();
+    void convertRenderCaptures();
     void sendShaderChangesToFrontend(Qt3DCore::QAspectManager *manager);
     void sendTextureChangesToFrontend(Qt3DCore::QAspectManager *manager);
     void sendSetFenceHandlesToFrontend(Qt3DCore::QAspectManager *manager);
@@ -349,9 +380,13 @@ private:
 
     QMutex m_abandonedVaosMutex;
     std::vector<HVao> m_abandonedVaos;
+    QAtomicInt m_glShadersAbandoned;
+    int m_lastGeometryCount = 0;
+    int m_abandonedVaosLookupFrames = 0;
+    bool m_lookForAbandonedVaos = false;
 
     std::vector<HBuffer> m_dirtyBuffers;
-    std::vector<Qt3DCore::QNodeId> m_downloadableBuffers;
+    QAtomicInt m_pendingBufferDownloadCount;
     std::vector<HShader> m_dirtyShaders;
     std::vector<HTexture> m_dirtyTextures;
     std::vector<QPair<Texture::TextureUpdateInfo, Qt3DCore::QNodeIdVector>> m_updatedTextureProperties;
@@ -377,15 +412,25 @@ private:
 
     QMetaObject::Connection m_contextConnection;
     RendererCache<RenderCommand> m_cache;
+    DirtyRenderCommandTracker m_dirtyRenderCommandTracker;
     bool m_shouldSwapBuffers;
     RenderDriver m_driver = RenderDriver::Qt3D;
 
     std::vector<FrameGraphNode *> m_frameGraphLeaves;
+    // Kept across frames alongside m_cache.leafNodeCache
+    QHash<FrameGraphNode *, QSharedPointer<RenderViewBuilder>> m_renderViewBuilders;
     QScreen *m_screen = nullptr;
     QSharedPointer<ResourceAccessor> m_scene2DResourceAccessor;
 
     Debug::ImGuiRenderer *m_imGuiRenderer;
     int m_jobsInLastFrame;
+
+    // Number of frames submitted while the next ones are being built, set
+    // through QT3D_FRAME_LATENCY. Only 0 and 1 are supported.
+    int m_frameLatency;
+    // Frame prepared by render() and submitted once the jobs of the next
+    // frame have been enqueued
+    FrameSubmission m_pendingFrame;
 };
 
 } // namespace OpenGL
@@ -78,6 +78,25 @@ Q_DECL_UNUSED const int qNodeIdTypeId = qMetaTypeId<Qt3DCore::QNodeId>();
 
 std::atomic_bool wasInitialized{};
 
+// Light sources of a RenderView ordered by distance to a position. Commands
+// are updated concurrently so each thread keeps its own, and consecutive
+// commands at the same position (e.g. several passes of an entity) reuse it
+struct SortedLightSources
+{
+    Vector3D center;
+    std::vector<std::pair<float, const LightSource *>> sources;
+    size_t sortedCount = 0;
+    bool valid = false;
+};
+
+thread_local SortedLightSources sortedLightSources;
+
+bool isCloserLightSource(const std::pair<float, const LightSource *> &a,
+                         const std::pair<float, const LightSource *> &b)
+{
+    return a.first < b.first;
+}
+
 } // anonymous namespace
 
 RenderView::StandardUniformsNameToTypeHash RenderView::ms_standardUniformSetters;
@@ -446,6 +465,61 @@ RenderView::~RenderView()
 {
 }
 
+void RenderView::reset()
+{
+    m_renderCommandDataView.reset();
+
+    m_surfaceSize = QSize();
+    m_devicePixelRatio = 1.0f;
+    m_viewport = QRectF(0.0f, 0.0f, 1.0f, 1.0f);
+    m_gamma = 2.2f;
+
+    m_renderCaptureNodeId = Qt3DCore::QNodeId();
+    m_renderCaptureRequest = QRenderCaptureRequest();
+    m_isDownloadBuffersEnable = false;
+
+    m_hasBlitFramebufferInfo = false;
+    m_blitFrameBufferInfo = BlitFramebufferInfo();
+
+    m_surface = nullptr;
+    m_renderTarget = Qt3DCore::QNodeId();
+    m_attachmentPack = AttachmentPack();
+    m_clearBuffer = QClearBuffers::None;
+    m_clearDepthValue = 1.0f;
+    m_clearStencilValue = 0;
+    m_globalClearColorBuffer = ClearBufferInfo();
+    m_specificClearColorBuffers.clear();
+
+    // Keep the RenderStateSet aside, a null one meaning no StateSet was found
+    if (m_stateSet) {
+        m_stateSet->clear();
+        m_recycledStateSet.reset(m_stateSet.take());
+    }
+    m_renderCameraLens = nullptr;
+    m_renderCameraNode = nullptr;
+    m_techniqueFilter = nullptr;
+    m_passFilter = nullptr;
+    m_noDraw = false;
+    m_compute = false;
+    m_frustumCulling = false;
+    m_showDebugOverlay = false;
+    m_workGroups[0] = m_workGroups[1] = m_workGroups[2] = 1;
+    m_memoryBarrier = QMemoryBarrier::None;
+    m_insertFenceIds.clear();
+    m_waitFences.clear();
+    m_sortingTypes.clear();
+    m_proximityFilterIds.clear();
+    m_layerFilterIds.clear();
+    m_viewMatrix = Matrix4x4();
+    m_viewProjectionMatrix = Matrix4x4();
+    m_eyePos = Vector3D();
+    m_eyeViewDir = Vector3D();
+
+    m_parameters.clear();
+    m_lightSources.clear();
+    m_environmentLight = nullptr;
+}
+
 namespace {
 
 template<int SortType>
@@ -803,7 +877,7 @@ void RenderView::setRenderer(Renderer *renderer)
 RenderStateSet *RenderView::getOrCreateStateSet()
 {
     if (!m_stateSet)
-        m_stateSet.reset(new RenderStateSet());
+        m_stateSet.reset(m_recycledStateSet ? m_recycledStateSet.take() : new RenderStateSet());
     return m_stateSet.data();
 }
 
@@ -1045,6 +1119,9 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const Entity **en
 
 void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subView)
 {
+    // Light sources sorted for a previous RenderView or frame may be stale
+    sortedLightSources.valid = false;
+
     subView.forEach([this] (const Entity *entity,
                             const RenderPassParameterData &passData,
                             RenderCommand &command) {
@@ -1326,24 +1403,34 @@ void RenderView::updateLightUniforms(RenderCommand *command, const Entity *entit
         // Pick which lights to take in to account.
         // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
         // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the current command
-        std::vector<LightSource> lightSources = m_lightSources;
-
-        if (lightSources.size() > 1) {
-            const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-            std::sort(lightSources.begin(), lightSources.end(),
-                      [&] (const LightSource &a, const LightSource &b) {
-                const float distA = entityCenter.distanceToPoint(a.entity->worldBoundingVolume()->center());
-                const float distB = entityCenter.distanceToPoint(b.entity->worldBoundingVolume()->center());
-                return distA < distB;
-            });
-            m_lightSources = {lightSources.begin(), lightSources.begin() + std::min(lightSources.size(), size_t(MAX_LIGHTS)) };
+        SortedLightSources &sorted = sortedLightSources;
+        const Vector3D entityCenter = entity->worldBoundingVolume()->center();
+
+        if (!sorted.valid || !(sorted.center == entityCenter)) {
+            sorted.sources.clear();
+            for (const LightSource &lightSource : m_lightSources)
+                sorted.sources.emplace_back(entityCenter.distanceToPoint(lightSource.entity->worldBoundingVolume()->center()),
+                                            &lightSource);
+            // Only the closest lights are used, there's no need to order the others
+            sorted.sortedCount = std::min(sorted.sources.size(), size_t(MAX_LIGHTS));
+            std::partial_sort(sorted.sources.begin(),
+                              sorted.sources.begin() + sorted.sortedCount,
+                              sorted.sources.end(),
+                              isCloserLightSource);
+            sorted.center = entityCenter;
+            sorted.valid = true;
         }
 
         int lightIdx = 0;
-        for (const LightSource &lightSource : m_lightSources) {
+        for (size_t i = 0, m = sorted.sources.size(); i < m; ++i) {
             if (lightIdx == MAX_LIGHTS)
                 break;
+            // Disabled lights left room for lights further away
+            if (i == sorted.sortedCount) {
+                std::sort(sorted.sources.begin() + i, sorted.sources.end(), isCloserLightSource);
+                sorted.sortedCount = m;
+            }
+            const LightSource &lightSource = *sorted.sources[i].second;
             const Entity *lightEntity = lightSource.entity;
             const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
             const Vector3D worldPos = lightWorldTransform.map(Vector3D(0.0f, 0.0f, 0.0f));
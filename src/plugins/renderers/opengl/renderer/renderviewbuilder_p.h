@@ -69,7 +69,7 @@ public:
     SynchronizerJobPtr syncMaterialGathererJob() const;
 
     void prepareJobs();
-    std::vector<Qt3DCore::QAspectJobPtr> buildJobHierachy() const;
+    std::vector<Qt3DCore::QAspectJobPtr> buildJobHierachy();
 
     Renderer *renderer() const;
     int renderViewIndex() const;
@@ -80,6 +80,8 @@ public:
     bool materialGathererCacheNeedsToBeRebuilt() const;
     void setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool renderCommandCacheNeedsToBeRebuilt() const;
+    void setRenderCommandCacheNeedsToBePatched(bool needsToBePatched);
+    bool renderCommandCacheNeedsToBePatched() const;
     void setLightCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool lightCacheNeedsToBeRebuilt() const;
 
@@ -91,6 +93,9 @@ private:
     const int m_renderViewIndex;
     Renderer *m_renderer;
     RebuildFlagSet m_rebuildFlags;
+    // Parts of the job hierarchy whose dependencies have already been set
+    RebuildFlagSet m_wiredJobs;
+    bool m_jobHierarchyWired = false;
 
     RenderViewInitializerJobPtr m_renderViewJob;
     FilterLayerEntityJobPtr m_filterEntityByLayerJob;
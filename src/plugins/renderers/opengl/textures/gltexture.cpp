@@ -20,6 +20,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/qabstracttexture_p.h>
 #include <Qt3DRender/private/qtextureimagedata_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 #include <renderbuffer_p.h>
 #include <Qt3DCore/private/vector_helper_p.h>
 
@@ -80,6 +81,8 @@ GLTexture::GLTexture()
     : m_dirtyFlags(None)
     , m_gl(nullptr)
     , m_renderBuffer(nullptr)
+    , m_textureDataManager(nullptr)
+    , m_textureImageDataManager(nullptr)
     , m_dataFunctor()
     , m_pendingDataFunctor(nullptr)
     , m_sharedTextureId(-1)
@@ -100,6 +103,11 @@ void GLTexture::destroy()
     delete m_renderBuffer;
     m_renderBuffer = nullptr;
 
+    // Release our references on the generated data
+    if (m_textureDataManager && m_dataFunctor)
+        m_textureDataManager->releaseData(m_dataFunctor, this);
+    releaseImageData(m_images, {});
+
     m_dirtyFlags = None;
     m_sharedTextureId = -1;
     m_externalRendering = false;
@@ -115,9 +123,67 @@ void GLTexture::destroy()
     m_pendingTextureDataUpdates.clear();
 }
 
+bool GLTexture::isTextureDataReady() const
+{
+    return !m_textureDataManager || m_textureDataManager->isDataReady(m_dataFunctor);
+}
+
+bool GLTexture::isImageDataReady() const
+{
+    if (!m_textureImageDataManager)
+        return true;
+    for (const Image &img : m_images) {
+        if (!img.generator.isNull() && !m_textureImageDataManager->isDataReady(img.generator))
+            return false;
+    }
+    return true;
+}
+
+QTextureDataPtr GLTexture::generateTextureData()
+{
+    if (m_textureDataManager) {
+        const QTextureDataPtr data = m_textureDataManager->getData(m_dataFunctor);
+        m_textureDataManager->markDataTaken(m_dataFunctor, this);
+        return data;
+    }
+    return m_dataFunctor->operator()();
+}
+
+QTextureImageDataPtr GLTexture::generateImageData(const QTextureImageDataGeneratorPtr &generator) const
+{
+    if (m_textureImageDataManager)
+        return m_textureImageDataManager->getData(generator);
+    return generator->operator()();
+}
+
+void GLTexture::requestImageData(const std::vector<Image> &images)
+{
+    if (!m_textureImageDataManager)
+        return;
+    for (const Image &img : images) {
+        if (!img.generator.isNull())
+            m_textureImageDataManager->requestData(img.generator, this);
+    }
+}
+
+void GLTexture::releaseImageData(const std::vector<Image> &images, const std::vector<Image> &imagesToKeep)
+{
+    if (!m_textureImageDataManager)
+        return;
+    for (const Image &img : images) {
+        if (img.generator.isNull())
+            continue;
+        const bool keep = std::any_of(imagesToKeep.begin(), imagesToKeep.end(), [&img] (const Image &other) {
+            return !other.generator.isNull() && *other.generator == *img.generator;
+        });
+        if (!keep)
+            m_textureImageDataManager->releaseData(img.generator, this);
+    }
+}
+
 bool GLTexture::loadTextureDataFromGenerator()
 {
-    m_textureData = m_dataFunctor->operator()();
+    m_textureData = generateTextureData();
     // if there is a texture generator, most properties will be defined by it
     if (m_textureData) {
         const QAbstractTexture::Target target = m_textureData->target();
@@ -162,7 +228,7 @@ void GLTexture::loadTextureDataFromImages()
 {
     int maxMipLevel = 0;
     for (const Image &img : qAsConst(m_images)) {
-        const QTextureImageDataPtr imgData = img.generator->operator()();
+        const QTextureImageDataPtr imgData = generateImageData(img.generator);
         // imgData may be null in the following cases:
         // - Texture is created with TextureImages which have yet to be
         // loaded (skybox where you don't yet know the path, source set by
@@ -191,6 +257,14 @@ void GLTexture::loadTextureDataFromImages()
         }
     }
 
+    // We keep the data until it is uploaded, the manager can drop its copy
+    if (m_textureImageDataManager) {
+        for (const Image &img : qAsConst(m_images)) {
+            if (!img.generator.isNull())
+                m_textureImageDataManager->markDataTaken(img.generator, this);
+        }
+    }
+
     // make sure the number of mip levels is set when there is no texture data generator
     if (!m_dataFunctor) {
         m_properties.mipLevels = maxMipLevel + 1;
@@ -210,6 +284,12 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
     if (!hasSharedTextureId) {
         // If dataFunctor exists and we have no data and it hasn´t run yet
         if (m_dataFunctor && !m_textureData && m_dataFunctor.get() != m_pendingDataFunctor ) {
+            // Wait for the generator to have been executed on a worker thread
+            if (!isTextureDataReady()) {
+                textureInfo.properties.status = QAbstractTexture::Loading;
+                return textureInfo;
+            }
+
             const bool successfullyLoadedTextureData = loadTextureDataFromGenerator();
             // If successful, m_textureData has content
             if (successfullyLoadedTextureData) {
@@ -228,6 +308,13 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
         // If images have changed, clear previous images data
         // and regenerate m_imageData for the images
         if (testDirtyFlag(TextureImageData)) {
+            // Wait for all the images to have been generated, we don't want
+            // to upload a partially filled texture
+            if (!isImageDataReady()) {
+                textureInfo.properties.status = QAbstractTexture::Loading;
+                return textureInfo;
+            }
+
             m_imageData.clear();
             loadTextureDataFromImages();
             // Mark for upload if we actually have something to upload
@@ -316,7 +403,10 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
 RenderBuffer *GLTexture::getOrCreateRenderBuffer()
 {
     if (m_dataFunctor && !m_textureData) {
-        m_textureData = m_dataFunctor->operator()();
+        if (!isTextureDataReady())
+            return nullptr;
+
+        m_textureData = generateTextureData();
         if (m_textureData) {
             if (m_properties.target != QAbstractTexture::TargetAutomatic)
                 qWarning() << "[Qt3DRender::GLTexture] [renderbuffer] When a texture provides a generator, it's target is expected to be TargetAutomatic";
@@ -356,6 +446,13 @@ void GLTexture::cleanup()
     destroy();
 }
 
+void GLTexture::setTextureDataManagers(TextureDataManager *textureDataManager,
+                                       TextureImageDataManager *textureImageDataManager)
+{
+    m_textureDataManager = textureDataManager;
+    m_textureImageDataManager = textureImageDataManager;
+}
+
 void GLTexture::setParameters(const TextureParameters &params)
 {
     if (m_parameters != params) {
@@ -378,6 +475,10 @@ void GLTexture::setImages(const std::vector<Image> &images)
     const bool same = (images == m_images);
 
     if (!same) {
+        // Request new data before releasing the previous one so that
+        // data shared between the old and new images isn't regenerated
+        requestImageData(images);
+        releaseImageData(m_images, images);
         m_images = images;
         requestImageUpload();
     }
@@ -385,6 +486,12 @@ void GLTexture::setImages(const std::vector<Image> &images)
 
 void GLTexture::setGenerator(const QTextureGeneratorPtr &generator)
 {
+    if (m_textureDataManager) {
+        if (generator)
+            m_textureDataManager->requestData(generator, this);
+        if (m_dataFunctor && !(generator && *generator == *m_dataFunctor))
+            m_textureDataManager->releaseData(m_dataFunctor, this);
+    }
     m_textureData.reset();
     m_dataFunctor = generator;
     m_pendingDataFunctor = nullptr;
@@ -165,6 +165,11 @@ public:
         return m_wasTextureRecreated;
     }
 
+    // When set, generators are executed ahead of time by the LoadTextureDataJob
+    // and we only pick up their results. Otherwise they are executed in place.
+    void setTextureDataManagers(TextureDataManager *textureDataManager,
+                                TextureImageDataManager *textureImageDataManager);
+
     void setParameters(const TextureParameters &params);
     void setProperties(const TextureProperties &props);
     void setImages(const std::vector<Image> &images);
@@ -197,6 +202,12 @@ private:
     }
 
     QOpenGLTexture *buildGLTexture();
+    bool isTextureDataReady() const;
+    bool isImageDataReady() const;
+    QTextureDataPtr generateTextureData();
+    QTextureImageDataPtr generateImageData(const QTextureImageDataGeneratorPtr &generator) const;
+    void requestImageData(const std::vector<Image> &images);
+    void releaseImageData(const std::vector<Image> &images, const std::vector<Image> &imagesToKeep);
     bool loadTextureDataFromGenerator();
     void loadTextureDataFromImages();
     void uploadGLTextureData();
@@ -208,6 +219,8 @@ private:
     QMutex m_externalRenderingMutex;
     QOpenGLTexture *m_gl;
     RenderBuffer *m_renderBuffer;
+    TextureDataManager *m_textureDataManager;
+    TextureImageDataManager *m_textureImageDataManager;
 
     // target which is actually used for GL texture
     TextureProperties m_properties;
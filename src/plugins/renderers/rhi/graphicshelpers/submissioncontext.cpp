@@ -42,6 +42,14 @@
 #include <QSurface>
 #include <QWindow>
 #include <QtShaderTools/private/qshaderbaker_p.h>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 #ifdef Q_OS_WIN
 #include <QtGui/private/qrhid3d11_p.h>
@@ -462,6 +470,26 @@ static QShader::Stage rhiShaderStage(QShaderProgram::ShaderType type) noexcept
     }
 }
 
+// Baked shaders and pipeline cache data are stored next to the .qt3d files
+// generated by ShaderBuilder and honor the same environment variables
+QDir writableCacheDirectory()
+{
+    const QByteArray userProvidedPath = qgetenv("QT3D_WRITABLE_CACHE_PATH");
+    return QDir(userProvidedPath.isEmpty()
+                ? QStandardPaths::writableLocation(QStandardPaths::TempLocation)
+                : QString::fromUtf8(userProvidedPath));
+}
+
+bool isCacheDisabled()
+{
+    return qEnvironmentVariableIsSet("QT3D_DISABLE_SHADER_CACHE");
+}
+
+bool isCacheRebuildForced()
+{
+    return qEnvironmentVariableIsSet("QT3D_REBUILD_SHADER_CACHE");
+}
+
 } // anonymous
 
 SubmissionContext::SubmissionContext()
@@ -543,6 +571,8 @@ void SubmissionContext::initialize()
     }
 
     QRhi::Flags rhiFlags = QRhi::EnableDebugMarkers;
+    if (!isCacheDisabled())
+        rhiFlags |= QRhi::EnablePipelineCacheDataSave;
 
 #if QT_CONFIG(qt3d_vulkan) && QT_CONFIG(vulkan)
     if (requestedApi == Qt3DRender::API::Vulkan) {
@@ -594,6 +624,45 @@ void SubmissionContext::initialize()
     }
 
     Q_ASSERT(m_rhi != nullptr);
+
+    loadPipelineCache();
+}
+
+QString SubmissionContext::pipelineCacheFilePath() const
+{
+    return writableCacheDirectory().absoluteFilePath(QStringLiteral("qt3d_rhi_pipelines_%1.bin").arg(int(m_rhi->backend())));
+}
+
+// Seeds the pipeline cache of the QRhi we own with the data saved by a
+// previous run, so that creating pipelines doesn't require compiling them
+// again. QRhi ignores data saved by another driver or device.
+void SubmissionContext::loadPipelineCache()
+{
+    if (m_rhi == nullptr || isCacheDisabled() || isCacheRebuildForced())
+        return;
+
+    QFile file(pipelineCacheFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QByteArray data = file.readAll();
+    if (!data.isEmpty()) {
+        m_rhi->setPipelineCacheData(data);
+        qCDebug(Backend) << "Loaded pipeline cache data from" << file.fileName();
+    }
+}
+
+void SubmissionContext::savePipelineCache()
+{
+    if (m_rhi == nullptr || isCacheDisabled())
+        return;
+
+    const QByteArray data = m_rhi->pipelineCacheData();
+    if (data.isEmpty())
+        return;
+
+    QSaveFile file(pipelineCacheFilePath());
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+        qCWarning(Backend) << "Unable to save pipeline cache data to" << file.fileName();
 }
 
 void SubmissionContext::setDrivenExternally(bool drivenExternally)
@@ -821,8 +890,10 @@ void SubmissionContext::releaseResources()
         }
 
         // Only destroy RHI context if we created it
-        if (m_ownsRhiCtx)
+        if (m_ownsRhiCtx) {
+            savePipelineCache();
             delete m_rhi;
+        }
         m_rhi = nullptr;
 
 #ifndef QT_NO_OPENGL
@@ -1442,117 +1513,266 @@ int glslVersionForFormat(const QSurfaceFormat &format) noexcept
         return *it;
     }
 }
+
+// Bump whenever the content of the cache key or of the cached files changes
+const char bakedShaderCacheVersion[] = "qt3d-rhi-qsb-1";
+
+struct StageBakeRequest
+{
+    QShader::Stage stage = QShader::VertexStage;
+    QByteArray source;
+    QShader shader;
+    QString errorMessage;
+};
+
+QByteArray cacheKeyForStage(const StageBakeRequest &request,
+                            const QList<QShaderBaker::GeneratedShader> &generatedShaders)
+{
+    // The key covers everything that affects the baker output: the Qt version
+    // (QShaderBaker and QShader serialization), the stage, the source and the
+    // list of shader languages and versions we generate
+    QByteArray header = QByteArray(bakedShaderCacheVersion) + ';' + qVersion() + ';'
+            + QByteArray::number(request.stage) + ';';
+    for (const QShaderBaker::GeneratedShader &generatedShader : generatedShaders) {
+        header += QByteArray::number(generatedShader.first) + ':'
+                + QByteArray::number(generatedShader.second.version()) + ':'
+                + QByteArray::number(generatedShader.second.flags().toInt()) + ';';
+    }
+
+    QCryptographicHash hashBuilder(QCryptographicHash::Sha1);
+    hashBuilder.addData(header);
+    hashBuilder.addData(request.source);
+    return hashBuilder.result().toHex();
 }
 
-// Called by GL Command Thread
-SubmissionContext::ShaderCreationInfo SubmissionContext::createShaderProgram(RHIShader *shader)
+void bakeStage(StageBakeRequest &request,
+               const QList<QShaderBaker::GeneratedShader> &generatedShaders,
+               const QDir &cacheDir, bool useCache, bool forceRebuild)
 {
-    // Compile shaders
-    const auto &shaderCode = shader->shaderCode();
+    // Can be called from several threads at once, each call using its own baker
+    QString cachedShaderPath;
+    if (useCache || forceRebuild) {
+        cachedShaderPath = cacheDir.absoluteFilePath(QString::fromLatin1(cacheKeyForStage(request, generatedShaders))
+                                                     + QLatin1String(".qsb"));
+
+        if (useCache) {
+            QFile cachedShaderFile(cachedShaderPath);
+            if (cachedShaderFile.exists() && cachedShaderFile.open(QFile::ReadOnly)) {
+                request.shader = QShader::fromSerialized(cachedShaderFile.readAll());
+                if (request.shader.isValid()) {
+                    qCDebug(ShaderCache) << "Using cached baked shader file" << cachedShaderPath;
+                    return;
+                }
+                qCWarning(ShaderCache) << "Discarding invalid cached baked shader file" << cachedShaderPath;
+            }
+        }
+    }
+
     QShaderBaker b;
+    b.setGeneratedShaders(generatedShaders);
+    b.setGeneratedShaderVariants(QList<QShader::Variant>(generatedShaders.size()));
+    b.setSourceString(request.source, request.stage);
+    request.shader = b.bake();
+    request.errorMessage = b.errorMessage();
+
+    if (cachedShaderPath.isEmpty() || !request.errorMessage.isEmpty() || !request.shader.isValid())
+        return;
+
+    // QSaveFile so that concurrent processes never see a partially written file
+    QSaveFile cachedShaderFile(cachedShaderPath);
+    if (cachedShaderFile.open(QIODevice::WriteOnly)
+            && cachedShaderFile.write(request.shader.serialized()) >= 0
+            && cachedShaderFile.commit()) {
+        qCDebug(ShaderCache) << "Saving cached baked shader file" << cachedShaderPath;
+    } else {
+        qCWarning(ShaderCache) << "Unable to write cached baked shader file" << cachedShaderPath;
+    }
+}
+
+QList<QShaderBaker::GeneratedShader> generatedShaderTargets(QRhi *rhi, const QSurfaceFormat &format)
+{
     QList<QShaderBaker::GeneratedShader> generatedShaders;
 
 #if QT_FEATURE_vulkan
-    if (m_rhi->backend() == QRhi::Vulkan)
+    if (rhi->backend() == QRhi::Vulkan)
         generatedShaders.emplace_back(QShader::SpirvShader, 100);
 #endif
 
 #ifndef QT_NO_OPENGL
-    if (m_rhi->backend() == QRhi::OpenGLES2)
-        generatedShaders.emplace_back(QShader::GlslShader, glslVersionForFormat(format()));
+    if (rhi->backend() == QRhi::OpenGLES2)
+        generatedShaders.emplace_back(QShader::GlslShader, glslVersionForFormat(format));
 #endif
 
 #ifdef Q_OS_WIN
-    if (m_rhi->backend() == QRhi::D3D11)
+    if (rhi->backend() == QRhi::D3D11)
         generatedShaders.emplace_back(QShader::HlslShader, QShaderVersion(50));
 #endif
 
 #if defined(Q_OS_MACOS) || defined(Q_OS_IOS)
-    if (m_rhi->backend() == QRhi::Metal)
+    if (rhi->backend() == QRhi::Metal)
         generatedShaders.emplace_back(QShader::MslShader, QShaderVersion(12));
 #endif
 
-    QList<QShader::Variant> generatedShaderVariants(generatedShaders.size());
+    return generatedShaders;
+}
 
-    b.setGeneratedShaders(generatedShaders);
-    b.setGeneratedShaderVariants(generatedShaderVariants);
-
-    // TODO handle caching as QShader does not have a built-in mechanism for that
-    QString logs;
-    bool success = true;
-    for (size_t i = QShaderProgram::Vertex; i <= QShaderProgram::Compute; ++i) {
-        const QShaderProgram::ShaderType type = static_cast<QShaderProgram::ShaderType>(i);
-        if (!shaderCode.at(i).isEmpty()) {
+} // anonymous
+
+// Called by GL Command Thread
+SubmissionContext::ShaderCreationInfo SubmissionContext::createShaderProgram(RHIShader *shader)
+{
+    return createShaderPrograms({ shader }).front();
+}
+
+// Called by GL Command Thread
+std::vector<SubmissionContext::ShaderCreationInfo>
+SubmissionContext::createShaderPrograms(const std::vector<RHIShader *> &shaders)
+{
+    const QList<QShaderBaker::GeneratedShader> generatedShaders = generatedShaderTargets(m_rhi, format());
+
+    const bool forceRebuild = isCacheRebuildForced();
+    const bool useCache = !isCacheDisabled() && !forceRebuild;
+    const QDir cacheDir = writableCacheDirectory();
+
+    // Gather every stage of every shader so that they can all be baked at once
+    std::vector<StageBakeRequest> requests;
+    std::vector<std::pair<size_t, size_t>> requestRanges;
+    requestRanges.reserve(shaders.size());
+    for (RHIShader *shader : shaders) {
+        const auto &shaderCode = shader->shaderCode();
+        const size_t firstRequest = requests.size();
+        for (size_t i = QShaderProgram::Vertex; i <= QShaderProgram::Compute; ++i) {
+            const QShaderProgram::ShaderType type = static_cast<QShaderProgram::ShaderType>(i);
+            if (!shaderCode.at(i).isEmpty())
+                requests.push_back({ rhiShaderStage(type), shaderCode.at(i), {}, {} });
+        }
+        requestRanges.emplace_back(firstRequest, requests.size());
+    }
+
+    auto bakeRequest = [&] (StageBakeRequest &request) {
+        bakeStage(request, generatedShaders, cacheDir, useCache, forceRebuild);
+    };
+
+#if QT_CONFIG(concurrent)
+    if (requests.size() > 1 && QAspectJobManager::idealThreadCount() > 1)
+        QtConcurrent::blockingMap(requests, bakeRequest);
+    else
+#endif
+        std::for_each(requests.begin(), requests.end(), bakeRequest);
+
+    std::vector<ShaderCreationInfo> creationInfos;
+    creationInfos.reserve(shaders.size());
+    for (size_t s = 0, m = shaders.size(); s < m; ++s) {
+        RHIShader *shader = shaders[s];
+        QString logs;
+        bool success = true;
+        for (size_t r = requestRanges[s].first; r < requestRanges[s].second; ++r) {
+            StageBakeRequest &request = requests[r];
             // Note: logs only return the error but not all the shader code
             // we could append it
-
-            const auto rhiStage = rhiShaderStage(type);
-            b.setSourceString(shaderCode.at(i), rhiStage);
-            QShader bakedShader = b.bake();
-            if (b.errorMessage() != QString() || !bakedShader.isValid()) {
-                qDebug() << "Shader Error: " << b.errorMessage() << shaderCode.at(i).data()
-                         << rhiStage;
-                logs += b.errorMessage();
+            if (!request.errorMessage.isEmpty() || !request.shader.isValid()) {
+                qDebug() << "Shader Error: " << request.errorMessage << request.source.data()
+                         << request.stage;
+                logs += request.errorMessage;
                 success = false;
             }
-            shader->m_stages[rhiStage] = std::move(bakedShader);
+            shader->m_stages[request.stage] = std::move(request.shader);
         }
-    }
 
-    // Perform shader introspection
-    if (success)
-        shader->introspect();
+        // Perform shader introspection
+        if (success)
+            shader->introspect();
 
-    return { success, logs };
+        creationInfos.push_back({ success, logs });
+    }
+
+    return creationInfos;
 }
 
 // Called by Renderer::updateResources
 void SubmissionContext::loadShader(Shader *shaderNode, ShaderManager *shaderManager,
                                    RHIShaderManager *rhiShaderManager)
 {
-    const Qt3DCore::QNodeId shaderId = shaderNode->peerId();
-    RHIShader *rhiShader = rhiShaderManager->lookupResource(shaderId);
+    loadShaders({ shaderNode }, shaderManager, rhiShaderManager);
+}
 
-    // We already have a shader associated with the node
-    if (rhiShader != nullptr) {
-        // We need to abandon it
-        rhiShaderManager->abandon(rhiShader, shaderNode);
+// Called by Renderer::updateResources
+void SubmissionContext::loadShaders(const std::vector<Shader *> &shaderNodes,
+                                    ShaderManager *shaderManager,
+                                    RHIShaderManager *rhiShaderManager)
+{
+    std::vector<Shader *> shaderNodesToCompile;
+    std::vector<RHIShader *> rhiShadersToCompile;
+    std::vector<Shader *> sharingShaderNodes;
+
+    for (Shader *shaderNode : shaderNodes) {
+        const Qt3DCore::QNodeId shaderId = shaderNode->peerId();
+        RHIShader *rhiShader = rhiShaderManager->lookupResource(shaderId);
+
+        // We already have a shader associated with the node
+        if (rhiShader != nullptr) {
+            // We need to abandon it
+            rhiShaderManager->abandon(rhiShader, shaderNode);
+        }
+
+        // We create or adopt an already created rhiShader
+        rhiShader = rhiShaderManager->createOrAdoptExisting(shaderNode);
+
+        const std::vector<Qt3DCore::QNodeId> &sharedShaderIds =
+                rhiShaderManager->shaderIdsForProgram(rhiShader);
+        if (sharedShaderIds.size() == 1) {
+            // Shader in the cache hasn't been loaded yet
+            // We want a copy of the QByteArray as preprocessRHIShader will
+            // modify them
+            std::vector<QByteArray> shaderCodes = shaderNode->shaderCode();
+            preprocessRHIShader(shaderCodes);
+            rhiShader->setShaderCode(shaderCodes);
+            shaderNodesToCompile.push_back(shaderNode);
+            rhiShadersToCompile.push_back(rhiShader);
+        } else {
+            // The shader we share the program with might only be compiled below
+            sharingShaderNodes.push_back(shaderNode);
+        }
     }
 
-    // We create or adopt an already created rhiShader
-    rhiShader = rhiShaderManager->createOrAdoptExisting(shaderNode);
-
-    const std::vector<Qt3DCore::QNodeId> &sharedShaderIds =
-            rhiShaderManager->shaderIdsForProgram(rhiShader);
-    if (sharedShaderIds.size() == 1) {
-        // Shader in the cache hasn't been loaded yet
-        // We want a copy of the QByteArray as preprocessRHIShader will
-        // modify them
-        std::vector<QByteArray> shaderCodes = shaderNode->shaderCode();
-        preprocessRHIShader(shaderCodes);
-        rhiShader->setShaderCode(shaderCodes);
-
-        const ShaderCreationInfo loadResult = createShaderProgram(rhiShader);
-        shaderNode->setStatus(loadResult.linkSucceeded ? QShaderProgram::Ready
-                                                       : QShaderProgram::Error);
-        shaderNode->setLog(loadResult.logs);
-        // Loaded in the sense we tried to load it (and maybe it failed)
-        rhiShader->setLoaded(true);
-    } else {
-        // Find an already loaded shader that shares the same QShaderProgram
+    // Compile all the new programs at once, so that their stages get baked in parallel
+    if (!rhiShadersToCompile.empty()) {
+        const std::vector<ShaderCreationInfo> loadResults = createShaderPrograms(rhiShadersToCompile);
+        for (size_t i = 0, m = shaderNodesToCompile.size(); i < m; ++i) {
+            Shader *shaderNode = shaderNodesToCompile[i];
+            shaderNode->setStatus(loadResults[i].linkSucceeded ? QShaderProgram::Ready
+                                                               : QShaderProgram::Error);
+            shaderNode->setLog(loadResults[i].logs);
+            // Loaded in the sense we tried to load it (and maybe it failed)
+            rhiShadersToCompile[i]->setLoaded(true);
+        }
+    }
+
+    for (Shader *shaderNode : sharingShaderNodes) {
+        RHIShader *rhiShader = rhiShaderManager->lookupResource(shaderNode->peerId());
+        const std::vector<Qt3DCore::QNodeId> &sharedShaderIds =
+                rhiShaderManager->shaderIdsForProgram(rhiShader);
+        // Find an already loaded shader that shares the same QShaderProgram,
+        // skipping the ones that are only being initialized in this batch
         for (const Qt3DCore::QNodeId &sharedShaderId : sharedShaderIds) {
-            if (sharedShaderId != shaderNode->peerId()) {
-                Shader *refShader = shaderManager->lookupResource(sharedShaderId);
-                // We only introspect once per actual OpenGL shader program
-                // rather than once per ShaderNode.
-                shaderNode->initializeFromReference(*refShader);
-                break;
-            }
+            if (sharedShaderId == shaderNode->peerId())
+                continue;
+            Shader *refShader = shaderManager->lookupResource(sharedShaderId);
+            if (refShader == nullptr
+                    || std::find(sharingShaderNodes.begin(), sharingShaderNodes.end(), refShader) != sharingShaderNodes.end())
+                continue;
+            // We only introspect once per actual OpenGL shader program
+            // rather than once per ShaderNode.
+            shaderNode->initializeFromReference(*refShader);
+            break;
         }
     }
-    shaderNode->unsetDirty();
-    // Ensure we will rebuilt material caches
-    shaderNode->requestCacheRebuild();
+
+    for (Shader *shaderNode : shaderNodes) {
+        shaderNode->unsetDirty();
+        // Ensure we will rebuilt material caches
+        shaderNode->requestCacheRebuild();
+    }
 }
 
 const GraphicsApiFilterData *SubmissionContext::contextInfo() const
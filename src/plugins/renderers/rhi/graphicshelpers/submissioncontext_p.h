@@ -109,8 +109,11 @@ public:
     };
 
     ShaderCreationInfo createShaderProgram(RHIShader *shaderNode);
+    std::vector<ShaderCreationInfo> createShaderPrograms(const std::vector<RHIShader *> &shaders);
     void loadShader(Shader *shader, ShaderManager *shaderManager,
                     RHIShaderManager *rhiShaderManager);
+    void loadShaders(const std::vector<Shader *> &shaders, ShaderManager *shaderManager,
+                     RHIShaderManager *rhiShaderManager);
 
 
     // FBO
@@ -171,6 +174,11 @@ private:
     // States
     void applyState(const StateVariant &state, QRhiGraphicsPipeline *graphicsPipeline);
 
+    // Pipeline cache
+    QString pipelineCacheFilePath() const;
+    void loadPipelineCache();
+    void savePipelineCache();
+
     bool m_ownsRhiCtx;
     bool m_drivenExternally;
     const unsigned int m_id;
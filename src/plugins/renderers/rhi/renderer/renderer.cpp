@@ -44,6 +44,7 @@
 #include <Qt3DRender/private/buffercapture_p.h>
 #include <Qt3DRender/private/offscreensurfacehelper_p.h>
 #include <Qt3DRender/private/subtreeenabler_p.h>
+#include <Qt3DRender/private/filterlayerentityjob_p.h>
 #include <Qt3DRender/private/qshaderprogrambuilder_p.h>
 #include <Qt3DRender/private/qshaderprogram_p.h>
 
@@ -165,6 +166,13 @@ private:
     RendererCache *m_cache;
 };
 
+int pipelinePrewarmBudgetFromEnvironment()
+{
+    bool ok = false;
+    const int budget = qEnvironmentVariableIntValue("QT3D_RHI_PIPELINE_PREWARM_BUDGET", &ok);
+    return ok ? qMax(0, budget) : Renderer::DefaultPipelinePrewarmBudget;
+}
+
 int locationForAttribute(Attribute *attr, const RHIShader *shader) noexcept
 {
     const std::vector<ShaderAttribute> &attribInfo = shader->attributes();
@@ -175,6 +183,24 @@ int locationForAttribute(Attribute *attr, const RHIShader *shader) noexcept
     return -1;
 }
 
+// Returns the rows of rect out of a RGBA8 readback of the whole render target,
+// tightly packed
+QByteArray cropReadback(const QRhiReadbackResult &result, const QRect &rect)
+{
+    constexpr int BytesPerPixel = 4;
+    if (rect == QRect(QPoint(0, 0), result.pixelSize))
+        return result.data;
+
+    const qsizetype sourceStride = qsizetype(result.pixelSize.width()) * BytesPerPixel;
+    const qsizetype rowBytes = qsizetype(rect.width()) * BytesPerPixel;
+    QByteArray cropped(rowBytes * rect.height(), Qt::Uninitialized);
+    for (int y = 0; y < rect.height(); ++y)
+        memcpy(cropped.data() + y * rowBytes,
+               result.data.constData() + (rect.y() + y) * sourceStride + rect.x() * BytesPerPixel,
+               rowBytes);
+    return cropped;
+}
+
 } // anonymous
 
 /*!
@@ -231,7 +257,8 @@ Renderer::Renderer()
       m_ownedContext(false),
       m_RHIResourceManagers(nullptr),
       m_commandExecuter(new Qt3DRender::DebugRhi::CommandExecuter(this)),
-      m_shouldSwapBuffers(true)
+      m_shouldSwapBuffers(true),
+      m_pipelinePrewarmBudget(pipelinePrewarmBudgetFromEnvironment())
 {
     std::fill_n(m_textureTransform, 4, 0.f);
 
@@ -324,6 +351,7 @@ void Renderer::setAspect(QRenderAspect *aspect)
 void Renderer::setNodeManagers(NodeManagers *managers)
 {
     m_nodesManager = managers;
+    m_dirtyRenderCommandTracker.setManagers(m_nodesManager);
     m_RHIResourceManagers = new RHIResourceManagers();
     m_scene2DResourceAccessor.reset(new ResourceAccessor(this, m_nodesManager));
 
@@ -506,6 +534,7 @@ void Renderer::shutdown()
     QMutexLocker lockRenderQueue(m_renderQueue.mutex());
     m_renderQueue.reset();
     lockRenderQueue.unlock();
+    m_renderViewPool.clear();
 
     releaseGraphicsResources();
 
@@ -699,8 +728,9 @@ void Renderer::render(bool swapBuffers)
             cleanGraphicsResources();
     }
 
-    // Reset RenderQueue and destroy the renderViews
-    m_renderQueue.reset();
+    // Reset RenderQueue and recycle the renderViews
+    m_renderQueue.takeFrameQueue(m_submittedRenderViews);
+    m_renderViewPool.release(m_submittedRenderViews);
 
     // We allow the RenderTickClock service to proceed to the next frame
     // In turn this will allow the aspect manager to request a new set of jobs
@@ -819,18 +849,10 @@ void Renderer::updateGraphicsPipeline(RenderCommand &cmd, RenderView *rv)
     // TO DO: Make RenderState part of the Key
     // as it is likely many geometrys will have the same layout
     RHIGraphicsPipelineManager *pipelineManager = m_RHIResourceManagers->rhiGraphicsPipelineManager();
-    const int geometryLayoutId = pipelineManager->getIdForAttributeVec(cmd.m_attributeInfo);
-    const int renderStatesKey = pipelineManager->getIdForRenderStates(cmd.m_stateSet);
-    const GraphicsPipelineIdentifier pipelineKey { geometryLayoutId, cmd.m_shaderId, rv->renderTargetId(), cmd.m_primitiveType, renderStatesKey };
+    const GraphicsPipelineIdentifier pipelineKey = graphicsPipelineKey(cmd, rv);
     RHIGraphicsPipeline *graphicsPipeline = pipelineManager->lookupResource(pipelineKey);
-    if (graphicsPipeline == nullptr) {
-        // Init UBOSet the first time we allocate a new pipeline
-        graphicsPipeline = pipelineManager->getOrCreateResource(pipelineKey);
-        graphicsPipeline->setKey(pipelineKey);
-        graphicsPipeline->uboSet()->setResourceManager(m_RHIResourceManagers);
-        graphicsPipeline->uboSet()->setNodeManagers(m_nodesManager);
-        graphicsPipeline->uboSet()->initializeLayout(m_submissionContext.data(), cmd.m_rhiShader);
-    }
+    if (graphicsPipeline == nullptr)
+        graphicsPipeline = createGraphicsPipeline(pipelineKey, cmd.m_rhiShader);
 
     // Increase score so that we know the pipeline was used for this frame and shouldn't be
     // destroyed
@@ -855,6 +877,184 @@ void Renderer::updateGraphicsPipeline(RenderCommand &cmd, RenderView *rv)
         buildGraphicsPipelines(graphicsPipeline, rv, cmd);
 }
 
+GraphicsPipelineIdentifier Renderer::graphicsPipelineKey(const RenderCommand &cmd, const RenderView *rv)
+{
+    RHIGraphicsPipelineManager *pipelineManager = m_RHIResourceManagers->rhiGraphicsPipelineManager();
+    const int geometryLayoutId = pipelineManager->getIdForAttributeVec(cmd.m_attributeInfo);
+    const int renderStatesKey = pipelineManager->getIdForRenderStates(cmd.m_stateSet);
+    return { geometryLayoutId, cmd.m_shaderId, rv->renderTargetId(), cmd.m_primitiveType, renderStatesKey };
+}
+
+RHIGraphicsPipeline *Renderer::createGraphicsPipeline(const GraphicsPipelineIdentifier &key, RHIShader *shader)
+{
+    // Init UBOSet the first time we allocate a new pipeline
+    RHIGraphicsPipeline *graphicsPipeline = m_RHIResourceManagers->rhiGraphicsPipelineManager()->getOrCreateResource(key);
+    graphicsPipeline->setKey(key);
+    graphicsPipeline->uboSet()->setResourceManager(m_RHIResourceManagers);
+    graphicsPipeline->uboSet()->setNodeManagers(m_nodesManager);
+    graphicsPipeline->uboSet()->initializeLayout(m_submissionContext.data(), shader);
+    return graphicsPipeline;
+}
+
+// Builds the pipelines of the commands of the RenderViews that weren't
+// selected for drawing this frame (frustum culled or filtered out by
+// proximity), so that they are ready by the time these come into view, as
+// well as the ones of the prewarmed entities. At most m_pipelinePrewarmBudget
+// pipelines of culled commands are built per frame to spread the cost, none
+// by default. Pre-built pipelines are kept alive as long as their commands or
+// prewarmed entities exist.
+void Renderer::prewarmGraphicsPipelines(const std::vector<RenderView *> &renderViews)
+{
+    prewarmDeclaredGraphicsPipelines(renderViews);
+
+    int budget = m_pipelinePrewarmBudget;
+    if (budget == 0)
+        return;
+
+    RHIGraphicsPipelineManager *pipelineManager = m_RHIResourceManagers->rhiGraphicsPipelineManager();
+    RHIShaderManager *rhiShaderManager = m_RHIResourceManagers->rhiShaderManager();
+
+    for (RenderView *rv : renderViews) {
+        const EntityRenderCommandDataViewPtr view = rv->renderCommandDataView();
+        if (!view || view->data.commands.size() == view->indices.size())
+            continue;
+
+        std::vector<RenderCommand> &commands = view->data.commands;
+        m_commandSelectedForDrawing.assign(commands.size(), false);
+        for (size_t idx : view->indices)
+            m_commandSelectedForDrawing[idx] = true;
+
+        for (size_t i = 0, m = commands.size(); i < m; ++i) {
+            RenderCommand &command = commands[i];
+            if (m_commandSelectedForDrawing[i] || command.m_type != RenderCommand::Draw)
+                continue;
+
+            command.m_rhiShader = rhiShaderManager->lookupResource(command.m_shaderId);
+            if (!command.m_rhiShader || !command.m_geometry.data())
+                continue;
+
+            const GraphicsPipelineIdentifier pipelineKey = graphicsPipelineKey(command, rv);
+            RHIGraphicsPipeline *graphicsPipeline = pipelineManager->lookupResource(pipelineKey);
+            if (graphicsPipeline == nullptr) {
+                if (budget == 0)
+                    continue;
+                --budget;
+                graphicsPipeline = createGraphicsPipeline(pipelineKey, command.m_rhiShader);
+                buildGraphicsPipelines(graphicsPipeline, rv, command);
+            }
+            graphicsPipeline->increaseScore();
+        }
+    }
+}
+
+// Builds the RenderCommands of the prewarmed entities for each RenderView
+// whose layer filters select them, whether their GeometryRenderer is enabled
+// or not, and records the pipelines these require. Technique and render pass
+// filters are applied through the material parameters of the RenderViews.
+void Renderer::collectDeclaredGraphicsPipelines(const std::vector<RenderView *> &renderViews,
+                                                const std::vector<Entity *> &entities)
+{
+    RHIGraphicsPipelineManager *pipelineManager = m_RHIResourceManagers->rhiGraphicsPipelineManager();
+    m_declaredPipelineKeys.clear();
+    m_missingDeclaredPipelines.clear();
+    if (entities.empty())
+        return;
+
+    for (size_t i = 0, m = renderViews.size(); i < m; ++i) {
+        RenderView *rv = renderViews[i];
+        if (rv->noDraw() || rv->isCompute())
+            continue;
+
+        std::vector<Entity *> selectedEntities = entities;
+        if (!rv->layerFilters().isEmpty()) {
+            FilterLayerEntityJob layerFilter;
+            layerFilter.setManager(m_nodesManager);
+            layerFilter.setLayerFilters(rv->layerFilters());
+            layerFilter.filterEntities(std::move(selectedEntities));
+            selectedEntities = std::move(layerFilter.filteredEntities());
+        }
+        if (selectedEntities.empty())
+            continue;
+
+        const std::vector<const Entity *> constEntities(selectedEntities.begin(), selectedEntities.end());
+        EntityRenderCommandData commandData =
+                rv->buildDrawRenderCommands(constEntities.data(), 0, int(constEntities.size()), true);
+        for (RenderCommand &command : commandData.commands) {
+            const GraphicsPipelineIdentifier pipelineKey = graphicsPipelineKey(command, rv);
+            if (Qt3DCore::contains(m_declaredPipelineKeys, pipelineKey))
+                continue;
+            m_declaredPipelineKeys.push_back(pipelineKey);
+            if (pipelineManager->lookupResource(pipelineKey) == nullptr)
+                m_missingDeclaredPipelines.push_back({ pipelineKey, std::move(command), i });
+        }
+    }
+}
+
+// The pipelines of the prewarmed entities are collected again when these or
+// the RenderCommands changed. The missing ones are built within budget, over
+// as many frames as needed, and all are kept alive.
+void Renderer::prewarmDeclaredGraphicsPipelines(const std::vector<RenderView *> &renderViews)
+{
+    {
+        QMutexLocker lock(&m_prewarmedEntitiesMutex);
+        if (m_prewarmedEntitiesDirty) {
+            m_prewarmedEntitiesDirty = false;
+            const std::vector<Entity *> entities = m_prewarmedEntities;
+            lock.unlock();
+            collectDeclaredGraphicsPipelines(renderViews, entities);
+        }
+    }
+
+    RHIGraphicsPipelineManager *pipelineManager = m_RHIResourceManagers->rhiGraphicsPipelineManager();
+    RHIShaderManager *rhiShaderManager = m_RHIResourceManagers->rhiShaderManager();
+    int budget = m_pipelinePrewarmBudget > 0 ? m_pipelinePrewarmBudget : DeclaredPipelinePrewarmBudget;
+    bool renderViewsChanged = false;
+
+    const auto built = [&] (DeclaredGraphicsPipeline &declared) {
+        // Drawn in the meantime
+        if (pipelineManager->lookupResource(declared.key) != nullptr)
+            return true;
+        if (budget == 0 || renderViewsChanged)
+            return false;
+        if (declared.renderViewIndex >= renderViews.size()) {
+            renderViewsChanged = true;
+            return false;
+        }
+
+        // Shaders are only loaded once used, try again next frame
+        RenderCommand &command = declared.command;
+        command.m_rhiShader = rhiShaderManager->lookupResource(command.m_shaderId);
+        if (!command.m_rhiShader)
+            return false;
+
+        RenderView *rv = renderViews[declared.renderViewIndex];
+        if (!(graphicsPipelineKey(command, rv) == declared.key)) {
+            renderViewsChanged = true;
+            return false;
+        }
+        --budget;
+        RHIGraphicsPipeline *graphicsPipeline = createGraphicsPipeline(declared.key, command.m_rhiShader);
+        buildGraphicsPipelines(graphicsPipeline, rv, command);
+        return true;
+    };
+    m_missingDeclaredPipelines.erase(std::remove_if(m_missingDeclaredPipelines.begin(),
+                                                    m_missingDeclaredPipelines.end(),
+                                                    built),
+                                     m_missingDeclaredPipelines.end());
+
+    // The RenderViews no longer match the ones the pipelines were collected
+    // with, collect them again next frame
+    if (renderViewsChanged) {
+        QMutexLocker lock(&m_prewarmedEntitiesMutex);
+        m_prewarmedEntitiesDirty = true;
+    }
+
+    for (const GraphicsPipelineIdentifier &pipelineKey : m_declaredPipelineKeys) {
+        if (RHIGraphicsPipeline *graphicsPipeline = pipelineManager->lookupResource(pipelineKey))
+            graphicsPipeline->increaseScore();
+    }
+}
+
 void Renderer::buildGraphicsPipelines(RHIGraphicsPipeline *graphicsPipeline,
                                       RenderView *rv,
                                       const RenderCommand &cmd)
@@ -1369,6 +1569,9 @@ Renderer::prepareCommandsSubmission(const std::vector<RenderView *> &renderViews
         });
     }
 
+    if (m_pipelinePrewarmBudget > 0)
+        prewarmGraphicsPipelines(renderViews);
+
     // Now that we know how many pipelines we have and how many RC each pipeline
     // has, we can allocate/reallocate UBOs with correct size for each pipelines
     for (RenderView *rv : renderViews) {
@@ -1400,12 +1603,16 @@ Renderer::prepareCommandsSubmission(const std::vector<RenderView *> &renderViews
 // Executed in a job
 void Renderer::lookForDirtyBuffers()
 {
-    const std::vector<HBuffer> &activeBufferHandles = m_nodesManager->bufferManager()->activeHandles();
-    for (const HBuffer &handle : activeBufferHandles) {
-        Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
-        if (buffer->isDirty())
+    // Only the buffers which were modified since the last time we looked are
+    // queued. Released buffers have been cleaned up and are no longer dirty
+    BufferManager *bufferManager = m_nodesManager->bufferManager();
+    bufferManager->dirtyNodeQueue().consume([this, bufferManager] (Buffer *buffer) {
+        if (!buffer->isDirty())
+            return;
+        const HBuffer handle = bufferManager->lookupHandle(buffer->peerId());
+        if (!handle.isNull())
             m_dirtyBuffers.push_back(handle);
-    }
+    });
 }
 
 // Called in prepareSubmission
@@ -1428,38 +1635,44 @@ void Renderer::lookForDirtyTextures()
     // image has been updated to then notify textures referencing the image
     // that they need to be updated
     TextureImageManager *imageManager = m_nodesManager->textureImageManager();
-    const std::vector<HTextureImage> &activeTextureImageHandles = imageManager->activeHandles();
-    Qt3DCore::QNodeIdVector dirtyImageIds;
-    for (const HTextureImage &handle : activeTextureImageHandles) {
-        TextureImage *image = imageManager->data(handle);
+    QSet<Qt3DCore::QNodeId> dirtyImageIds;
+    imageManager->dirtyNodeQueue().consume([&dirtyImageIds] (TextureImage *image) {
         if (image->isDirty()) {
-            dirtyImageIds.push_back(image->peerId());
+            dirtyImageIds.insert(image->peerId());
             image->unsetDirty();
         }
-    }
+    });
 
     TextureManager *textureManager = m_nodesManager->textureManager();
-    const std::vector<HTexture> &activeTextureHandles = textureManager->activeHandles();
-    for (const HTexture &handle : activeTextureHandles) {
-        Texture *texture = textureManager->data(handle);
-        const QNodeIdVector imageIds = texture->textureImageIds();
-
-        // Does the texture reference any of the dirty texture images?
-        for (const QNodeId &imageId : imageIds) {
-            if (dirtyImageIds.contains(imageId)) {
-                texture->addDirtyFlag(Texture::DirtyImageGenerators);
-                break;
+    if (!dirtyImageIds.isEmpty()) {
+        const std::vector<HTexture> &activeTextureHandles = textureManager->activeHandles();
+        for (const HTexture &handle : activeTextureHandles) {
+            Texture *texture = textureManager->data(handle);
+            const QNodeIdVector imageIds = texture->textureImageIds();
+
+            // Does the texture reference any of the dirty texture images?
+            for (const QNodeId &imageId : imageIds) {
+                if (dirtyImageIds.contains(imageId)) {
+                    // Queues the texture
+                    texture->addDirtyFlag(Texture::DirtyImageGenerators);
+                    break;
+                }
             }
         }
+    }
 
+    textureManager->dirtyNodeQueue().consume([this, textureManager] (Texture *texture) {
         // Dirty meaning that something has changed on the texture
         // either properties, parameters, shared texture id, generator or a texture image
-        if (texture->dirtyFlags() != Texture::NotDirty)
+        if (texture->dirtyFlags() == Texture::NotDirty)
+            return;
+        const HTexture handle = textureManager->lookupHandle(texture->peerId());
+        if (!handle.isNull())
             m_dirtyTextures.push_back(handle);
         // Note: texture dirty flags are reset when actually updating the
         // textures in updateGLResources() as resetting flags here would make
         // us lose information about what was dirty exactly.
-    }
+    });
 }
 
 // Executed in a job
@@ -1779,17 +1992,21 @@ void Renderer::updateResources()
     {
         const std::vector<HShader> dirtyShaderHandles = Qt3DCore::moveAndClear(m_dirtyShaders);
         ShaderManager *shaderManager = m_nodesManager->shaderManager();
+        std::vector<Shader *> dirtyShaders;
+        dirtyShaders.reserve(dirtyShaderHandles.size());
         for (const HShader &handle : dirtyShaderHandles) {
             Shader *shader = shaderManager->data(handle);
 
             // Can be null when using Scene3D rendering
-            if (shader == nullptr)
-                continue;
+            if (shader != nullptr)
+                dirtyShaders.push_back(shader);
+        }
 
-            // Compile shader
-            m_submissionContext->loadShader(shader, shaderManager,
-                                            m_RHIResourceManagers->rhiShaderManager());
+        // Compile shaders, all at once so that they can be baked in parallel
+        m_submissionContext->loadShaders(dirtyShaders, shaderManager,
+                                         m_RHIResourceManagers->rhiShaderManager());
 
+        for (Shader *shader : dirtyShaders) {
             // Release pipelines that reference the shaderId
             // to ensure they get rebuilt with updated shader
             graphicsPipelineManager->releasePipelinesReferencingShader(shader->peerId());
@@ -1815,6 +2032,11 @@ void Renderer::updateResources()
             // Create or Update RHITexture (the RHITexture instance is created if required
             // and all things that can take place without a GL context are done here)
             updateTexture(texture);
+
+            // Textures referencing missing images are left dirty, look at
+            // them again the next time textures are gathered
+            if (texture->dirtyFlags() != Texture::NotDirty)
+                m_nodesManager->textureManager()->dirtyNodeQueue().push(texture);
         }
         // We want to upload textures data at this point as the SubmissionThread and
         // AspectThread are locked ensuring no races between Texture/TextureImage and
@@ -1942,6 +2164,8 @@ void Renderer::updateTexture(Texture *texture)
     // No RHITexture associated yet -> create it
     if (rhiTexture == nullptr) {
         rhiTexture = rhiTextureManager->getOrCreateResource(texture->peerId());
+        rhiTexture->setTextureDataManagers(m_nodesManager->textureDataManager(),
+                                           m_nodesManager->textureImageDataManager());
         rhiTextureManager->texNodeIdForRHITexture.insert(rhiTexture, texture->peerId());
     }
 
@@ -2147,8 +2371,8 @@ Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
 
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
-    Q_UNUSED(node);
     m_dirtyBits.marked |= changes;
+    m_dirtyRenderCommandTracker.markDirty(changes, node);
 }
 
 Renderer::BackendNodeDirtySet Renderer::dirtyBits()
@@ -2172,6 +2396,15 @@ bool Renderer::shouldRender() const
             || m_dirtyBits.remaining != 0 || !m_lastFrameCorrect.loadRelaxed());
 }
 
+bool Renderer::needsNextFrame() const
+{
+    // Captured renders and buffers are only sent to the frontend by the next frame
+    if (shouldRender() || m_sendBufferCaptureJob->hasRequests())
+        return true;
+    QMutexLocker lock(&m_pendingRenderCaptureSendRequestsMutex);
+    return !m_pendingRenderCaptureSendRequests.empty();
+}
+
 void Renderer::skipNextFrame()
 {
     Q_ASSERT(m_settings->renderPolicy() != QRenderSettings::Always);
@@ -2273,6 +2506,24 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool renderCommandsDirty =
             materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
 
+    // When all changes can be attributed to GeometryRenderers, Geometries or
+    // Materials, only the RenderCommands of the entities using them are rebuilt
+    // and patched into the cached ones
+    const bool partialCommandRebuild = renderCommandsDirty
+            && !frameGraphDirty && !shadersDirty && !computeableDirty
+            && m_dirtyRenderCommandTracker.canRebuildPartially();
+    if (partialCommandRebuild) {
+        m_cache.dirtyRenderableEntities = m_dirtyRenderCommandTracker.dirtyEntities(m_cache.renderableEntities);
+        m_cache.dirtyComputeEntities = m_dirtyRenderCommandTracker.dirtyEntities(m_cache.computeEntities);
+    } else {
+        m_cache.dirtyRenderableEntities.clear();
+        m_cache.dirtyComputeEntities.clear();
+    }
+    m_dirtyRenderCommandTracker.clear();
+    const bool fullCommandRebuild = renderCommandsDirty && !partialCommandRebuild;
+    const bool commandsToPatch = partialCommandRebuild
+            && !(m_cache.dirtyRenderableEntities.empty() && m_cache.dirtyComputeEntities.empty());
+
     // Rebuild Entity Layers list if layers are dirty
 
     if (renderableDirty)
@@ -2286,6 +2537,22 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
     QMutexLocker lock(m_renderQueue.mutex());
     if (m_renderQueue.wasReset()) { // Have we rendered yet? (Scene3D case)
+        // Pipelines of the prewarmed entities are collected again once the
+        // new RenderViews are submitted
+        if (renderCommandsDirty) {
+            QMutexLocker prewarmLock(&m_prewarmedEntitiesMutex);
+            m_prewarmedEntities.clear();
+            if (m_settings) {
+                EntityManager *entityManager = m_nodesManager->renderNodesManager();
+                const Qt3DCore::QNodeIdVector entityIds = m_settings->prewarmedEntityIds();
+                for (const Qt3DCore::QNodeId &entityId : entityIds) {
+                    if (Entity *entity = entityManager->lookupResource(entityId))
+                        m_prewarmedEntities.push_back(entity);
+                }
+            }
+            m_prewarmedEntitiesDirty = true;
+        }
+
         // Traverse the current framegraph. For each leaf node create a
         // RenderView and set its configuration then create a job to
         // populate the RenderView with a set of RenderCommands that get
@@ -2302,6 +2569,14 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
                               leafNode) == m_frameGraphLeaves.end())
                     m_cache.leafNodeCache.remove(leafNode);
             }
+            for (auto it = m_renderViewBuilders.begin(); it != m_renderViewBuilders.end();) {
+                if (std::find(m_frameGraphLeaves.begin(),
+                              m_frameGraphLeaves.end(),
+                              it.key()) == m_frameGraphLeaves.end())
+                    it = m_renderViewBuilders.erase(it);
+                else
+                    ++it;
+            }
 
             // Handle single shot subtree enablers
             const auto subtreeEnablers = visitor.takeEnablersToDisable();
@@ -2324,24 +2599,35 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
         for (size_t i = 0; i < fgBranchCount; ++i) {
             FrameGraphNode *leaf = m_frameGraphLeaves.at(i);
-            RenderViewBuilder builder(leaf, int(i), this);
-            builder.setOptimalJobCount(leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount);
+            const int optimalJobCount = leaf->nodeType() == FrameGraphNode::NoDraw ? 1 : idealThreadCount;
+
+            // Builders and their job hierarchy are kept across frames, they are
+            // only recreated when the leaf moved in the FrameGraph or when the
+            // number of jobs to split the work into changed
+            QSharedPointer<RenderViewBuilder> &builder = m_renderViewBuilders[leaf];
+            if (builder.isNull()
+                    || builder->renderViewIndex() != int(i)
+                    || builder->optimalJobCount() != optimalJobCount) {
+                builder = QSharedPointer<RenderViewBuilder>::create(leaf, int(i), this);
+                builder->setOptimalJobCount(optimalJobCount);
+            }
 
             // If we have a new RV (wasn't in the cache before, then it contains no cached data)
             const bool isNewRV = !m_cache.leafNodeCache.contains(leaf);
-            builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
-            builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt
-                                                             || isNewRV);
-            builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
-            builder.setLightCacheNeedsToBeRebuilt(lightsDirty);
+            builder->setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
+            builder->setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt
+                                                              || isNewRV);
+            builder->setRenderCommandCacheNeedsToBeRebuilt(fullCommandRebuild || isNewRV);
+            builder->setRenderCommandCacheNeedsToBePatched(commandsToPatch && !isNewRV);
+            builder->setLightCacheNeedsToBeRebuilt(lightsDirty);
 
             // Insert leaf into cache
             if (isNewRV) {
                 m_cache.leafNodeCache[leaf] = {};
             }
 
-            builder.prepareJobs();
-            Qt3DCore::moveAtEnd(renderBinJobs, builder.buildJobHierachy());
+            builder->prepareJobs();
+            Qt3DCore::moveAtEnd(renderBinJobs, builder->buildJobHierachy());
         }
 
         // Set target number of RenderViews
@@ -2766,14 +3052,31 @@ bool Renderer::executeCommandsSubmission(const RHIPassInfo &passInfo)
                 if (!rect.isEmpty()) {
                     // Bind fbo as read framebuffer
                     QRhiReadbackResult *readBackResult = new QRhiReadbackResult;
-                    readBackResult->completed = [this, readBackResult, renderCaptureId, request] () {
+                    readBackResult->completed = [this, readBackResult, renderCaptureId, request, rect] () {
+                        Render::RenderCapture *renderCapture = static_cast<Render::RenderCapture*>(m_nodesManager->frameGraphManager()->lookupNode(renderCaptureId));
+                        if (request.rawData) {
+                            // The whole texture is read back, only hand the
+                            // requested rectangle over, as the OpenGL renderer does
+                            const QRect readRect = rect.intersected(QRect(QPoint(0, 0), readBackResult->pixelSize));
+                            auto data = RenderCaptureDataPtr::create();
+                            data->captureId = request.captureId;
+                            data->raw = true;
+                            data->rawData = cropReadback(*readBackResult, readRect);
+                            data->rect = readRect;
+                            delete readBackResult;
+                            renderCapture->addRenderCapture(data);
+                            QMutexLocker lock(&m_pendingRenderCaptureSendRequestsMutex);
+                            if (!Qt3DCore::contains(m_pendingRenderCaptureSendRequests, renderCaptureId))
+                                m_pendingRenderCaptureSendRequests.push_back(renderCaptureId);
+                            return;
+                        }
+
                         const QImage::Format fmt = QImage::Format_RGBA8888_Premultiplied; // fits QRhiTexture::RGBA8
                         const uchar *p = reinterpret_cast<const uchar *>(readBackResult->data.constData());
                         const QImage image(p, readBackResult->pixelSize.width(), readBackResult->pixelSize.height(), fmt, [] (void *ptr) {
                             delete static_cast<QRhiReadbackResult *>(ptr);
                         }, readBackResult);
 
-                        Render::RenderCapture *renderCapture = static_cast<Render::RenderCapture*>(m_nodesManager->frameGraphManager()->lookupNode(renderCaptureId));
                         renderCapture->addRenderCapture(request.captureId, image);
                         QMutexLocker lock(&m_pendingRenderCaptureSendRequestsMutex);
                         if (!Qt3DCore::contains(m_pendingRenderCaptureSendRequests, renderCaptureId))
@@ -34,7 +34,9 @@
 #include <Qt3DRender/private/filterentitybycomponentjob_p.h>
 #include <Qt3DRender/private/filtercompatibletechniquejob_p.h>
 #include <Qt3DRender/private/renderqueue_p.h>
+#include <Qt3DRender/private/renderviewpool_p.h>
 #include <Qt3DRender/private/renderercache_p.h>
+#include <Qt3DRender/private/dirtyrendercommandtracker_p.h>
 #include <Qt3DRender/private/renderviewinitializerjob_p.h>
 
 #include <QtGui/private/qrhi_p.h>
@@ -121,6 +123,7 @@ struct RHIRenderTarget;
 class RHIShader;
 class RHIResourceManagers;
 class RenderView;
+class RenderViewBuilder;
 class RHIGraphicsPipeline;
 class RHIComputePipeline;
 class PipelineUBOSet;
@@ -128,6 +131,12 @@ class PipelineUBOSet;
 class Q_AUTOTEST_EXPORT Renderer : public AbstractRenderer
 {
 public:
+    // Pipelines of frustum culled commands built per frame ahead of being
+    // drawn, off unless set through QT3D_RHI_PIPELINE_PREWARM_BUDGET
+    static constexpr int DefaultPipelinePrewarmBudget = 0;
+    // Pipelines of prewarmed entities built per frame when no budget is set
+    static constexpr int DeclaredPipelinePrewarmBudget = 4;
+
     explicit Renderer();
     ~Renderer();
 
@@ -164,6 +173,7 @@ public:
 
     FrameGraphNode *frameGraphRoot() const override;
     RenderQueue<RenderView> *renderQueue() { return &m_renderQueue; }
+    RenderViewPool<RenderView> *renderViewPool() { return &m_renderViewPool; }
 
     void markDirty(BackendNodeDirtySet changes, BackendNode *node) override;
     BackendNodeDirtySet dirtyBits() override;
@@ -172,6 +182,7 @@ public:
     void clearDirtyBits(BackendNodeDirtySet changes) override;
 #endif
     bool shouldRender() const override;
+    bool needsNextFrame() const override;
     void skipNextFrame() override;
     void jobsDone(Qt3DCore::QAspectManager *manager) override;
 
@@ -266,6 +277,8 @@ public:
 
     float *textureTransform() noexcept { return m_textureTransform; }
     const float *textureTransform() const noexcept { return m_textureTransform; }
+
+    int pipelinePrewarmBudget() const noexcept { return m_pipelinePrewarmBudget; }
 #ifdef QT3D_RENDER_UNIT_TESTS
 public:
 #else
@@ -289,6 +302,8 @@ private:
     QScopedPointer<SubmissionContext> m_submissionContext;
 
     RenderQueue<RenderView> m_renderQueue;
+    RenderViewPool<RenderView> m_renderViewPool;
+    std::vector<RenderView *> m_submittedRenderViews;
     QScopedPointer<VSyncFrameAdvanceService> m_vsyncFrameAdvanceService;
 
     QSemaphore m_submitRenderViewsSemaphore;
@@ -324,7 +339,7 @@ private:
     RenderableEntityFilterPtr m_renderableEntityFilterJob;
     ComputableEntityFilterPtr m_computableEntityFilterJob;
 
-    QMutex m_pendingRenderCaptureSendRequestsMutex;
+    mutable QMutex m_pendingRenderCaptureSendRequestsMutex;
     std::vector<Qt3DCore::QNodeId> m_pendingRenderCaptureSendRequests;
 
     SynchronizerJobPtr m_bufferGathererJob;
@@ -362,9 +377,12 @@ private:
 
     QMetaObject::Connection m_contextConnection;
     RendererCache<RenderCommand> m_cache;
+    DirtyRenderCommandTracker m_dirtyRenderCommandTracker;
     bool m_shouldSwapBuffers;
 
     std::vector<FrameGraphNode *> m_frameGraphLeaves;
+    // Kept across frames alongside m_cache.leafNodeCache
+    QHash<FrameGraphNode *, QSharedPointer<RenderViewBuilder>> m_renderViewBuilders;
     QScreen *m_screen = nullptr;
     QSharedPointer<ResourceAccessor> m_scene2DResourceAccessor;
     QHash<RenderView *, std::vector<RHIGraphicsPipeline *>> m_rvToGraphicsPipelines;
@@ -377,6 +395,30 @@ private:
 
     float m_textureTransform[4];
 
+    // Number of pipelines built ahead of their commands being drawn per frame,
+    // DefaultPipelinePrewarmBudget unless set through
+    // QT3D_RHI_PIPELINE_PREWARM_BUDGET
+    const int m_pipelinePrewarmBudget;
+    std::vector<bool> m_commandSelectedForDrawing;
+
+    // Entities declared through QRenderSettings::addPrewarmedEntity(), handed
+    // over to the render thread whenever the RenderCommands are rebuilt
+    QMutex m_prewarmedEntitiesMutex;
+    std::vector<Entity *> m_prewarmedEntities;
+    bool m_prewarmedEntitiesDirty = false;
+
+    // Pipelines required by the prewarmed entities, collected once per
+    // change. Missing ones are built within budget over the next frames,
+    // with the RenderView of the same index, and all are kept alive.
+    struct DeclaredGraphicsPipeline
+    {
+        GraphicsPipelineIdentifier key;
+        RenderCommand command;
+        size_t renderViewIndex;
+    };
+    std::vector<DeclaredGraphicsPipeline> m_missingDeclaredPipelines;
+    std::vector<GraphicsPipelineIdentifier> m_declaredPipelineKeys;
+
     bool prepareGeometryInputBindings(const Geometry *geometry, const RHIShader *shader,
                                       QVarLengthArray<QRhiVertexInputBinding, 8> &inputBindings,
                                       QVarLengthArray<QRhiVertexInputAttribute, 8> &rhiAttributes,
@@ -386,6 +428,12 @@ private:
     void updateComputePipeline(RenderCommand &cmd, RenderView *rv,
                                int renderViewIndex);
 
+    GraphicsPipelineIdentifier graphicsPipelineKey(const RenderCommand &command, const RenderView *rv);
+    RHIGraphicsPipeline *createGraphicsPipeline(const GraphicsPipelineIdentifier &key, RHIShader *shader);
+    void prewarmGraphicsPipelines(const std::vector<RenderView *> &renderViews);
+    void collectDeclaredGraphicsPipelines(const std::vector<RenderView *> &renderViews,
+                                          const std::vector<Entity *> &entities);
+    void prewarmDeclaredGraphicsPipelines(const std::vector<RenderView *> &renderViews);
     void buildGraphicsPipelines(RHIGraphicsPipeline *graphicsPipeline,
                                 RenderView *rv,
                                 const RenderCommand &command);
@@ -374,6 +374,59 @@ RenderView::~RenderView()
 {
 }
 
+void RenderView::reset()
+{
+    m_renderCommandDataView.reset();
+
+    m_surfaceSize = QSize();
+    m_devicePixelRatio = 1.0f;
+    m_viewport = QRectF(0.0f, 0.0f, 1.0f, 1.0f);
+    m_gamma = 2.2f;
+
+    m_renderCaptureNodeId = Qt3DCore::QNodeId();
+    m_renderCaptureRequest = QRenderCaptureRequest();
+    m_isDownloadBuffersEnable = false;
+
+    m_hasBlitFramebufferInfo = false;
+    m_blitFrameBufferInfo = BlitFramebufferInfo();
+
+    m_surface = nullptr;
+    m_renderTarget = Qt3DCore::QNodeId();
+    m_attachmentPack = AttachmentPack();
+    m_clearBuffer = QClearBuffers::None;
+    m_clearDepthValue = 1.0f;
+    m_clearStencilValue = 0;
+    m_globalClearColorBuffer = ClearBufferInfo();
+    m_specificClearColorBuffers.clear();
+
+    // Keep the RenderStateSet aside, a null one meaning no StateSet was found
+    if (m_stateSet) {
+        m_stateSet->clear();
+        m_recycledStateSet.reset(m_stateSet.take());
+    }
+    m_renderCameraLens = nullptr;
+    m_renderCameraNode = nullptr;
+    m_techniqueFilter = nullptr;
+    m_passFilter = nullptr;
+    m_noDraw = false;
+    m_compute = false;
+    m_frustumCulling = false;
+    m_showDebugOverlay = false;
+    m_workGroups[0] = m_workGroups[1] = m_workGroups[2] = 1;
+    m_sortingTypes.clear();
+    m_proximityFilterIds.clear();
+    m_layerFilterIds.clear();
+    m_viewMatrix = Matrix4x4();
+    m_viewProjectionMatrix = Matrix4x4();
+    m_clipCorrectionMatrix = Matrix4x4();
+    m_eyePos = Vector3D();
+    m_eyeViewDir = Vector3D();
+
+    m_parameters.clear();
+    m_lightSources.clear();
+    m_environmentLight = nullptr;
+}
+
 namespace {
 
 template<int SortType>
@@ -731,7 +784,7 @@ void RenderView::setRenderer(Renderer *renderer)
 RenderStateSet *RenderView::getOrCreateStateSet()
 {
     if (!m_stateSet)
-        m_stateSet.reset(new RenderStateSet());
+        m_stateSet.reset(m_recycledStateSet ? m_recycledStateSet.take() : new RenderStateSet());
     return m_stateSet.data();
 }
 
@@ -772,8 +825,12 @@ void RenderView::addClearBuffers(const ClearBuffers *cb)
 }
 
 // If we are there, we know that entity had a GeometryRenderer + Material
+// When prewarm is true, commands are also built for the entities whose
+// GeometryRenderer is disabled, so that the pipelines of prewarmed entities
+// can be built before they are drawn
 EntityRenderCommandData RenderView::buildDrawRenderCommands(const Entity **entities,
-                                                            int offset, int count) const
+                                                            int offset, int count,
+                                                            bool prewarm) const
 {
     EntityRenderCommandData commands;
 
@@ -788,7 +845,8 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const Entity **entit
         // There is a geometry renderer with geometry
         if ((geometryRenderer = m_manager->geometryRendererManager()->data(geometryRendererHandle))
                     != nullptr
-            && geometryRenderer->isEnabled() && !geometryRenderer->geometryId().isNull()) {
+            && (geometryRenderer->isEnabled() || prewarm)
+            && !geometryRenderer->geometryId().isNull()) {
 
             const Qt3DCore::QNodeId materialComponentId = entity->componentUuid<Material>();
             const HMaterial materialHandle = entity->componentHandle<Material>();
@@ -120,6 +120,10 @@ public:
 
     QT3D_ALIGNED_MALLOC_AND_FREE()
 
+    // Brings the RenderView back to its initial state, keeping the storage
+    // of its containers, so that it can be reused for another frame
+    void reset();
+
     static void setRenderViewConfigFromFrameGraphLeafNode(RenderView *rv,
                                                           const FrameGraphNode *fgLeaf);
 
@@ -209,7 +213,8 @@ public:
     RenderPassList passesAndParameters(ParameterInfoList *parameter, Entity *node, bool useDefaultMaterials = true);
 
     EntityRenderCommandData buildDrawRenderCommands(const Entity **entities,
-                                                    int offset, int count) const;
+                                                    int offset, int count,
+                                                    bool prewarm = false) const;
     EntityRenderCommandData buildComputeRenderCommands(const Entity **entities,
                                                        int offset, int count) const;
 
@@ -296,6 +301,7 @@ private:
     std::vector<ClearBufferInfo> m_specificClearColorBuffers;   // different draw buffers with distinct colors
 
     QScopedPointer<RenderStateSet> m_stateSet;
+    QScopedPointer<RenderStateSet> m_recycledStateSet;
     CameraLens *m_renderCameraLens = nullptr;
     Entity *m_renderCameraNode = nullptr;
     const TechniqueFilter *m_techniqueFilter = nullptr;
@@ -12,6 +12,17 @@ namespace Qt3DRender {
 namespace Render {
 namespace Rhi {
 
+namespace {
+
+void addDependencyOnce(const Qt3DCore::QAspectJobPtr &job, const Qt3DCore::QAspectJobPtr &dependency)
+{
+    const std::vector<QWeakPointer<Qt3DCore::QAspectJob>> &dependencies = job->dependencies();
+    if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end())
+        job->addDependency(dependency);
+}
+
+} // anonymous
+
 RenderViewBuilder::RenderViewBuilder(Render::FrameGraphNode *leafNode, int renderViewIndex, Renderer *renderer)
     : m_leafNode(leafNode)
     , m_renderViewIndex(renderViewIndex)
@@ -105,8 +116,11 @@ void RenderViewBuilder::prepareJobs()
     m_filterProximityJob->setManager(m_renderer->nodeManagers());
     m_frustumCullingJob->setRoot(m_renderer->sceneRoot());
 
-    const bool commandsNeedRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
-    if (commandsNeedRebuild) {
+    // Jobs are kept across frames, only create the ones that the
+    // current rebuild flags require and that weren't created yet
+    const bool commandsNeedRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild)
+            || m_rebuildFlags.testFlag(RebuildFlag::PartialCommandRebuild);
+    if (commandsNeedRebuild && m_renderViewCommandBuilderJobs.empty()) {
         m_renderViewCommandBuilderJobs.reserve(m_optimalParallelJobCount);
         for (auto i = 0; i < m_optimalParallelJobCount; ++i) {
             auto renderViewCommandBuilder = Render::Rhi::RenderViewCommandBuilderJobPtr::create();
@@ -115,7 +129,8 @@ void RenderViewBuilder::prepareJobs()
         m_syncRenderViewPreCommandBuildingJob = CreateSynchronizerJobPtr(SyncPreCommandBuilding(m_renderViewJob,
                                                                                                 m_renderViewCommandBuilderJobs,
                                                                                                 m_renderer,
-                                                                                                m_leafNode),
+                                                                                                m_leafNode,
+                                                                                                m_rebuildFlags),
                                                                          JobTypes::SyncRenderViewPreCommandBuilding);
     }
 
@@ -125,10 +140,12 @@ void RenderViewBuilder::prepareJobs()
 
     // RenderCommand building is the most consuming task -> split it
     // Estimate the number of jobs to create based on the number of entities
-    m_renderViewCommandUpdaterJobs.reserve(m_optimalParallelJobCount);
-    for (auto i = 0; i < m_optimalParallelJobCount; ++i) {
-        auto renderViewCommandUpdater = RenderViewCommandUpdaterJobPtr::create();
-        m_renderViewCommandUpdaterJobs.push_back(renderViewCommandUpdater);
+    if (m_renderViewCommandUpdaterJobs.empty()) {
+        m_renderViewCommandUpdaterJobs.reserve(m_optimalParallelJobCount);
+        for (auto i = 0; i < m_optimalParallelJobCount; ++i) {
+            auto renderViewCommandUpdater = RenderViewCommandUpdaterJobPtr::create();
+            m_renderViewCommandUpdaterJobs.push_back(renderViewCommandUpdater);
+        }
     }
 
     const bool materialCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheRebuild);
@@ -136,29 +153,41 @@ void RenderViewBuilder::prepareJobs()
         // Since Material gathering is an heavy task, we split it
         const std::vector<HMaterial> &materialHandles = m_renderer->nodeManagers()->materialManager()->activeHandles();
         const size_t handlesCount = materialHandles.size();
-        if (handlesCount) {
-            m_materialGathererJobs.reserve(m_optimalParallelJobCount);
-            const size_t elementsPerJob =  std::max(handlesCount / m_optimalParallelJobCount, size_t(1));
-            size_t elementCount = 0;
-            while (elementCount < handlesCount) {
+        const size_t elementsPerJob =  std::max(handlesCount / m_optimalParallelJobCount, size_t(1));
+        const size_t jobCount = (handlesCount + elementsPerJob - 1) / elementsPerJob;
+
+        // Gatherers of previous frames are reused unless the split changed
+        if (jobCount != m_materialGathererJobs.size()) {
+            if (!m_syncMaterialGathererJob.isNull()) {
+                for (const auto &materialGatherer : m_materialGathererJobs)
+                    m_syncMaterialGathererJob->removeDependency(materialGatherer);
+            }
+            m_materialGathererJobs.clear();
+            m_materialGathererJobs.reserve(jobCount);
+            for (size_t i = 0; i < jobCount; ++i) {
                 auto materialGatherer = MaterialParameterGathererJobPtr::create();
                 materialGatherer->setNodeManagers(m_renderer->nodeManagers());
-                // TO DO: Candidate for std::span if C++20
-                materialGatherer->setHandles({materialHandles.begin() + elementCount,
-                                              materialHandles.begin() + std::min(elementCount + elementsPerJob, handlesCount)});
                 m_materialGathererJobs.push_back(materialGatherer);
-
-                elementCount += elementsPerJob;
             }
+            m_wiredJobs.setFlag(RebuildFlag::MaterialCacheRebuild, false);
         }
-        m_syncMaterialGathererJob = CreateSynchronizerJobPtr(SyncMaterialParameterGatherer(m_materialGathererJobs,
-                                                                                           m_renderer,
-                                                                                           m_leafNode),
-                                                             JobTypes::SyncMaterialGatherer);
+
+        for (size_t i = 0; i < jobCount; ++i) {
+            const size_t elementCount = i * elementsPerJob;
+            // TO DO: Candidate for std::span if C++20
+            m_materialGathererJobs[i]->setHandles({materialHandles.begin() + elementCount,
+                                                   materialHandles.begin() + std::min(elementCount + elementsPerJob, handlesCount)});
+        }
+
+        if (m_syncMaterialGathererJob.isNull())
+            m_syncMaterialGathererJob = CreateSynchronizerJobPtr(SyncMaterialParameterGatherer(m_materialGathererJobs,
+                                                                                               m_renderer,
+                                                                                               m_leafNode),
+                                                                 JobTypes::SyncMaterialGatherer);
     }
 
     const bool layerCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::LayerCacheRebuild);
-    if (layerCacheNeedsRebuild) {
+    if (layerCacheNeedsRebuild && m_filterEntityByLayerJob.isNull()) {
         m_filterEntityByLayerJob = Render::FilterLayerEntityJobPtr::create();
         m_filterEntityByLayerJob->setManager(m_renderer->nodeManagers());
         m_syncFilterEntityByLayerJob = CreateSynchronizerJobPtr(SyncFilterEntityByLayer(m_filterEntityByLayerJob,
@@ -167,6 +196,11 @@ void RenderViewBuilder::prepareJobs()
                                                                   JobTypes::SyncFilterEntityByLayer);
     }
 
+    // The synchronizers below reference the job lists of the builder
+    // and only need to be created once
+    if (!m_syncRenderViewPreCommandUpdateJob.isNull())
+        return;
+
     m_syncRenderViewPreCommandUpdateJob = CreateSynchronizerJobPtr(SyncRenderViewPreCommandUpdate(m_renderViewJob,
                                                                                                   m_frustumCullingJob,
                                                                                                   m_filterProximityJob,
@@ -193,88 +227,116 @@ void RenderViewBuilder::prepareJobs()
                                                                      JobTypes::SyncRenderViewInitialization);
 }
 
-std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
+std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy()
 {
     std::vector<Qt3DCore::QAspectJobPtr> jobs;
     auto daspect = QRenderAspectPrivate::get(m_renderer->aspect());
-    auto expandBVJob = daspect->m_expandBoundingVolumeJob;
-    auto wordTransformJob = daspect->m_worldTransformJob;
-    auto updateTreeEnabledJob = daspect->m_updateTreeEnabledJob;
-    auto updateSkinningPaletteJob = daspect->m_updateSkinningPaletteJob;
-    auto updateEntityLayersJob = daspect->m_updateEntityLayersJob;
 
     jobs.reserve(m_materialGathererJobs.size() + m_renderViewCommandUpdaterJobs.size() + 11);
 
-    // Set dependencies
+    const bool commandsNeedRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild)
+            || m_rebuildFlags.testFlag(RebuildFlag::PartialCommandRebuild);
+    const bool materialCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheRebuild);
+    const bool layerCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::LayerCacheRebuild);
 
-    // Finish the skinning palette job before processing renderviews
-    // TODO: Maybe only update skinning palettes for non-culled entities
-    m_renderViewJob->addDependency(updateSkinningPaletteJob);
+    // Set dependencies
+    // The jobs being kept across frames, dependencies are only set the first
+    // time a job takes part in the hierarchy. Dependencies on jobs that are
+    // not scheduled for a given frame are ignored by the QAspectJobManager.
+    if (!m_jobHierarchyWired) {
+        auto expandBVJob = daspect->m_expandBoundingVolumeJob;
+        auto wordTransformJob = daspect->m_worldTransformJob;
+        auto updateSkinningPaletteJob = daspect->m_updateSkinningPaletteJob;
+
+        // Finish the skinning palette job before processing renderviews
+        // Note: palettes are only updated for skeletons used by enabled entities,
+        // frustum culling results are only known after this job has run
+        m_renderViewJob->addDependency(updateSkinningPaletteJob);
+
+        m_syncPreFrustumCullingJob->addDependency(wordTransformJob);
+        m_syncPreFrustumCullingJob->addDependency(m_renderer->updateShaderDataTransformJob());
+        m_syncPreFrustumCullingJob->addDependency(m_syncRenderViewPostInitializationJob);
+
+        m_frustumCullingJob->addDependency(expandBVJob);
+        m_frustumCullingJob->addDependency(m_syncPreFrustumCullingJob);
+
+        m_syncRenderViewPostInitializationJob->addDependency(m_renderViewJob);
+
+        m_filterProximityJob->addDependency(expandBVJob);
+        m_filterProximityJob->addDependency(m_syncRenderViewPostInitializationJob);
+
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_syncRenderViewPostInitializationJob);
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_filterProximityJob);
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_frustumCullingJob);
+
+        // Ensure the RenderThread won't be able to process dirtyResources
+        // before they have been completely gathered
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->introspectShadersJob());
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->bufferGathererJob());
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->textureGathererJob());
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->lightGathererJob());
+
+        for (const auto &renderViewCommandUpdater : m_renderViewCommandUpdaterJobs) {
+            renderViewCommandUpdater->addDependency(m_syncRenderViewPreCommandUpdateJob);
+            m_syncRenderViewPostCommandUpdateJob->addDependency(renderViewCommandUpdater);
+        }
 
-    m_syncPreFrustumCullingJob->addDependency(wordTransformJob);
-    m_syncPreFrustumCullingJob->addDependency(m_renderer->updateShaderDataTransformJob());
-    m_syncPreFrustumCullingJob->addDependency(m_syncRenderViewPostInitializationJob);
+        m_renderer->frameCleanupJob()->addDependency(m_syncRenderViewPostCommandUpdateJob);
 
-    m_frustumCullingJob->addDependency(expandBVJob);
-    m_frustumCullingJob->addDependency(m_syncPreFrustumCullingJob);
+        m_jobHierarchyWired = true;
+    }
 
-    m_syncRenderViewPostInitializationJob->addDependency(m_renderViewJob);
+    if (commandsNeedRebuild && !m_wiredJobs.testFlag(RebuildFlag::FullCommandRebuild)) {
+        m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->computableEntityFilterJob());
+        m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->renderableEntityFilterJob());
+        m_syncRenderViewPreCommandBuildingJob->addDependency(m_syncRenderViewPostInitializationJob);
 
-    m_filterProximityJob->addDependency(expandBVJob);
-    m_filterProximityJob->addDependency(m_syncRenderViewPostInitializationJob);
+        for (const auto &renderViewCommandBuilder : m_renderViewCommandBuilderJobs) {
+            renderViewCommandBuilder->addDependency(m_syncRenderViewPreCommandBuildingJob);
+            m_syncRenderViewPreCommandUpdateJob->addDependency(renderViewCommandBuilder);
+        }
+        m_wiredJobs |= RebuildFlag::FullCommandRebuild;
+    }
 
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_syncRenderViewPostInitializationJob);
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_filterProximityJob);
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_frustumCullingJob);
+    if (layerCacheNeedsRebuild && !m_wiredJobs.testFlag(RebuildFlag::LayerCacheRebuild)) {
+        m_filterEntityByLayerJob->addDependency(daspect->m_updateEntityLayersJob);
+        m_filterEntityByLayerJob->addDependency(m_syncRenderViewPostInitializationJob);
+        m_filterEntityByLayerJob->addDependency(daspect->m_updateTreeEnabledJob);
 
-    // Ensure the RenderThread won't be able to process dirtyResources
-    // before they have been completely gathered
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->introspectShadersJob());
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->bufferGathererJob());
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->textureGathererJob());
-    m_syncRenderViewPreCommandUpdateJob->addDependency(m_renderer->lightGathererJob());
+        m_syncFilterEntityByLayerJob->addDependency(m_filterEntityByLayerJob);
+        m_syncRenderViewPreCommandUpdateJob->addDependency(m_syncFilterEntityByLayerJob);
+        m_wiredJobs |= RebuildFlag::LayerCacheRebuild;
+    }
 
-    for (const auto &renderViewCommandUpdater : m_renderViewCommandUpdaterJobs) {
-        renderViewCommandUpdater->addDependency(m_syncRenderViewPreCommandUpdateJob);
-        m_syncRenderViewPostCommandUpdateJob->addDependency(renderViewCommandUpdater);
+    if (materialCacheNeedsRebuild && !m_wiredJobs.testFlag(RebuildFlag::MaterialCacheRebuild)) {
+        for (const auto &materialGatherer : m_materialGathererJobs)  {
+            materialGatherer->addDependency(m_syncRenderViewPostInitializationJob);
+            materialGatherer->addDependency(m_renderer->introspectShadersJob());
+            materialGatherer->addDependency(m_renderer->filterCompatibleTechniqueJob());
+            m_syncMaterialGathererJob->addDependency(materialGatherer);
+        }
+        // Gatherers may be recreated when the number of materials changes,
+        // the synchronizer itself is only wired once
+        addDependencyOnce(m_syncRenderViewPreCommandUpdateJob, m_syncMaterialGathererJob);
+        m_wiredJobs |= RebuildFlag::MaterialCacheRebuild;
     }
 
-    m_renderer->frameCleanupJob()->addDependency(m_syncRenderViewPostCommandUpdateJob);
+    if (commandsNeedRebuild && materialCacheNeedsRebuild)
+        addDependencyOnce(m_syncRenderViewPreCommandBuildingJob, m_syncMaterialGathererJob);
 
     // Add jobs
     jobs.push_back(m_renderViewJob); // Step 1
 
     jobs.push_back(m_syncRenderViewPostInitializationJob); // Step 2
 
-    const bool commandsNeedRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
-    const bool materialCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::MaterialCacheRebuild);
-    const bool layerCacheNeedsRebuild = m_rebuildFlags.testFlag(RebuildFlag::LayerCacheRebuild);
-
     if (commandsNeedRebuild) { // Step 3
-        m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->computableEntityFilterJob());
-        m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->renderableEntityFilterJob());
-        m_syncRenderViewPreCommandBuildingJob->addDependency(m_syncRenderViewPostInitializationJob);
-
-        if (materialCacheNeedsRebuild)
-            m_syncRenderViewPreCommandBuildingJob->addDependency(m_syncMaterialGathererJob);
-
         jobs.push_back(m_syncRenderViewPreCommandBuildingJob);
 
-        for (const auto &renderViewCommandBuilder : m_renderViewCommandBuilderJobs) {
-            renderViewCommandBuilder->addDependency(m_syncRenderViewPreCommandBuildingJob);
-            m_syncRenderViewPreCommandUpdateJob->addDependency(renderViewCommandBuilder);
+        for (const auto &renderViewCommandBuilder : m_renderViewCommandBuilderJobs)
             jobs.push_back(renderViewCommandBuilder);
-        }
     }
 
     if (layerCacheNeedsRebuild) {
-        m_filterEntityByLayerJob->addDependency(updateEntityLayersJob);
-        m_filterEntityByLayerJob->addDependency(m_syncRenderViewPostInitializationJob);
-        m_filterEntityByLayerJob->addDependency(updateTreeEnabledJob);
-
-        m_syncFilterEntityByLayerJob->addDependency(m_filterEntityByLayerJob);
-        m_syncRenderViewPreCommandUpdateJob->addDependency(m_syncFilterEntityByLayerJob);
-
         jobs.push_back(m_filterEntityByLayerJob); // Step 3
         jobs.push_back(m_syncFilterEntityByLayerJob); // Step 4
     }
@@ -282,15 +344,8 @@ std::vector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
     jobs.push_back(m_filterProximityJob); // Step 3
 
     if (materialCacheNeedsRebuild) {
-        for (const auto &materialGatherer : m_materialGathererJobs)  {
-            materialGatherer->addDependency(m_syncRenderViewPostInitializationJob);
-            materialGatherer->addDependency(m_renderer->introspectShadersJob());
-            materialGatherer->addDependency(m_renderer->filterCompatibleTechniqueJob());
+        for (const auto &materialGatherer : m_materialGathererJobs)
             jobs.push_back(materialGatherer); // Step3
-            m_syncMaterialGathererJob->addDependency(materialGatherer);
-        }
-        m_syncRenderViewPreCommandUpdateJob->addDependency(m_syncMaterialGathererJob);
-
         jobs.push_back(m_syncMaterialGathererJob); // Step 3
     }
 
@@ -346,6 +401,16 @@ bool RenderViewBuilder::renderCommandCacheNeedsToBeRebuilt() const
     return m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
 }
 
+void RenderViewBuilder::setRenderCommandCacheNeedsToBePatched(bool needsToBePatched)
+{
+    m_rebuildFlags.setFlag(RebuildFlag::PartialCommandRebuild, needsToBePatched);
+}
+
+bool RenderViewBuilder::renderCommandCacheNeedsToBePatched() const
+{
+    return m_rebuildFlags.testFlag(RebuildFlag::PartialCommandRebuild);
+}
+
 void RenderViewBuilder::setLightCacheNeedsToBeRebuilt(bool needsToBeRebuilt)
 {
     m_rebuildFlags.setFlag(RebuildFlag::LightCacheRebuild, needsToBeRebuilt);
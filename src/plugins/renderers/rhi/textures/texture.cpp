@@ -14,6 +14,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/qabstracttexture_p.h>
 #include <Qt3DRender/private/qtextureimagedata_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 #include <renderbuffer_p.h>
 #include <submissioncontext_p.h>
 
@@ -250,6 +251,8 @@ RHITexture::RHITexture()
       m_rhi(nullptr),
       m_rhiSampler(nullptr),
       m_renderBuffer(nullptr),
+      m_textureDataManager(nullptr),
+      m_textureImageDataManager(nullptr),
       m_dataFunctor(),
       m_pendingDataFunctor(nullptr),
       m_sharedTextureId(-1),
@@ -274,6 +277,11 @@ void RHITexture::destroy()
     delete m_renderBuffer;
     m_renderBuffer = nullptr;
 
+    // Release our references on the generated data
+    if (m_textureDataManager && m_dataFunctor)
+        m_textureDataManager->releaseData(m_dataFunctor, this);
+    releaseImageData(m_images, {});
+
     m_dirtyFlags = None;
     m_sharedTextureId = -1;
     m_externalRendering = false;
@@ -289,9 +297,70 @@ void RHITexture::destroy()
     m_pendingTextureDataUpdates.clear();
 }
 
+bool RHITexture::isTextureDataReady() const
+{
+    return !m_textureDataManager || m_textureDataManager->isDataReady(m_dataFunctor);
+}
+
+bool RHITexture::isImageDataReady() const
+{
+    if (!m_textureImageDataManager)
+        return true;
+    for (const Image &img : m_images) {
+        if (!img.generator.isNull() && !m_textureImageDataManager->isDataReady(img.generator))
+            return false;
+    }
+    return true;
+}
+
+QTextureDataPtr RHITexture::generateTextureData()
+{
+    if (m_textureDataManager) {
+        const QTextureDataPtr data = m_textureDataManager->getData(m_dataFunctor);
+        m_textureDataManager->markDataTaken(m_dataFunctor, this);
+        return data;
+    }
+    return m_dataFunctor->operator()();
+}
+
+QTextureImageDataPtr RHITexture::generateImageData(const QTextureImageDataGeneratorPtr &generator) const
+{
+    if (m_textureImageDataManager)
+        return m_textureImageDataManager->getData(generator);
+    return generator->operator()();
+}
+
+void RHITexture::requestImageData(const std::vector<Image> &images)
+{
+    if (!m_textureImageDataManager)
+        return;
+    for (const Image &img : images) {
+        if (!img.generator.isNull())
+            m_textureImageDataManager->requestData(img.generator, this);
+    }
+}
+
+void RHITexture::releaseImageData(const std::vector<Image> &images,
+                                  const std::vector<Image> &imagesToKeep)
+{
+    if (!m_textureImageDataManager)
+        return;
+    for (const Image &img : images) {
+        if (img.generator.isNull())
+            continue;
+        const bool keep = std::any_of(imagesToKeep.begin(), imagesToKeep.end(),
+                                      [&img](const Image &other) {
+                                          return !other.generator.isNull()
+                                                  && *other.generator == *img.generator;
+                                      });
+        if (!keep)
+            m_textureImageDataManager->releaseData(img.generator, this);
+    }
+}
+
 bool RHITexture::loadTextureDataFromGenerator()
 {
-    m_textureData = m_dataFunctor->operator()();
+    m_textureData = generateTextureData();
     // if there is a texture generator, most properties will be defined by it
     if (m_textureData) {
         const QAbstractTexture::Target target = m_textureData->target();
@@ -336,7 +405,7 @@ void RHITexture::loadTextureDataFromImages()
 {
     int maxMipLevel = 0;
     for (const Image &img : qAsConst(m_images)) {
-        const QTextureImageDataPtr imgData = img.generator->operator()();
+        const QTextureImageDataPtr imgData = generateImageData(img.generator);
         // imgData may be null in the following cases:
         // - Texture is created with TextureImages which have yet to be
         // loaded (skybox where you don't yet know the path, source set by
@@ -367,6 +436,14 @@ void RHITexture::loadTextureDataFromImages()
         }
     }
 
+    // We keep the data until it is uploaded, the manager can drop its copy
+    if (m_textureImageDataManager) {
+        for (const Image &img : qAsConst(m_images)) {
+            if (!img.generator.isNull())
+                m_textureImageDataManager->markDataTaken(img.generator, this);
+        }
+    }
+
     // make sure the number of mip levels is set when there is no texture data generator
     if (!m_dataFunctor) {
         m_properties.mipLevels = maxMipLevel + 1;
@@ -386,6 +463,12 @@ RHITexture::TextureUpdateInfo RHITexture::createOrUpdateRhiTexture(SubmissionCon
     if (!hasSharedTextureId) {
         // If dataFunctor exists and we have no data and it hasn´t run yet
         if (m_dataFunctor && !m_textureData && m_dataFunctor.get() != m_pendingDataFunctor) {
+            // Wait for the generator to have been executed on a worker thread
+            if (!isTextureDataReady()) {
+                textureInfo.properties.status = QAbstractTexture::Loading;
+                return textureInfo;
+            }
+
             const bool successfullyLoadedTextureData = loadTextureDataFromGenerator();
             // If successful, m_textureData has content
             if (successfullyLoadedTextureData) {
@@ -405,6 +488,13 @@ RHITexture::TextureUpdateInfo RHITexture::createOrUpdateRhiTexture(SubmissionCon
         // If images have changed, clear previous images data
         // and regenerate m_imageData for the images
         if (testDirtyFlag(TextureImageData)) {
+            // Wait for all the images to have been generated, we don't want
+            // to upload a partially filled texture
+            if (!isImageDataReady()) {
+                textureInfo.properties.status = QAbstractTexture::Loading;
+                return textureInfo;
+            }
+
             m_imageData.clear();
             loadTextureDataFromImages();
             // Mark for upload if we actually have something to upload
@@ -488,7 +578,10 @@ RHITexture::TextureUpdateInfo RHITexture::createOrUpdateRhiTexture(SubmissionCon
 RenderBuffer *RHITexture::getOrCreateRenderBuffer()
 {
     if (m_dataFunctor && !m_textureData) {
-        m_textureData = m_dataFunctor->operator()();
+        if (!isTextureDataReady())
+            return nullptr;
+
+        m_textureData = generateTextureData();
         if (m_textureData) {
             if (m_properties.target != QAbstractTexture::TargetAutomatic)
                 qWarning() << "[Qt3DRender::RHITexture] [renderbuffer] When a texture provides a "
@@ -531,6 +624,13 @@ void RHITexture::cleanup()
     destroy();
 }
 
+void RHITexture::setTextureDataManagers(TextureDataManager *textureDataManager,
+                                        TextureImageDataManager *textureImageDataManager)
+{
+    m_textureDataManager = textureDataManager;
+    m_textureImageDataManager = textureImageDataManager;
+}
+
 void RHITexture::setParameters(const TextureParameters &params)
 {
     if (m_parameters != params) {
@@ -561,6 +661,10 @@ void RHITexture::setImages(const std::vector<Image> &images)
     }
 
     if (!same) {
+        // Request new data before releasing the previous one so that
+        // data shared between the old and new images isn't regenerated
+        requestImageData(images);
+        releaseImageData(m_images, images);
         m_images = images;
         requestImageUpload();
     }
@@ -568,6 +672,12 @@ void RHITexture::setImages(const std::vector<Image> &images)
 
 void RHITexture::setGenerator(const QTextureGeneratorPtr &generator)
 {
+    if (m_textureDataManager) {
+        if (generator)
+            m_textureDataManager->requestData(generator, this);
+        if (m_dataFunctor && !(generator && *generator == *m_dataFunctor))
+            m_textureDataManager->releaseData(m_dataFunctor, this);
+    }
     m_textureData.reset();
     m_dataFunctor = generator;
     m_pendingDataFunctor = nullptr;
@@ -153,6 +153,11 @@ public:
     // Purely for unit testing purposes
     bool wasTextureRecreated() const { return m_wasTextureRecreated; }
 
+    // When set, generators are executed ahead of time by the LoadTextureDataJob
+    // and we only pick up their results. Otherwise they are executed in place.
+    void setTextureDataManagers(TextureDataManager *textureDataManager,
+                                TextureImageDataManager *textureImageDataManager);
+
     void setParameters(const TextureParameters &params);
     void setProperties(const TextureProperties &props);
     void setImages(const std::vector<Image> &images);
@@ -173,6 +178,12 @@ private:
     void setDirtyFlag(DirtyFlag flag, bool value = true) { m_dirtyFlags.setFlag(flag, value); }
 
     QRhiTexture *buildRhiTexture(SubmissionContext *ctx);
+    bool isTextureDataReady() const;
+    bool isImageDataReady() const;
+    QTextureDataPtr generateTextureData();
+    QTextureImageDataPtr generateImageData(const QTextureImageDataGeneratorPtr &generator) const;
+    void requestImageData(const std::vector<Image> &images);
+    void releaseImageData(const std::vector<Image> &images, const std::vector<Image> &imagesToKeep);
     bool loadTextureDataFromGenerator();
     void loadTextureDataFromImages();
     void uploadRhiTextureData(SubmissionContext *ctx);
@@ -185,6 +196,8 @@ private:
     QRhiTexture *m_rhi;
     QRhiSampler *m_rhiSampler;
     RenderBuffer *m_renderBuffer;
+    TextureDataManager *m_textureDataManager;
+    TextureImageDataManager *m_textureImageDataManager;
 
     // target which is actually used for GL texture
     TextureProperties m_properties;
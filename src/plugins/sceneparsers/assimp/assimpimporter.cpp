@@ -25,6 +25,7 @@
 #include <Qt3DExtras/qphongmaterial.h>
 #include <Qt3DAnimation/qkeyframeanimation.h>
 #include <Qt3DAnimation/qmorphinganimation.h>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QFileInfo>
 #include <QtGui/QColor>
 
@@ -628,8 +629,17 @@ void AssimpImporter::parse()
         // Set parsed flags
         m_sceneParsed = !m_sceneParsed;
 
+        // Building the buffers of the meshes is what takes the longest, it
+        // only reads the aiScene and runs on worker threads. Nodes are
+        // created on this thread.
+        const QList<const aiMesh *> meshes(m_scene->m_aiScene->mMeshes,
+                                           m_scene->m_aiScene->mMeshes + m_scene->m_aiScene->mNumMeshes);
+        QFuture<MeshData> meshData = QtConcurrent::mapped(meshes, &AssimpImporter::convertMesh);
+
         for (uint i = 0; i < m_scene->m_aiScene->mNumAnimations; i++)
             loadAnimation(i);
+
+        m_scene->m_meshData = meshData.results();
     }
 }
 
@@ -656,22 +666,15 @@ QMaterial *AssimpImporter::loadMaterial(uint materialIndex)
 }
 
 /*!
- * Converts the Assimp aiMesh mesh identified by \a meshIndex to a QGeometryRenderer
- * \sa QGeometryRenderer
+ * Converts the vertices, indices and morph targets of the Assimp aiMesh
+ * \a mesh to the content of the buffers of a Qt3D geometry.
+ *
+ * Only reads \a mesh and creates no node, so that the meshes of a scene can
+ * be converted in parallel.
  */
-QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
+AssimpImporter::MeshData AssimpImporter::convertMesh(const aiMesh *mesh)
 {
-    aiMesh *mesh = m_scene->m_aiScene->mMeshes[meshIndex];
-
-    QGeometryRenderer *geometryRenderer = QAbstractNodeFactory::createNode<QGeometryRenderer>("QGeometryRenderer");
-    QGeometry *meshGeometry = QAbstractNodeFactory::createNode<QGeometry>("QGeometry");
-    meshGeometry->setParent(geometryRenderer);
-    Qt3DCore::QBuffer *vertexBuffer = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
-    vertexBuffer->setParent(meshGeometry);
-    Qt3DCore::QBuffer *indexBuffer = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
-    indexBuffer->setParent(meshGeometry);
-
-    geometryRenderer->setGeometry(meshGeometry);
+    MeshData meshData;
 
     // Primitive are always triangles with the current Assimp's configuration
 
@@ -680,15 +683,19 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
     aiVector3D *normals = mesh->mNormals;
     aiColor4D *colors = mesh->mColors[0];
     // Tangents and TextureCoord not always present
-    bool hasTangent = mesh->HasTangentsAndBitangents();
-    bool hasTexture = mesh->HasTextureCoords(0);
-    bool hasColor = (colors != NULL); // NULL defined by Assimp
+    const bool hasTangent = mesh->HasTangentsAndBitangents();
+    const bool hasTexture = mesh->HasTextureCoords(0);
+    const bool hasColor = (colors != NULL); // NULL defined by Assimp
     aiVector3D *tangents = hasTangent ? mesh->mTangents : nullptr;
     aiVector3D *textureCoord = hasTexture ? mesh->mTextureCoords[0] : nullptr;
+    meshData.hasTangent = hasTangent;
+    meshData.hasTexture = hasTexture;
+    meshData.hasColor = hasColor;
 
     // Add values in raw float array
-    ushort chunkSize = 6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0) + (hasColor ? 4 : 0);
-    QByteArray bufferArray;
+    const ushort chunkSize = 6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0) + (hasColor ? 4 : 0);
+    meshData.chunkSize = chunkSize;
+    QByteArray &bufferArray = meshData.vertexData;
     bufferArray.resize(chunkSize * mesh->mNumVertices * sizeof(float));
     float *vbufferContent = reinterpret_cast<float*>(bufferArray.data());
     for (uint i = 0; i < mesh->mNumVertices; i++) {
@@ -721,7 +728,108 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
         }
     }
 
-    vertexBuffer->setData(bufferArray);
+    QByteArray &ibufferContent = meshData.indexData;
+    const uint indices = mesh->mNumFaces * 3;
+    meshData.indexCount = indices;
+    // If there are less than 65535 indices, indices can then fit in ushort
+    // which saves video memory
+    if (indices >= USHRT_MAX) {
+        meshData.indexType = QAttribute::UnsignedInt;
+        ibufferContent.resize(indices * sizeof(quint32));
+        for (uint i = 0; i < mesh->mNumFaces; i++) {
+            aiFace face = mesh->mFaces[i];
+            Q_ASSERT(face.mNumIndices == 3);
+            memcpy(&reinterpret_cast<quint32*>(ibufferContent.data())[i * 3], face.mIndices, 3 * sizeof(uint));
+        }
+    }
+    else {
+        meshData.indexType = QAttribute::UnsignedShort;
+        ibufferContent.resize(indices * sizeof(quint16));
+        for (uint i = 0; i < mesh->mNumFaces; i++) {
+            aiFace face = mesh->mFaces[i];
+            Q_ASSERT(face.mNumIndices == 3);
+            for (ushort j = 0; j < face.mNumIndices; j++)
+                reinterpret_cast<quint16*>(ibufferContent.data())[i * 3 + j] = face.mIndices[j];
+        }
+    }
+
+    if (mesh->mNumAnimMeshes == 0 || mesh->mAnimMeshes[0]->mNumVertices != mesh->mNumVertices)
+        return meshData;
+
+    const aiAnimMesh *animesh = mesh->mAnimMeshes[0];
+    const ushort clumpSize = (animesh->mVertices ? 3 : 0)
+            + (animesh->mNormals ? 3 : 0)
+            + (animesh->mTangents ? 3 : 0)
+            + (animesh->mColors[0] ? 4 : 0)
+            + (animesh->mTextureCoords[0] ? 2 : 0);
+    meshData.morphTargetClumpSize = clumpSize;
+
+    meshData.morphTargetData.reserve(mesh->mNumAnimMeshes);
+    for (uint i = 0; i < mesh->mNumAnimMeshes; i++) {
+        const aiAnimMesh *animesh = mesh->mAnimMeshes[i];
+        QByteArray targetBufferArray;
+        targetBufferArray.resize(clumpSize * mesh->mNumVertices * sizeof(float));
+        float *dst = reinterpret_cast<float *>(targetBufferArray.data());
+
+        for (uint j = 0; j < mesh->mNumVertices; j++) {
+            if (animesh->mVertices) {
+                *dst++ = animesh->mVertices[j].x;
+                *dst++ = animesh->mVertices[j].y;
+                *dst++ = animesh->mVertices[j].z;
+            }
+            if (animesh->mNormals) {
+                *dst++ = animesh->mNormals[j].x;
+                *dst++ = animesh->mNormals[j].y;
+                *dst++ = animesh->mNormals[j].z;
+            }
+            if (animesh->mTangents) {
+                *dst++ = animesh->mTangents[j].x;
+                *dst++ = animesh->mTangents[j].y;
+                *dst++ = animesh->mTangents[j].z;
+            }
+            if (animesh->mTextureCoords[0]) {
+                *dst++ = animesh->mTextureCoords[0][j].x;
+                *dst++ = animesh->mTextureCoords[0][j].y;
+            }
+            if (animesh->mColors[0]) {
+                *dst++ = animesh->mColors[0][j].r;
+                *dst++ = animesh->mColors[0][j].g;
+                *dst++ = animesh->mColors[0][j].b;
+                *dst++ = animesh->mColors[0][j].a;
+            }
+        }
+        meshData.morphTargetData.push_back(targetBufferArray);
+    }
+
+    return meshData;
+}
+
+/*!
+ * Converts the Assimp aiMesh mesh identified by \a meshIndex to a QGeometryRenderer
+ * \sa QGeometryRenderer
+ */
+QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
+{
+    aiMesh *mesh = m_scene->m_aiScene->mMeshes[meshIndex];
+    // Converted when parsing the scene
+    const MeshData &meshData = m_scene->m_meshData[meshIndex];
+
+    QGeometryRenderer *geometryRenderer = QAbstractNodeFactory::createNode<QGeometryRenderer>("QGeometryRenderer");
+    QGeometry *meshGeometry = QAbstractNodeFactory::createNode<QGeometry>("QGeometry");
+    meshGeometry->setParent(geometryRenderer);
+    Qt3DCore::QBuffer *vertexBuffer = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
+    vertexBuffer->setParent(meshGeometry);
+    Qt3DCore::QBuffer *indexBuffer = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
+    indexBuffer->setParent(meshGeometry);
+
+    geometryRenderer->setGeometry(meshGeometry);
+
+    const bool hasTangent = meshData.hasTangent;
+    const bool hasTexture = meshData.hasTexture;
+    const bool hasColor = meshData.hasColor;
+    const ushort chunkSize = meshData.chunkSize;
+
+    vertexBuffer->setData(meshData.vertexData);
 
     // Add vertex attributes to the mesh with the right array
     QAttribute *positionAttribute = createAttribute(vertexBuffer, VERTICES_ATTRIBUTE_NAME,
@@ -766,46 +874,19 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
         meshGeometry->addAttribute(colorAttribute);
     }
 
-    QAttribute::VertexBaseType indiceType;
-    QByteArray ibufferContent;
-    uint indices = mesh->mNumFaces * 3;
-    // If there are less than 65535 indices, indices can then fit in ushort
-    // which saves video memory
-    if (indices >= USHRT_MAX) {
-        indiceType = QAttribute::UnsignedInt;
-        ibufferContent.resize(indices * sizeof(quint32));
-        for (uint i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            Q_ASSERT(face.mNumIndices == 3);
-            memcpy(&reinterpret_cast<quint32*>(ibufferContent.data())[i * 3], face.mIndices, 3 * sizeof(uint));
-        }
-    }
-    else {
-        indiceType = QAttribute::UnsignedShort;
-        ibufferContent.resize(indices * sizeof(quint16));
-        for (uint i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            Q_ASSERT(face.mNumIndices == 3);
-            for (ushort j = 0; j < face.mNumIndices; j++)
-                reinterpret_cast<quint16*>(ibufferContent.data())[i * 3 + j] = face.mIndices[j];
-        }
-    }
-
-    indexBuffer->setData(ibufferContent);
+    const uint indices = meshData.indexCount;
+    indexBuffer->setData(meshData.indexData);
 
     // Add indices attributes
-    QAttribute *indexAttribute = createIndexAttribute(indexBuffer, indiceType, 1, indices);
+    QAttribute *indexAttribute = createIndexAttribute(indexBuffer, meshData.indexType, 1, indices);
     indexAttribute->setAttributeType(QAttribute::IndexAttribute);
 
     meshGeometry->addAttribute(indexAttribute);
 
-    if (mesh->mNumAnimMeshes > 0) {
+    if (!meshData.morphTargetData.empty()) {
 
         aiAnimMesh *animesh = mesh->mAnimMeshes[0];
 
-        if (animesh->mNumVertices != mesh->mNumVertices)
-            return geometryRenderer;
-
         Qt3DAnimation::QMorphingAnimation *morphingAnimation
                 = new Qt3DAnimation::QMorphingAnimation(geometryRenderer);
         QList<QString> names;
@@ -845,53 +926,17 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
             coloff = offset;
         }
 
-        ushort clumpSize = (animesh->mVertices ? 3 : 0)
-                            + (animesh->mNormals ? 3 : 0)
-                            + (animesh->mTangents ? 3 : 0)
-                            + (animesh->mColors[0] ? 4 : 0)
-                            + (animesh->mTextureCoords[0] ? 2 : 0);
-
+        const ushort clumpSize = meshData.morphTargetClumpSize;
 
         for (uint i = 0; i < mesh->mNumAnimMeshes; i++) {
             aiAnimMesh *animesh = mesh->mAnimMeshes[i];
             Qt3DAnimation::QMorphTarget *target = new Qt3DAnimation::QMorphTarget(geometryRenderer);
             targets.push_back(target);
             QList<QAttribute *> attributes;
-            QByteArray targetBufferArray;
-            targetBufferArray.resize(clumpSize * mesh->mNumVertices * sizeof(float));
-            float *dst = reinterpret_cast<float *>(targetBufferArray.data());
-
-            for (uint j = 0; j < mesh->mNumVertices; j++) {
-                if (animesh->mVertices) {
-                    *dst++ = animesh->mVertices[j].x;
-                    *dst++ = animesh->mVertices[j].y;
-                    *dst++ = animesh->mVertices[j].z;
-                }
-                if (animesh->mNormals) {
-                    *dst++ = animesh->mNormals[j].x;
-                    *dst++ = animesh->mNormals[j].y;
-                    *dst++ = animesh->mNormals[j].z;
-                }
-                if (animesh->mTangents) {
-                    *dst++ = animesh->mTangents[j].x;
-                    *dst++ = animesh->mTangents[j].y;
-                    *dst++ = animesh->mTangents[j].z;
-                }
-                if (animesh->mTextureCoords[0]) {
-                    *dst++ = animesh->mTextureCoords[0][j].x;
-                    *dst++ = animesh->mTextureCoords[0][j].y;
-                }
-                if (animesh->mColors[0]) {
-                    *dst++ = animesh->mColors[0][j].r;
-                    *dst++ = animesh->mColors[0][j].g;
-                    *dst++ = animesh->mColors[0][j].b;
-                    *dst++ = animesh->mColors[0][j].a;
-                }
-            }
 
             Qt3DCore::QBuffer *targetBuffer
                     = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
-            targetBuffer->setData(targetBufferArray);
+            targetBuffer->setData(meshData.morphTargetData[i]);
             targetBuffer->setParent(meshGeometry);
 
             if (animesh->mVertices) {
@@ -28,6 +28,7 @@
 
 #include "assimphelpers.h"
 
+#include <Qt3DCore/qattribute.h>
 #include <Qt3DRender/private/qsceneimporter_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -79,6 +80,22 @@ private:
     void cleanup();
     void parse();
 
+    // Content of the buffers of a mesh
+    struct MeshData {
+        QByteArray vertexData;
+        QByteArray indexData;
+        QList<QByteArray> morphTargetData;
+        Qt3DCore::QAttribute::VertexBaseType indexType = Qt3DCore::QAttribute::UnsignedShort;
+        uint indexCount = 0;
+        ushort chunkSize = 0;
+        ushort morphTargetClumpSize = 0;
+        bool hasTangent = false;
+        bool hasTexture = false;
+        bool hasColor = false;
+    };
+
+    static MeshData convertMesh(const aiMesh *mesh);
+
     QMaterial *loadMaterial(uint materialIndex);
     QGeometryRenderer *loadMesh(uint meshIndex);
     QAbstractTexture *loadEmbeddedTexture(uint textureIndex);
@@ -106,6 +123,7 @@ private:
         QHash<aiTextureType, QString> m_textureToParameterName;
         QList<Qt3DAnimation::QKeyframeAnimation *> m_animations;
         QList<Qt3DAnimation::QMorphingAnimation *> m_morphAnimations;
+        QList<MeshData> m_meshData;
     };
 
     QDir     m_sceneDir;
@@ -73,6 +73,7 @@
 
 #include <private/qurlhelper_p.h>
 #include <private/qloadgltf_p.h>
+#include <Qt3DCore/private/qattribute_p.h>
 
 /**
   * glTF 2.0 conformance report
@@ -137,6 +138,8 @@
 #define KEY_ORTHOGRAPHIC       QLatin1String("orthographic")
 #define KEY_NAME               QLatin1String("name")
 #define KEY_COUNT              QLatin1String("count")
+#define KEY_MIN                QLatin1String("min")
+#define KEY_MAX                QLatin1String("max")
 #define KEY_YFOV               QLatin1String("yfov")
 #define KEY_ZNEAR              QLatin1String("znear")
 #define KEY_ZFAR               QLatin1String("zfar")
@@ -688,6 +691,7 @@ GLTFImporter::AccessorData::AccessorData()
     , count(0)
     , offset(0)
     , stride(0)
+    , hasBounds(false)
 {
 
 }
@@ -697,7 +701,8 @@ GLTFImporter::AccessorData::AccessorData(const QJsonObject &json, int major, int
       dataSize(accessorDataSizeFromJson(json.value(KEY_TYPE).toString())),
       count(json.value(KEY_COUNT).toInt()),
       offset(0),
-      stride(0)
+      stride(0),
+      hasBounds(false)
 {
     Q_UNUSED(minor);
 
@@ -713,6 +718,15 @@ GLTFImporter::AccessorData::AccessorData(const QJsonObject &json, int major, int
     const auto byteStride = json.value(KEY_BYTE_STRIDE);
     if (!byteStride.isUndefined())
         stride = byteStride.toInt();
+
+    // Extent of the values, used to speed up bounding volume computations
+    const QJsonArray minArray = json.value(KEY_MIN).toArray();
+    const QJsonArray maxArray = json.value(KEY_MAX).toArray();
+    if (type == QAttribute::Float && dataSize == 3 && minArray.size() == 3 && maxArray.size() == 3) {
+        minBound = jsonArrToVec3(minArray);
+        maxBound = jsonArrToVec3(maxArray);
+        hasBounds = true;
+    }
 }
 
 bool GLTFImporter::isGLTFSupported(const QStringList &extensions)
@@ -1741,6 +1755,8 @@ void GLTFImporter::processJSONMesh(const QString &id, const QJsonObject &json)
                                                        accessorIt->offset,
                                                        accessorIt->stride);
                 attribute->setAttributeType(QAttribute::VertexAttribute);
+                if (accessorIt->hasBounds)
+                    QAttributePrivate::get(attribute)->setBounds(accessorIt->minBound, accessorIt->maxBound);
                 meshGeometry->addAttribute(attribute);
             }
 
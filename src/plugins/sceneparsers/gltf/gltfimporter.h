@@ -22,6 +22,7 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtGui/qvector3d.h>
 
 #include <Qt3DRender/private/qsceneimporter_p.h>
 
@@ -104,6 +105,9 @@ private:
         int count;
         int offset;
         int stride;
+        QVector3D minBound;
+        QVector3D maxBound;
+        bool hasBounds;
     };
 
     static bool isGLTFSupported(const QStringList &extensions);
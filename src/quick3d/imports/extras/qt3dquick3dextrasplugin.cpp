@@ -38,6 +38,7 @@
 #include <Qt3DExtras/qspheremesh.h>
 #include <Qt3DExtras/qspritegrid.h>
 #include <Qt3DExtras/qspritesheetitem.h>
+#include <Qt3DExtras/qtext2dbatch.h>
 #include <Qt3DExtras/qtext2dentity.h>
 #include <Qt3DExtras/qtexturematerial.h>
 #include <Qt3DExtras/qtorusgeometry.h>
@@ -116,6 +117,7 @@ void Qt3DQuick3DExtrasPlugin::registerTypes(const char *uri)
     qmlRegisterType<Qt3DExtras::QExtrudedTextMesh>(uri, 2, 9, "ExtrudedTextMesh");
 
     qmlRegisterType<Qt3DExtras::QText2DEntity>(uri, 2, 9, "Text2DEntity");
+    qmlRegisterType<Qt3DExtras::QText2DBatch>(uri, 2, 16, "Text2DBatch");
 
     // Auto-increment the import to stay in sync with ALL future Qt minor versions
     qmlRegisterModule(uri, 2, 15);
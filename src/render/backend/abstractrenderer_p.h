@@ -125,7 +125,11 @@ public:
     virtual void clearDirtyBits(BackendNodeDirtySet changes) = 0;
 #endif
     virtual bool shouldRender() const = 0;
+    // Whether the simulation loop has to keep running for this renderer
+    virtual bool needsNextFrame() const { return shouldRender(); }
     virtual void skipNextFrame() = 0;
+    // Called on the aspect thread while the jobs of the frame are running
+    virtual void jobsEnqueued() {}
     virtual void jobsDone(Qt3DCore::QAspectManager *manager) = 0;
 
     virtual bool processMouseEvent(QObject *object, QMouseEvent *event) = 0;
@@ -0,0 +1,101 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DRENDER_RENDER_DIRTYNODEQUEUE_P_H
+#define QT3DRENDER_RENDER_DIRTYNODEQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGlobal>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Storage a node needs to be queued in a DirtyNodeQueue. Nodes expose it
+// through a dirtyNodeQueueLink() member function.
+template<class Node>
+struct DirtyNodeQueueLink
+{
+    DirtyNodeQueueLink() = default;
+    Q_DISABLE_COPY(DirtyNodeQueueLink)
+
+    Node *next = nullptr;
+    std::atomic<bool> queued = false;
+};
+
+// Lock-free list of the backend nodes that became dirty since the last time
+// it was consumed, so that gatherers don't have to go over every active
+// handle of a manager to find them. Nodes can be pushed from any thread,
+// a node is only queued once until consumed. The nodes are not owned, since
+// managers never free released nodes a queued node can be released before
+// the queue is consumed, consumers have to check the node is still alive.
+template<class Node>
+class DirtyNodeQueue
+{
+public:
+    DirtyNodeQueue() = default;
+
+    // Returns false if the node was already queued
+    bool push(Node *node) noexcept
+    {
+        DirtyNodeQueueLink<Node> &link = node->dirtyNodeQueueLink();
+        if (link.queued.exchange(true))
+            return false;
+
+        Node *head = m_head.load(std::memory_order_relaxed);
+        do {
+            link.next = head;
+        } while (!m_head.compare_exchange_weak(head, node,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+        return true;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return m_head.load(std::memory_order_relaxed) == nullptr;
+    }
+
+    // Takes all queued nodes and calls \a f on each of them. A node pushed
+    // again while \a f runs is queued for the next call.
+    template<typename F>
+    void consume(F &&f)
+    {
+        Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            DirtyNodeQueueLink<Node> &link = node->dirtyNodeQueueLink();
+            Node *next = link.next;
+            link.next = nullptr;
+            link.queued.store(false);
+            f(node);
+            node = next;
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(DirtyNodeQueue)
+
+    std::atomic<Node *> m_head = nullptr;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_DIRTYNODEQUEUE_P_H
@@ -99,22 +99,8 @@ void Entity::cleanup()
     // Release all component will have to perform their own release when they receive the
     // NodeDeleted notification
     // Clear components
-    m_transformComponent = Qt3DCore::QNodeId();
-    m_cameraComponent = Qt3DCore::QNodeId();
-    m_materialComponent = Qt3DCore::QNodeId();
-    m_geometryRendererComponent = Qt3DCore::QNodeId();
-    m_pickingProxyComponent = Qt3DCore::QNodeId();
-    m_objectPickerComponent = QNodeId();
-    m_boundingVolumeDebugComponent = QNodeId();
-    m_computeComponent = QNodeId();
-    m_armatureComponent = QNodeId();
+    m_components = {};
     m_childrenHandles.clear();
-    m_layerComponents.clear();
-    m_levelOfDetailComponents.clear();
-    m_rayCasterComponents.clear();
-    m_shaderDataComponents.clear();
-    m_lightComponents.clear();
-    m_environmentLightComponents.clear();
     m_localBoundingVolume.reset();
     m_worldBoundingVolume.reset();
     m_worldBoundingVolumeWithChildren.reset();
@@ -180,21 +166,7 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (firstTime) {
         m_worldTransform = m_nodeManagers->worldMatrixManager()->getOrAcquireHandle(peerId());
 
-        // TODO: Suboptimal -> Maybe have a Hash<QComponent, QEntityList> instead
-        m_transformComponent = QNodeId();
-        m_materialComponent = QNodeId();
-        m_cameraComponent = QNodeId();
-        m_geometryRendererComponent = QNodeId();
-        m_pickingProxyComponent = QNodeId();
-        m_objectPickerComponent = QNodeId();
-        m_boundingVolumeDebugComponent = QNodeId();
-        m_computeComponent = QNodeId();
-        m_layerComponents.clear();
-        m_levelOfDetailComponents.clear();
-        m_rayCasterComponents.clear();
-        m_shaderDataComponents.clear();
-        m_lightComponents.clear();
-        m_environmentLightComponents.clear();
+        m_components = {};
         m_localBoundingVolume = QSharedPointer<Sphere>::create(peerId());
         m_worldBoundingVolume = QSharedPointer<Sphere>::create(peerId());
         m_worldBoundingVolumeWithChildren = QSharedPointer<Sphere>::create(peerId());
@@ -275,6 +247,43 @@ const Matrix4x4 *Entity::worldTransform() const
     return m_nodeManagers->worldMatrixManager()->data(m_worldTransform);
 }
 
+template<class Backend, class Manager>
+void Entity::setComponent(ComponentSlot<Backend> &slot, QNodeId id, Manager *(NodeManagers::*manager)() const noexcept)
+{
+    slot.id = id;
+    slot.handle = m_nodeManagers ? (m_nodeManagers->*manager)()->lookupHandle(id) : Qt3DCore::QHandle<Backend>();
+}
+
+template<class Backend, class Manager>
+void Entity::appendComponent(ComponentListSlot<Backend> &slot, QNodeId id, Manager *(NodeManagers::*manager)() const noexcept)
+{
+    slot.ids.push_back(id);
+    slot.handles.push_back(m_nodeManagers ? (m_nodeManagers->*manager)()->lookupHandle(id) : Qt3DCore::QHandle<Backend>());
+}
+
+template<class Backend>
+bool Entity::takeComponent(ComponentSlot<Backend> &slot, QNodeId id)
+{
+    if (slot.id != id)
+        return false;
+    slot = {};
+    return true;
+}
+
+template<class Backend>
+bool Entity::takeComponent(ComponentListSlot<Backend> &slot, QNodeId id)
+{
+    bool removed = false;
+    for (qsizetype i = slot.ids.size() - 1; i >= 0; --i) {
+        if (slot.ids[i] == id) {
+            slot.ids.removeAt(i);
+            slot.handles.erase(slot.handles.begin() + i);
+            removed = true;
+        }
+    }
+    return removed;
+}
+
 void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
 {
     // The backend element is always created when this method is called
@@ -283,76 +292,57 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     const auto id = idAndType.id;
     qCDebug(Render::RenderNodes) << Q_FUNC_INFO << "id =" << id << type->className();
     if (type->inherits(&Qt3DCore::QTransform::staticMetaObject)) {
-        m_transformComponent = id;
+        setComponent(m_components.transform, id, &NodeManagers::transformManager);
     } else if (type->inherits(&QCameraLens::staticMetaObject)) {
-        m_cameraComponent = id;
+        setComponent(m_components.camera, id, &NodeManagers::cameraManager);
     } else if (type->inherits(&QLayer::staticMetaObject)) {
-        m_layerComponents.append(id);
+        appendComponent(m_components.layers, id, &NodeManagers::layerManager);
     } else if (type->inherits(&QLevelOfDetail::staticMetaObject)) {
-        m_levelOfDetailComponents.append(id);
+        appendComponent(m_components.levelOfDetails, id, &NodeManagers::levelOfDetailManager);
     } else if (type->inherits(&QRayCaster::staticMetaObject)) {
-        m_rayCasterComponents.append(id);
+        appendComponent(m_components.rayCasters, id, &NodeManagers::rayCasterManager);
     } else if (type->inherits(&QScreenRayCaster::staticMetaObject)) {
-        m_rayCasterComponents.append(id);
+        appendComponent(m_components.rayCasters, id, &NodeManagers::rayCasterManager);
     } else if (type->inherits(&QMaterial::staticMetaObject)) {
-        m_materialComponent = id;
+        setComponent(m_components.material, id, &NodeManagers::materialManager);
     } else if (type->inherits(&QAbstractLight::staticMetaObject)) { // QAbstractLight subclasses QShaderData
-        m_lightComponents.append(id);
+        appendComponent(m_components.lights, id, &NodeManagers::lightManager);
     } else if (type->inherits(&QEnvironmentLight::staticMetaObject)) {
-        m_environmentLightComponents.append(id);
+        appendComponent(m_components.environmentLights, id, &NodeManagers::environmentLightManager);
     } else if (type->inherits(&QShaderData::staticMetaObject)) {
-        m_shaderDataComponents.append(id);
+        appendComponent(m_components.shaderData, id, &NodeManagers::shaderDataManager);
     } else if (type->inherits(&QGeometryRenderer::staticMetaObject)) {
-        m_geometryRendererComponent = id;
+        setComponent(m_components.geometryRenderer, id, &NodeManagers::geometryRendererManager);
         m_boundingDirty = true;
     } else if (type->inherits(&QPickingProxy::staticMetaObject)) {
-        m_pickingProxyComponent = id;
+        setComponent(m_components.pickingProxy, id, &NodeManagers::pickingProxyManager);
     } else if (type->inherits(&QObjectPicker::staticMetaObject)) {
-        m_objectPickerComponent = id;
-//    } else if (type->inherits(&QBoundingVolumeDebug::staticMetaObject)) {
-//        m_boundingVolumeDebugComponent = id;
+        setComponent(m_components.objectPicker, id, &NodeManagers::objectPickerManager);
     } else if (type->inherits(&QComputeCommand::staticMetaObject)) {
-        m_computeComponent = id;
+        setComponent(m_components.compute, id, &NodeManagers::computeJobManager);
     } else if (type->inherits(&QArmature::staticMetaObject)) {
-        m_armatureComponent = id;
+        setComponent(m_components.armature, id, &NodeManagers::armatureManager);
     }
     markDirty(AbstractRenderer::AllDirty);
 }
 
 void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
 {
-    if (m_transformComponent == nodeId) {
-        m_transformComponent = QNodeId();
-    } else if (m_cameraComponent == nodeId) {
-        m_cameraComponent = QNodeId();
-    } else if (m_layerComponents.contains(nodeId)) {
-        m_layerComponents.removeAll(nodeId);
-    } else if (m_levelOfDetailComponents.contains(nodeId)) {
-        m_levelOfDetailComponents.removeAll(nodeId);
-    } else if (m_rayCasterComponents.contains(nodeId)) {
-        m_rayCasterComponents.removeAll(nodeId);
-    } else if (m_materialComponent == nodeId) {
-        m_materialComponent = QNodeId();
-    } else if (m_shaderDataComponents.contains(nodeId)) {
-        m_shaderDataComponents.removeAll(nodeId);
-    } else if (m_geometryRendererComponent == nodeId) {
-        m_geometryRendererComponent = QNodeId();
+    if (takeComponent(m_components.geometryRenderer, nodeId))
         m_boundingDirty = true;
-    } else if (m_pickingProxyComponent == nodeId) {
-        m_pickingProxyComponent = QNodeId();
-    } else if (m_objectPickerComponent == nodeId) {
-        m_objectPickerComponent = QNodeId();
-//    } else if (m_boundingVolumeDebugComponent == nodeId) {
-//        m_boundingVolumeDebugComponent = QNodeId();
-    } else if (m_lightComponents.contains(nodeId)) {
-        m_lightComponents.removeAll(nodeId);
-    } else if (m_environmentLightComponents.contains(nodeId)) {
-        m_environmentLightComponents.removeAll(nodeId);
-    } else if (m_computeComponent == nodeId) {
-        m_computeComponent = QNodeId();
-    } else if (m_armatureComponent == nodeId) {
-        m_armatureComponent = QNodeId();
-    }
+    takeComponent(m_components.transform, nodeId);
+    takeComponent(m_components.camera, nodeId);
+    takeComponent(m_components.material, nodeId);
+    takeComponent(m_components.pickingProxy, nodeId);
+    takeComponent(m_components.objectPicker, nodeId);
+    takeComponent(m_components.compute, nodeId);
+    takeComponent(m_components.armature, nodeId);
+    takeComponent(m_components.layers, nodeId);
+    takeComponent(m_components.levelOfDetails, nodeId);
+    takeComponent(m_components.rayCasters, nodeId);
+    takeComponent(m_components.shaderData, nodeId);
+    takeComponent(m_components.lights, nodeId);
+    takeComponent(m_components.environmentLights, nodeId);
     markDirty(AbstractRenderer::AllDirty);
 }
 
@@ -368,7 +358,7 @@ void Entity::unsetBoundingVolumeDirty()
 
 void Entity::addRecursiveLayerId(const QNodeId layerId)
 {
-    if (!m_recursiveLayerComponents.contains(layerId) && !m_layerComponents.contains(layerId))
+    if (!m_recursiveLayerComponents.contains(layerId) && !m_components.layers.ids.contains(layerId))
         m_recursiveLayerComponents.push_back(layerId);
 }
 
@@ -377,20 +367,20 @@ void Entity::removeRecursiveLayerId(const QNodeId layerId)
     m_recursiveLayerComponents.removeOne(layerId);
 }
 
-ENTITY_COMPONENT_TEMPLATE_IMPL(Material, HMaterial, MaterialManager, m_materialComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(CameraLens, HCamera, CameraManager, m_cameraComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(Transform, HTransform, TransformManager, m_transformComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(GeometryRenderer, HGeometryRenderer, GeometryRendererManager, m_geometryRendererComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(PickingProxy, HPickingProxy, PickingProxyManager, m_pickingProxyComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(ObjectPicker, HObjectPicker, ObjectPickerManager, m_objectPickerComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(ComputeCommand, HComputeCommand, ComputeCommandManager, m_computeComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(Armature, HArmature, ArmatureManager, m_armatureComponent)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Layer, HLayer, LayerManager, m_layerComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(LevelOfDetail, HLevelOfDetail, LevelOfDetailManager, m_levelOfDetailComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(RayCaster, HRayCaster, RayCasterManager, m_rayCasterComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(ShaderData, HShaderData, ShaderDataManager, m_shaderDataComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Light, HLight, LightManager, m_lightComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(EnvironmentLight, HEnvironmentLight, EnvironmentLightManager, m_environmentLightComponents)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Material, HMaterial, MaterialManager, m_components.material)
+ENTITY_COMPONENT_TEMPLATE_IMPL(CameraLens, HCamera, CameraManager, m_components.camera)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Transform, HTransform, TransformManager, m_components.transform)
+ENTITY_COMPONENT_TEMPLATE_IMPL(GeometryRenderer, HGeometryRenderer, GeometryRendererManager, m_components.geometryRenderer)
+ENTITY_COMPONENT_TEMPLATE_IMPL(PickingProxy, HPickingProxy, PickingProxyManager, m_components.pickingProxy)
+ENTITY_COMPONENT_TEMPLATE_IMPL(ObjectPicker, HObjectPicker, ObjectPickerManager, m_components.objectPicker)
+ENTITY_COMPONENT_TEMPLATE_IMPL(ComputeCommand, HComputeCommand, ComputeCommandManager, m_components.compute)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Armature, HArmature, ArmatureManager, m_components.armature)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Layer, HLayer, LayerManager, m_components.layers)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(LevelOfDetail, HLevelOfDetail, LevelOfDetailManager, m_components.levelOfDetails)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(RayCaster, HRayCaster, RayCasterManager, m_components.rayCasters)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(ShaderData, HShaderData, ShaderDataManager, m_components.shaderData)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Light, HLight, LightManager, m_components.lights)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(EnvironmentLight, HEnvironmentLight, EnvironmentLightManager, m_components.environmentLights)
 
 RenderEntityFunctor::RenderEntityFunctor(AbstractRenderer *renderer, NodeManagers *manager)
     : m_nodeManagers(manager)
@@ -86,7 +86,7 @@ public:
     void setTreeEnabled(bool enabled) { m_treeEnabled = enabled; }
     bool isTreeEnabled() const { return m_treeEnabled; }
 
-    Qt3DCore::QNodeIdVector layerIds() const { return m_layerComponents + m_recursiveLayerComponents; }
+    Qt3DCore::QNodeIdVector layerIds() const { return m_components.layers.ids + m_recursiveLayerComponents; }
     void addRecursiveLayerId(const Qt3DCore::QNodeId layerId);
     void removeRecursiveLayerId(const Qt3DCore::QNodeId layerId);
     void clearRecursiveLayerIds() { m_recursiveLayerComponents.clear(); }
@@ -146,6 +146,53 @@ protected:
     Q_DECLARE_PRIVATE(Entity)
 
 private:
+    // Components keep the handle of their backend node next to their id so
+    // that resolving them doesn't require a lookup in the manager. The handle
+    // is only trusted while its counter matches the resource it points to.
+    template<class Backend>
+    struct ComponentSlot
+    {
+        Qt3DCore::QNodeId id;
+        Qt3DCore::QHandle<Backend> handle;
+    };
+
+    template<class Backend>
+    struct ComponentListSlot
+    {
+        Qt3DCore::QNodeIdVector ids;
+        // Indexed like ids
+        std::vector<Qt3DCore::QHandle<Backend>> handles;
+    };
+
+    struct ComponentTable
+    {
+        ComponentSlot<Transform> transform;
+        ComponentSlot<Material> material;
+        ComponentSlot<CameraLens> camera;
+        ComponentSlot<GeometryRenderer> geometryRenderer;
+        ComponentSlot<PickingProxy> pickingProxy;
+        ComponentSlot<ObjectPicker> objectPicker;
+        ComponentSlot<ComputeCommand> compute;
+        ComponentSlot<Armature> armature;
+        ComponentListSlot<Layer> layers;
+        ComponentListSlot<LevelOfDetail> levelOfDetails;
+        ComponentListSlot<RayCaster> rayCasters;
+        ComponentListSlot<ShaderData> shaderData;
+        ComponentListSlot<Light> lights;
+        ComponentListSlot<EnvironmentLight> environmentLights;
+    };
+
+    template<class Backend, class Manager>
+    void setComponent(ComponentSlot<Backend> &slot, Qt3DCore::QNodeId id,
+                      Manager *(NodeManagers::*manager)() const noexcept);
+    template<class Backend, class Manager>
+    void appendComponent(ComponentListSlot<Backend> &slot, Qt3DCore::QNodeId id,
+                         Manager *(NodeManagers::*manager)() const noexcept);
+    template<class Backend>
+    static bool takeComponent(ComponentSlot<Backend> &slot, Qt3DCore::QNodeId id);
+    template<class Backend>
+    static bool takeComponent(ComponentListSlot<Backend> &slot, Qt3DCore::QNodeId id);
+
     NodeManagers *m_nodeManagers;
     HEntity m_handle;
     HEntity m_parentHandle;
@@ -156,22 +203,7 @@ private:
     QSharedPointer<Sphere> m_worldBoundingVolume;
     QSharedPointer<Sphere> m_worldBoundingVolumeWithChildren;
 
-    // Handles to Components
-    Qt3DCore::QNodeId m_transformComponent;
-    Qt3DCore::QNodeId m_materialComponent;
-    Qt3DCore::QNodeId m_cameraComponent;
-    QList<Qt3DCore::QNodeId> m_layerComponents;
-    QList<Qt3DCore::QNodeId> m_levelOfDetailComponents;
-    QList<Qt3DCore::QNodeId> m_rayCasterComponents;
-    QList<Qt3DCore::QNodeId> m_shaderDataComponents;
-    QList<Qt3DCore::QNodeId> m_lightComponents;
-    QList<Qt3DCore::QNodeId> m_environmentLightComponents;
-    Qt3DCore::QNodeId m_geometryRendererComponent;
-    Qt3DCore::QNodeId m_pickingProxyComponent;
-    Qt3DCore::QNodeId m_objectPickerComponent;
-    Qt3DCore::QNodeId m_boundingVolumeDebugComponent;
-    Qt3DCore::QNodeId m_computeComponent;
-    Qt3DCore::QNodeId m_armatureComponent;
+    ComponentTable m_components;
 
     // Includes recursive layers
     Qt3DCore::QNodeIdVector m_recursiveLayerComponents;
@@ -210,19 +242,23 @@ private:
     template<> \
     Handle Entity::componentHandle<Type>() const \
     { \
-        return m_nodeManagers->lookupHandle<Type, Manager, Handle>(variable); \
+        if (variable.handle.data() != nullptr) \
+            return variable.handle; \
+        return m_nodeManagers->lookupHandle<Type, Manager, Handle>(variable.id); \
     } \
     /* Component */ \
     template<> \
     Type *Entity::renderComponent<Type>() const \
     { \
-        return m_nodeManagers->lookupResource<Type, Manager>(variable); \
+        if (Type *component = variable.handle.data()) \
+            return component; \
+        return m_nodeManagers->lookupResource<Type, Manager>(variable.id); \
     } \
     /* Uuid */ \
     template<> \
     Qt3DCore::QNodeId Entity::componentUuid<Type>() const \
     { \
-        return variable; \
+        return variable.id; \
     }
 
 #define ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Type, Handle, Manager, variable) \
@@ -232,27 +268,33 @@ private:
     { \
         Manager *manager = m_nodeManagers->manager<Type, Manager>(); \
         QList<Handle> entries; \
-        entries.reserve(variable.size()); \
-        for (const QNodeId &id : variable) \
-            entries.push_back(manager->lookupHandle(id)); \
-        return entries; \
+        const qsizetype count = variable.ids.size(); \
+        entries.reserve(count); \
+        for (qsizetype i = 0; i < count; ++i) { \
+            const Handle &handle = variable.handles[i]; \
+            entries.push_back(handle.data() != nullptr ? handle : manager->lookupHandle(variable.ids[i])); \
         } \
+        return entries; \
+    } \
     /* Component */ \
     template<> \
     std::vector<Type *> Entity::renderComponents<Type>() const \
     { \
         Manager *manager = m_nodeManagers->manager<Type, Manager>(); \
         std::vector<Type *> entries; \
-        entries.reserve(variable.size()); \
-        for (const QNodeId &id : variable) \
-            entries.push_back(manager->lookupResource(id)); \
+        const qsizetype count = variable.ids.size(); \
+        entries.reserve(count); \
+        for (qsizetype i = 0; i < count; ++i) { \
+            Type *component = variable.handles[i].data(); \
+            entries.push_back(component != nullptr ? component : manager->lookupResource(variable.ids[i])); \
+        } \
         return entries; \
     } \
     /* Uuid */ \
     template<> \
     Qt3DCore::QNodeIdVector Entity::componentsUuid<Type>() const \
     { \
-        return variable; \
+        return variable.ids; \
     }
 
 ENTITY_COMPONENT_TEMPLATE_SPECIALIZATION(Material, HMaterial)
@@ -35,6 +35,7 @@
 #include <Qt3DRender/private/parameter_p.h>
 #include <Qt3DRender/private/shaderdata_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
 #include <Qt3DRender/private/textureimage_p.h>
 #include <Qt3DRender/private/attribute_p.h>
 #include <Qt3DRender/private/geometry_p.h>
@@ -237,6 +238,9 @@ public:
         return Qt3DCore::moveAndClear(m_textureIdsToCleanup);
     }
 
+    // Textures push themselves when their dirty flags are set
+    DirtyNodeQueue<Texture> &dirtyNodeQueue() noexcept { return m_dirtyNodeQueue; }
+
 #ifdef QT_BUILD_INTERNAL
     // For unit testing purposes only
     QList<Qt3DCore::QNodeId> textureIdsToCleanup() const
@@ -248,6 +252,7 @@ public:
 
 private:
     QList<Qt3DCore::QNodeId> m_textureIdsToCleanup;
+    DirtyNodeQueue<Texture> m_dirtyNodeQueue;
 };
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT TransformManager : public Qt3DCore::QResourceManager<
@@ -339,6 +344,12 @@ class Q_3DRENDERSHARED_PRIVATE_EXPORT TextureImageManager : public Qt3DCore::QRe
         Qt3DCore::QNodeId,
         Qt3DCore::NonLockingPolicy>
 {
+public:
+    // Texture images push themselves when they are modified
+    DirtyNodeQueue<TextureImage> &dirtyNodeQueue() noexcept { return m_dirtyNodeQueue; }
+
+private:
+    DirtyNodeQueue<TextureImage> m_dirtyNodeQueue;
 };
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT AttributeManager : public Qt3DCore::QResourceManager<
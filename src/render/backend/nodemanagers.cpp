@@ -10,6 +10,7 @@
 #include <Qt3DRender/private/techniquemanager_p.h>
 #include <Qt3DRender/private/armature_p.h>
 #include <Qt3DRender/private/skeleton_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -30,6 +31,8 @@ NodeManagers::NodeManagers()
     , m_renderPassManager(new RenderPassManager())
     , m_textureManager(new TextureManager())
     , m_textureImageManager(new TextureImageManager())
+    , m_textureDataManager(new TextureDataManager())
+    , m_textureImageDataManager(new TextureImageDataManager())
     , m_layerManager(new LayerManager())
     , m_levelOfDetailManager(new LevelOfDetailManager())
     , m_filterKeyManager(new FilterKeyManager())
@@ -80,6 +83,8 @@ NodeManagers::~NodeManagers()
     delete m_parameterManager;
     delete m_shaderDataManager;
     delete m_textureImageManager;
+    delete m_textureDataManager;
+    delete m_textureImageDataManager;
     delete m_bufferManager;
     delete m_attributeManager;
     delete m_geometryManager;
@@ -102,6 +107,32 @@ NodeManagers::~NodeManagers()
     delete m_shaderImageManager;
 }
 
+// Publishes read-only lookup tables for the managers that are queried
+// concurrently by the render jobs, so that these can look resources up
+// without contending on the managers' read/write locks.
+// Called by the aspect before jobs are launched, once the frontend changes
+// have been synced.
+void NodeManagers::publishLookupTables()
+{
+    m_shaderManager->publishLookupTable();
+    m_bufferManager->publishLookupTable();
+    m_geometryRendererManager->publishLookupTable();
+    m_sceneManager->publishLookupTable();
+}
+
+// Gives back the memory still held by the released geometry and shader
+// resources once a frame went by without allocating any, so that unloading
+// a large scene makes the memory go down. Called by the aspect before jobs
+// are launched, like publishLookupTables().
+void NodeManagers::trimIdleManagers()
+{
+    m_bufferManager->trimIfIdle();
+    m_attributeManager->trimIfIdle();
+    m_geometryManager->trimIfIdle();
+    m_geometryRendererManager->trimIfIdle();
+    m_shaderManager->trimIfIdle();
+}
+
 template<>
 CameraManager *NodeManagers::manager<CameraLens>() const noexcept
 {
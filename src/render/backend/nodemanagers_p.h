@@ -168,6 +168,8 @@ public:
     inline ParameterManager *parameterManager() const noexcept { return m_parameterManager; }
     inline ShaderDataManager *shaderDataManager() const noexcept { return m_shaderDataManager; }
     inline TextureImageManager *textureImageManager() const noexcept { return m_textureImageManager; }
+    inline TextureDataManager *textureDataManager() const noexcept { return m_textureDataManager; }
+    inline TextureImageDataManager *textureImageDataManager() const noexcept { return m_textureImageDataManager; }
     inline BufferManager *bufferManager() const noexcept { return m_bufferManager; }
     inline AttributeManager *attributeManager() const noexcept { return m_attributeManager; }
     inline GeometryManager *geometryManager() const noexcept { return m_geometryManager; }
@@ -185,6 +187,9 @@ public:
     inline ShaderImageManager *shaderImageManager() const noexcept { return m_shaderImageManager; }
     inline PickingProxyManager *pickingProxyManager() const noexcept { return m_pickingProxyManager; }
 
+    void publishLookupTables();
+    void trimIdleManagers();
+
 private:
     CameraManager *m_cameraManager;
     EntityManager *m_renderNodesManager;
@@ -197,6 +202,8 @@ private:
     RenderPassManager *m_renderPassManager;
     TextureManager *m_textureManager;
     TextureImageManager *m_textureImageManager;
+    TextureDataManager *m_textureDataManager;
+    TextureImageDataManager *m_textureImageDataManager;
     LayerManager *m_layerManager;
     LevelOfDetailManager *m_levelOfDetailManager;
     FilterKeyManager *m_filterKeyManager;
@@ -24,6 +24,7 @@ HEADERS += \
     $$PWD/trianglesvisitor_p.h \
     $$PWD/abstractrenderer_p.h \
     $$PWD/computecommand_p.h \
+    $$PWD/dirtynodequeue_p.h \
     $$PWD/rendersettings_p.h \
     $$PWD/stringtoint_p.h \
     $$PWD/backendnode_p.h \
@@ -60,6 +60,8 @@ void RenderSettings::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firs
         m_faceOrientationPickingMode = ncnode->pickingSettings()->faceOrientationPickingMode();
     }
 
+    m_prewarmedEntityIds = qIdsForNodes(node->prewarmedEntities());
+
     if (firstTime)
         m_capabilities = QRenderCapabilitiesPrivate::get(const_cast<QRenderSettings *>(node)->renderCapabilities())->toString();
 
@@ -40,6 +40,7 @@ public:
     QPickingSettings::FaceOrientationPickingMode faceOrientationPickingMode() const { return m_faceOrientationPickingMode; }
     float pickWorldSpaceTolerance() const { return m_pickWorldSpaceTolerance; }
     QString capabilities() const { return m_capabilities; }
+    Qt3DCore::QNodeIdVector prewarmedEntityIds() const { return m_prewarmedEntityIds; }
 
     // For unit test purposes
     void setActiveFrameGraphId(Qt3DCore::QNodeId frameGraphNodeId) { m_activeFrameGraph = frameGraphNodeId; }
@@ -52,6 +53,7 @@ private:
     float m_pickWorldSpaceTolerance;
     Qt3DCore::QNodeId m_activeFrameGraph;
     QString m_capabilities;
+    Qt3DCore::QNodeIdVector m_prewarmedEntityIds;
 };
 
 class RenderSettingsFunctor : public Qt3DCore::QBackendNodeMapper
@@ -60,6 +60,9 @@ namespace Qt3DRender {
  * \qmlproperty variant Qt3D.Render::RenderCaptureReply::image
  *
  * Holds the image, which was produced as a result of render capture.
+ *
+ * The image is null if the renderer released its graphics resources before
+ * the captured pixels could be read back.
  */
 
 /*!
@@ -136,6 +139,9 @@ QRenderCaptureReply::QRenderCaptureReply(QObject *parent)
  * \property QRenderCaptureReply::image
  *
  * Holds the image, which was produced as a result of render capture.
+ *
+ * The image is null if the renderer released its graphics resources before
+ * the captured pixels could be read back.
  */
 QImage QRenderCaptureReply::image() const
 {
@@ -143,6 +149,39 @@ QImage QRenderCaptureReply::image() const
     return d->m_image;
 }
 
+/*!
+ * Returns the pixels of a capture requested with
+ * QRenderCapture::requestRawCapture(), as read back by the renderer without
+ * any conversion, the rows being tightly packed.
+ *
+ * With the OpenGL renderer, the rows start with the bottom row of rect(). For
+ * 8 bit render targets each pixel has the layout of the QImage::Format
+ * image() would have had, for floating point render targets each pixel is
+ * made of 4 floats in RGBA order. With the RHI renderer, the pixels are RGBA8
+ * in the row order of the image() it would have returned.
+ *
+ * Returns an empty byte array for captures requested with requestCapture(),
+ * and for captures whose pixels could not be read back because the renderer
+ * released its graphics resources first, rect() being empty then.
+ * \since 6.5
+ */
+QByteArray QRenderCaptureReply::rawData() const
+{
+    Q_D(const QRenderCaptureReply);
+    return d->m_rawData;
+}
+
+/*!
+ * Returns the rectangle of the framebuffer rawData() was read from, which is
+ * the requested rectangle clipped to the framebuffer.
+ * \since 6.5
+ */
+QRect QRenderCaptureReply::rect() const
+{
+    Q_D(const QRenderCaptureReply);
+    return d->m_rect;
+}
+
 /*!
  * \property QRenderCaptureReply::captureId
  *
@@ -233,6 +272,38 @@ void QRenderCapturePrivate::setImage(QRenderCaptureReply *reply, const QImage &i
     reply->d_func()->m_image = image;
 }
 
+/*!
+ * \internal
+ */
+void QRenderCapturePrivate::setRawData(QRenderCaptureReply *reply, const QByteArray &data, const QRect &rect)
+{
+    reply->d_func()->m_complete = true;
+    reply->d_func()->m_rawData = data;
+    reply->d_func()->m_rect = rect;
+}
+
+/*!
+ * \internal
+ */
+QRenderCaptureReply *QRenderCapturePrivate::requestCapture(const QRect &rect, bool rawData)
+{
+    Q_Q(QRenderCapture);
+    static int captureId = 1;
+    QRenderCaptureReply *reply = createReply(captureId);
+    reply->setParent(q);
+    QObject::connect(reply, &QObject::destroyed, q, [this, reply] (QObject *) {
+        replyDestroyed(reply);
+    });
+
+    const QRenderCaptureRequest request = { captureId, rect, rawData };
+    m_pendingRequests.push_back(request);
+    update();
+
+    captureId++;
+
+    return reply;
+}
+
 /*!
  * \internal
  */
@@ -284,20 +355,23 @@ QRenderCaptureReply *QRenderCapture::requestCapture(int captureId)
 QRenderCaptureReply *QRenderCapture::requestCapture(const QRect &rect)
 {
     Q_D(QRenderCapture);
-    static int captureId = 1;
-    QRenderCaptureReply *reply = d->createReply(captureId);
-    reply->setParent(this);
-    QObject::connect(reply, &QObject::destroyed, this, [&, reply, d] (QObject *) {
-        d->replyDestroyed(reply);
-    });
-
-    const QRenderCaptureRequest request = { captureId, rect };
-    d->m_pendingRequests.push_back(request);
-    d->update();
-
-    captureId++;
+    return d->requestCapture(rect, false);
+}
 
-    return reply;
+/*!
+ * Used to request render capture from a specified \a rect without converting
+ * the captured pixels to a QImage, see QRenderCaptureReply::rawData(). An
+ * empty \a rect captures the whole framebuffer. The user is responsible for
+ * deallocating the returned object by calling deleteLater().
+ *
+ * The reply completes once the pixels have been read back, which can be a
+ * few frames after the one that was captured.
+ * \since 6.5
+ */
+QRenderCaptureReply *QRenderCapture::requestRawCapture(const QRect &rect)
+{
+    Q_D(QRenderCapture);
+    return d->requestCapture(rect, true);
 }
 
 /*!
@@ -24,6 +24,8 @@ class Q_3DRENDERSHARED_EXPORT QRenderCaptureReply : public QObject
 public:
 
     QImage image() const;
+    QByteArray rawData() const;
+    QRect rect() const;
     Q_DECL_DEPRECATED int captureId() const;
     bool isComplete() const;
 
@@ -49,6 +51,7 @@ public:
     Qt3DRender::QRenderCaptureReply *requestCapture(int captureId);
     Q_REVISION(9) Q_INVOKABLE Qt3DRender::QRenderCaptureReply *requestCapture();
     Q_REVISION(10) Q_INVOKABLE Qt3DRender::QRenderCaptureReply *requestCapture(const QRect &rect);
+    Qt3DRender::QRenderCaptureReply *requestRawCapture(const QRect &rect = QRect());
 
 private:
     Q_DECLARE_PRIVATE(QRenderCapture)
@@ -28,6 +28,7 @@ struct QRenderCaptureRequest
 {
     int captureId;
     QRect rect;
+    bool rawData = false;
 };
 
 class QRenderCapturePrivate : public QFrameGraphNodePrivate
@@ -41,7 +42,9 @@ public:
 
     QRenderCaptureReply *createReply(int captureId);
     QRenderCaptureReply *takeReply(int captureId);
+    QRenderCaptureReply *requestCapture(const QRect &rect, bool rawData);
     void setImage(QRenderCaptureReply *reply, const QImage &image);
+    void setRawData(QRenderCaptureReply *reply, const QByteArray &data, const QRect &rect);
     void replyDestroyed(QRenderCaptureReply *reply);
 
     Q_DECLARE_PUBLIC(QRenderCapture)
@@ -53,6 +56,8 @@ public:
     QRenderCaptureReplyPrivate();
 
     QImage m_image;
+    QByteArray m_rawData;
+    QRect m_rect;
     int m_captureId;
     bool m_complete;
 
@@ -65,6 +70,10 @@ struct RenderCaptureData
 {
     QImage image;
     int captureId;
+    // Only set for raw captures
+    bool raw = false;
+    QByteArray rawData;
+    QRect rect;
 };
 
 typedef QSharedPointer<RenderCaptureData> RenderCaptureDataPtr;
@@ -60,10 +60,16 @@ void RenderCapture::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool first
 // called by render thread
 void RenderCapture::addRenderCapture(int captureId, const QImage &image)
 {
-    QMutexLocker lock(&m_mutex);
     auto data = RenderCaptureDataPtr::create();
     data.data()->captureId = captureId;
     data.data()->image = image;
+    addRenderCapture(data);
+}
+
+// called by render thread or by a job once the capture was converted
+void RenderCapture::addRenderCapture(const RenderCaptureDataPtr &data)
+{
+    QMutexLocker lock(&m_mutex);
     m_renderCaptureData.push_back(data);
 }
 
@@ -80,7 +86,10 @@ void RenderCapture::syncRenderCapturesToFrontend(Qt3DCore::QAspectManager *manag
         QPointer<QRenderCaptureReply> reply = dfrontend->takeReply(data.data()->captureId);
         // Note: QPointer has no operator bool, we must use isNull() to check it
         if (!reply.isNull()) {
-            dfrontend->setImage(reply, data.data()->image);
+            if (data.data()->raw)
+                dfrontend->setRawData(reply, data.data()->rawData, data.data()->rect);
+            else
+                dfrontend->setImage(reply, data.data()->image);
             emit reply->completed();
         }
     }
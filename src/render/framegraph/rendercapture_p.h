@@ -33,6 +33,7 @@ public:
     bool wasCaptureRequested() const;
     QRenderCaptureRequest takeCaptureRequest();
     void addRenderCapture(int captureId, const QImage &image);
+    void addRenderCapture(const RenderCaptureDataPtr &data);
 
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
     void syncRenderCapturesToFrontend(Qt3DCore::QAspectManager *manager);
@@ -265,6 +265,7 @@ QRenderAspectPrivate::QRenderAspectPrivate(QRenderAspect::SubmissionType submiss
     , m_calculateBoundingVolumeJob(Render::CalculateBoundingVolumeJobPtr::create())
     , m_updateWorldBoundingVolumeJob(Render::UpdateWorldBoundingVolumeJobPtr::create())
     , m_updateSkinningPaletteJob(Render::UpdateSkinningPaletteJobPtr::create())
+    , m_loadTextureDataJob(Render::LoadTextureDataJobPtr::create())
     , m_updateLevelOfDetailJob(Render::UpdateLevelOfDetailJobPtr::create())
     , m_updateEntityLayersJob(Render::UpdateEntityLayersJobPtr::create())
     , m_syncLoadingJobs(CreateSynchronizerJobPtr([] {}, Render::JobTypes::SyncLoadingJobs))
@@ -277,6 +278,7 @@ QRenderAspectPrivate::QRenderAspectPrivate(QRenderAspect::SubmissionType submiss
     loadSceneParsers();
 
     m_updateWorldBoundingVolumeJob->addDependency(m_worldTransformJob);
+    m_updateWorldBoundingVolumeJob->setTransformHierarchy(&m_worldTransformJob->hierarchy());
     m_updateWorldBoundingVolumeJob->addDependency(m_calculateBoundingVolumeJob);
     m_calculateBoundingVolumeJob->addDependency(m_updateTreeEnabledJob);
     m_expandBoundingVolumeJob->addDependency(m_updateWorldBoundingVolumeJob);
@@ -316,6 +318,11 @@ QRenderAspectPrivate *QRenderAspectPrivate::get(QRenderAspect *q)
     return q->d_func();
 }
 
+void QRenderAspectPrivate::jobsEnqueued()
+{
+    m_renderer->jobsEnqueued();
+}
+
 void QRenderAspectPrivate::jobsDone()
 {
     m_renderer->jobsDone(m_aspectManager);
@@ -328,6 +335,17 @@ void QRenderAspectPrivate::frameDone()
         m_renderer->render(true);
 }
 
+bool QRenderAspectPrivate::needsNextFrame() const
+{
+    // When rendering isn't driven by the aspect loop, frames are requested
+    // by whoever renders
+    if (!m_renderer || !m_renderAfterJobs)
+        return true;
+    return m_renderer->needsNextFrame()
+            || m_loadTextureDataJob->hasPendingGenerators()
+            || hasPendingSingleShotJobs();
+}
+
 void QRenderAspectPrivate::createNodeManagers()
 {
     m_nodeManagers = new Render::NodeManagers();
@@ -338,6 +356,7 @@ void QRenderAspectPrivate::createNodeManagers()
     m_calculateBoundingVolumeJob->setManagers(m_nodeManagers);
     m_updateWorldBoundingVolumeJob->setManager(m_nodeManagers->renderNodesManager());
     m_updateSkinningPaletteJob->setManagers(m_nodeManagers);
+    m_loadTextureDataJob->setNodeManagers(m_nodeManagers);
     m_updateLevelOfDetailJob->setManagers(m_nodeManagers);
     m_updateEntityLayersJob->setManager(m_nodeManagers);
     m_pickBoundingVolumeJob->setManagers(m_nodeManagers);
@@ -639,6 +658,8 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
     // be null and we should not generate any jobs.
     if (d->m_renderer->isRunning() && d->m_renderer->settings()) {
         NodeManagers *manager = d->m_nodeManagers;
+        manager->trimIdleManagers();
+        manager->publishLookupTables();
         d->m_syncLoadingJobs->removeDependency(QWeakPointer<QAspectJob>());
         d->m_calculateBoundingVolumeJob->removeDependency(QWeakPointer<QAspectJob>());
         d->m_updateLevelOfDetailJob->setFrameGraphRoot(d->m_renderer->frameGraphRoot());
@@ -663,6 +684,10 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
             jobs.push_back(job);
         }
 
+        // Decode texture data requested by the renderer on the job threads
+        if (d->m_loadTextureDataJob->hasPendingGenerators())
+            jobs.push_back(d->m_loadTextureDataJob);
+
         const std::vector<QAspectJobPtr> geometryJobs = d->createGeometryRendererJobs();
         jobs.insert(jobs.end(), std::make_move_iterator(geometryJobs.begin()), std::make_move_iterator(geometryJobs.end()));
 
@@ -674,7 +699,10 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
         // perform picking,... must still be run)
         if (!d->m_renderer->shouldRender()) {
             d->m_renderer->skipNextFrame();
+#if !QT_CONFIG(animation)
+            // Without animations the loop is driven by posted events
             QThread::msleep(1);
+#endif
             return jobs;
         }
 
@@ -692,6 +720,9 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
 
         if (entitiesEnabledDirty ||
             dirtyBitsForFrame & AbstractRenderer::TransformDirty) {
+            // Changes to the entity tree are always flagged as enabled changes
+            if (entitiesEnabledDirty)
+                d->m_worldTransformJob->invalidateHierarchy();
             jobs.push_back(d->m_worldTransformJob);
             jobs.push_back(d->m_updateWorldBoundingVolumeJob);
         }
@@ -781,6 +812,7 @@ void QRenderAspect::onRegistered()
     d->m_renderer->setScreen(d->m_screen);
     d->m_renderer->setAspect(this);
     d->m_renderer->setNodeManagers(d->m_nodeManagers);
+    d->m_loadTextureDataJob->setRenderer(d->m_renderer);
 
     // Create a helper for deferring creation of an offscreen surface used during cleanup
     // to the main thread, after we know what the surface format in use is.
@@ -833,6 +865,7 @@ void QRenderAspect::onUnregistered()
     // Waits for the render thread to join (if using threaded renderer)
     delete d->m_renderer;
     d->m_renderer = nullptr;
+    d->m_loadTextureDataJob->setRenderer(nullptr);
 
     // Queue the offscreen surface helper for deletion on the main thread.
     // That will take care of deleting the offscreen surface itself.
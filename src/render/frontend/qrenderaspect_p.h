@@ -23,6 +23,7 @@
 #include <Qt3DRender/private/updateworldboundingvolumejob_p.h>
 #include <Qt3DRender/private/calcboundingvolumejob_p.h>
 #include <Qt3DRender/private/updateskinningpalettejob_p.h>
+#include <Qt3DRender/private/loadtexturedatajob_p.h>
 #include <Qt3DRender/private/updateentitylayersjob_p.h>
 #include <Qt3DRender/private/updatetreeenabledjob_p.h>
 #include <Qt3DRender/private/genericlambdajob_p.h>
@@ -67,8 +68,10 @@ public:
     static QRenderAspectPrivate* findPrivate(Qt3DCore::QAspectEngine *engine);
     static QRenderAspectPrivate *get(QRenderAspect *q);
 
+    void jobsEnqueued() override;
     void jobsDone() override;
     void frameDone() override;
+    bool needsNextFrame() const override;
 
     void createNodeManagers();
     void onEngineStartup();
@@ -104,6 +107,7 @@ public:
     Render::CalculateBoundingVolumeJobPtr m_calculateBoundingVolumeJob;
     Render::UpdateWorldBoundingVolumeJobPtr m_updateWorldBoundingVolumeJob;
     Render::UpdateSkinningPaletteJobPtr m_updateSkinningPaletteJob;
+    Render::LoadTextureDataJobPtr m_loadTextureDataJob;
     Render::UpdateLevelOfDetailJobPtr m_updateLevelOfDetailJob;
     Render::UpdateEntityLayersJobPtr m_updateEntityLayersJob;
     Render::SynchronizerJobPtr m_syncLoadingJobs;
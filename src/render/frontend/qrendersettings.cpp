@@ -7,6 +7,7 @@
 #include "qframegraphnode.h"
 #include "qrendersurfaceselector.h"
 #include "qrendersurfaceselector_p.h"
+#include <Qt3DCore/qentity.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -199,6 +200,62 @@ QRenderSettings::RenderPolicy QRenderSettings::renderPolicy() const
     return d->m_renderPolicy;
 }
 
+/*!
+    Adds \a entity to the entities whose graphics pipelines are prewarmed.
+
+    With the RHI renderer, the graphics pipelines needed to draw a prewarmed
+    entity, with each RenderView of the active \l{Qt 3D Render Framegraph}{FrameGraph}
+    whose layer, technique and render pass filters select it, are built
+    ahead of time, a few per frame, even while the entity isn't drawn (e.g.
+    its QGeometryRenderer is disabled or it is outside of the view frustum).
+    This keeps the first frames it is drawn in from stalling on pipeline
+    creation. The pipelines are kept alive for as long as the entity remains
+    prewarmed.
+
+    \since 6.5
+ */
+void QRenderSettings::addPrewarmedEntity(Qt3DCore::QEntity *entity)
+{
+    Q_ASSERT(entity);
+    Q_D(QRenderSettings);
+    if (!d->m_prewarmedEntities.contains(entity)) {
+        d->m_prewarmedEntities.append(entity);
+
+        // Ensures proper bookkeeping
+        d->registerDestructionHelper(entity, &QRenderSettings::removePrewarmedEntity, d->m_prewarmedEntities);
+
+        d->update();
+    }
+}
+
+/*!
+    Removes \a entity from the entities whose graphics pipelines are prewarmed.
+
+    \since 6.5
+ */
+void QRenderSettings::removePrewarmedEntity(Qt3DCore::QEntity *entity)
+{
+    Q_ASSERT(entity);
+    Q_D(QRenderSettings);
+    if (!d->m_prewarmedEntities.removeOne(entity))
+        return;
+    d->update();
+    // Remove bookkeeping connection
+    d->unregisterDestructionHelper(entity);
+}
+
+/*!
+    Returns the entities whose graphics pipelines are prewarmed.
+
+    \since 6.5
+    \sa addPrewarmedEntity()
+ */
+QList<Qt3DCore::QEntity *> QRenderSettings::prewarmedEntities() const
+{
+    Q_D(const QRenderSettings);
+    return d->m_prewarmedEntities;
+}
+
 void QRenderSettings::setActiveFrameGraph(QFrameGraphNode *activeFrameGraph)
 {
     Q_D(QRenderSettings);
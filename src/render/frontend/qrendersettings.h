@@ -40,6 +40,10 @@ public:
     QFrameGraphNode *activeFrameGraph() const;
     RenderPolicy renderPolicy() const;
 
+    void addPrewarmedEntity(Qt3DCore::QEntity *entity);
+    void removePrewarmedEntity(Qt3DCore::QEntity *entity);
+    QList<Qt3DCore::QEntity *> prewarmedEntities() const;
+
 public Q_SLOTS:
     void setActiveFrameGraph(QFrameGraphNode *activeFrameGraph);
     void setRenderPolicy(RenderPolicy renderPolicy);
@@ -36,6 +36,7 @@ public:
     QFrameGraphNode *m_activeFrameGraph;
     QRenderSettings::RenderPolicy m_renderPolicy;
     QRenderCapabilities m_renderCapabilities;
+    QList<Qt3DCore::QEntity *> m_prewarmedEntities;
 
     void invalidateFrame();
 
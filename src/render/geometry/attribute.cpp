@@ -22,6 +22,7 @@ Attribute::Attribute()
     , m_byteOffset(0)
     , m_divisor(0)
     , m_attributeType(QAttribute::VertexAttribute)
+    , m_hasBounds(false)
     , m_attributeDirty(false)
 {
 }
@@ -39,6 +40,9 @@ void Attribute::cleanup()
     m_byteOffset = 0;
     m_divisor = 0;
     m_attributeType = QAttribute::VertexAttribute;
+    m_minBound = QVector3D();
+    m_maxBound = QVector3D();
+    m_hasBounds = false;
     m_bufferId = Qt3DCore::QNodeId();
     m_name.clear();
     m_attributeDirty = false;
@@ -91,6 +95,15 @@ void Attribute::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         m_bufferId = bufferId;
         m_attributeDirty = true;
     }
+    const QAttributePrivate *dnode = static_cast<const QAttributePrivate *>(QNodePrivate::get(node));
+    if (m_hasBounds != dnode->m_hasBounds
+            || m_minBound != dnode->m_minBound
+            || m_maxBound != dnode->m_maxBound) {
+        m_hasBounds = dnode->m_hasBounds;
+        m_minBound = dnode->m_minBound;
+        m_maxBound = dnode->m_maxBound;
+        m_attributeDirty = true;
+    }
 
     markDirty(AbstractRenderer::AllDirty);
 }
@@ -17,6 +17,7 @@
 
 #include <Qt3DRender/private/backendnode_p.h>
 #include <Qt3DCore/qattribute.h>
+#include <QtGui/qvector3d.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -44,6 +45,9 @@ public:
     inline uint byteOffset() const { return m_byteOffset; }
     inline uint divisor() const { return m_divisor; }
     inline Qt3DCore::QAttribute::AttributeType attributeType() const { return m_attributeType; }
+    inline bool hasBounds() const { return m_hasBounds; }
+    inline QVector3D minBound() const { return m_minBound; }
+    inline QVector3D maxBound() const { return m_maxBound; }
     inline bool isDirty() const { return m_attributeDirty; }
     void unsetDirty();
 
@@ -58,6 +62,9 @@ private:
     uint m_byteOffset;
     uint m_divisor;
     Qt3DCore::QAttribute::AttributeType m_attributeType;
+    QVector3D m_minBound;
+    QVector3D m_maxBound;
+    bool m_hasBounds;
     bool m_attributeDirty;
 };
 
@@ -107,6 +107,8 @@ void Buffer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
             const_cast<Qt3DCore::QBuffer *>(node)->setProperty(Qt3DCore::QBufferPrivate::UpdateDataPropertyName, {});
         }
     }
+    if (m_bufferDirty && m_manager != nullptr)
+        m_manager->dirtyNodeQueue().push(this);
     markDirty(AbstractRenderer::BuffersDirty);
 }
 
@@ -17,6 +17,7 @@
 
 #include <QtCore>
 #include <Qt3DRender/private/backendnode_p.h>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
 #include <Qt3DCore/qbuffer.h>
 
 QT_BEGIN_NAMESPACE
@@ -48,6 +49,8 @@ public:
     inline Qt3DCore::QBuffer::AccessType access() const { return m_access; }
     void unsetDirty();
 
+    DirtyNodeQueueLink<Buffer> &dirtyNodeQueueLink() noexcept { return m_dirtyNodeQueueLink; }
+
 private:
     void forceDataUpload();
 
@@ -57,6 +60,7 @@ private:
     bool m_bufferDirty;
     Qt3DCore::QBuffer::AccessType m_access;
     BufferManager *m_manager;
+    DirtyNodeQueueLink<Buffer> m_dirtyNodeQueueLink;
 };
 
 class BufferFunctor : public Qt3DCore::QBackendNodeMapper
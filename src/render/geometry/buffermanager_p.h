@@ -17,6 +17,7 @@
 
 #include <Qt3DCore/private/qresourcemanager_p.h>
 #include <Qt3DRender/private/buffer_p.h>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -44,10 +45,14 @@ public:
     // Render Thread (no concurrent access)
     QList<Qt3DCore::QNodeId> takeBuffersToRelease();
 
+    // Buffers push themselves when their data needs to be uploaded
+    DirtyNodeQueue<Buffer> &dirtyNodeQueue() noexcept { return m_dirtyNodeQueue; }
+
 private:
     QList<Qt3DCore::QNodeId> m_dirtyBuffers;
     QHash<Qt3DCore::QNodeId, int> m_bufferReferences;
     QMutex m_mutex;
+    DirtyNodeQueue<Buffer> m_dirtyNodeQueue;
 };
 
 } // namespace Render
@@ -72,6 +72,11 @@ void QGeometryRendererPrivate::setView(QGeometryView *view)
     A GeometryRenderer holds all the information necessary to draw
     a Geometry. A Geometry holds the coordinates of the geometry data -
     GeometryRenderer specifies how to interpret that data.
+
+    With the RHI renderer, the graphics pipelines of an entity that will be
+    drawn later on, such as one whose GeometryRenderer is still disabled, can
+    be built ahead of time by declaring it from C++ with
+    QRenderSettings::addPrewarmedEntity().
  */
 
 /*!
@@ -83,6 +88,12 @@ void QGeometryRendererPrivate::setView(QGeometryView *view)
     A Qt3DRender::QGeometryRenderer holds all the information necessary to draw
     a Qt3DCore::QGeometry. A QGeometry holds the coordinates of the geometry data -
     QGeometryRenderer specifies how to interpret that data.
+
+    With the RHI renderer, the graphics pipelines of an entity that will be
+    drawn later on, such as one whose QGeometryRenderer is still disabled, can
+    be built ahead of time by declaring it with
+    QRenderSettings::addPrewarmedEntity(), so that enabling it doesn't stall
+    rendering.
  */
 
 
@@ -15,6 +15,7 @@
 #include <Qt3DCore/private/qskeleton_p.h>
 #include <Qt3DCore/private/qskeletonloader_p.h>
 #include <Qt3DCore/private/qmath3d_p.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -143,16 +144,16 @@ QVector<QMatrix4x4> Skeleton::calculateSkinningMatrixPalette()
     const QVector<Sqt> &localPoses = m_skeletonData.localPoses;
     QVector<JointInfo> &joints = m_skeletonData.joints;
     for (int i = 0; i < m_skeletonData.joints.size(); ++i) {
-        // Calculate the global pose of this joint
+        // Calculate the global pose of this joint, using the SIMD
+        // Matrix4x4 for the multiplications when available
         JointInfo &joint = joints[i];
-        if (joint.parentIndex == -1) {
-            joint.globalPose = localPoses[i].toMatrix();
-        } else {
-            JointInfo &parentJoint = joints[joint.parentIndex];
-            joint.globalPose = parentJoint.globalPose * localPoses[i].toMatrix();
-        }
+        const Matrix4x4 localPose(localPoses[i].toMatrix());
+        const Matrix4x4 globalPose = (joint.parentIndex == -1)
+                ? localPose
+                : Matrix4x4(joints[joint.parentIndex].globalPose) * localPose;
 
-        m_skinningPalette[i] = joint.globalPose * joint.inverseBindPose;
+        joint.globalPose = convertToQMatrix4x4(globalPose);
+        m_skinningPalette[i] = convertToQMatrix4x4(globalPose * Matrix4x4(joint.inverseBindPose));
     }
     return m_skinningPalette;
 }
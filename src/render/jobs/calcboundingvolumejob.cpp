@@ -8,6 +8,8 @@
 #include <Qt3DCore/private/qabstractfrontendnodemanager_p.h>
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/boundingsphereutils_p.h>
+#include <Qt3DCore/private/bufferutils_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
@@ -19,7 +21,6 @@
 #include <Qt3DRender/private/attribute_p.h>
 #include <Qt3DRender/private/buffer_p.h>
 #include <Qt3DRender/private/sphere_p.h>
-#include <Qt3DRender/private/buffervisitor_p.h>
 #include <Qt3DRender/private/entityvisitor_p.h>
 
 #include <QtCore/qmath.h>
@@ -52,47 +53,36 @@ public:
                bool primitiveRestartEnabled,
                int primitiveRestartIndex)
     {
-        FindExtremePoints findExtremePoints(m_manager);
-        if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                     primitiveRestartEnabled, primitiveRestartIndex))
+        if (positionAttribute->vertexBaseType() != QAttribute::Float
+                || positionAttribute->vertexSize() < 3)
             return false;
 
-        m_min = QVector3D(findExtremePoints.xMin, findExtremePoints.yMin, findExtremePoints.zMin);
-        m_max = QVector3D(findExtremePoints.xMax, findExtremePoints.yMax, findExtremePoints.zMax);
-
-        FindMaxDistantPoint maxDistantPointY(m_manager);
-        maxDistantPointY.setReferencePoint = true;
-        if (!maxDistantPointY.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                     primitiveRestartEnabled, primitiveRestartIndex))
-            return false;
-        if (maxDistantPointY.hasNoPoints)
-            return false;
-
-        //const Vector3D x = maxDistantPointY.referencePt;
-        const Vector3D y = maxDistantPointY.maxDistPt;
-
-        FindMaxDistantPoint maxDistantPointZ(m_manager);
-        maxDistantPointZ.setReferencePoint = false;
-        maxDistantPointZ.referencePt = y;
-        if (!maxDistantPointZ.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                     primitiveRestartEnabled, primitiveRestartIndex)) {
-            return false;
+        // Read the positions straight from the buffer data rather than
+        // through a BufferVisitor, the data is kept alive by the copies
+        const QByteArray positionData = m_manager->lookupResource<Buffer, BufferManager>(positionAttribute->bufferId())->data();
+        QByteArray indexData;
+
+        PositionStream stream;
+        stream.positions = BufferTypeInfo::castToType<QAttribute::Float>(positionData, positionAttribute->byteOffset());
+        stream.byteStride = positionAttribute->byteStride();
+        stream.count = uint(drawVertexCount);
+        if (indexAttribute) {
+            indexData = m_manager->lookupResource<Buffer, BufferManager>(indexAttribute->bufferId())->data();
+            stream.indices = indexData.constData() + indexAttribute->byteOffset();
+            stream.indexType = indexAttribute->vertexBaseType();
+            stream.primitiveRestartEnabled = primitiveRestartEnabled;
+            stream.primitiveRestartIndex = primitiveRestartIndex;
         }
-        const Vector3D z = maxDistantPointZ.maxDistPt;
 
-        const Vector3D center = (y + z) * 0.5f;
-
-        FindMaxDistantPoint maxDistantPointCenter(m_manager);
-        maxDistantPointCenter.setReferencePoint = false;
-        maxDistantPointCenter.referencePt = center;
-        if (!maxDistantPointCenter.apply(positionAttribute, indexAttribute, drawVertexCount,
-                                     primitiveRestartEnabled, primitiveRestartIndex)) {
+        const BoundingSphereResult sphere = positionAttribute->hasBounds()
+                ? computeBoundingSphere(stream, positionAttribute->minBound(), positionAttribute->maxBound())
+                : computeBoundingSphere(stream);
+        if (!sphere.isValid())
             return false;
-        }
-
-        const float radius = (center - maxDistantPointCenter.maxDistPt).length();
 
-        m_volume = Qt3DRender::Render::Sphere(center, radius);
+        m_min = sphere.min;
+        m_max = sphere.max;
+        m_volume = Qt3DRender::Render::Sphere(Vector3D(sphere.center), sphere.radius);
 
         if (m_volume.isNull())
             return false;
@@ -105,84 +95,6 @@ private:
     NodeManagers *m_manager;
     QVector3D m_min;
     QVector3D m_max;
-
-    class FindExtremePoints : public Buffer3fVisitor
-    {
-    public:
-        explicit FindExtremePoints(NodeManagers *manager)
-            : Buffer3fVisitor(manager)
-            , xMin(0.0f), xMax(0.0f), yMin(0.0f), yMax(0.0f), zMin(0.0f), zMax(0.0f)
-        { }
-
-        float xMin, xMax, yMin, yMax, zMin, zMax;
-        Vector3D xMinPt, xMaxPt, yMinPt, yMaxPt, zMinPt, zMaxPt;
-
-        void visit(uint ndx, float x, float y, float z) override
-        {
-            if (ndx) {
-                if (x < xMin) {
-                    xMin = x;
-                    xMinPt = Vector3D(x, y, z);
-                }
-                if (x > xMax) {
-                    xMax = x;
-                    xMaxPt = Vector3D(x, y, z);
-                }
-                if (y < yMin) {
-                    yMin = y;
-                    yMinPt = Vector3D(x, y, z);
-                }
-                if (y > yMax) {
-                    yMax = y;
-                    yMaxPt = Vector3D(x, y, z);
-                }
-                if (z < zMin) {
-                    zMin = z;
-                    zMinPt = Vector3D(x, y, z);
-                }
-                if (z > zMax) {
-                    zMax = z;
-                    zMaxPt = Vector3D(x, y, z);
-                }
-            } else {
-                xMin = xMax = x;
-                yMin = yMax = y;
-                zMin = zMax = z;
-                xMinPt = xMaxPt = yMinPt = yMaxPt = zMinPt = zMaxPt = Vector3D(x, y, z);
-            }
-        }
-    };
-
-    class FindMaxDistantPoint : public Buffer3fVisitor
-    {
-    public:
-        explicit FindMaxDistantPoint(NodeManagers *manager)
-            : Buffer3fVisitor(manager)
-        { }
-
-        float maxLengthSquared = 0.0f;
-        Vector3D maxDistPt;
-        Vector3D referencePt;
-        bool setReferencePoint = false;
-        bool hasNoPoints = true;
-
-        void visit(uint ndx, float x, float y, float z) override
-        {
-            Q_UNUSED(ndx);
-            const Vector3D p = Vector3D(x, y, z);
-
-            if (hasNoPoints && setReferencePoint) {
-                maxLengthSquared = 0.0f;
-                referencePt = p;
-            }
-            const float lengthSquared = (p - referencePt).lengthSquared();
-            if ( lengthSquared >= maxLengthSquared ) {
-                maxDistPt = p;
-                maxLengthSquared = lengthSquared;
-            }
-            hasNoPoints = false;
-        }
-    };
 };
 
 struct BoundingVolumeComputeData {
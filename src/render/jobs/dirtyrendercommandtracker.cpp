@@ -0,0 +1,110 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "dirtyrendercommandtracker_p.h"
+
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/geometry_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/material_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Changes which lead the renderers to rebuild RenderCommands
+constexpr AbstractRenderer::BackendNodeDirtySet renderCommandChanges =
+        AbstractRenderer::MaterialDirty |
+        AbstractRenderer::GeometryDirty |
+        AbstractRenderer::ComputeDirty |
+        AbstractRenderer::ShadersDirty |
+        AbstractRenderer::FrameGraphDirty;
+
+} // anonymous
+
+void DirtyRenderCommandTracker::markDirty(AbstractRenderer::BackendNodeDirtySet changes, BackendNode *node)
+{
+    const AbstractRenderer::BackendNodeDirtySet commandChanges = changes & renderCommandChanges;
+    if (!commandChanges || m_fullRebuildRequired)
+        return;
+
+    if (node && m_managers) {
+        const Qt3DCore::QNodeId id = node->peerId();
+        if (commandChanges == AbstractRenderer::GeometryDirty) {
+            if (m_managers->geometryRendererManager()->lookupResource(id) == node) {
+                m_geometryRenderers.insert(id);
+                return;
+            }
+            if (m_managers->geometryManager()->lookupResource(id) == node) {
+                m_geometries.insert(id);
+                return;
+            }
+        } else if (commandChanges == AbstractRenderer::MaterialDirty) {
+            if (m_managers->materialManager()->lookupResource(id) == node) {
+                m_materials.insert(id);
+                return;
+            }
+        }
+    }
+
+    // Can't tell which entities are affected
+    m_fullRebuildRequired = true;
+}
+
+bool DirtyRenderCommandTracker::canRebuildPartially() const noexcept
+{
+    return !m_fullRebuildRequired && !isEmpty();
+}
+
+bool DirtyRenderCommandTracker::isEmpty() const noexcept
+{
+    return !m_fullRebuildRequired
+            && m_geometryRenderers.isEmpty()
+            && m_geometries.isEmpty()
+            && m_materials.isEmpty();
+}
+
+std::vector<Entity *> DirtyRenderCommandTracker::dirtyEntities(const std::vector<Entity *> &entities) const
+{
+    std::vector<Entity *> dirty;
+    for (Entity *entity : entities) {
+        if (!m_materials.isEmpty() && m_materials.contains(entity->componentUuid<Material>())) {
+            dirty.push_back(entity);
+            continue;
+        }
+
+        const Qt3DCore::QNodeId geometryRendererId = entity->componentUuid<GeometryRenderer>();
+        if (geometryRendererId.isNull())
+            continue;
+        if (m_geometryRenderers.contains(geometryRendererId)) {
+            dirty.push_back(entity);
+            continue;
+        }
+        if (!m_geometries.isEmpty()) {
+            const GeometryRenderer *geometryRenderer = entity->renderComponent<GeometryRenderer>();
+            if (geometryRenderer && m_geometries.contains(geometryRenderer->geometryId()))
+                dirty.push_back(entity);
+        }
+    }
+    return dirty;
+}
+
+void DirtyRenderCommandTracker::clear()
+{
+    m_geometryRenderers.clear();
+    m_geometries.clear();
+    m_materials.clear();
+    m_fullRebuildRequired = false;
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
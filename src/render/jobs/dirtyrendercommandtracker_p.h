@@ -0,0 +1,71 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DRENDER_RENDER_DIRTYRENDERCOMMANDTRACKER_P_H
+#define QT3DRENDER_RENDER_DIRTYRENDERCOMMANDTRACKER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qnodeid.h>
+#include <Qt3DRender/private/abstractrenderer_p.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/qset.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class BackendNode;
+class Entity;
+class NodeManagers;
+
+// Records which backend nodes invalidated RenderCommands since the last frame.
+// A GeometryRenderer, Geometry or Material change only invalidates the commands
+// of the entities referencing it, any other change requires all RenderCommands
+// to be rebuilt.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT DirtyRenderCommandTracker
+{
+public:
+    void setManagers(NodeManagers *managers) noexcept { m_managers = managers; }
+
+    void markDirty(AbstractRenderer::BackendNodeDirtySet changes, BackendNode *node);
+
+    // True when RenderCommands were invalidated and all invalidations can be
+    // attributed to specific entities
+    bool canRebuildPartially() const noexcept;
+    bool isEmpty() const noexcept;
+
+    // Returns the entities of the sorted \a entities whose RenderCommands
+    // were invalidated, preserving their order
+    std::vector<Entity *> dirtyEntities(const std::vector<Entity *> &entities) const;
+
+    void clear();
+
+private:
+    NodeManagers *m_managers = nullptr;
+    QSet<Qt3DCore::QNodeId> m_geometryRenderers;
+    QSet<Qt3DCore::QNodeId> m_geometries;
+    QSet<Qt3DCore::QNodeId> m_materials;
+    bool m_fullRebuildRequired = false;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_DIRTYRENDERCOMMANDTRACKER_P_H
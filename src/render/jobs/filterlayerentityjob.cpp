@@ -155,6 +155,14 @@ void FilterLayerEntityJob::filterLayerAndEntity()
             entitiesToFilter.push_back(entity);
     }
 
+    filterEntities(std::move(entitiesToFilter));
+}
+
+// Keeps the entities of entitiesToFilter that satisfy all the layer filters,
+// whether they are enabled or not, into filteredEntities()
+void FilterLayerEntityJob::filterEntities(std::vector<Entity *> entitiesToFilter)
+{
+    m_filteredEntities.clear();
     FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
     LayerManager *layerManager = m_manager->layerManager();
 
@@ -44,6 +44,8 @@ public:
     // QAspectJob interface
     void run() final;
 
+    void filterEntities(std::vector<Entity *> entitiesToFilter);
+
     void filterEntityAgainstLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds, const QLayerFilter::FilterMode filterMode);
     void filterAcceptAnyMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
     void filterAcceptAllMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
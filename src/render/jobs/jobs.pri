@@ -22,17 +22,21 @@ HEADERS += \
     $$PWD/updatetreeenabledjob_p.h \
     $$PWD/sendbuffercapturejob_p.h \
     $$PWD/loadskeletonjob_p.h \
+    $$PWD/loadtexturedatajob_p.h \
     $$PWD/updateskinningpalettejob_p.h \
     $$PWD/filterproximitydistancejob_p.h \
     $$PWD/abstractpickingjob_p.h \
     $$PWD/raycastingjob_p.h \
     $$PWD/updateentitylayersjob_p.h \
+    $$PWD/dirtyrendercommandtracker_p.h \
     $$PWD/filtercompatibletechniquejob_p.h \
     $$PWD/materialparametergathererjob_p.h \
     $$PWD/renderviewjobutils_p.h \
     $$PWD/uniformblockbuilder_p.h \
     $$PWD/renderqueue_p.h \
     $$PWD/renderercache_p.h \
+    $$PWD/renderviewpool_p.h \
+    $$PWD/transformhierarchy_p.h \
     $$PWD/renderviewcommandbuilderjob_p.h \
     $$PWD/renderviewcommandupdaterjob_p.h \
     $$PWD/renderviewinitializerjob_p.h \
@@ -40,6 +44,7 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/updateworldtransformjob.cpp \
+    $$PWD/transformhierarchy.cpp \
     $$PWD/loadscenejob.cpp \
     $$PWD/framecleanupjob.cpp \
     $$PWD/loadgeometryjob.cpp \
@@ -57,11 +62,13 @@ SOURCES += \
     $$PWD/updatetreeenabledjob.cpp \
     $$PWD/sendbuffercapturejob.cpp \
     $$PWD/loadskeletonjob.cpp \
+    $$PWD/loadtexturedatajob.cpp \
     $$PWD/updateskinningpalettejob.cpp \
     $$PWD/filterproximitydistancejob.cpp \
     $$PWD/abstractpickingjob.cpp \
     $$PWD/raycastingjob.cpp \
     $$PWD/updateentitylayersjob.cpp \
+    $$PWD/dirtyrendercommandtracker.cpp \
     $$PWD/filtercompatibletechniquejob.cpp \
     $$PWD/materialparametergathererjob.cpp \
     $$PWD/renderviewjobutils.cpp \
@@ -0,0 +1,113 @@
+// Copyright (C) 2022 Klaralvdalens Datakonsult AB (KDAB).
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "loadtexturedatajob_p.h"
+#include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DRender/private/abstractrenderer_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
+#include <Qt3DRender/private/job_common_p.h>
+
+#include <QtConcurrent/QtConcurrent>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt3DCore;
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+template<typename GeneratorPtr, typename DataManager>
+bool executeGenerators(const QList<GeneratorPtr> &generators, DataManager *manager)
+{
+    if (generators.isEmpty())
+        return false;
+
+    auto generate = [manager] (const GeneratorPtr &generator) {
+        manager->assignData(generator, generator->operator()());
+    };
+
+#if QT_CONFIG(concurrent)
+    if (generators.size() > 1 && QAspectJobManager::idealThreadCount() > 1) {
+        QtConcurrent::blockingMap(generators, generate);
+    } else
+#endif
+    {
+        for (const GeneratorPtr &generator : generators)
+            generate(generator);
+    }
+    return true;
+}
+
+} // anonymous
+
+class LoadTextureDataJobPrivate : public Qt3DCore::QAspectJobPrivate
+{
+public:
+    LoadTextureDataJobPrivate() {}
+    ~LoadTextureDataJobPrivate() {}
+
+    void postFrame(Qt3DCore::QAspectManager *manager) override;
+
+    AbstractRenderer *m_renderer = nullptr;
+    bool m_loadedData = false;
+};
+
+LoadTextureDataJob::LoadTextureDataJob()
+    : QAspectJob(*new LoadTextureDataJobPrivate)
+    , m_nodeManagers(nullptr)
+{
+    SET_JOB_RUN_STAT_TYPE(this, JobTypes::LoadTextureData, 0)
+}
+
+LoadTextureDataJob::~LoadTextureDataJob()
+{
+}
+
+void LoadTextureDataJob::setRenderer(AbstractRenderer *renderer)
+{
+    Q_D(LoadTextureDataJob);
+    d->m_renderer = renderer;
+}
+
+bool LoadTextureDataJob::hasPendingGenerators() const
+{
+    return m_nodeManagers->textureDataManager()->hasPendingGenerators() ||
+            m_nodeManagers->textureImageDataManager()->hasPendingGenerators();
+}
+
+void LoadTextureDataJob::run()
+{
+    Q_D(LoadTextureDataJob);
+
+    // Generators are executed outside of the managers' locks, the renderers
+    // only pick up the data once it has been assigned
+    TextureDataManager *textureDataManager = m_nodeManagers->textureDataManager();
+    TextureImageDataManager *textureImageDataManager = m_nodeManagers->textureImageDataManager();
+
+    const bool loadedTextureData = executeGenerators(textureDataManager->pendingGenerators(),
+                                                     textureDataManager);
+    const bool loadedImageData = executeGenerators(textureImageDataManager->pendingGenerators(),
+                                                   textureImageDataManager);
+    d->m_loadedData = loadedTextureData || loadedImageData;
+}
+
+void LoadTextureDataJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
+{
+    Q_UNUSED(manager);
+    // Make sure we render a frame to upload the new data even
+    // if the render policy is OnDemand
+    if (m_loadedData && m_renderer)
+        m_renderer->markDirty(AbstractRenderer::TexturesDirty, nullptr);
+    m_loadedData = false;
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
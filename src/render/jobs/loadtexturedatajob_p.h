@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Klaralvdalens Datakonsult AB (KDAB).
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DRENDER_RENDER_LOADTEXTUREDATAJOB_P_H
+#define QT3DRENDER_RENDER_LOADTEXTUREDATAJOB_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QSharedPointer>
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class NodeManagers;
+class AbstractRenderer;
+class LoadTextureDataJobPrivate;
+
+// Executes the texture and texture image generators registered with the
+// TextureDataManager and TextureImageDataManager so that decoding takes
+// place on the job threads rather than on the submission thread
+class Q_3DRENDERSHARED_PRIVATE_EXPORT LoadTextureDataJob : public Qt3DCore::QAspectJob
+{
+public:
+    LoadTextureDataJob();
+    ~LoadTextureDataJob();
+
+    void setNodeManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
+    void setRenderer(AbstractRenderer *renderer);
+
+    bool hasPendingGenerators() const;
+
+    void run() override;
+
+private:
+    NodeManagers *m_nodeManagers;
+
+    Q_DECLARE_PRIVATE(LoadTextureDataJob)
+};
+
+typedef QSharedPointer<LoadTextureDataJob> LoadTextureDataJobPtr;
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_LOADTEXTUREDATAJOB_P_H
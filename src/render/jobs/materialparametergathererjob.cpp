@@ -66,6 +66,9 @@ MaterialParameterGathererJob::MaterialParameterGathererJob()
 // improvement
 void MaterialParameterGathererJob::run()
 {
+    // The job can be reused across frames
+    m_parameters.clear();
+
     for (const HMaterial &materialHandle : qAsConst(m_handles)) {
         Material *material = m_manager->materialManager()->data(materialHandle);
 
@@ -43,6 +43,13 @@ struct EntityRenderCommandData
 
     inline size_t size() const { return entities.size(); }
 
+    void clear()
+    {
+        entities.clear();
+        commands.clear();
+        passesData.clear();
+    }
+
     inline void push_back(const Entity *e, const RenderCommand &c, const RenderPassParameterData &p)
     {
         entities.push_back(e);
@@ -65,6 +72,43 @@ struct EntityRenderCommandData
         return *this;
     }
 
+    // Returns a copy of this data where the commands of \a dirtyEntities are
+    // replaced by \a rebuiltData. This data, \a rebuiltData and \a dirtyEntities
+    // are all sorted by Entity and so is the result.
+    EntityRenderCommandData patched(EntityRenderCommandData &&rebuiltData,
+                                    const std::vector<Entity *> &dirtyEntities) const
+    {
+        EntityRenderCommandData result;
+        result.reserve(size() + rebuiltData.size());
+
+        auto dirtyIt = dirtyEntities.cbegin();
+        const auto dirtyEnd = dirtyEntities.cend();
+        size_t rebuiltIdx = 0;
+        const size_t rebuiltEnd = rebuiltData.size();
+
+        for (size_t idx = 0, end = size(); idx < end; ++idx) {
+            const Entity *entity = entities[idx];
+            // Insert rebuilt commands of entities ordered before this one
+            while (rebuiltIdx != rebuiltEnd && rebuiltData.entities[rebuiltIdx] < entity) {
+                result.push_back(rebuiltData.entities[rebuiltIdx],
+                                 std::move(rebuiltData.commands[rebuiltIdx]),
+                                 std::move(rebuiltData.passesData[rebuiltIdx]));
+                ++rebuiltIdx;
+            }
+            // Drop the previous commands of dirty entities
+            while (dirtyIt != dirtyEnd && *dirtyIt < entity)
+                ++dirtyIt;
+            if (dirtyIt != dirtyEnd && *dirtyIt == entity)
+                continue;
+            result.push_back(entity, commands[idx], passesData[idx]);
+        }
+        for (; rebuiltIdx != rebuiltEnd; ++rebuiltIdx)
+            result.push_back(rebuiltData.entities[rebuiltIdx],
+                             std::move(rebuiltData.commands[rebuiltIdx]),
+                             std::move(rebuiltData.passesData[rebuiltIdx]));
+        rebuiltData.clear();
+        return result;
+    }
 };
 
 template<class RenderCommand>
@@ -134,10 +178,18 @@ struct RendererCache
         // be cached across frame
         std::vector<Entity *> layeredFilteredRenderables; // Changes rarely
         std::vector<Entity *> filteredAndCulledRenderables; // Changes if camera is modified
+        // Storage recycled from one frame to the next by the frustum and proximity filtering
+        std::vector<Entity *> previousFilteredAndCulledRenderables;
+        std::vector<Entity *> proximityFilteredRenderables;
         std::vector<LightSource> layeredFilteredLightSources;
 
         // Cache of RenderCommands
         EntityRenderCommandDataViewPtr<RenderCommand> filteredRenderCommandDataViews;
+
+        // When frames are pipelined, the RenderCommands of the previous frame
+        // may still be submitted while the ones of the current frame are
+        // updated. The two views are then swapped every frame.
+        EntityRenderCommandDataViewPtr<RenderCommand> submittedRenderCommandDataViews;
     };
 
     // Variabled below are shared amongst all RV
@@ -148,11 +200,19 @@ struct RendererCache
     // Set by CachingComputableEntityFilterJob
     std::vector<Entity *> computeEntities;
 
+    // Set by the Renderer when only some entities need their RenderCommands
+    // rebuilt, sorted subsets of renderableEntities and computeEntities
+    std::vector<Entity *> dirtyRenderableEntities;
+    std::vector<Entity *> dirtyComputeEntities;
+
     // Set by CachingLightGathererJob
     std::vector<LightSource> gatheredLights;
 
     EnvironmentLight* environmentLight;
 
+    // Set by the Renderer when a frame is submitted while the next one is built
+    bool pipelinedFrames = false;
+
     // Per RV cache
     // Leaves inserted by SyncRenderViewPostInitialization
     QHash<FrameGraphNode *, LeafNodeData> leafNodeCache;
@@ -98,6 +98,20 @@ public:
         m_wasReset = true;
     }
 
+    /*
+     Same as reset() but hands the RenderView objects of the frame queue over
+     to the caller instead of deleting them. This allows submitting a frame
+     while the next one is being built and recycling the RenderViews. The
+     empty \a frameQueue is swapped with the queue so that no allocation
+     takes place.
+     */
+    void takeFrameQueue(std::vector<RenderView *> &frameQueue)
+    {
+        Q_ASSERT(frameQueue.empty());
+        std::swap(frameQueue, m_currentWorkQueue);
+        reset();
+    }
+
     void setNoRender()
     {
         Q_ASSERT(m_targetRenderViewCount == 0);
@@ -35,11 +35,17 @@ enum RebuildFlag {
     FullCommandRebuild = 1 << 0,
     LayerCacheRebuild = 1 << 1,
     MaterialCacheRebuild = 1 << 2,
-    LightCacheRebuild = 1 << 3
+    LightCacheRebuild = 1 << 3,
+    // Only rebuild the RenderCommands of the dirty entities of the RendererCache
+    PartialCommandRebuild = 1 << 4
 };
 Q_DECLARE_FLAGS(RebuildFlagSet, RebuildFlag)
 Q_DECLARE_OPERATORS_FOR_FLAGS(RebuildFlagSet)
 
+// The synchronizers below are created once per RenderViewBuilder and kept
+// across frames. They reference the job lists and rebuild flags owned by the
+// builder, which may be refilled from one frame to the next.
+
 #define RenderViewInitializerJobPtrAlias RenderViewInitializerJobPtr<RenderView, Renderer>
 #define RenderViewCommandBuilderJobPtrAlias RenderViewCommandBuilderJobPtr<RenderView, RenderCommand>
 #define RenderViewCommandUpdaterJobPtrAlias RenderViewCommandUpdaterJobPtr<RenderView, RenderCommand>
@@ -51,11 +57,13 @@ public:
     explicit SyncPreCommandBuilding(RenderViewInitializerJobPtrAlias renderViewInitializerJob,
                                     const std::vector<RenderViewCommandBuilderJobPtrAlias> &renderViewCommandBuilderJobs,
                                     Renderer *renderer,
-                                    FrameGraphNode *leafNode)
+                                    FrameGraphNode *leafNode,
+                                    const RebuildFlagSet &rebuildFlags)
         : m_renderViewInitializer(renderViewInitializerJob)
         , m_renderViewCommandBuilderJobs(renderViewCommandBuilderJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
+        , m_rebuildFlags(rebuildFlags)
     {
     }
 
@@ -64,6 +72,7 @@ public:
         // Split commands to build among jobs
 
         // Rebuild RenderCommands for all entities in RV (ignoring filtering)
+        // or only for the dirty ones when the cached commands can be patched
         auto *cache = m_renderer->cache();
         QMutexLocker lock(cache->mutex());
 
@@ -71,7 +80,10 @@ public:
         // The cache leaf should already have been created so we don't need to protect the access
         const auto &dataCacheForLeaf = cache->leafNodeCache[m_leafNode];
         RenderView *rv = m_renderViewInitializer->renderView();
-        const auto &entities = !rv->isCompute() ? cache->renderableEntities : cache->computeEntities;
+        const bool partialRebuild = !m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
+        const auto &entities = partialRebuild
+                ? (!rv->isCompute() ? cache->dirtyRenderableEntities : cache->dirtyComputeEntities)
+                : (!rv->isCompute() ? cache->renderableEntities : cache->computeEntities);
 
         rv->setMaterialParameterTable(dataCacheForLeaf.materialParameterGatherer);
 
@@ -88,13 +100,18 @@ public:
             const int count = (i == m - 1) ? entityCount - (i * idealPacketSize) : idealPacketSize;
             renderViewCommandBuilder->setEntities(entitiesPtr, i * idealPacketSize, count);
         }
+        // Builders are reused across frames, make sure the ones we don't
+        // need don't rebuild the entities of a previous frame
+        for (int i = m; i < jobCount; ++i)
+            m_renderViewCommandBuilderJobs[i]->setEntities(nullptr, 0, 0);
     }
 
 private:
     RenderViewInitializerJobPtrAlias m_renderViewInitializer;
-    std::vector<RenderViewCommandBuilderJobPtrAlias> m_renderViewCommandBuilderJobs;
+    const std::vector<RenderViewCommandBuilderJobPtrAlias> &m_renderViewCommandBuilderJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
+    const RebuildFlagSet &m_rebuildFlags;
 };
 
 template<class RenderView, class Renderer, class RenderCommand>
@@ -125,7 +142,7 @@ public:
 
 private:
     RenderViewInitializerJobPtrAlias m_renderViewJob;
-    std::vector<RenderViewCommandUpdaterJobPtrAlias> m_renderViewCommandUpdaterJobs;
+    const std::vector<RenderViewCommandUpdaterJobPtrAlias> &m_renderViewCommandUpdaterJobs;
     Renderer *m_renderer;
 };
 
@@ -205,11 +222,11 @@ public:
 private:
     RenderViewInitializerJobPtrAlias m_renderViewJob;
     FrustumCullingJobPtr m_frustumCullingJob;
-    FilterLayerEntityJobPtr m_filterEntityByLayerJob;
+    const FilterLayerEntityJobPtr &m_filterEntityByLayerJob;
     FilterProximityDistanceJobPtr m_filterProximityJob;
-    std::vector<MaterialParameterGathererJobPtr> m_materialGathererJobs;
-    std::vector<RenderViewCommandUpdaterJobPtrAlias> m_renderViewCommandUpdaterJobs;
-    std::vector<RenderViewCommandBuilderJobPtrAlias> m_renderViewCommandBuilderJobs;
+    const std::vector<MaterialParameterGathererJobPtr> &m_materialGathererJobs;
+    const std::vector<RenderViewCommandUpdaterJobPtrAlias> &m_renderViewCommandUpdaterJobs;
+    const std::vector<RenderViewCommandBuilderJobPtrAlias> &m_renderViewCommandBuilderJobs;
 };
 
 template<class RenderView, class Renderer, class RenderCommand>
@@ -224,7 +241,7 @@ public:
                                             const std::vector<RenderViewCommandBuilderJobPtrAlias> &renderViewCommandBuilderJobs,
                                             Renderer *renderer,
                                             FrameGraphNode *leafNode,
-                                            RebuildFlagSet rebuildFlags)
+                                            const RebuildFlagSet &rebuildFlags)
         : m_renderViewJob(renderViewJob)
         , m_frustumCullingJob(frustumCullingJob)
         , m_filterProximityJob(filterProximityJob)
@@ -259,12 +276,14 @@ public:
             auto &cacheForLeaf = cache->leafNodeCache[m_leafNode];
 
             const bool fullRebuild = m_rebuildFlags.testFlag(RebuildFlag::FullCommandRebuild);
+            const bool partialRebuild = !fullRebuild && m_rebuildFlags.testFlag(RebuildFlag::PartialCommandRebuild);
             const bool layerFilteringRebuild = m_rebuildFlags.testFlag(RebuildFlag::LayerCacheRebuild);
             const bool lightsCacheRebuild = m_rebuildFlags.testFlag(RebuildFlag::LightCacheRebuild);
             const bool cameraDirty = cacheForLeaf.viewProjectionMatrix != rv->viewProjectionMatrix();
             const bool hasProximityFilter = !rv->proximityFilterIds().empty();
             bool commandFilteringRequired =
                     fullRebuild ||
+                    partialRebuild ||
                     layerFilteringRebuild ||
                     lightsCacheRebuild ||
                     cameraDirty ||
@@ -277,7 +296,7 @@ public:
             // Rebuild RenderCommands if required
             // This should happen fairly infrequently (FrameGraph Change, Geometry/Material change)
             // and allow to skip that step most of the time
-            if (fullRebuild) {
+            if (fullRebuild || partialRebuild) {
                 EntityRenderCommandData<RenderCommand> commandData;
                 // Reduction
                 {
@@ -286,14 +305,36 @@ public:
                         totalCommandCount += int(renderViewCommandBuilder->commandData().size());
                     commandData.reserve(totalCommandCount);
                     for (const RenderViewCommandBuilderJobPtrAlias &renderViewCommandBuilder : qAsConst(m_renderViewCommandBuilderJobs))
-                        commandData += std::move(renderViewCommandBuilder->commandData());
+                        commandData += Qt3DCore::moveAndClear(renderViewCommandBuilder->commandData());
                 }
 
                 // Store new cache
                 auto dataView = EntityRenderCommandDataViewPtr<RenderCommand>::create();
-                dataView->data = std::move(commandData);
+                if (partialRebuild) {
+                    // Keep the cached commands of the entities that weren't rebuilt
+                    const auto &dirtyEntities = isDraw ? cache->dirtyRenderableEntities : cache->dirtyComputeEntities;
+                    dataView->data = cacheForLeaf.filteredRenderCommandDataViews->data.patched(std::move(commandData),
+                                                                                              dirtyEntities);
+                } else {
+                    dataView->data = std::move(commandData);
+                }
                 // Store the update dataView
                 cacheForLeaf.filteredRenderCommandDataViews = dataView;
+                // The other buffer holds commands that no longer match
+                cacheForLeaf.submittedRenderCommandDataViews.reset();
+            } else if (cache->pipelinedFrames) {
+                // The previous frame may still be submitted from the cached
+                // view, update the other buffer instead. Both buffers hold the
+                // same commands, whose values are all refreshed by the command
+                // updaters, so only the first frame after a rebuild copies them
+                auto &backDataView = cacheForLeaf.submittedRenderCommandDataViews;
+                if (backDataView.isNull()) {
+                    backDataView = EntityRenderCommandDataViewPtr<RenderCommand>::create();
+                    *backDataView = *cacheForLeaf.filteredRenderCommandDataViews;
+                } else {
+                    backDataView->indices = cacheForLeaf.filteredRenderCommandDataViews->indices;
+                }
+                std::swap(backDataView, cacheForLeaf.filteredRenderCommandDataViews);
             }
 
 
@@ -339,12 +380,14 @@ public:
             // We need to check this regardless of whether the camera has moved since
             // entities in the scene themselves could have moved
             if (isDraw && rv->frustumCulling()) {
-                const std::vector<Entity *> &subset = entitiesInSubset(
-                            cacheForLeaf.layeredFilteredRenderables,
-                            m_frustumCullingJob->visibleEntities());
+                // Filter into the storage of the previous frame's result
+                std::vector<Entity *> &subset = cacheForLeaf.previousFilteredAndCulledRenderables;
+                entitiesInSubset(cacheForLeaf.layeredFilteredRenderables,
+                                 m_frustumCullingJob->visibleEntities(),
+                                 subset);
                 // Force command filtering if what we contain in cache and what we filtered differ
                 commandFilteringRequired |= (subset != cacheForLeaf.filteredAndCulledRenderables);
-                cacheForLeaf.filteredAndCulledRenderables = subset;
+                std::swap(subset, cacheForLeaf.filteredAndCulledRenderables);
             }
 
             rv->setMaterialParameterTable(cacheForLeaf.materialParameterGatherer);
@@ -353,14 +396,17 @@ public:
             // Set the light sources, with layer filters applied.
             rv->setLightSources(cacheForLeaf.layeredFilteredLightSources);
 
-            std::vector<Entity *> renderableEntities = isDraw ? cacheForLeaf.filteredAndCulledRenderables : cacheForLeaf.layeredFilteredRenderables;
+            const std::vector<Entity *> *renderableEntities = isDraw ? &cacheForLeaf.filteredAndCulledRenderables : &cacheForLeaf.layeredFilteredRenderables;
 
             // TO DO: Find a way to do that only if proximity entities has changed
             if (isDraw) {
                 // Filter out entities which didn't satisfy proximity filtering
-                if (hasProximityFilter)
-                    renderableEntities = entitiesInSubset(renderableEntities,
-                                                          m_filterProximityJob->filteredEntities());
+                if (hasProximityFilter) {
+                    entitiesInSubset(*renderableEntities,
+                                     m_filterProximityJob->filteredEntities(),
+                                     cacheForLeaf.proximityFilteredRenderables);
+                    renderableEntities = &cacheForLeaf.proximityFilteredRenderables;
+                }
             }
 
             EntityRenderCommandDataViewPtr<RenderCommand> filteredCommandData = cacheForLeaf.filteredRenderCommandDataViews;
@@ -374,13 +420,15 @@ public:
                 const std::vector<const Entity *> &entities = filteredCommandData->data.entities;
                 // Because cacheForLeaf.renderableEntities or computeEntities are sorted
                 // What we get out of EntityRenderCommandData is also sorted by Entity
-                auto eIt = renderableEntities.cbegin();
-                const auto eEnd = renderableEntities.cend();
+                auto eIt = renderableEntities->cbegin();
+                const auto eEnd = renderableEntities->cend();
                 size_t cIt = 0;
                 const size_t cEnd = entities.size();
 
-                std::vector<size_t> filteredCommandIndices;
-                filteredCommandIndices.reserve(renderableEntities.size());
+                // Filter in place, reusing the storage of the previous indices
+                std::vector<size_t> &filteredCommandIndices = filteredCommandData->indices;
+                filteredCommandIndices.clear();
+                filteredCommandIndices.reserve(renderableEntities->size());
 
                 while (eIt != eEnd) {
                     const Entity *targetEntity = *eIt;
@@ -397,9 +445,6 @@ public:
                     }
                     ++eIt;
                 }
-
-                // Store result in cache
-                cacheForLeaf.filteredRenderCommandDataViews->indices = std::move(filteredCommandIndices);
             }
 
             // Split among the number of command updaters
@@ -417,6 +462,10 @@ public:
                 const size_t count = (i == m - 1) ? commandCount - (i * idealPacketSize) : idealPacketSize;
                 renderViewCommandUpdater->setRenderablesSubView({filteredCommandData, size_t(i * idealPacketSize), count});
             }
+            // Updaters are reused across frames, release the sub views
+            // of the previous frame for the ones we don't need
+            for (int i = m; i < jobCount; ++i)
+                m_renderViewCommandUpdaterJobs.at(i)->setRenderablesSubView({});
         }
     }
 
@@ -424,12 +473,12 @@ private:
     RenderViewInitializerJobPtrAlias m_renderViewJob;
     FrustumCullingJobPtr m_frustumCullingJob;
     FilterProximityDistanceJobPtr m_filterProximityJob;
-    std::vector<MaterialParameterGathererJobPtr> m_materialGathererJobs;
-    std::vector<RenderViewCommandUpdaterJobPtrAlias> m_renderViewCommandUpdaterJobs;
-    std::vector<RenderViewCommandBuilderJobPtrAlias> m_renderViewCommandBuilderJobs;
+    const std::vector<MaterialParameterGathererJobPtr> &m_materialGathererJobs;
+    const std::vector<RenderViewCommandUpdaterJobPtrAlias> &m_renderViewCommandUpdaterJobs;
+    const std::vector<RenderViewCommandBuilderJobPtrAlias> &m_renderViewCommandBuilderJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
-    RebuildFlagSet m_rebuildFlags;
+    const RebuildFlagSet &m_rebuildFlags;
 };
 
 template<class Renderer>
@@ -492,7 +541,7 @@ public:
     }
 
 private:
-    std::vector<MaterialParameterGathererJobPtr> m_materialParameterGathererJobs;
+    const std::vector<MaterialParameterGathererJobPtr> &m_materialParameterGathererJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
 };
@@ -69,8 +69,8 @@ public:
         qint64 buildCommandsTime;
 #endif
 
-        // Create a RenderView object
-        m_renderView = new RenderView;
+        // Get a RenderView object, recycled from a previous frame if possible
+        m_renderView = m_renderer->renderViewPool()->acquire();
         m_renderView->setRenderer(m_renderer);
 
         // Populate the renderview's configuration from the framegraph
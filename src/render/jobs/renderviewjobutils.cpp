@@ -199,12 +199,18 @@ int findIdealNumberOfWorkers(int elementCount, int packetSize, int maxJobCount)
 std::vector<Entity *> entitiesInSubset(const std::vector<Entity *> &entities, const std::vector<Entity *> &subset)
 {
     std::vector<Entity *> intersection;
+    entitiesInSubset(entities, subset, intersection);
+    return intersection;
+}
+
+void entitiesInSubset(const std::vector<Entity *> &entities, const std::vector<Entity *> &subset,
+                      std::vector<Entity *> &intersection)
+{
+    intersection.clear();
     intersection.reserve(qMin(entities.size(), subset.size()));
     std::set_intersection(entities.begin(), entities.end(),
                           subset.begin(), subset.end(),
                           std::back_inserter(intersection));
-
-    return intersection;
 }
 
 } // namespace Render
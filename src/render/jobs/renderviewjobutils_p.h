@@ -113,6 +113,11 @@ Q_3DRENDERSHARED_PRIVATE_EXPORT int findIdealNumberOfWorkers(int elementCount, i
 Q_3DRENDERSHARED_PRIVATE_EXPORT std::vector<Entity *> entitiesInSubset(const std::vector<Entity *> &entities,
 const std::vector<Entity *> &subset);
 
+// Same as above but reuses the storage of \a intersection
+Q_3DRENDERSHARED_PRIVATE_EXPORT void entitiesInSubset(const std::vector<Entity *> &entities,
+                                                      const std::vector<Entity *> &subset,
+                                                      std::vector<Entity *> &intersection);
+
 } // namespace Render
 } // namespace Qt3DRender
 
@@ -0,0 +1,104 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DRENDER_RENDER_RENDERVIEWPOOL_P_H
+#define QT3DRENDER_RENDER_RENDERVIEWPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <vector>
+#include <QMutex>
+#include <Qt3DCore/private/vector_helper_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Recycles the RenderView objects of submitted frames so that building the
+// RenderViews of a frame doesn't go through the heap once the number of
+// RenderViews per frame is stable. Recycled RenderViews keep the capacity of
+// their containers.
+template<class RenderView>
+class RenderViewPool
+{
+public:
+    RenderViewPool() = default;
+    ~RenderViewPool()
+    {
+        clear();
+    }
+
+    /*
+     Returns a RenderView in its default state. Called from the
+     RenderViewInitializerJobs, possibly concurrently.
+     */
+    RenderView *acquire()
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            if (!m_freeRenderViews.empty()) {
+                RenderView *rv = m_freeRenderViews.back();
+                m_freeRenderViews.pop_back();
+                return rv;
+            }
+        }
+        return new RenderView;
+    }
+
+    /*
+     Takes back the RenderViews once they have been submitted. \a renderViews
+     is cleared but keeps its capacity.
+     */
+    void release(std::vector<RenderView *> &renderViews)
+    {
+        for (RenderView *rv : renderViews) {
+            if (rv)
+                rv->reset();
+        }
+
+        QMutexLocker lock(&m_mutex);
+        for (RenderView *rv : renderViews) {
+            if (rv)
+                m_freeRenderViews.push_back(rv);
+        }
+        renderViews.clear();
+    }
+
+    void clear()
+    {
+        QMutexLocker lock(&m_mutex);
+        Qt3DCore::deleteAll(m_freeRenderViews);
+        m_freeRenderViews.clear();
+    }
+
+    size_t freeRenderViewCount() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_freeRenderViews.size();
+    }
+
+private:
+    Q_DISABLE_COPY(RenderViewPool)
+
+    mutable QMutex m_mutex;
+    std::vector<RenderView *> m_freeRenderViews;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_RENDERVIEWPOOL_P_H
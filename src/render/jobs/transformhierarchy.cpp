@@ -0,0 +1,129 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "transformhierarchy_p.h"
+
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/transform_p.h>
+
+#include <cmath>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Same result as Sphere::transformed(). The SIMD matrices transpose themselves
+// on every map() call, transpose once for the 4 points instead
+template<typename Matrix>
+Sphere transformSphere(const Sphere &sphere, const Matrix &matrix)
+{
+    if constexpr (std::is_same_v<Matrix, QMatrix4x4>) {
+        return sphere.transformed(matrix);
+    } else {
+        if (sphere.isNull())
+            return sphere;
+
+        const Matrix transposed = matrix.transposed();
+        const Vector3D center = sphere.center();
+        const float radius = sphere.radius();
+        const Vector3D x = (center + Vector3D(radius, 0.0f, 0.0f)) * transposed;
+        const Vector3D y = (center + Vector3D(0.0f, radius, 0.0f)) * transposed;
+        const Vector3D z = (center + Vector3D(0.0f, 0.0f, radius)) * transposed;
+        const Vector3D c = center * transposed;
+        const float rSquared = qMax(qMax((x - c).lengthSquared(), (y - c).lengthSquared()), (z - c).lengthSquared());
+        return Sphere(c, std::sqrt(rSquared), sphere.id());
+    }
+}
+
+} // anonymous
+
+void computeWorldTransforms(const int *parentIndices,
+                            const Matrix4x4 *localTransforms,
+                            const std::vector<bool> &hasLocalTransform,
+                            Matrix4x4 *worldTransforms,
+                            size_t count,
+                            const Matrix4x4 &rootParentTransform)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const int parentIndex = parentIndices[i];
+        const Matrix4x4 &parentTransform = parentIndex < 0 ? rootParentTransform : worldTransforms[parentIndex];
+        if (hasLocalTransform[i])
+            worldTransforms[i] = parentTransform * localTransforms[i];
+        else
+            worldTransforms[i] = parentTransform;
+    }
+}
+
+void TransformHierarchy::rebuild(NodeManagers *manager, Entity *root)
+{
+    m_entities.clear();
+    m_transforms.clear();
+    m_parentIndices.clear();
+    m_valid = true;
+
+    if (!root || !root->isEnabled())
+        return;
+
+    // Breadth first, parents are always visited before their children
+    EntityManager *entityManager = manager->renderNodesManager();
+    m_entities.push_back(root);
+    m_parentIndices.push_back(-1);
+    for (size_t i = 0; i < m_entities.size(); ++i) {
+        const auto &childrenHandles = m_entities[i]->childrenHandles();
+        for (const HEntity &handle : childrenHandles) {
+            Entity *child = entityManager->data(handle);
+            if (child && child->isEnabled()) {
+                m_entities.push_back(child);
+                m_parentIndices.push_back(int(i));
+            }
+        }
+    }
+
+    m_transforms.reserve(m_entities.size());
+    for (const Entity *entity : m_entities)
+        m_transforms.push_back(entity->renderComponent<Transform>());
+
+    m_hasLocalTransform.assign(m_entities.size(), false);
+    m_localTransforms.resize(m_entities.size());
+    m_worldTransforms.resize(m_entities.size());
+}
+
+void TransformHierarchy::updateWorldTransforms(const Matrix4x4 &rootParentTransform)
+{
+    const size_t count = m_entities.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Transform *transform = m_transforms[i];
+        const bool hasLocalTransform = transform != nullptr && transform->isEnabled();
+        m_hasLocalTransform[i] = hasLocalTransform;
+        if (hasLocalTransform)
+            m_localTransforms[i] = transform->transformMatrix();
+    }
+
+    computeWorldTransforms(m_parentIndices.data(), m_localTransforms.data(), m_hasLocalTransform,
+                           m_worldTransforms.data(), count, rootParentTransform);
+}
+
+void TransformHierarchy::updateWorldBoundingVolumes() const
+{
+    const size_t count = m_entities.size();
+    for (size_t i = 0; i < count; ++i) {
+        Entity *entity = m_entities[i];
+        Sphere *worldBoundingVolume = entity->worldBoundingVolume();
+        *worldBoundingVolume = transformSphere(*entity->localBoundingVolume(), m_worldTransforms[i]);
+        *(entity->worldBoundingVolumeWithChildren()) = *worldBoundingVolume; // expanded in UpdateBoundingVolumeJob
+    }
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
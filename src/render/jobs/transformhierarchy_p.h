@@ -0,0 +1,80 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QT3DRENDER_RENDER_TRANSFORMHIERARCHY_P_H
+#define QT3DRENDER_RENDER_TRANSFORMHIERARCHY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class Entity;
+class NodeManagers;
+class Transform;
+
+// Flattened view of the enabled entity tree, parents before children. World
+// matrices and world bounding volumes are computed by sweeping over its
+// arrays instead of walking the Entity tree.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT TransformHierarchy
+{
+public:
+    void rebuild(NodeManagers *manager, Entity *root);
+    void invalidate() noexcept { m_valid = false; }
+    bool isValid() const noexcept { return m_valid; }
+
+    // Gathers the local matrices and computes the world matrices, the root
+    // being transformed by \a rootParentTransform
+    void updateWorldTransforms(const Matrix4x4 &rootParentTransform);
+    // Transforms the local bounding volume of each entity by its world matrix
+    void updateWorldBoundingVolumes() const;
+
+    size_t size() const noexcept { return m_entities.size(); }
+    const std::vector<Entity *> &entities() const noexcept { return m_entities; }
+    const std::vector<Transform *> &transforms() const noexcept { return m_transforms; }
+    const std::vector<int> &parentIndices() const noexcept { return m_parentIndices; }
+    const std::vector<bool> &hasLocalTransform() const noexcept { return m_hasLocalTransform; }
+    const std::vector<Matrix4x4> &worldTransforms() const noexcept { return m_worldTransforms; }
+
+private:
+    std::vector<Entity *> m_entities;
+    std::vector<Transform *> m_transforms;
+    std::vector<int> m_parentIndices;
+    std::vector<bool> m_hasLocalTransform;
+    std::vector<Matrix4x4> m_localTransforms;
+    std::vector<Matrix4x4> m_worldTransforms;
+    bool m_valid = false;
+};
+
+// world[i] = world[parent[i]] * local[i], parent[i] < i, -1 for roots
+Q_3DRENDERSHARED_PRIVATE_EXPORT void computeWorldTransforms(const int *parentIndices,
+                                                            const Matrix4x4 *localTransforms,
+                                                            const std::vector<bool> &hasLocalTransform,
+                                                            Matrix4x4 *worldTransforms,
+                                                            size_t count,
+                                                            const Matrix4x4 &rootParentTransform);
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_TRANSFORMHIERARCHY_P_H
@@ -2,16 +2,82 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "updateskinningpalettejob_p.h"
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/entityvisitor_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 
+#include <QtConcurrent/QtConcurrent>
+
 QT_BEGIN_NAMESPACE
 
+using namespace Qt3DCore;
+
 namespace Qt3DRender {
 namespace Render {
 
+namespace {
+
+struct SkinningPaletteComputeData
+{
+    Skeleton *skeleton = nullptr;
+    std::vector<Armature *> armatures;
+};
+
+class ArmatureGatherer : public EntityVisitor
+{
+public:
+    explicit ArmatureGatherer(NodeManagers *manager)
+        : EntityVisitor(manager)
+    {
+    }
+
+    Operation visit(Entity *entity) override
+    {
+        // Armatures of disabled sub-trees won't be rendered this frame,
+        // there is no point in updating their skinning palettes
+        if (!entity->isTreeEnabled())
+            return Prune;
+
+        Armature *armature = entity->renderComponent<Armature>();
+        if (armature == nullptr || !armature->isEnabled())
+            return Continue;
+
+        Skeleton *skeleton = m_manager->skeletonManager()->lookupResource(armature->skeletonId());
+        if (skeleton == nullptr || !skeleton->isEnabled())
+            return Continue;
+
+        // Group armatures per skeleton so that each palette is computed once
+        auto it = m_skeletonIndices.find(skeleton);
+        if (it == m_skeletonIndices.end()) {
+            it = m_skeletonIndices.insert(skeleton, m_computeData.size());
+            m_computeData.push_back({ skeleton, {} });
+        }
+        std::vector<Armature *> &armatures = m_computeData[it.value()].armatures;
+        if (std::find(armatures.begin(), armatures.end(), armature) == armatures.end())
+            armatures.push_back(armature);
+
+        return Continue;
+    }
+
+    std::vector<SkinningPaletteComputeData> m_computeData;
+
+private:
+    QHash<Skeleton *, size_t> m_skeletonIndices;
+};
+
+void updateSkinningPalette(const SkinningPaletteComputeData &data)
+{
+    const QVector<QMatrix4x4> &skinningPalette = data.skeleton->calculateSkinningMatrixPalette();
+    for (Armature *armature : data.armatures)
+        armature->skinningPaletteUniform().setData(skinningPalette);
+}
+
+} // anonymous
+
 UpdateSkinningPaletteJob::UpdateSkinningPaletteJob()
     : Qt3DCore::QAspectJob()
     , m_nodeManagers(nullptr)
@@ -30,11 +96,10 @@ void UpdateSkinningPaletteJob::run()
     if (armatureManager->count() == 0)
         return;
 
-    // TODO: Decompose this job across several jobs, say one per skeleton so
-    // that it can be done in parallel
-
     // Update the local pose transforms of JointInfo's in Skeletons from
-    // the set of dirty joints.
+    // the set of dirty joints. This is done for all skeletons, including the
+    // ones we skip below, so that their poses are correct once they are
+    // enabled again.
     for (const auto &jointHandle : qAsConst(m_dirtyJoints)) {
         Joint *joint = m_nodeManagers->jointManager()->data(jointHandle);
         Q_ASSERT(joint);
@@ -44,26 +109,21 @@ void UpdateSkinningPaletteJob::run()
             skeleton->setLocalPose(jointHandle, joint->localPose());
     }
 
-    // Find all the armature components and update their skinning palettes
-    QList<HArmature> dirtyArmatures;
-    m_root->traverse([&dirtyArmatures](Entity *entity) {
-        const auto armatureHandle = entity->componentHandle<Armature>();
-        if (!armatureHandle.isNull() && !dirtyArmatures.contains(armatureHandle))
-            dirtyArmatures.push_back(armatureHandle);
-    });
-
-    // Update the skeleton for each dirty armature
-    auto skeletonManager = m_nodeManagers->skeletonManager();
-    for (const auto &armatureHandle : qAsConst(dirtyArmatures)) {
-        auto armature = armatureManager->data(armatureHandle);
-        Q_ASSERT(armature);
-
-        auto skeletonId = armature->skeletonId();
-        auto skeleton = skeletonManager->lookupResource(skeletonId);
-        Q_ASSERT(skeleton);
+    // Find the skeletons referenced by armatures of enabled entities
+    ArmatureGatherer gatherer(m_nodeManagers);
+    gatherer.apply(m_root);
+    std::vector<SkinningPaletteComputeData> computeData = std::move(gatherer.m_computeData);
 
-        const QVector<QMatrix4x4> &skinningPalette = skeleton->calculateSkinningMatrixPalette();
-        armature->skinningPaletteUniform().setData(skinningPalette);
+    // Update the skinning palette of each skeleton and its armatures. Skeletons
+    // are independent from one another so we can process them in parallel.
+#if QT_CONFIG(concurrent)
+    if (computeData.size() > 1 && QAspectJobManager::idealThreadCount() > 1) {
+        QtConcurrent::blockingMap(computeData, updateSkinningPalette);
+    } else
+#endif
+    {
+        for (const SkinningPaletteComputeData &data : computeData)
+            updateSkinningPalette(data);
     }
 }
 
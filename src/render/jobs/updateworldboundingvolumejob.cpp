@@ -6,6 +6,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/transformhierarchy_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -15,12 +16,18 @@ namespace Render {
 UpdateWorldBoundingVolumeJob::UpdateWorldBoundingVolumeJob()
     : Qt3DCore::QAspectJob()
     , m_manager(nullptr)
+    , m_hierarchy(nullptr)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateWorldBoundingVolume, 0)
 }
 
 void UpdateWorldBoundingVolumeJob::run()
 {
+    if (m_hierarchy) {
+        m_hierarchy->updateWorldBoundingVolumes();
+        return;
+    }
+
     const std::vector<HEntity> &handles = m_manager->activeHandles();
 
     for (const HEntity &handle : handles) {
@@ -25,6 +25,7 @@ namespace Qt3DRender {
 namespace Render {
 
 class EntityManager;
+class TransformHierarchy;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateWorldBoundingVolumeJob : public Qt3DCore::QAspectJob
 {
@@ -32,10 +33,14 @@ public:
     UpdateWorldBoundingVolumeJob();
 
     inline void setManager(EntityManager *manager) noexcept { m_manager = manager; }
+    // When set, only the entities of the hierarchy are updated, using the
+    // world matrices it computed
+    inline void setTransformHierarchy(const TransformHierarchy *hierarchy) noexcept { m_hierarchy = hierarchy; }
     void run() override;
 
 private:
     EntityManager *m_manager;
+    const TransformHierarchy *m_hierarchy;
 };
 
 typedef QSharedPointer<UpdateWorldBoundingVolumeJob> UpdateWorldBoundingVolumeJobPtr;
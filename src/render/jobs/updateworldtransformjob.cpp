@@ -28,32 +28,6 @@ struct TransformUpdate
     QMatrix4x4 worldTransformMatrix;
 };
 
-void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform, QList<TransformUpdate> &updatedTransforms)
-{
-    if (!node->isEnabled())
-        return;
-
-    Matrix4x4 worldTransform(parentTransform);
-    Transform *nodeTransform = node->renderComponent<Transform>();
-
-    const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
-    if (hasTransformComponent)
-        worldTransform = worldTransform * nodeTransform->transformMatrix();
-
-    if (*(node->worldTransform()) != worldTransform) {
-        *(node->worldTransform()) = worldTransform;
-        if (hasTransformComponent)
-            updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
-    }
-
-    const auto &childrenHandles = node->childrenHandles();
-    for (const HEntity &handle : childrenHandles) {
-        Entity *child = manager->renderNodesManager()->data(handle);
-        if (child)
-            updateWorldTransformAndBounds(manager, child, worldTransform, updatedTransforms);
-    }
-}
-
 }
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateWorldTransformJobPrivate : public Qt3DCore::QAspectJobPrivate
@@ -78,6 +52,7 @@ UpdateWorldTransformJob::UpdateWorldTransformJob()
 void UpdateWorldTransformJob::setRoot(Entity *root)
 {
     m_node = root;
+    m_hierarchy.invalidate();
 }
 
 void UpdateWorldTransformJob::setManagers(NodeManagers *manager)
@@ -87,21 +62,35 @@ void UpdateWorldTransformJob::setManagers(NodeManagers *manager)
 
 void UpdateWorldTransformJob::run()
 {
-    // Iterate over each level of hierarchy in our scene
-    // and update each node's world transform from its
-    // local transform and its parent's world transform
-
-    // TODO: Parallelise this on each level using a parallel_for
-    // implementation.
+    // Update each node's world transform from its local transform and its
+    // parent's world transform, sweeping over the flattened entity tree
 
     Q_D(UpdateWorldTransformJob);
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
 
+    if (!m_hierarchy.isValid())
+        m_hierarchy.rebuild(m_manager, m_node);
+
     Matrix4x4 parentTransform;
     Entity *parent = m_node->parent();
     if (parent != nullptr)
         parentTransform = *(parent->worldTransform());
-    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, d->m_updatedTransforms);
+    m_hierarchy.updateWorldTransforms(parentTransform);
+
+    // Only report the transforms that actually changed
+    const std::vector<Entity *> &entities = m_hierarchy.entities();
+    const std::vector<Transform *> &transforms = m_hierarchy.transforms();
+    const std::vector<bool> &hasLocalTransform = m_hierarchy.hasLocalTransform();
+    const std::vector<Matrix4x4> &worldTransforms = m_hierarchy.worldTransforms();
+    for (size_t i = 0, m = entities.size(); i < m; ++i) {
+        Matrix4x4 *entityWorldTransform = entities[i]->worldTransform();
+        const Matrix4x4 &worldTransform = worldTransforms[i];
+        if (*entityWorldTransform == worldTransform)
+            continue;
+        *entityWorldTransform = worldTransform;
+        if (hasLocalTransform[i])
+            d->m_updatedTransforms.push_back({transforms[i]->peerId(), convertToQMatrix4x4(worldTransform)});
+    }
 
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
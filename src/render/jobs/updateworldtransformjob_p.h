@@ -17,6 +17,7 @@
 
 #include <Qt3DCore/qaspectjob.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/transformhierarchy_p.h>
 
 #include <QSharedPointer>
 
@@ -37,11 +38,17 @@ public:
     void setRoot(Entity *root);
     void setManagers(NodeManagers *manager);
 
+    // To be called when entities are added, removed, reparented, enabled,
+    // disabled or gain or lose a Transform
+    void invalidateHierarchy() noexcept { m_hierarchy.invalidate(); }
+    const TransformHierarchy &hierarchy() const noexcept { return m_hierarchy; }
+
     void run() override;
 
 private:
     Entity *m_node;
     NodeManagers *m_manager;
+    TransformHierarchy m_hierarchy;
     Q_DECLARE_PRIVATE(UpdateWorldTransformJob)
 };
 
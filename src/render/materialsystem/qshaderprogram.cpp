@@ -234,6 +234,14 @@
         fragColor = texture(source, vec2(0.5, 0.5));
     }
     \endcode
+
+    The RHI backend keeps a cache of the baked shaders it generates from the
+    GLSL code. They are by default saved in
+    QStandardPaths::writableLocation(QStandardPaths::TempLocation)). This path
+    can be overridden by setting environment variable QT3D_WRITABLE_CACHE_PATH
+    to a valid writable path. The use of the cache can be disabled by setting
+    environment variable QT3D_DISABLE_SHADER_CACHE, while setting
+    QT3D_REBUILD_SHADER_CACHE forces shaders to be baked again.
 */
 
 /*!
@@ -459,6 +467,14 @@
         fragColor = texture(source, vec2(0.5, 0.5));
     }
     \endcode
+
+    The RHI backend keeps a cache of the baked shaders it generates from the
+    GLSL code. They are by default saved in
+    QStandardPaths::writableLocation(QStandardPaths::TempLocation)). This path
+    can be overridden by setting environment variable QT3D_WRITABLE_CACHE_PATH
+    to a valid writable path. The use of the cache can be disabled by setting
+    environment variable QT3D_DISABLE_SHADER_CACHE, while setting
+    QT3D_REBUILD_SHADER_CACHE forces shaders to be baked again.
 */
 
 /*!
@@ -23,6 +23,13 @@ RenderStateSet::~RenderStateSet()
 {
 }
 
+// Removes all states but keeps the allocated storage
+void RenderStateSet::clear()
+{
+    m_stateMask = 0;
+    m_states.clear();
+}
+
 template<>
 void RenderStateSet::addState<StateVariant>(const StateVariant &ds)
 {
@@ -53,6 +53,7 @@ public:
 
     StateMaskSet stateMask() const;
     void merge(const RenderStateSet *other);
+    void clear();
 
     const std::vector<StateVariant>& states() const noexcept { return m_states; }
     std::vector<StateVariant>& states() noexcept { return m_states; }
@@ -8,6 +8,7 @@
 #include "qtexturedata.h"
 #include "qtexture.h"
 #include "qtexture_p.h"
+#include <QFile>
 #include <QFileInfo>
 #include <QMimeDatabase>
 #include <QMimeType>
@@ -23,6 +24,8 @@
 #include <Qt3DRender/private/texture_p.h>
 #include <qmath.h>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -401,6 +404,94 @@ const struct DX10Format
 { DXGI_FORMAT_BC7_UNORM_SRGB,                       { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_BP_UNorm,  QOpenGLTexture::NoPixelType,    16, true } },
 };
 
+// KTX2 files describe their content with a VkFormat
+const struct VkFormat
+{
+    quint32 vkFormat;
+    FormatInfo formatInfo;
+} vkFormats[] = {
+    // uncompressed formats
+{ /* VK_FORMAT_R8_UNORM */                      9,  { QOpenGLTexture::Red,              QOpenGLTexture::R8_UNorm,       QOpenGLTexture::UInt8,           1, false } },
+{ /* VK_FORMAT_R8_SNORM */                     10,  { QOpenGLTexture::Red,              QOpenGLTexture::R8_SNorm,       QOpenGLTexture::Int8,            1, false } },
+{ /* VK_FORMAT_R8G8_UNORM */                   16,  { QOpenGLTexture::RG,               QOpenGLTexture::RG8_UNorm,      QOpenGLTexture::UInt8,           2, false } },
+{ /* VK_FORMAT_R8G8_SNORM */                   17,  { QOpenGLTexture::RG,               QOpenGLTexture::RG8_SNorm,      QOpenGLTexture::Int8,            2, false } },
+{ /* VK_FORMAT_R8G8B8_UNORM */                 23,  { QOpenGLTexture::RGB,              QOpenGLTexture::RGB8_UNorm,     QOpenGLTexture::UInt8,           3, false } },
+{ /* VK_FORMAT_R8G8B8_SRGB */                  29,  { QOpenGLTexture::RGB,              QOpenGLTexture::SRGB8,          QOpenGLTexture::UInt8,           3, false } },
+{ /* VK_FORMAT_R8G8B8A8_UNORM */               37,  { QOpenGLTexture::RGBA,             QOpenGLTexture::RGBA8_UNorm,    QOpenGLTexture::UInt8,           4, false } },
+{ /* VK_FORMAT_R8G8B8A8_SNORM */               38,  { QOpenGLTexture::RGBA,             QOpenGLTexture::RGBA8_SNorm,    QOpenGLTexture::Int8,            4, false } },
+{ /* VK_FORMAT_R8G8B8A8_SRGB */                43,  { QOpenGLTexture::RGBA,             QOpenGLTexture::SRGB8_Alpha8,   QOpenGLTexture::UInt8,           4, false } },
+{ /* VK_FORMAT_B8G8R8A8_UNORM */               44,  { QOpenGLTexture::BGRA,             QOpenGLTexture::RGBA8_UNorm,    QOpenGLTexture::UInt8,           4, false } },
+{ /* VK_FORMAT_B8G8R8A8_SRGB */                50,  { QOpenGLTexture::BGRA,             QOpenGLTexture::SRGB8_Alpha8,   QOpenGLTexture::UInt8,           4, false } },
+{ /* VK_FORMAT_R16_UNORM */                    70,  { QOpenGLTexture::Red,              QOpenGLTexture::R16_UNorm,      QOpenGLTexture::UInt16,          2, false } },
+{ /* VK_FORMAT_R16_SFLOAT */                   76,  { QOpenGLTexture::Red,              QOpenGLTexture::R16F,           QOpenGLTexture::Float16,         2, false } },
+{ /* VK_FORMAT_R16G16_UNORM */                 77,  { QOpenGLTexture::RG,               QOpenGLTexture::RG16_UNorm,     QOpenGLTexture::UInt16,          4, false } },
+{ /* VK_FORMAT_R16G16_SFLOAT */                83,  { QOpenGLTexture::RG,               QOpenGLTexture::RG16F,          QOpenGLTexture::Float16,         4, false } },
+{ /* VK_FORMAT_R16G16B16A16_UNORM */           91,  { QOpenGLTexture::RGBA,             QOpenGLTexture::RGBA16_UNorm,   QOpenGLTexture::UInt16,          8, false } },
+{ /* VK_FORMAT_R16G16B16A16_SFLOAT */          97,  { QOpenGLTexture::RGBA,             QOpenGLTexture::RGBA16F,        QOpenGLTexture::Float16,         8, false } },
+{ /* VK_FORMAT_R32_SFLOAT */                  100,  { QOpenGLTexture::Red,              QOpenGLTexture::R32F,           QOpenGLTexture::Float32,         4, false } },
+{ /* VK_FORMAT_R32G32_SFLOAT */               103,  { QOpenGLTexture::RG,               QOpenGLTexture::RG32F,          QOpenGLTexture::Float32,         8, false } },
+{ /* VK_FORMAT_R32G32B32_SFLOAT */            106,  { QOpenGLTexture::RGB,              QOpenGLTexture::RGB32F,         QOpenGLTexture::Float32,        12, false } },
+{ /* VK_FORMAT_R32G32B32A32_SFLOAT */         109,  { QOpenGLTexture::RGBA,             QOpenGLTexture::RGBA32F,        QOpenGLTexture::Float32,        16, false } },
+{ /* VK_FORMAT_B10G11R11_UFLOAT_PACK32 */     122,  { QOpenGLTexture::RGB,              QOpenGLTexture::RG11B10F,       QOpenGLTexture::UInt32_RG11B10F, 4, false } },
+{ /* VK_FORMAT_E5B9G9R9_UFLOAT_PACK32 */      123,  { QOpenGLTexture::RGB,              QOpenGLTexture::RGB9E5,         QOpenGLTexture::UInt32_RGB9_E5,  4, false } },
+
+    // block compressed formats
+{ /* VK_FORMAT_BC1_RGB_UNORM_BLOCK */         131,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB_DXT1,       QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_BC1_RGB_SRGB_BLOCK */          132,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_DXT1,      QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_BC1_RGBA_UNORM_BLOCK */        133,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_DXT1,      QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_BC1_RGBA_SRGB_BLOCK */         134,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_Alpha_DXT1, QOpenGLTexture::NoPixelType,    8, true } },
+{ /* VK_FORMAT_BC2_UNORM_BLOCK */             135,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_DXT3,      QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_BC2_SRGB_BLOCK */              136,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_Alpha_DXT3, QOpenGLTexture::NoPixelType,   16, true } },
+{ /* VK_FORMAT_BC3_UNORM_BLOCK */             137,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_DXT5,      QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_BC3_SRGB_BLOCK */              138,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_Alpha_DXT5, QOpenGLTexture::NoPixelType,   16, true } },
+{ /* VK_FORMAT_BC4_UNORM_BLOCK */             139,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::R_ATI1N_UNorm,  QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_BC4_SNORM_BLOCK */             140,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::R_ATI1N_SNorm,  QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_BC5_UNORM_BLOCK */             141,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RG_ATI2N_UNorm, QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_BC5_SNORM_BLOCK */             142,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RG_ATI2N_SNorm, QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_BC6H_UFLOAT_BLOCK */           143,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB_BP_UNSIGNED_FLOAT, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_BC6H_SFLOAT_BLOCK */           144,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB_BP_SIGNED_FLOAT, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_BC7_UNORM_BLOCK */             145,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB_BP_UNorm,   QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_BC7_SRGB_BLOCK */              146,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB_BP_UNorm,  QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK */     147,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB8_ETC2,      QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK */      148,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_ETC2,     QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK */   149,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGB8_PunchThrough_Alpha1_ETC2, QOpenGLTexture::NoPixelType, 8, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK */    150,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_PunchThrough_Alpha1_ETC2, QOpenGLTexture::NoPixelType, 8, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK */   151,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA8_ETC2_EAC, QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK */    152,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ETC2_EAC, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_EAC_R11_UNORM_BLOCK */         153,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::R11_EAC_UNorm,  QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_EAC_R11_SNORM_BLOCK */         154,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::R11_EAC_SNorm,  QOpenGLTexture::NoPixelType,     8, true } },
+{ /* VK_FORMAT_EAC_R11G11_UNORM_BLOCK */      155,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RG11_EAC_UNorm, QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_EAC_R11G11_SNORM_BLOCK */      156,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RG11_EAC_SNorm, QOpenGLTexture::NoPixelType,    16, true } },
+{ /* VK_FORMAT_ASTC_4x4_UNORM_BLOCK */        157,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_4x4, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_4x4_SRGB_BLOCK */         158,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_4x4, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_5x4_UNORM_BLOCK */        159,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_5x4, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_5x4_SRGB_BLOCK */         160,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_5x4, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_5x5_UNORM_BLOCK */        161,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_5x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_5x5_SRGB_BLOCK */         162,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_5x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_6x5_UNORM_BLOCK */        163,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_6x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_6x5_SRGB_BLOCK */         164,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_6x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_6x6_UNORM_BLOCK */        165,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_6x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_6x6_SRGB_BLOCK */         166,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_6x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x5_UNORM_BLOCK */        167,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_8x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x5_SRGB_BLOCK */         168,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_8x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x6_UNORM_BLOCK */        169,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_8x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x6_SRGB_BLOCK */         170,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_8x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x8_UNORM_BLOCK */        171,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_8x8, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_8x8_SRGB_BLOCK */         172,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_8x8, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x5_UNORM_BLOCK */       173,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_10x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x5_SRGB_BLOCK */        174,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_10x5, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x6_UNORM_BLOCK */       175,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_10x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x6_SRGB_BLOCK */        176,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_10x6, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x8_UNORM_BLOCK */       177,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_10x8, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x8_SRGB_BLOCK */        178,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_10x8, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x10_UNORM_BLOCK */      179,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_10x10, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_10x10_SRGB_BLOCK */       180,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_10x10, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_12x10_UNORM_BLOCK */      181,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_12x10, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_12x10_SRGB_BLOCK */       182,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_12x10, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_12x12_UNORM_BLOCK */      183,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::RGBA_ASTC_12x12, QOpenGLTexture::NoPixelType, 16, true } },
+{ /* VK_FORMAT_ASTC_12x12_SRGB_BLOCK */       184,  { QOpenGLTexture::NoSourceFormat,   QOpenGLTexture::SRGB8_Alpha8_ASTC_12x12, QOpenGLTexture::NoPixelType, 16, true } },
+};
+
 struct PkmHeader
 {
     char magic[4];
@@ -428,7 +519,7 @@ ImageFormat imageFormatFromSuffix(const QString &suffix)
         return DDS;
     if (suffix == QStringLiteral("hdr"))
         return HDR;
-    if (suffix == QStringLiteral("ktx"))
+    if (suffix == QStringLiteral("ktx") || suffix == QStringLiteral("ktx2"))
         return KTX;
     return GenericImageFormat;
 }
@@ -453,10 +544,60 @@ quint32 blockSizeForTextureFormat(QOpenGLTexture::TextureFormat format)
     }
 }
 
-QTextureImageDataPtr setKtxFile(QIODevice *source)
+// Location of the image of a given layer, face and mipmap level within a KTX container
+struct KtxImage
+{
+    qsizetype offset;
+    qsizetype size;
+};
+
+struct KtxLayout
+{
+    int width = 0;
+    int height = 0;
+    int depth = 1;
+    int layers = 1;
+    int faces = 1;
+    int mipLevels = 1;
+    bool isArray = false;
+    int alignment = 1;
+    FormatInfo formatInfo = { QOpenGLTexture::NoSourceFormat, QOpenGLTexture::NoFormat,
+                              QOpenGLTexture::NoPixelType, 0, false };
+    // Indexed by (mipLevel * layers + layer) * faces + face
+    std::vector<KtxImage> images;
+
+    // Splits the image data of a mipmap level into one image per layer and face
+    bool addLevelImages(qsizetype offset, qsizetype levelSize, qsizetype fileSize)
+    {
+        const int imageCount = layers * faces;
+        if (levelSize <= 0 || levelSize % imageCount != 0
+                || offset < 0 || offset > fileSize || levelSize > fileSize - offset)
+            return false;
+        const qsizetype imageSize = levelSize / imageCount;
+        for (int i = 0; i < imageCount; ++i)
+            images.push_back({ offset + i * imageSize, imageSize });
+        return true;
+    }
+};
+
+// Each image takes at least a byte, so counts that the file can't hold are
+// rejected before anything gets allocated for them. The product fits in an int
+// once checked, the image indices are computed with ints.
+bool isPlausibleKtxImageCount(quint32 layers, quint32 faces, quint32 mipLevels, qsizetype fileSize)
+{
+    if (layers == 0 || faces == 0 || mipLevels == 0)
+        return false;
+    const quint64 maxImageCount = qMin(quint64(fileSize), quint64(std::numeric_limits<int>::max()));
+    const quint64 layerImageCount = quint64(layers) * quint64(faces);
+    return layerImageCount <= maxImageCount && mipLevels <= maxImageCount / layerImageCount;
+}
+
+const int KTX_IDENTIFIER_LENGTH = 12;
+const char ktx1Identifier[KTX_IDENTIFIER_LENGTH] = { '\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n' };
+const char ktx2Identifier[KTX_IDENTIFIER_LENGTH] = { '\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n' };
+
+bool parseKtx1Layout(const QByteArray &fileData, KtxLayout &layout)
 {
-    static const int KTX_IDENTIFIER_LENGTH = 12;
-    static const char ktxIdentifier[KTX_IDENTIFIER_LENGTH] = { '\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n' };
     static const quint32 platformEndianIdentifier = 0x04030201;
     static const quint32 inversePlatformEndianIdentifier = 0x01020304;
 
@@ -478,13 +619,11 @@ QTextureImageDataPtr setKtxFile(QIODevice *source)
     };
 
     KTXHeader header;
-    QTextureImageDataPtr imageData;
-    if (source->read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)
-            || qstrncmp(reinterpret_cast<char *>(header.identifier), ktxIdentifier, KTX_IDENTIFIER_LENGTH) != 0
-            || (header.endianness != platformEndianIdentifier && header.endianness != inversePlatformEndianIdentifier))
-    {
-        return imageData;
-    }
+    if (fileData.size() < qsizetype(sizeof(header)))
+        return false;
+    memcpy(&header, fileData.constData(), sizeof(header));
+    if (header.endianness != platformEndianIdentifier && header.endianness != inversePlatformEndianIdentifier)
+        return false;
 
     const bool isInverseEndian = (header.endianness == inversePlatformEndianIdentifier);
     auto decode = [isInverseEndian](quint32 val) {
@@ -492,80 +631,251 @@ QTextureImageDataPtr setKtxFile(QIODevice *source)
     };
 
     const bool isCompressed = decode(header.glType) == 0 && decode(header.glFormat) == 0 && decode(header.glTypeSize) == 1;
-    if (!isCompressed) {
-        qWarning("Uncompressed ktx texture data is not supported");
-        return imageData;
-    }
-
-    if (decode(header.numberOfArrayElements) != 0) {
-        qWarning("Array ktx textures not supported");
-        return imageData;
-    }
-
-    if (decode(header.pixelDepth) != 0) {
-        qWarning("Only 2D and cube ktx textures are supported");
-        return imageData;
+    if (!isCompressed && isInverseEndian && decode(header.glTypeSize) > 1) {
+        qWarning("Uncompressed ktx texture data with a different endianness is not supported");
+        return false;
     }
 
-    const int bytesToSkip = decode(header.bytesOfKeyValueData);
-    if (source->read(bytesToSkip).size() != bytesToSkip) {
-        qWarning("Unexpected end of ktx data");
-        return imageData;
+    const quint32 arrayElements = decode(header.numberOfArrayElements);
+    if (!isPlausibleKtxImageCount(qMax(arrayElements, 1U), decode(header.numberOfFaces),
+                                  qMax(decode(header.numberOfMipmapLevels), 1U), fileData.size()))
+        return false;
+
+    layout.width = int(decode(header.pixelWidth));
+    layout.height = int(decode(header.pixelHeight));
+    layout.depth = qMax(int(decode(header.pixelDepth)), 1);
+    layout.layers = qMax(int(arrayElements), 1);
+    layout.faces = int(decode(header.numberOfFaces));
+    layout.mipLevels = qMax(int(decode(header.numberOfMipmapLevels)), 1);
+    layout.isArray = arrayElements != 0;
+    // Rows of uncompressed images are padded to 4 bytes, like GL_UNPACK_ALIGNMENT
+    layout.alignment = 4;
+
+    // The GL enums stored in the header map directly to the QOpenGLTexture ones
+    const auto textureFormat = QOpenGLTexture::TextureFormat(decode(header.glInternalFormat));
+    if (isCompressed) {
+        layout.formatInfo = { QOpenGLTexture::NoSourceFormat, textureFormat, QOpenGLTexture::NoPixelType,
+                              int(blockSizeForTextureFormat(textureFormat)), true };
+    } else {
+        layout.formatInfo = { QOpenGLTexture::PixelFormat(decode(header.glFormat)), textureFormat,
+                              QOpenGLTexture::PixelType(decode(header.glType)),
+                              int(decode(header.glTypeSize)), false };
     }
 
-    const int level0Width = decode(header.pixelWidth);
-    const int level0Height = decode(header.pixelHeight);
-    const int faceCount = decode(header.numberOfFaces);
-    const int mipMapLevels = decode(header.numberOfMipmapLevels);
-    const QOpenGLTexture::TextureFormat format = QOpenGLTexture::TextureFormat(decode(header.glInternalFormat));
-    const int blockSize = blockSizeForTextureFormat(format);
-
-    // now for each mipmap level we have (arrays and 3d textures not supported here)
+    // The key/value data precedes the images, then for each mipmap level we have
     // uint32 imageSize
     // for each array element
     //   for each face
     //     for each z slice
-    //       compressed data
-    //     padding so that each face data starts at an offset that is a multiple of 4
-    // padding so that each imageSize starts at an offset that is a multiple of 4
+    //       image data
+    //     cube padding so that each face of non array cube maps starts at a multiple of 4
+    // mip padding so that each imageSize starts at an offset that is a multiple of 4
+    const bool isNonArrayCubeMap = layout.faces == 6 && !layout.isArray;
+    qsizetype offset = qsizetype(sizeof(header)) + decode(header.bytesOfKeyValueData);
+    layout.images.reserve(size_t(layout.mipLevels * layout.layers * layout.faces));
+
+    for (int level = 0; level < layout.mipLevels; ++level) {
+        quint32 imageSize = 0;
+        if (offset + 4 > fileData.size())
+            return false;
+        memcpy(&imageSize, fileData.constData() + offset, sizeof(imageSize));
+        imageSize = decode(imageSize);
+        offset += 4;
+
+        if (isNonArrayCubeMap) {
+            // imageSize is the size of a single face here
+            const qsizetype paddedFaceSize = (qsizetype(imageSize) + 3) & ~qsizetype(3);
+            for (int face = 0; face < layout.faces; ++face) {
+                if (imageSize == 0 || qsizetype(imageSize) > fileData.size() - offset)
+                    return false;
+                layout.images.push_back({ offset, qsizetype(imageSize) });
+                offset += paddedFaceSize;
+            }
+        } else {
+            if (!layout.addLevelImages(offset, imageSize, fileData.size()))
+                return false;
+            offset += (qsizetype(imageSize) + 3) & ~qsizetype(3);
+        }
+    }
 
-    // assumes no depth or uncompressed textures (per above)
-    auto computeMipMapLevelSize = [&] (int level) {
-        const int w = qMax(level0Width >> level, 1);
-        const int h = qMax(level0Height >> level, 1);
-        return ((w + 3) / 4) * ((h + 3) / 4) * blockSize;
+    if (offset < fileData.size())
+        qWarning() << "Unrecognized data at the end of ktx data";
+
+    return true;
+}
+
+bool parseKtx2Layout(const QByteArray &fileData, KtxLayout &layout)
+{
+    struct KTX2Header {
+        quint8 identifier[KTX_IDENTIFIER_LENGTH];
+        quint32 vkFormat;
+        quint32 typeSize;
+        quint32 pixelWidth;
+        quint32 pixelHeight;
+        quint32 pixelDepth;
+        quint32 layerCount;
+        quint32 faceCount;
+        quint32 levelCount;
+        quint32 supercompressionScheme;
+        quint32 dfdByteOffset;
+        quint32 dfdByteLength;
+        quint32 kvdByteOffset;
+        quint32 kvdByteLength;
+        quint64 sgdByteOffset;
+        quint64 sgdByteLength;
     };
 
-    int dataSize = 0;
-    for (auto i = 0; i < mipMapLevels; ++i)
-        dataSize += computeMipMapLevelSize(i) * faceCount + 4; // assumes a single layer (per above)
+    struct KTX2LevelIndex {
+        quint64 byteOffset;
+        quint64 byteLength;
+        quint64 uncompressedByteLength;
+    };
 
-    const QByteArray rawData = source->read(dataSize);
-    if (rawData.size() < dataSize) {
-        qWarning() << "Unexpected end of data in" << source;
+    // KTX2 files are always little endian
+    KTX2Header header;
+    if (fileData.size() < qsizetype(sizeof(header)))
+        return false;
+    memcpy(&header, fileData.constData(), sizeof(header));
+
+    if (qFromLittleEndian(header.supercompressionScheme) != 0) {
+        qWarning("Supercompressed ktx2 texture data is not supported");
+        return false;
+    }
+
+    const quint32 vkFormat = qFromLittleEndian(header.vkFormat);
+    const auto formatIt = std::find_if(std::begin(vkFormats), std::end(vkFormats),
+                                       [vkFormat] (const VkFormat &format) { return format.vkFormat == vkFormat; });
+    if (formatIt == std::end(vkFormats)) {
+        qWarning() << "Unsupported ktx2 texture format" << vkFormat;
+        return false;
+    }
+
+    const quint32 layerCount = qFromLittleEndian(header.layerCount);
+    if (!isPlausibleKtxImageCount(qMax(layerCount, 1U), qFromLittleEndian(header.faceCount),
+                                  qMax(qFromLittleEndian(header.levelCount), 1U), fileData.size()))
+        return false;
+
+    layout.formatInfo = formatIt->formatInfo;
+    layout.width = int(qFromLittleEndian(header.pixelWidth));
+    layout.height = int(qFromLittleEndian(header.pixelHeight));
+    layout.depth = qMax(int(qFromLittleEndian(header.pixelDepth)), 1);
+    layout.layers = qMax(int(layerCount), 1);
+    layout.faces = int(qFromLittleEndian(header.faceCount));
+    layout.mipLevels = qMax(int(qFromLittleEndian(header.levelCount)), 1);
+    layout.isArray = layerCount != 0;
+    layout.alignment = 1;
+
+    const qsizetype levelIndexOffset = qsizetype(sizeof(header));
+    if (fileData.size() < levelIndexOffset + layout.mipLevels * qsizetype(sizeof(KTX2LevelIndex)))
+        return false;
+
+    // Each level holds the images of all layers and faces, tightly packed
+    layout.images.reserve(size_t(layout.mipLevels * layout.layers * layout.faces));
+    for (int level = 0; level < layout.mipLevels; ++level) {
+        KTX2LevelIndex levelIndex;
+        memcpy(&levelIndex, fileData.constData() + levelIndexOffset + level * sizeof(KTX2LevelIndex), sizeof(levelIndex));
+        if (!layout.addLevelImages(qsizetype(qFromLittleEndian(levelIndex.byteOffset)),
+                                   qsizetype(qFromLittleEndian(levelIndex.byteLength)),
+                                   fileData.size()))
+            return false;
+    }
+
+    return true;
+}
+
+// fileData is either the content of the file or the memory map of mappedFile. In
+// the latter case, images are handed out straight from the mapped memory so that
+// there is never a complete copy of the file in memory
+QTextureImageDataPtr setKtxData(const QByteArray &fileData, const std::shared_ptr<QFile> &mappedFile)
+{
+    QTextureImageDataPtr imageData;
+    if (fileData.size() < KTX_IDENTIFIER_LENGTH)
+        return imageData;
+
+    KtxLayout layout;
+    bool parsed = false;
+    if (memcmp(fileData.constData(), ktx1Identifier, KTX_IDENTIFIER_LENGTH) == 0)
+        parsed = parseKtx1Layout(fileData, layout);
+    else if (memcmp(fileData.constData(), ktx2Identifier, KTX_IDENTIFIER_LENGTH) == 0)
+        parsed = parseKtx2Layout(fileData, layout);
+
+    if (!parsed) {
+        qWarning("Invalid or truncated ktx data");
         return imageData;
     }
 
-    if (!source->atEnd())
-        qWarning() << "Unrecognized data in" << source;
+    if (layout.width <= 0 || layout.height <= 0) {
+        qWarning("1D ktx textures are not supported");
+        return imageData;
+    }
+
+    if (layout.faces != 1 && layout.faces != 6) {
+        qWarning("Invalid number of faces in ktx texture");
+        return imageData;
+    }
+
+    if (layout.depth > 1 && (layout.isArray || layout.faces != 1)) {
+        qWarning("Array or cube ktx textures can't have a depth");
+        return imageData;
+    }
+
+    QOpenGLTexture::Target target = QOpenGLTexture::Target2D;
+    if (layout.depth > 1)
+        target = QOpenGLTexture::Target3D;
+    else if (layout.faces == 6)
+        target = layout.isArray ? QOpenGLTexture::TargetCubeMapArray : QOpenGLTexture::TargetCubeMap;
+    else if (layout.isArray)
+        target = QOpenGLTexture::Target2DArray;
 
     imageData = QTextureImageDataPtr::create();
-    imageData->setTarget(faceCount == 6 ? QOpenGLTexture::TargetCubeMap : QOpenGLTexture::Target2D);
-    imageData->setFormat(format);
-    imageData->setWidth(level0Width);
-    imageData->setHeight(level0Height);
-    imageData->setLayers(1);
-    imageData->setDepth(1);
-    imageData->setFaces(faceCount);
-    imageData->setMipLevels(mipMapLevels);
-    imageData->setPixelFormat(QOpenGLTexture::NoSourceFormat);
-    imageData->setPixelType(QOpenGLTexture::NoPixelType);
-    imageData->setData(rawData, blockSize, true);
-    QTextureImageDataPrivate::get(imageData.data())->m_isKtx = true; // see note in QTextureImageDataPrivate
+    imageData->setTarget(target);
+    imageData->setFormat(layout.formatInfo.textureFormat);
+    imageData->setWidth(layout.width);
+    imageData->setHeight(layout.height);
+    imageData->setLayers(layout.layers);
+    imageData->setDepth(layout.depth);
+    imageData->setFaces(layout.faces);
+    imageData->setMipLevels(layout.mipLevels);
+    imageData->setPixelFormat(layout.formatInfo.pixelFormat);
+    imageData->setPixelType(layout.formatInfo.pixelType);
+    imageData->setAlignment(layout.alignment);
+    QTextureImageDataPrivate::get(imageData.data())->m_blockSize = layout.formatInfo.components;
+
+    // The extractor keeps the mapped file alive for as long as the image data exists
+    const int layers = layout.layers;
+    const int faces = layout.faces;
+    imageData->setData(fileData,
+        [images = std::move(layout.images), layers, faces, mappedFile] (QByteArray rawData, int layer, int face, int mipmapLevel) {
+            const KtxImage &image = images[size_t((mipmapLevel * layers + layer) * faces + face)];
+            return QByteArray::fromRawData(rawData.constData() + image.offset, image.size);
+        },
+        layout.formatInfo.compressed);
 
     return imageData;
 }
 
+QTextureImageDataPtr setKtxFile(QIODevice *source)
+{
+    return setKtxData(source->readAll(), {});
+}
+
+QTextureImageDataPtr setKtxFile(const QString &source)
+{
+    auto file = std::make_shared<QFile>(source);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open" << source;
+        return {};
+    }
+
+    // Map the file so that images are only paged in when uploaded. Resources
+    // that can't be mapped, such as compressed qrc entries, are read instead
+    if (uchar *mappedData = file->map(0, file->size())) {
+        return setKtxData(QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData), file->size()),
+                          file);
+    }
+    return setKtxData(file->readAll(), {});
+}
+
 QTextureImageDataPtr setPkmFile(QIODevice *source)
 {
     QTextureImageDataPtr imageData;
@@ -966,11 +1276,19 @@ QTextureImageDataPtr TextureLoadingHelper::loadTextureData(const QUrl &url, bool
 #endif
             ) {
         const QString source = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(url);
+        const QString suffix = QFileInfo(source).suffix().toLower();
+        if (imageFormatFromSuffix(suffix) == KTX) {
+            textureData = setKtxFile(source);
+            if (!allow3D && textureData && (textureData->layers() > 1 || textureData->depth() > 1))
+                qWarning() << "Texture data has a 3rd dimension which wasn't expected";
+            return textureData;
+        }
+
         QFile f(source);
         if (!f.open(QIODevice::ReadOnly))
             qWarning() << "Failed to open" << source;
         else
-            textureData = loadTextureData(&f, QFileInfo(source).suffix().toLower(), allow3D, mirrored);
+            textureData = loadTextureData(&f, suffix, allow3D, mirrored);
     }
     return textureData;
 }
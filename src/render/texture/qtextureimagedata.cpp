@@ -24,25 +24,9 @@ QTextureImageDataPrivate::QTextureImageDataPrivate()
     , m_pixelFormat(QOpenGLTexture::RGBA)
     , m_pixelType(QOpenGLTexture::UInt8)
     , m_isCompressed(false)
-    , m_isKtx(false)
 {
 }
 
-QByteArray QTextureImageDataPrivate::ktxData(int layer, int face, int mipmapLevel) const
-{
-    Q_ASSERT(layer >= 0 && layer < m_layers &&
-            face >= 0 && face < m_faces &&
-            mipmapLevel >= 0 && mipmapLevel < m_mipLevels);
-
-    int offset = 0;
-    for (int i = 0; i < mipmapLevel; i++)
-        offset += (mipmapLevelSize(i) * m_faces * m_layers) + 4;
-    const int selectedMipmapLevelSize = mipmapLevelSize(mipmapLevel);
-    offset += (selectedMipmapLevelSize * m_faces * layer) + (selectedMipmapLevelSize * face) + 4;
-
-    return QByteArray::fromRawData(m_data.constData() + offset, selectedMipmapLevelSize);
-}
-
 QByteArray QTextureImageDataPrivate::data(int layer, int face, int mipmapLevel) const
 {
     if (layer < 0 || layer >= m_layers ||
@@ -55,9 +39,6 @@ QByteArray QTextureImageDataPrivate::data(int layer, int face, int mipmapLevel)
     if (m_dataExtractor)
         return m_dataExtractor(m_data, layer, face, mipmapLevel);
 
-    if (m_isKtx)
-        return ktxData(layer, face, mipmapLevel);
-
     int offset = layer * ddsLayerSize() + face * ddsFaceSize();
 
     for (int i = 0; i < mipmapLevel; i++)
@@ -52,11 +52,6 @@ public:
     QOpenGLTexture::PixelType m_pixelType;
 
     bool m_isCompressed;
-    // ### Qt 6
-    // QTextureImageData was originally written with assumptions around the internal data format
-    // matching dds layout. This is an ugly, but easy, way to add basic ktx support without any
-    // public API changes. Consider https://codereview.qt-project.org/#/c/178474/ for Qt 6.
-    bool m_isKtx;
     QByteArray m_data;
     std::function<QByteArray(QByteArray rawData, int layer, int face, int mipmapLevel)> m_dataExtractor;
 
@@ -66,7 +61,6 @@ private:
     int ddsLayerSize() const;
     int ddsFaceSize() const;
     int mipmapLevelSize(int level) const;
-    QByteArray ktxData(int layer, int face, int mipmapLevel) const;
 };
 
 } // namespace Qt3DRender
@@ -10,6 +10,7 @@
 #include <Qt3DRender/private/texture_p.h>
 #include <Qt3DRender/private/qabstracttexture_p.h>
 #include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -38,8 +39,10 @@ void Texture::addDirtyFlag(DirtyFlags flags)
 {
     QMutexLocker lock(&m_flagsMutex);
     m_dirty |= flags;
-    if (m_renderer)
+    if (m_renderer) {
         markDirty(AbstractRenderer::TexturesDirty);
+        pushToDirtyNodeQueue();
+    }
 }
 
 Texture::DirtyFlags Texture::dirtyFlags()
@@ -133,6 +136,18 @@ void Texture::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
             addDirtyFlag(DirtySharedTextureId);
         }
     }
+
+    // A newly created texture starts dirty without going through addDirtyFlag
+    if (firstTime && m_renderer && dirtyFlags() != NotDirty)
+        pushToDirtyNodeQueue();
+}
+
+// Lets the renderer gather the dirty textures without going over all of them
+void Texture::pushToDirtyNodeQueue()
+{
+    NodeManagers *managers = m_renderer->nodeManagers();
+    if (managers != nullptr)
+        managers->textureManager()->dirtyNodeQueue().push(this);
 }
 
 // Called by syncFromFrontend or TextureDownloadRequest (both in AspectThread context)
@@ -8,6 +8,7 @@ HEADERS += \
     $$PWD/qtextureimage_p.h \
     $$PWD/qtexturewrapmode.h \
     $$PWD/texture_p.h \
+    $$PWD/texturedatamanager_p.h \
     $$PWD/textureimage_p.h \
     $$PWD/qabstracttexture.h \
     $$PWD/qabstracttexture_p.h \
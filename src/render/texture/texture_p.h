@@ -16,6 +16,7 @@
 //
 
 #include <Qt3DRender/private/backendnode_p.h>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/qabstracttexture_p.h>
 #include <Qt3DRender/private/qtexturegenerator_p.h>
@@ -136,7 +137,12 @@ public:
 
     void setDataGenerator(const QTextureGeneratorPtr &generator);
     bool isValid(TextureImageManager *manager) const;
+
+    DirtyNodeQueueLink<Texture> &dirtyNodeQueueLink() noexcept { return m_dirtyNodeQueueLink; }
+
 private:
+    void pushToDirtyNodeQueue();
+
     DirtyFlags m_dirty;
     TextureProperties m_properties;
     TextureParameters m_parameters;
@@ -147,6 +153,7 @@ private:
 
     QMutex m_flagsMutex;
     std::vector<QTextureDataUpdate> m_pendingTextureDataUpdates;
+    DirtyNodeQueueLink<Texture> m_dirtyNodeQueueLink;
 };
 
 class Q_AUTOTEST_EXPORT TextureFunctor : public Qt3DCore::QBackendNodeMapper
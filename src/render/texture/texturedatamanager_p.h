@@ -15,14 +15,18 @@
 // We mean it.
 //
 
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
 #include <Qt3DRender/qtexture.h>
 #include <Qt3DRender/qtextureimagedata.h>
-#include <Qt3DRender/qtexturegenerator.h>
+#include <Qt3DRender/private/qtexturegenerator_p.h>
 #include <Qt3DRender/qtextureimagedatagenerator.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -36,14 +40,17 @@ namespace Render {
  *   QTextureGenerator -> QTextureData
  *
  * This way, texture classes only need to refer to the texture functors used.
- * Aspect jobs will make sure that at the start of each frame, all generators
- * registered with the GeneratorDataManagers have been executed.
+ * The LoadTextureDataJob makes sure that all generators registered with the
+ * GeneratorDataManagers are executed on worker threads ahead of the frame
+ * submission. Renderers should only upload data that is ready.
  *
  * This guarantees that no texture data generator is executed twice.
  *
  * Each Generator is associated with a number of textures that reference it.
  * If the last texture disassociates from a generator, the QTextureData will
- * be deleted.
+ * be deleted. The data is also dropped once every referencing texture took it
+ * with markDataTaken(), textures then own it until they have uploaded it. Requesting
+ * the data again afterwards executes the generator again.
  */
 template <class GeneratorPtr, class DataPtr, class ReferencedType>
 class GeneratorDataManager
@@ -69,6 +76,13 @@ public:
         Q_ASSERT(entry);
         if (!entry->referencingObjects.contains(r))
             entry->referencingObjects.push_back(r);
+        entry->consumers.removeAll(r);
+        // The data was taken by all the textures, generate it again
+        if (entry->released) {
+            entry->released = false;
+            entry->generated = false;
+            ++m_pendingCount;
+        }
         return needsToBeCreated;
     }
 
@@ -80,18 +94,16 @@ public:
     {
         QMutexLocker lock(&m_mutex);
 
-        const auto end = m_data.end();
-        for (auto it = m_data.begin(); it != end; ++it) {
-            Entry &entry = *it;
-            if (*entry.generator == *generator) {
-                entry.referencingObjects.removeAll(r);
-                // delete, if that was the last reference
-                if (entry.referencingObjects.empty()) {
-                    m_data.erase(it);
-                    return;
-                }
-            }
-        }
+        Entry *entry = findEntry(generator);
+        if (!entry)
+            return;
+        entry->referencingObjects.removeAll(r);
+        entry->consumers.removeAll(r);
+        // delete, if that was the last reference
+        if (entry->referencingObjects.empty())
+            removeEntry(entry);
+        else
+            releaseConsumedData(entry);
     }
 
     /*!
@@ -105,6 +117,45 @@ public:
         return entry ? entry->data : DataPtr();
     }
 
+    /*!
+     * Record that texture \a r took the data of the generator. The manager
+     * drops the data once all the textures referencing the generator took it.
+     */
+    void markDataTaken(const GeneratorPtr &generator, ReferencedType r)
+    {
+        QMutexLocker lock(&m_mutex);
+
+        Entry *entry = findEntry(generator);
+        if (!entry || !entry->generated)
+            return;
+        if (entry->referencingObjects.contains(r) && !entry->consumers.contains(r))
+            entry->consumers.push_back(r);
+        releaseConsumedData(entry);
+    }
+
+    /*!
+     * Returns true if the generator has been executed, in which case
+     * getData() returns its result (which might be null if the generator
+     * failed)
+     */
+    bool isDataReady(const GeneratorPtr &generator)
+    {
+        QMutexLocker lock(&m_mutex);
+
+        const Entry *entry = findEntry(generator);
+        return entry ? entry->generated : false;
+    }
+
+    /*!
+     * Returns true if some generators were not yet executed
+     */
+    bool hasPendingGenerators()
+    {
+        QMutexLocker lock(&m_mutex);
+
+        return m_pendingCount > 0;
+    }
+
     /*!
      * Returns all generators that were not yet executed
      */
@@ -113,9 +164,12 @@ public:
         QMutexLocker lock(&m_mutex);
 
         QList<GeneratorPtr> ret;
-        for (const Entry &entry : m_data)
-            if (!entry.data && !ret.contains(entry.generator))
-                ret.push_back(entry.generator);
+        if (m_pendingCount == 0)
+            return ret;
+        ret.reserve(m_pendingCount);
+        for (const auto &entry : m_data)
+            if (!entry->generated)
+                ret.push_back(entry->generator);
         return ret;
     }
 
@@ -127,16 +181,20 @@ public:
     {
         QMutexLocker lock(&m_mutex);
 
+        // The generator might have been released while it was executed
         Entry *entry = findEntry(generator);
-        if (!entry) {
-            qWarning() << "[TextureDataManager] assignData() called with non-existent generator";
+        if (!entry)
             return;
-        }
         entry->data = data;
+        if (!entry->generated)
+            --m_pendingCount;
+        entry->generated = true;
     }
 
     bool contains(const GeneratorPtr &generator)
     {
+        QMutexLocker lock(&m_mutex);
+
         return findEntry(generator) != nullptr;
     }
 
@@ -144,42 +202,90 @@ private:
 
     struct Entry {
         GeneratorPtr generator;
+        // Other generators comparing equal to generator that were looked up
+        QList<GeneratorPtr> aliases;
         QList<ReferencedType> referencingObjects;
+        // The referencing objects that took the data
+        QList<ReferencedType> consumers;
         DataPtr data;
+        size_t index = 0;
+        bool generated = false;
+        bool released = false;
     };
 
     /*!
      * Helper function: return entry for given generator if it exists, nullptr
-     * otherwise.
+     * otherwise. Generators compare by value, the ones that were already
+     * looked up are found directly.
      */
     Entry* findEntry(const GeneratorPtr &generator)
     {
-        for (int i = 0, sz = m_data.size(); i < sz; ++i)
-            if (*m_data[i].generator == *generator)
-                return &m_data[i];
+        const auto it = m_entriesByGenerator.constFind(generator.get());
+        if (it != m_entriesByGenerator.cend())
+            return it.value();
+
+        for (const auto &entry : m_data) {
+            if (*entry->generator == *generator) {
+                entry->aliases.push_back(generator);
+                m_entriesByGenerator.insert(generator.get(), entry.get());
+                return entry.get();
+            }
+        }
         return nullptr;
     }
 
     Entry *createEntry(const GeneratorPtr &generator)
     {
-        Entry newEntry;
-        newEntry.generator = generator;
+        auto newEntry = std::make_unique<Entry>();
+        newEntry->generator = generator;
+        newEntry->index = m_data.size();
+
+        Entry *entry = newEntry.get();
+        m_data.push_back(std::move(newEntry));
+        m_entriesByGenerator.insert(generator.get(), entry);
+        ++m_pendingCount;
+        return entry;
+    }
+
+    void removeEntry(Entry *entry)
+    {
+        m_entriesByGenerator.remove(entry->generator.get());
+        for (const GeneratorPtr &alias : std::as_const(entry->aliases))
+            m_entriesByGenerator.remove(alias.get());
+        if (!entry->generated)
+            --m_pendingCount;
 
-        m_data.push_back(newEntry);
-        return &m_data.back();
+        // Swap with the last entry to remove in constant time
+        const size_t index = entry->index;
+        if (index != m_data.size() - 1) {
+            std::swap(m_data[index], m_data.back());
+            m_data[index]->index = index;
+        }
+        m_data.pop_back();
+    }
+
+    void releaseConsumedData(Entry *entry)
+    {
+        if (entry->generated && !entry->released
+                && entry->consumers.size() == entry->referencingObjects.size()) {
+            entry->data = DataPtr();
+            entry->released = true;
+        }
     }
 
     QMutex m_mutex;
-    QList<Entry> m_data;
+    std::vector<std::unique_ptr<Entry>> m_data;
+    QHash<const void *, Entry *> m_entriesByGenerator;
+    qsizetype m_pendingCount = 0;
 };
 
-class QT3DRENDERSHARED_PRIVATE_EXPORT TextureDataManager
+class Q_3DRENDERSHARED_PRIVATE_EXPORT TextureDataManager
         : public GeneratorDataManager<QTextureGeneratorPtr, QTextureDataPtr, void*>
 {
 };
 
-class QT3DRENDERSHARED_PRIVATE_EXPORT TextureImageDataManager
-        : public GeneratorDataManager<QTextureImageDataGeneratorPtr, QTextureImageDataPtr, Qt3DCore::QNodeId>
+class Q_3DRENDERSHARED_PRIVATE_EXPORT TextureImageDataManager
+        : public GeneratorDataManager<QTextureImageDataGeneratorPtr, QTextureImageDataPtr, void*>
 {
 };
 
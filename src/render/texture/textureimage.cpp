@@ -4,6 +4,7 @@
 #include "textureimage_p.h"
 #include <Qt3DRender/qtextureimage.h>
 #include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/qabstracttextureimage_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -66,8 +67,12 @@ void TextureImage::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         m_dirty = true;
     }
 
-    if (m_dirty)
+    if (m_dirty) {
         markDirty(AbstractRenderer::AllDirty);
+        NodeManagers *managers = m_renderer ? m_renderer->nodeManagers() : nullptr;
+        if (managers != nullptr)
+            managers->textureImageManager()->dirtyNodeQueue().push(this);
+    }
 }
 
 void TextureImage::unsetDirty()
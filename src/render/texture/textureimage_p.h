@@ -16,6 +16,7 @@
 //
 
 #include <Qt3DRender/private/backendnode_p.h>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/qabstracttexture.h>
 #include <Qt3DRender/qtextureimagedatagenerator.h>
@@ -50,12 +51,15 @@ public:
     inline bool isDirty() const { return m_dirty; }
     void unsetDirty();
 
+    DirtyNodeQueueLink<TextureImage> &dirtyNodeQueueLink() noexcept { return m_dirtyNodeQueueLink; }
+
 private:
     bool m_dirty;
     int m_layer;
     int m_mipLevel;
     QAbstractTexture::CubeMapFace m_face;
     QTextureImageDataGeneratorPtr m_generator;
+    DirtyNodeQueueLink<TextureImage> m_dirtyNodeQueueLink;
 };
 
 class TextureImageFunctor : public Qt3DCore::QBackendNodeMapper
@@ -0,0 +1,7 @@
+TARGET = tst_boundingsphereutils
+CONFIG += testcase
+TEMPLATE = app
+
+SOURCES += tst_boundingsphereutils.cpp
+
+QT += testlib 3dcore 3dcore-private
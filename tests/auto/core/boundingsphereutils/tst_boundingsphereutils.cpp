@@ -0,0 +1,167 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <Qt3DCore/private/boundingsphereutils_p.h>
+
+#include <random>
+#include <vector>
+
+using namespace Qt3DCore;
+
+namespace {
+
+float maxDistanceFrom(const std::vector<float> &positions, uint stride, const QVector3D &center)
+{
+    float maxDistance = 0.f;
+    for (size_t i = 0; i + 2 < positions.size(); i += stride) {
+        const QVector3D p(positions[i], positions[i + 1], positions[i + 2]);
+        maxDistance = std::max(maxDistance, (p - center).length());
+    }
+    return maxDistance;
+}
+
+} // anonymous
+
+class tst_BoundingSphereUtils : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkInvalidStream()
+    {
+        // GIVEN
+        PositionStream stream;
+
+        // THEN
+        QVERIFY(!computeBoundingSphere(stream).isValid());
+
+        // WHEN
+        const std::vector<float> positions = { 1.f, 2.f, 3.f };
+        stream.positions = positions.data();
+        stream.count = 0;
+
+        // THEN
+        QVERIFY(!computeBoundingSphere(stream).isValid());
+    }
+
+    void checkDirectPositions()
+    {
+        // GIVEN
+        const std::vector<float> positions = {
+            -1.f,  0.f,  0.f,
+             1.f,  0.f,  0.f,
+             0.f, -1.f,  0.f,
+             0.f,  1.f,  0.f,
+             0.f,  0.f, -1.f,
+             0.f,  0.f,  1.f,
+        };
+        PositionStream stream;
+        stream.positions = positions.data();
+        stream.count = 6;
+
+        // WHEN
+        const BoundingSphereResult result = computeBoundingSphere(stream);
+
+        // THEN
+        QVERIFY(result.isValid());
+        QCOMPARE(result.min, QVector3D(-1.f, -1.f, -1.f));
+        QCOMPARE(result.max, QVector3D(1.f, 1.f, 1.f));
+        QCOMPARE(result.center, QVector3D(0.f, 0.f, 0.f));
+        QCOMPARE(result.radius, 1.f);
+    }
+
+    void checkInterleavedLargeStream()
+    {
+        // GIVEN
+        // Large enough to be split in several chunks, with a normal
+        // interleaved after each position
+        const uint vertexCount = 100000;
+        const uint stride = 6;
+        std::vector<float> data(vertexCount * stride);
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> distribution(-50.f, 50.f);
+        for (float &v : data)
+            v = distribution(generator);
+
+        PositionStream stream;
+        stream.positions = data.data();
+        stream.byteStride = stride * sizeof(float);
+        stream.count = vertexCount;
+
+        // WHEN
+        const BoundingSphereResult result = computeBoundingSphere(stream);
+
+        // THEN
+        QVERIFY(result.isValid());
+        QVector3D expectedMin(data[0], data[1], data[2]);
+        QVector3D expectedMax = expectedMin;
+        for (uint i = 0; i < vertexCount; ++i) {
+            const QVector3D p(data[i * stride], data[i * stride + 1], data[i * stride + 2]);
+            for (int c = 0; c < 3; ++c) {
+                expectedMin[c] = std::min(expectedMin[c], p[c]);
+                expectedMax[c] = std::max(expectedMax[c], p[c]);
+            }
+        }
+        QCOMPARE(result.min, expectedMin);
+        QCOMPARE(result.max, expectedMax);
+        QVERIFY(qFuzzyCompare(result.radius, maxDistanceFrom(data, stride, result.center)));
+    }
+
+    void checkIndexedWithPrimitiveRestart()
+    {
+        // GIVEN
+        const std::vector<float> positions = {
+            0.f, 0.f, 0.f,
+            2.f, 0.f, 0.f,
+            100.f, 100.f, 100.f, // Only referenced through the restart index
+        };
+        const std::vector<quint16> indices = { 0, 2, 1, 2, 0 };
+        PositionStream stream;
+        stream.positions = positions.data();
+        stream.indices = reinterpret_cast<const char *>(indices.data());
+        stream.indexType = QAttribute::UnsignedShort;
+        stream.count = uint(indices.size());
+        stream.primitiveRestartEnabled = true;
+        stream.primitiveRestartIndex = 2;
+
+        // WHEN
+        const BoundingSphereResult result = computeBoundingSphere(stream);
+
+        // THEN
+        QVERIFY(result.isValid());
+        QCOMPARE(result.min, QVector3D(0.f, 0.f, 0.f));
+        QCOMPARE(result.max, QVector3D(2.f, 0.f, 0.f));
+        QCOMPARE(result.center, QVector3D(1.f, 0.f, 0.f));
+        QCOMPARE(result.radius, 1.f);
+    }
+
+    void checkKnownExtent()
+    {
+        // GIVEN
+        const std::vector<float> positions = {
+            0.f, 0.f, 0.f,
+            4.f, 2.f, 0.f,
+            1.f, 1.f, 1.f,
+        };
+        PositionStream stream;
+        stream.positions = positions.data();
+        stream.count = 3;
+        const QVector3D min(0.f, 0.f, 0.f);
+        const QVector3D max(4.f, 2.f, 1.f);
+
+        // WHEN
+        const BoundingSphereResult result = computeBoundingSphere(stream, min, max);
+
+        // THEN
+        QVERIFY(result.isValid());
+        QCOMPARE(result.min, min);
+        QCOMPARE(result.max, max);
+        QCOMPARE(result.center, QVector3D(2.f, 1.f, .5f));
+        QVERIFY(qFuzzyCompare(result.radius, maxDistanceFrom(positions, 3, result.center)));
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_BoundingSphereUtils)
+
+#include "tst_boundingsphereutils.moc"
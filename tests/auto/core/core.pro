@@ -3,6 +3,7 @@ TEMPLATE = subdirs
 SUBDIRS = \
     handle \
     qresourcemanager \
+    boundingsphereutils \
     nodes \
     qaspectengine \
     qaspectfactory \
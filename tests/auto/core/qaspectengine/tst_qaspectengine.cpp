@@ -8,6 +8,9 @@
 #include <Qt3DCore/qaspectengine.h>
 #include <Qt3DCore/qentity.h>
 #include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qabstractaspect_p.h>
+#include <Qt3DCore/private/qaspectengine_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
 
 using namespace Qt3DCore;
 
@@ -49,6 +52,38 @@ private:
     QNodeId m_rootEntityId;
 };
 
+class CountingAspectPrivate : public QAbstractAspectPrivate
+{
+public:
+    bool needsNextFrame() const override { return m_framesNeeded > 0; }
+
+    int m_framesNeeded = 0;
+    int m_frameCount = 0;
+};
+
+// Needs frames as long as m_framesNeeded isn't zero
+class CountingAspect : public QAbstractAspect
+{
+    Q_OBJECT
+public:
+    explicit CountingAspect(QObject *parent = nullptr)
+        : QAbstractAspect(*new CountingAspectPrivate, parent) {}
+
+    void requestFrames(int count) { d()->m_framesNeeded = count; }
+    int frameCount() const { return d()->m_frameCount; }
+
+private:
+    CountingAspectPrivate *d() const { return static_cast<CountingAspectPrivate *>(d_ptr.data()); }
+
+    std::vector<QAspectJobPtr> jobsToExecute(qint64) override
+    {
+        ++d()->m_frameCount;
+        if (d()->m_framesNeeded > 0)
+            --d()->m_framesNeeded;
+        return {};
+    }
+};
+
 #define FAKE_ASPECT(ClassName, dependAspects) \
 class ClassName : public QAbstractAspect \
 { \
@@ -177,6 +212,48 @@ private Q_SLOTS:
         // * destroying the aspect engine
     }
 
+    void shouldIdleWhenNoAspectNeedsFrames()
+    {
+        // GIVEN
+        QAspectEngine engine;
+        CountingAspect *aspect = new CountingAspect;
+        engine.registerAspect(aspect);
+        QAspectManager *manager = QAspectEnginePrivate::get(&engine)->m_aspectManager;
+
+        // WHEN
+        aspect->requestFrames(3);
+        QEntityPtr root(new QEntity);
+        engine.setRootEntity(root);
+
+        // THEN
+        QTRY_VERIFY(manager->isIdle());
+        QVERIFY(aspect->frameCount() >= 3);
+
+        // WHEN
+        const int idleFrameCount = aspect->frameCount();
+        QTest::qWait(100);
+
+        // THEN
+        QVERIFY(manager->isIdle());
+        QCOMPARE(aspect->frameCount(), idleFrameCount);
+
+        // WHEN
+        root->setEnabled(false);
+
+        // THEN
+        QTRY_VERIFY(aspect->frameCount() > idleFrameCount);
+        QTRY_VERIFY(manager->isIdle());
+
+        // WHEN
+        const int wokenFrameCount = aspect->frameCount();
+        aspect->requestFrames(5);
+        manager->wakeUp();
+
+        // THEN
+        QTRY_VERIFY(aspect->frameCount() >= wokenFrameCount + 5);
+        QTRY_VERIFY(manager->isIdle());
+    }
+
     void shouldNotCrashWhenEntityIsAddedThenImmediatelyDeleted()
     {
         // GIVEN
@@ -27,6 +27,10 @@ private slots:
     void collectResources();
     void activeHandles();
     void checkCleanup();
+    void releaseKeepsActiveHandlesDense();
+    void memoryStatistics();
+    void trimIfIdle();
+    void publishedLookupTable();
 };
 
 class tst_ArrayResource
@@ -40,8 +44,19 @@ public:
     QAtomicInt m_value;
 };
 
+class tst_PayloadResource
+{
+public:
+    // Like most backend nodes, keeps its payload around on cleanup
+    void cleanup() { m_id = 0; }
+
+    int m_id = 0;
+    QByteArray m_payload;
+};
+
 QT_BEGIN_NAMESPACE
 Q_DECLARE_RESOURCE_INFO(tst_ArrayResource, Q_REQUIRES_CLEANUP)
+Q_DECLARE_RESOURCE_INFO(tst_PayloadResource, Q_REQUIRES_CLEANUP)
 QT_END_NAMESPACE
 
 typedef Qt3DCore::QHandle<tst_ArrayResource> tHandle;
@@ -419,8 +434,200 @@ void tst_QResourceManager::checkCleanup()
     QCOMPARE(data->m_value.loadRelaxed(), 0);
 }
 
+void tst_QResourceManager::releaseKeepsActiveHandlesDense()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
+    QList<tHandle> handles;
+    for (int i = 0; i < 8; ++i)
+        handles << manager.acquire();
+
+    // WHEN
+    manager.release(handles.at(2));
+    manager.release(handles.at(0));
+    manager.release(handles.at(7));
+
+    // THEN
+    QCOMPARE(manager.count(), 5);
+    const std::vector<tHandle> &activeHandles = manager.activeHandles();
+    for (int i : {1, 3, 4, 5, 6})
+        QVERIFY(std::find(activeHandles.begin(), activeHandles.end(), handles.at(i)) != activeHandles.end());
+
+    // WHEN
+    manager.release(handles.at(2));
+
+    // THEN -> releasing a stale handle is a no-op
+    QCOMPARE(manager.count(), 5);
+
+    // WHEN
+    for (int i : {1, 3, 4, 5, 6})
+        manager.release(handles.at(i));
 
+    // THEN
+    QCOMPARE(manager.count(), 0);
+    QVERIFY(manager.activeHandles().empty());
+}
+
+void tst_QResourceManager::memoryStatistics()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
+    QCOMPARE(manager.memoryStatistics().bucketCount, 0);
+
+    // WHEN
+    QList<tHandle> handles;
+    for (int i = 0; i < 10000; ++i)
+        handles << manager.acquire();
+
+    // THEN
+    const auto fullStats = manager.memoryStatistics();
+    QCOMPARE(fullStats.activeCount, 10000);
+    QVERIFY(fullStats.bucketCount > 1);
+    QVERIFY(fullStats.capacity >= 10000);
+    QVERIFY(fullStats.allocatedBytes > 0);
+
+    // WHEN
+    for (const tHandle &h : std::as_const(handles))
+        manager.release(h);
+
+    // THEN -> buckets are kept so that released handles can be detected as stale
+    const auto releasedStats = manager.memoryStatistics();
+    QCOMPARE(releasedStats.activeCount, 0);
+    QCOMPARE(releasedStats.bucketCount, fullStats.bucketCount);
+    for (const tHandle &h : std::as_const(handles))
+        QVERIFY(manager.data(h) == nullptr);
+
+    // WHEN
+    for (int i = 0; i < 10000; ++i)
+        manager.acquire();
+
+    // THEN -> and reused
+    QCOMPARE(manager.memoryStatistics().bucketCount, fullStats.bucketCount);
+}
 
+void tst_QResourceManager::trimIfIdle()
+{
+    // GIVEN
+    using tPayloadHandle = Qt3DCore::QHandle<tst_PayloadResource>;
+    Qt3DCore::QResourceManager<tst_PayloadResource, uint> manager;
+    const auto payloadCount = [&manager] {
+        int count = 0;
+        manager.for_each([&count](tst_PayloadResource *r) {
+            if (!r->m_payload.isEmpty())
+                ++count;
+        });
+        return count;
+    };
+
+    QList<tPayloadHandle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles << manager.acquire();
+        manager.data(handles.last())->m_payload = QByteArray(64, 'a');
+    }
+
+    // THEN -> nothing to trim while resources are allocated
+    QVERIFY(!manager.trimIfIdle());
+    QVERIFY(!manager.trimIfIdle());
+
+    // WHEN -> released along with an allocation in the same frame
+    for (int i = 0; i < 500; ++i)
+        manager.release(handles.at(i));
+    const tPayloadHandle extra = manager.acquire();
+
+    // THEN -> the reused entry still holds the payload of the released one
+    QVERIFY(!manager.trimIfIdle());
+    QCOMPARE(payloadCount(), 1000);
+
+    // WHEN -> a frame without allocations
+    const bool trimmed = manager.trimIfIdle();
+
+    // THEN -> released payloads are gone, live ones and stale handles are untouched
+    QVERIFY(trimmed);
+    QCOMPARE(payloadCount(), 501);
+    for (int i = 0; i < 500; ++i)
+        QVERIFY(manager.data(handles.at(i)) == nullptr);
+    for (int i = 500; i < 1000; ++i)
+        QCOMPARE(manager.data(handles.at(i))->m_payload, QByteArray(64, 'a'));
+    QVERIFY(manager.data(extra) != nullptr);
+    QCOMPARE(manager.memoryStatistics().activeCount, 501);
+
+    // THEN -> nothing left to trim
+    QVERIFY(!manager.trimIfIdle());
+
+    // WHEN -> trimmed entries are reused
+    for (int i = 0; i < 500; ++i)
+        QVERIFY(manager.data(manager.acquire())->m_payload.isEmpty());
+
+    // THEN
+    QCOMPARE(manager.memoryStatistics().activeCount, 1001);
+}
+
+void tst_QResourceManager::publishedLookupTable()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint, Qt3DCore::ObjectLevelLockingPolicy> manager;
+    const tHandle h1 = manager.getOrAcquireHandle(1U);
+    const tHandle h2 = manager.getOrAcquireHandle(2U);
+    const tHandle h4 = manager.getOrAcquireHandle(4U);
+    manager.release(h4);
+
+    // WHEN
+    manager.publishLookupTable();
+
+    // THEN -> only lookups from aspect jobs go through the published table
+    QVERIFY(!Qt3DCore::QLookupTableReadScope::isActive());
+    Qt3DCore::QLookupTableReadScope scope;
+    QVERIFY(Qt3DCore::QLookupTableReadScope::isActive());
+    {
+        Qt3DCore::QLookupTableReadScope nestedScope;
+    }
+    QVERIFY(Qt3DCore::QLookupTableReadScope::isActive());
+
+    // THEN -> keys whose handle was released directly aren't published
+    QCOMPARE(manager.lookupHandle(4U), h4);
+    QVERIFY(manager.lookupResource(4U) == nullptr);
+
+    // THEN
+    QCOMPARE(manager.lookupHandle(1U), h1);
+    QCOMPARE(manager.lookupHandle(2U), h2);
+    QCOMPARE(manager.lookupResource(2U), manager.data(h2));
+    QCOMPARE(manager.getOrAcquireHandle(1U), h1);
+    QVERIFY(manager.contains(1U));
+
+    // WHEN -> changes made after publishing are still visible
+    const tHandle h3 = manager.getOrAcquireHandle(3U);
+    manager.releaseResource(1U);
+
+    // THEN
+    QCOMPARE(manager.lookupHandle(3U), h3);
+    QVERIFY(manager.contains(3U));
+    QVERIFY(!manager.contains(1U));
+    QVERIFY(manager.lookupHandle(1U).isNull());
+    QVERIFY(manager.lookupResource(1U) == nullptr);
+
+    // WHEN -> a released key is acquired again
+    const tHandle h1b = manager.getOrAcquireHandle(1U);
+
+    // THEN
+    QVERIFY(h1b != h1);
+    QCOMPARE(manager.lookupHandle(1U), h1b);
+
+    // WHEN
+    manager.publishLookupTable();
+
+    // THEN
+    QCOMPARE(manager.lookupHandle(1U), h1b);
+    QCOMPARE(manager.lookupResource(3U), manager.data(h3));
+
+    // WHEN
+    manager.releaseAllResources();
+
+    // THEN
+    QVERIFY(!manager.contains(1U));
+    QVERIFY(!manager.contains(2U));
+    QVERIFY(!manager.contains(3U));
+    QVERIFY(manager.lookupResource(2U) == nullptr);
+}
 
 QTEST_APPLESS_MAIN(tst_QResourceManager)
 
@@ -63,11 +63,17 @@ using JobPtr = QSharedPointer<Job>;
 
 class AspectPrivate : public QAbstractAspectPrivate
 {
+    bool m_jobsEnqueuedCalled = false;
     bool m_jobsDoneCalled = false;
     bool m_frameDoneCalled = false;
 
 public:
 
+    bool jobsEnqueuedCalled() const
+    {
+        return m_jobsEnqueuedCalled;
+    }
+
     bool jobsDoneCalled() const
     {
         return m_jobsDoneCalled;
@@ -79,6 +85,11 @@ public:
     }
 
     // QAspectJobProviderInterface interface
+    void jobsEnqueued() override
+    {
+        m_jobsEnqueuedCalled = true;
+    }
+
     void jobsDone() override
     {
         m_jobsDoneCalled = true;
@@ -151,6 +162,7 @@ private Q_SLOTS:
         // THEN
         const JobPtr first = aspect.firstJob();
         const JobPtr second = aspect.secondJob();
+        QVERIFY(!aspectPriv->jobsEnqueuedCalled());
         QVERIFY(!aspectPriv->jobsDoneCalled());
         QVERIFY(!aspectPriv->frameDoneCalled());
         QVERIFY(!first->wasExecuted());
@@ -167,6 +179,7 @@ private Q_SLOTS:
         QVERIFY(second->wasExecuted());
         QVERIFY(first->postFrameCalled());
         QVERIFY(second->postFrameCalled());
+        QVERIFY(aspectPriv->jobsEnqueuedCalled());
         QVERIFY(aspectPriv->jobsDoneCalled());
         QVERIFY(!aspectPriv->frameDoneCalled());
 
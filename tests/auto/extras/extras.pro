@@ -6,7 +6,10 @@ contains(QT_CONFIG, private_tests) {
         qtorusgeometry \
         qforwardrenderer \
         qfirstpersoncameracontroller \
-        qorbitcameracontroller
+        qorbitcameracontroller \
+        qtext2dbatch \
+        qdistancefieldglyphcache \
+        qextrudedtextgeometry
 }
 
 qtHaveModule(quick) {
@@ -2,7 +2,7 @@ TEMPLATE = app
 
 TARGET = tst_qcuboidgeometry
 
-QT += 3dextras testlib
+QT += 3dcore-private 3dextras testlib
 
 CONFIG += testcase
 
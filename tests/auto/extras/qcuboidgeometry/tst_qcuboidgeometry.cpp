@@ -6,11 +6,15 @@
 #include <Qt3DExtras/qcuboidgeometry.h>
 #include <Qt3DCore/qattribute.h>
 #include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qscene_p.h>
 #include <QtGui/qopenglcontext.h>
 #include <QtGui/qvector2d.h>
 #include <QtGui/qvector3d.h>
 #include <QtGui/qvector4d.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qscopedpointer.h>
 #include <QtCore/qsharedpointer.h>
 #include <QSignalSpy>
 
@@ -555,6 +559,119 @@ private Q_SLOTS:
             ++i;
         }
     }
+
+    void checkIdenticalGeometriesShareBuffers()
+    {
+        // GIVEN
+        QScopedPointer<Qt3DExtras::QCuboidGeometry> geometry1(new Qt3DExtras::QCuboidGeometry());
+        Qt3DExtras::QCuboidGeometry geometry2;
+        geometry1->setXExtent(2.0f);
+        geometry2.setXExtent(2.0f);
+
+        // THEN
+        QVERIFY(geometry1->positionAttribute()->buffer() != nullptr);
+        QCOMPARE(geometry1->positionAttribute()->buffer(), geometry2.positionAttribute()->buffer());
+        QCOMPARE(geometry1->indexAttribute()->buffer(), geometry2.indexAttribute()->buffer());
+
+        // WHEN
+        geometry2.setXExtent(3.0f);
+
+        // THEN -> only the vertices depend on the extents
+        QVERIFY(geometry1->positionAttribute()->buffer() != geometry2.positionAttribute()->buffer());
+        QCOMPARE(geometry1->indexAttribute()->buffer(), geometry2.indexAttribute()->buffer());
+
+        // WHEN
+        geometry2.setXExtent(2.0f);
+        Qt3DCore::QBuffer *vertexBuffer = geometry2.positionAttribute()->buffer();
+        const QByteArray vertexData = vertexBuffer->data();
+        geometry1.reset();
+
+        // THEN -> the remaining geometry keeps the buffers alive
+        QCOMPARE(geometry2.positionAttribute()->buffer(), vertexBuffer);
+        QCOMPARE(vertexBuffer->data(), vertexData);
+        QVERIFY(geometry2.indexAttribute()->buffer()->data().size() != 0);
+    }
+
+    void checkBuffersAreSharedPerScene()
+    {
+        // GIVEN
+        Qt3DCore::QScene scene1;
+        Qt3DCore::QScene scene2;
+        Qt3DCore::QEntity root1;
+        Qt3DCore::QEntity root2;
+        Qt3DCore::QNodePrivate::get(&root1)->setScene(&scene1);
+        Qt3DCore::QNodePrivate::get(&root2)->setScene(&scene2);
+
+        // WHEN
+        auto geometry1 = new Qt3DExtras::QCuboidGeometry(&root1);
+        auto geometry2 = new Qt3DExtras::QCuboidGeometry(&root1);
+        auto geometry3 = new Qt3DExtras::QCuboidGeometry(&root2);
+
+        // THEN
+        Qt3DCore::QBuffer *buffer1 = geometry1->positionAttribute()->buffer();
+        Qt3DCore::QBuffer *buffer2 = geometry3->positionAttribute()->buffer();
+        QCOMPARE(geometry2->positionAttribute()->buffer(), buffer1);
+        QVERIFY(buffer2 != buffer1);
+        QCOMPARE(buffer1->parent(), geometry1);
+        QCOMPARE(buffer2->parent(), geometry3);
+        QCOMPARE(Qt3DCore::QNodePrivate::get(buffer2)->scene(), &scene2);
+        QCOMPARE(buffer2->data(), buffer1->data());
+        QVERIFY(geometry3->indexAttribute()->buffer() != geometry1->indexAttribute()->buffer());
+
+        // WHEN
+        auto geometry4 = new Qt3DExtras::QCuboidGeometry();
+
+        // THEN -> not shared with geometries of a scene
+        QVERIFY(geometry4->positionAttribute()->buffer() != buffer1);
+        QVERIFY(geometry4->positionAttribute()->buffer() != buffer2);
+
+        // WHEN
+        geometry4->setParent(&root2);
+
+        // THEN
+        QCOMPARE(geometry4->positionAttribute()->buffer(), buffer2);
+        QCOMPARE(geometry4->indexAttribute()->buffer(), geometry3->indexAttribute()->buffer());
+        QCOMPARE(geometry4->findChildren<Qt3DCore::QBuffer *>().size(), 0);
+    }
+
+    void checkDetachedOwnerHandsBufferOver()
+    {
+        // GIVEN
+        Qt3DCore::QScene scene;
+        Qt3DCore::QEntity root;
+        Qt3DCore::QNodePrivate::get(&root)->setScene(&scene);
+        QScopedPointer<Qt3DExtras::QCuboidGeometry> geometry1(new Qt3DExtras::QCuboidGeometry(&root));
+        auto geometry2 = new Qt3DExtras::QCuboidGeometry(&root);
+        Qt3DCore::QBuffer *buffer = geometry1->positionAttribute()->buffer();
+        const QByteArray data = buffer->data();
+        QCOMPARE(buffer->parent(), geometry1.data());
+        QCOMPARE(geometry2->positionAttribute()->buffer(), buffer);
+
+        // WHEN -> removed from the scene
+        Qt3DCore::QNodePrivate::get(geometry1.data())->m_hasBackendNode = true;
+        geometry1->setParent(static_cast<Qt3DCore::QNode *>(nullptr));
+
+        // THEN -> the buffer stays in the scene with the remaining geometry
+        QVERIFY(Qt3DCore::QNodePrivate::get(geometry1.data())->scene() == nullptr);
+        QCOMPARE(geometry2->positionAttribute()->buffer(), buffer);
+        QCOMPARE(buffer->parent(), geometry2);
+        QCOMPARE(Qt3DCore::QNodePrivate::get(buffer)->scene(), &scene);
+        QCOMPARE(buffer->data(), data);
+
+        // THEN -> the detached geometry got its own copy
+        Qt3DCore::QBuffer *detachedBuffer = geometry1->positionAttribute()->buffer();
+        QVERIFY(detachedBuffer != buffer);
+        QCOMPARE(detachedBuffer->parent(), geometry1.data());
+        QCOMPARE(detachedBuffer->data(), data);
+        QVERIFY(geometry1->indexAttribute()->buffer() != geometry2->indexAttribute()->buffer());
+
+        // WHEN
+        geometry1.reset();
+
+        // THEN
+        QCOMPARE(geometry2->positionAttribute()->buffer(), buffer);
+        QCOMPARE(buffer->parent(), geometry2);
+    }
 };
 
 
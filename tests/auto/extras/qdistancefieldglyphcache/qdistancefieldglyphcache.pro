@@ -0,0 +1,10 @@
+TEMPLATE = app
+
+TARGET = tst_qdistancefieldglyphcache
+
+QT += 3dcore 3dcore-private 3dextras 3dextras-private 3drender 3drender-private gui-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_qdistancefieldglyphcache.cpp
@@ -0,0 +1,222 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qfont.h>
+#include <QtGui/qrawfont.h>
+#include <QtGui/private/qrawfont_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DRender/qtexturedata.h>
+#include <Qt3DRender/qtextureimagedata.h>
+#include <Qt3DExtras/private/qdistancefieldglyphcache_p.h>
+#include <Qt3DExtras/private/qtextureatlas_p.h>
+#include <Qt3DExtras/private/qtextureatlas_p_p.h>
+
+using namespace Qt3DExtras;
+
+namespace {
+
+QTextureAtlasPrivate *atlasPrivate(Qt3DRender::QAbstractTexture *texture)
+{
+    return static_cast<QTextureAtlasPrivate *>(Qt3DCore::QNodePrivate::get(texture));
+}
+
+// Content of the atlas, as it would be uploaded
+QByteArray atlasContent(Qt3DRender::QAbstractTexture *texture)
+{
+    const QTextureAtlasGeneratorPtr generator =
+            qSharedPointerCast<QTextureAtlasGenerator>(atlasPrivate(texture)->dataFunctor());
+    const Qt3DRender::QTextureDataPtr data = (*generator)();
+    return data->imageData().first()->data();
+}
+
+QString fontFileName(const QRawFont &font)
+{
+    return QFile::decodeName(QRawFontPrivate::get(font)->fontEngine->faceId().filename);
+}
+
+} // anonymous
+
+class tst_QDistanceFieldGlyphCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY(m_cacheDir.isValid());
+        qputenv("QT3D_WRITABLE_CACHE_PATH", QFile::encodeName(m_cacheDir.path()));
+        m_font = QRawFont::fromFont(QFont());
+        if (!m_font.isValid())
+            QSKIP("No font available");
+        m_glyphs = m_font.glyphIndexesForString(QStringLiteral("ABCDEF"));
+    }
+
+    void cleanupTestCase()
+    {
+        qunsetenv("QT3D_WRITABLE_CACHE_PATH");
+        qunsetenv("QT3D_DISABLE_DISTANCEFIELD_CACHE");
+    }
+
+    void checkDistanceFieldsAreGeneratedAsynchronously()
+    {
+        // GIVEN
+        qputenv("QT3D_DISABLE_DISTANCEFIELD_CACHE", "1");
+        QDistanceFieldGlyphCache cache;
+
+        // WHEN
+        Qt3DRender::QAbstractTexture *texture = nullptr;
+        for (quint32 glyph : qAsConst(m_glyphs)) {
+            const QDistanceFieldGlyphCache::Glyph g = cache.refGlyph(m_font, glyph);
+            // THEN -> glyphs can be laid out right away
+            QVERIFY(g.texture != nullptr);
+            QVERIFY(!g.texCoords.isEmpty());
+            QVERIFY(texture == nullptr || texture == g.texture);
+            texture = g.texture;
+        }
+        const int generation = atlasPrivate(texture)->m_currGen;
+
+        // THEN -> but are blank until their distance field is ready
+        QVERIFY(atlasContent(texture).count(char(0)) == atlasContent(texture).size());
+
+        // WHEN
+        cache.waitForPendingGlyphs();
+
+        // THEN -> all the distance fields are uploaded at once
+        QCOMPARE(atlasPrivate(texture)->m_currGen, generation + 1);
+        const QByteArray content = atlasContent(texture);
+        QVERIFY(content.count(char(0)) < content.size());
+
+        for (quint32 glyph : qAsConst(m_glyphs))
+            cache.derefGlyph(m_font, glyph);
+        qunsetenv("QT3D_DISABLE_DISTANCEFIELD_CACHE");
+    }
+
+    void checkReleasedGlyphsAreDropped()
+    {
+        // GIVEN
+        qputenv("QT3D_DISABLE_DISTANCEFIELD_CACHE", "1");
+        QDistanceFieldGlyphCache cache;
+        const QDistanceFieldGlyphCache::Glyph kept = cache.refGlyph(m_font, m_glyphs.first());
+        cache.refGlyph(m_font, m_glyphs.last());
+        const int generation = atlasPrivate(kept.texture)->m_currGen;
+
+        // WHEN
+        cache.derefGlyph(m_font, m_glyphs.last());
+        cache.waitForPendingGlyphs();
+
+        // THEN -> only the kept glyph is stored
+        QCOMPARE(atlasPrivate(kept.texture)->m_currGen, generation + 1);
+
+        // WHEN
+        cache.waitForPendingGlyphs();
+
+        // THEN -> nothing left to upload
+        QCOMPARE(atlasPrivate(kept.texture)->m_currGen, generation + 1);
+
+        cache.derefGlyph(m_font, m_glyphs.first());
+        qunsetenv("QT3D_DISABLE_DISTANCEFIELD_CACHE");
+    }
+
+    void checkDiskCacheKey()
+    {
+        const QString fileName = fontFileName(m_font);
+        if (fileName.isEmpty() || !QFile::exists(fileName))
+            QSKIP("Font isn't loaded from a file");
+
+        // GIVEN
+        const QString copyName = m_cacheDir.filePath(QStringLiteral("font_copy"));
+        QVERIFY(QFile::copy(fileName, copyName));
+        QFile copy(copyName);
+        QVERIFY(copy.open(QIODevice::ReadWrite));
+        QVERIFY(copy.setFileTime(QDateTime::fromSecsSinceEpoch(1000000), QFileDevice::FileModificationTime));
+        copy.close();
+        QRawFont copiedFont(copyName, 12);
+        QVERIFY(copiedFont.isValid());
+
+        // THEN
+        const QString directory = QDistanceFieldGlyphCache::diskCacheDirectory(copiedFont, false);
+        QVERIFY(!directory.isEmpty());
+        QVERIFY(directory.startsWith(m_cacheDir.path()));
+        QCOMPARE(QDistanceFieldGlyphCache::diskCacheDirectory(copiedFont, false), directory);
+        QVERIFY(QDistanceFieldGlyphCache::diskCacheDirectory(copiedFont, true) != directory);
+        QVERIFY(QDistanceFieldGlyphCache::diskCacheDirectory(m_font, false) != directory);
+
+        // WHEN -> the font file is updated
+        QVERIFY(copy.open(QIODevice::ReadWrite));
+        QVERIFY(copy.setFileTime(QDateTime::fromSecsSinceEpoch(2000000), QFileDevice::FileModificationTime));
+        copy.close();
+
+        // THEN -> previous distance fields aren't used
+        QVERIFY(QDistanceFieldGlyphCache::diskCacheDirectory(copiedFont, false) != directory);
+
+        // WHEN
+        qputenv("QT3D_DISABLE_DISTANCEFIELD_CACHE", "1");
+
+        // THEN
+        QVERIFY(QDistanceFieldGlyphCache::diskCacheDirectory(copiedFont, false).isEmpty());
+        qunsetenv("QT3D_DISABLE_DISTANCEFIELD_CACHE");
+    }
+
+    void checkDiskCache()
+    {
+        // GIVEN
+        const QString fileName = fontFileName(m_font);
+        if (fileName.isEmpty() || !QFile::exists(fileName))
+            QSKIP("Font isn't loaded from a file");
+        const quint32 glyph = m_glyphs.first();
+        QString glyphFile;
+        qint32 width = 0;
+        qint32 height = 0;
+
+        {
+            QDistanceFieldGlyphCache cache;
+            const bool doubleResolution = cache.doubleGlyphResolution(m_font);
+            glyphFile = QDistanceFieldGlyphCache::diskCacheDirectory(m_font, doubleResolution)
+                    + QLatin1Char('/') + QString::number(glyph);
+            QFile::remove(glyphFile);
+
+            // WHEN
+            cache.refGlyph(m_font, glyph);
+            cache.waitForPendingGlyphs();
+            cache.derefGlyph(m_font, glyph);
+        }
+
+        // THEN -> the distance field was stored
+        QFile file(glyphFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        {
+            QDataStream stream(&file);
+            quint32 magic = 0;
+            quint32 version = 0;
+            stream >> magic >> version >> width >> height;
+            QVERIFY(width > 0 && height > 0);
+
+            // WHEN -> replaced by a recognizable distance field
+            stream.writeRawData(QByteArray(width * height, char(0x7f)).constData(), width * height);
+        }
+        file.close();
+
+        // THEN -> it is loaded back instead of being generated
+        QDistanceFieldGlyphCache cache;
+        const QDistanceFieldGlyphCache::Glyph g = cache.refGlyph(m_font, glyph);
+        cache.waitForPendingGlyphs();
+        const QByteArray content = atlasContent(g.texture);
+        QVERIFY(content.count(char(0x7f)) >= width * height);
+
+        cache.derefGlyph(m_font, glyph);
+    }
+
+private:
+    QTemporaryDir m_cacheDir;
+    QRawFont m_font;
+    QList<quint32> m_glyphs;
+};
+
+QTEST_MAIN(tst_QDistanceFieldGlyphCache)
+
+#include "tst_qdistancefieldglyphcache.moc"
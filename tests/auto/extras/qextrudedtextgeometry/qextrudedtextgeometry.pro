@@ -0,0 +1,10 @@
+TEMPLATE = app
+
+TARGET = tst_qextrudedtextgeometry
+
+QT += 3dcore 3dextras gui testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_qextrudedtextgeometry.cpp
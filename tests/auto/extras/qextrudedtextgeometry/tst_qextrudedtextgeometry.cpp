@@ -0,0 +1,138 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qthreadpool.h>
+#include <QtGui/qfont.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DExtras/qextrudedtextgeometry.h>
+
+namespace {
+
+// Glyphs are cached per font, each test uses its own font size so that its
+// glyphs aren't cached by a previous test
+QFont testFont(qreal pointSize)
+{
+    QFont font;
+    font.setPointSizeF(pointSize);
+    return font;
+}
+
+// Waits for the triangulation jobs and for the geometry to be updated
+void waitForGlyphs()
+{
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::sendPostedEvents();
+}
+
+QByteArray vertexData(const Qt3DExtras::QExtrudedTextGeometry &geometry)
+{
+    return geometry.positionAttribute()->buffer()->data();
+}
+
+QByteArray indexData(const Qt3DExtras::QExtrudedTextGeometry &geometry)
+{
+    return geometry.indexAttribute()->buffer()->data();
+}
+
+} // anonymous
+
+class tst_QExtrudedTextGeometry : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void checkGlyphsAreTriangulatedAsynchronously()
+    {
+        // GIVEN
+        Qt3DExtras::QExtrudedTextGeometry geometry;
+        geometry.setFont(testFont(21.5));
+
+        // WHEN
+        geometry.setText(QStringLiteral("Qt3D"));
+
+        // THEN -> content only updated once the glyphs are ready
+        QCOMPARE(geometry.positionAttribute()->count(), 0U);
+
+        // WHEN
+        waitForGlyphs();
+
+        // THEN
+        QVERIFY(geometry.positionAttribute()->count() > 0);
+        QVERIFY(geometry.indexAttribute()->count() > 0);
+        QCOMPARE(geometry.positionAttribute()->count(), geometry.normalAttribute()->count());
+    }
+
+    void checkCachedGlyphsAreReused()
+    {
+        // GIVEN
+        Qt3DExtras::QExtrudedTextGeometry geometry1;
+        geometry1.setFont(testFont(22.5));
+        geometry1.setText(QStringLiteral("Qt3D"));
+        waitForGlyphs();
+        QVERIFY(geometry1.positionAttribute()->count() > 0);
+
+        // WHEN
+        Qt3DExtras::QExtrudedTextGeometry geometry2;
+        geometry2.setFont(testFont(22.5));
+        geometry2.setText(QStringLiteral("3DQt"));
+
+        // THEN -> updated right away, without triangulating again
+        QCOMPARE(QThreadPool::globalInstance()->activeThreadCount(), 0);
+        QCOMPARE(geometry2.positionAttribute()->count(), geometry1.positionAttribute()->count());
+        QCOMPARE(geometry2.indexAttribute()->count(), geometry1.indexAttribute()->count());
+
+        // WHEN
+        geometry2.setText(QStringLiteral("Qt3D"));
+
+        // THEN
+        QCOMPARE(vertexData(geometry2), vertexData(geometry1));
+        QCOMPARE(indexData(geometry2), indexData(geometry1));
+    }
+
+    void checkTextChangedWhileTriangulating()
+    {
+        // GIVEN
+        Qt3DExtras::QExtrudedTextGeometry reference;
+        reference.setFont(testFont(23.5));
+        reference.setText(QStringLiteral("AB"));
+        waitForGlyphs();
+        QVERIFY(reference.positionAttribute()->count() > 0);
+
+        Qt3DExtras::QExtrudedTextGeometry geometry;
+        geometry.setFont(testFont(23.5));
+
+        // WHEN -> glyphs to triangulate
+        geometry.setText(QStringLiteral("XYZW"));
+        // WHEN -> changed to cached glyphs before these jobs are done
+        geometry.setText(QStringLiteral("AB"));
+
+        // THEN
+        QCOMPARE(vertexData(geometry), vertexData(reference));
+        QCOMPARE(indexData(geometry), indexData(reference));
+
+        // WHEN
+        waitForGlyphs();
+
+        // THEN -> results of the previous text are dropped
+        QCOMPARE(vertexData(geometry), vertexData(reference));
+        QCOMPARE(indexData(geometry), indexData(reference));
+
+        // WHEN -> changed to other glyphs to triangulate
+        geometry.setText(QStringLiteral("XYZW"));
+        geometry.setText(QStringLiteral("CD"));
+        waitForGlyphs();
+
+        // THEN -> only the last text is shown
+        Qt3DExtras::QExtrudedTextGeometry last;
+        last.setFont(testFont(23.5));
+        last.setText(QStringLiteral("CD"));
+        QCOMPARE(vertexData(geometry), vertexData(last));
+        QCOMPARE(indexData(geometry), indexData(last));
+    }
+};
+
+QTEST_MAIN(tst_QExtrudedTextGeometry)
+
+#include "tst_qextrudedtextgeometry.moc"
@@ -0,0 +1,10 @@
+TEMPLATE = app
+
+TARGET = tst_qtext2dbatch
+
+QT += 3dcore 3dcore-private 3dextras 3dextras-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_qtext2dbatch.cpp
@@ -0,0 +1,295 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <QSignalSpy>
+#include <Qt3DExtras/qtext2dbatch.h>
+#include <Qt3DExtras/qtext2dentity.h>
+#include <Qt3DExtras/private/qtext2dbatch_p.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qscene_p.h>
+
+namespace {
+
+using Bucket = Qt3DExtras::QText2DBatchPrivate::Bucket;
+using Slot = Qt3DExtras::QText2DBatchPrivate::Slot;
+
+// Quads of the label in its bucket, in the batch coordinate system
+std::vector<float> labelQuads(const Bucket *bucket, Qt3DExtras::QText2DEntity *label)
+{
+    const Slot slot = bucket->slots.value(label);
+    const auto first = bucket->vertices.begin()
+            + size_t(slot.first) * Qt3DExtras::QText2DBatchPrivate::FloatsPerQuad;
+    return std::vector<float>(first, first + size_t(slot.count) * Qt3DExtras::QText2DBatchPrivate::FloatsPerQuad);
+}
+
+// Positions are the first 3 of the 5 floats of each vertex
+std::vector<float> translated(std::vector<float> vertices, const QVector3D &offset)
+{
+    for (size_t i = 0, m = vertices.size(); i < m; i += 5) {
+        vertices[i] += offset.x();
+        vertices[i + 1] += offset.y();
+        vertices[i + 2] += offset.z();
+    }
+    return vertices;
+}
+
+Qt3DExtras::QText2DBatchPrivate *batchPrivate(Qt3DExtras::QText2DBatch *batch)
+{
+    return static_cast<Qt3DExtras::QText2DBatchPrivate *>(Qt3DCore::QNodePrivate::get(batch));
+}
+
+bool fuzzyCompare(const std::vector<float> &a, const std::vector<float> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0, m = a.size(); i < m; ++i) {
+        if (!qFuzzyCompare(1.0f + a[i], 1.0f + b[i]))
+            return false;
+    }
+    return true;
+}
+
+} // anonymous
+
+class tst_QText2DBatch : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void checkDefaultConstruction()
+    {
+        // GIVEN
+        Qt3DExtras::QText2DBatch batch;
+        Qt3DExtras::QText2DEntity label;
+
+        // THEN
+        QCOMPARE(batch.labelCount(), 0);
+        QVERIFY(label.batch() == nullptr);
+    }
+
+    void checkAddingAndRemovingLabels()
+    {
+        // GIVEN
+        Qt3DExtras::QText2DBatch batch;
+        Qt3DExtras::QText2DEntity label1;
+        Qt3DExtras::QText2DEntity label2;
+        QSignalSpy labelCountSpy(&batch, &Qt3DExtras::QText2DBatch::labelCountChanged);
+        QSignalSpy batchSpy(&label1, &Qt3DExtras::QText2DEntity::batchChanged);
+
+        // WHEN
+        label1.setBatch(&batch);
+        label2.setBatch(&batch);
+
+        // THEN
+        QCOMPARE(label1.batch(), &batch);
+        QCOMPARE(batch.labelCount(), 2);
+        QCOMPARE(labelCountSpy.count(), 2);
+        QCOMPARE(batchSpy.count(), 1);
+
+        // WHEN
+        labelCountSpy.clear();
+        batchSpy.clear();
+        label1.setBatch(&batch);
+
+        // THEN
+        QCOMPARE(batch.labelCount(), 2);
+        QCOMPARE(labelCountSpy.count(), 0);
+        QCOMPARE(batchSpy.count(), 0);
+
+        // WHEN
+        label1.setBatch(nullptr);
+
+        // THEN
+        QVERIFY(label1.batch() == nullptr);
+        QCOMPARE(batch.labelCount(), 1);
+        QCOMPARE(labelCountSpy.count(), 1);
+        QCOMPARE(batchSpy.count(), 1);
+    }
+
+    void checkLabelDestruction()
+    {
+        // GIVEN
+        Qt3DExtras::QText2DBatch batch;
+        auto *label = new Qt3DExtras::QText2DEntity();
+        label->setText(QStringLiteral("Label"));
+        label->setWidth(20.0f);
+        label->setHeight(10.0f);
+        label->setBatch(&batch);
+        QCOMPARE(batch.labelCount(), 1);
+
+        // WHEN
+        delete label;
+
+        // THEN
+        QCOMPARE(batch.labelCount(), 0);
+    }
+
+    void checkBatchDestruction()
+    {
+        // GIVEN
+        Qt3DExtras::QText2DEntity label;
+        auto *batch = new Qt3DExtras::QText2DBatch();
+        label.setBatch(batch);
+        QSignalSpy batchSpy(&label, &Qt3DExtras::QText2DEntity::batchChanged);
+
+        // WHEN
+        delete batch;
+
+        // THEN
+        QVERIFY(label.batch() == nullptr);
+        QCOMPARE(batchSpy.count(), 1);
+    }
+
+    void checkMergedQuads()
+    {
+        // GIVEN
+        Qt3DCore::QScene scene;
+        Qt3DExtras::QText2DBatch batch;
+        Qt3DExtras::QText2DEntity label1;
+        Qt3DExtras::QText2DEntity label2;
+        Qt3DExtras::QText2DBatchPrivate *batchD = batchPrivate(&batch);
+
+        // Labels use the glyph cache of their scene
+        for (Qt3DExtras::QText2DEntity *label : { &label1, &label2 }) {
+            label->setText(QStringLiteral("IIII"));
+            label->setWidth(200.0f);
+            label->setHeight(50.0f);
+            Qt3DCore::QNodePrivate::get(label)->setScene(&scene);
+        }
+
+        // WHEN
+        label1.setBatch(&batch);
+        label2.setBatch(&batch);
+
+        // THEN -> both labels share the same atlas and color
+        QCOMPARE(batchD->m_buckets.size(), size_t(1));
+        const Bucket *bucket = batchD->m_buckets.front().get();
+        QVERIFY(bucket->texture != nullptr);
+        QCOMPARE(bucket->slots.size(), 2);
+
+        const Slot slot1 = bucket->slots.value(&label1);
+        const Slot slot2 = bucket->slots.value(&label2);
+        QCOMPARE(slot1.count, 4U);
+        QCOMPARE(slot2.count, 4U);
+        QVERIFY(slot1.first + slot1.capacity <= slot2.first || slot2.first + slot2.capacity <= slot1.first);
+        QCOMPARE(bucket->usedQuads, slot1.capacity + slot2.capacity);
+
+        // Without transforms, the labels are laid out the same way
+        const std::vector<float> quads = labelQuads(bucket, &label1);
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), quads));
+
+        // WHEN
+        Qt3DCore::QTransform transform;
+        transform.setTranslation(QVector3D(10.0f, 20.0f, 0.0f));
+        label2.addComponent(&transform);
+
+        // THEN -> the added transform is applied with the next change of the label
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), quads));
+
+        // WHEN
+        label2.setColor(Qt::red);
+        label2.setColor(label1.color());
+
+        // THEN
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), translated(quads, QVector3D(10.0f, 20.0f, 0.0f))));
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label1), quads));
+
+        // WHEN
+        transform.setTranslation(QVector3D(0.0f, 0.0f, 5.0f));
+
+        // THEN
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), translated(quads, QVector3D(0.0f, 0.0f, 5.0f))));
+
+        // WHEN
+        label2.removeComponent(&transform);
+
+        // THEN -> back to the label coordinates
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), quads));
+
+        // WHEN
+        transform.setTranslation(QVector3D(1.0f, 1.0f, 1.0f));
+
+        // THEN -> the removed transform is no longer followed
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label2), quads));
+
+        // WHEN
+        const uint label2First = bucket->slots.value(&label2).first;
+        label2.setText(QStringLiteral("II"));
+
+        // THEN -> the label shrinks in place
+        QCOMPARE(bucket->slots.value(&label2).count, 2U);
+        QCOMPARE(bucket->slots.value(&label2).first, label2First);
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label1), quads));
+
+        // Release the glyph cache of the scene
+        label1.setBatch(nullptr);
+        label2.setBatch(nullptr);
+        Qt3DCore::QNodePrivate::get(&label1)->setScene(nullptr);
+        Qt3DCore::QNodePrivate::get(&label2)->setScene(nullptr);
+    }
+
+    void checkGrowingSingleLabel()
+    {
+        // GIVEN
+        Qt3DCore::QScene scene;
+        Qt3DExtras::QText2DBatch batch;
+        Qt3DExtras::QText2DEntity label;
+        label.setText(QStringLiteral("II"));
+        label.setWidth(200.0f);
+        label.setHeight(50.0f);
+        Qt3DCore::QNodePrivate::get(&label)->setScene(&scene);
+        label.setBatch(&batch);
+
+        const Bucket *bucket = batchPrivate(&batch)->m_buckets.front().get();
+        QCOMPARE(bucket->usedQuads, 2U);
+
+        // WHEN
+        label.setText(QStringLiteral("IIIIIIII"));
+
+        // THEN -> the emptied bucket doesn't keep the outgrown slot around
+        QCOMPARE(batchPrivate(&batch)->m_buckets.size(), size_t(1));
+        QCOMPARE(bucket->slots.value(&label).first, 0U);
+        QCOMPARE(bucket->slots.value(&label).count, 8U);
+        QCOMPARE(bucket->usedQuads, 8U);
+        QCOMPARE(bucket->freeQuads, 0U);
+
+        label.setBatch(nullptr);
+        Qt3DCore::QNodePrivate::get(&label)->setScene(nullptr);
+    }
+
+    void checkDestroyedTransform()
+    {
+        // GIVEN
+        Qt3DCore::QScene scene;
+        Qt3DExtras::QText2DBatch batch;
+        Qt3DExtras::QText2DEntity label;
+        label.setText(QStringLiteral("II"));
+        label.setWidth(200.0f);
+        label.setHeight(50.0f);
+        Qt3DCore::QNodePrivate::get(&label)->setScene(&scene);
+        auto *transform = new Qt3DCore::QTransform();
+        transform->setTranslation(QVector3D(0.0f, 3.0f, 0.0f));
+        label.addComponent(transform);
+        label.setBatch(&batch);
+
+        const Bucket *bucket = batchPrivate(&batch)->m_buckets.front().get();
+        transform->setTranslation(QVector3D());
+        const std::vector<float> quads = labelQuads(bucket, &label);
+        transform->setTranslation(QVector3D(0.0f, 3.0f, 0.0f));
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label), translated(quads, QVector3D(0.0f, 3.0f, 0.0f))));
+
+        // WHEN
+        delete transform;
+
+        // THEN
+        QVERIFY(fuzzyCompare(labelQuads(bucket, &label), quads));
+
+        label.setBatch(nullptr);
+        Qt3DCore::QNodePrivate::get(&label)->setScene(nullptr);
+    }
+};
+
+QTEST_MAIN(tst_QText2DBatch)
+
+#include "tst_qtext2dbatch.moc"
@@ -5,6 +5,7 @@
 #include <qbackendnodetester.h>
 #include <Qt3DRender/private/attribute_p.h>
 #include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/private/qattribute_p.h>
 #include "testrenderer.h"
 
 class tst_Attribute : public Qt3DCore::QBackendNodeTester
@@ -250,6 +251,64 @@ private Q_SLOTS:
         renderer.resetDirty();
         QVERIFY(!renderAttribute.isDirty());
     }
+    void checkBoundsAreClearedWhenDataChanges()
+    {
+        // GIVEN
+        Qt3DCore::QAttribute attribute;
+        Qt3DCore::QBuffer *buffer = new Qt3DCore::QBuffer(&attribute);
+        buffer->setData(QByteArray(12 * sizeof(float), 0));
+        attribute.setBuffer(buffer);
+        attribute.setVertexSize(3);
+        attribute.setCount(4);
+        Qt3DCore::QAttributePrivate *dAttribute = Qt3DCore::QAttributePrivate::get(&attribute);
+        const QVector3D minBound(-1.0f, -2.0f, -3.0f);
+        const QVector3D maxBound(1.0f, 2.0f, 3.0f);
+        dAttribute->setBounds(minBound, maxBound);
+
+        TestRenderer renderer;
+        Qt3DRender::Render::Attribute renderAttribute;
+        renderAttribute.setRenderer(&renderer);
+        simulateInitializationSync(&attribute, &renderAttribute);
+
+        // THEN
+        QVERIFY(renderAttribute.hasBounds());
+        QCOMPARE(renderAttribute.minBound(), minBound);
+        QCOMPARE(renderAttribute.maxBound(), maxBound);
+
+        // WHEN -> data of the buffer changes
+        buffer->updateData(0, QByteArray(sizeof(float), 1));
+        renderAttribute.syncFromFrontEnd(&attribute, false);
+
+        // THEN
+        QVERIFY(!dAttribute->m_hasBounds);
+        QVERIFY(!renderAttribute.hasBounds());
+        QVERIFY(renderAttribute.isDirty());
+
+        // WHEN -> the buffer is swapped
+        dAttribute->setBounds(minBound, maxBound);
+        renderAttribute.syncFromFrontEnd(&attribute, false);
+        QVERIFY(renderAttribute.hasBounds());
+        Qt3DCore::QBuffer *otherBuffer = new Qt3DCore::QBuffer(&attribute);
+        attribute.setBuffer(otherBuffer);
+        renderAttribute.syncFromFrontEnd(&attribute, false);
+
+        // THEN
+        QVERIFY(!renderAttribute.hasBounds());
+
+        // WHEN -> the previous buffer no longer affects the attribute
+        dAttribute->setBounds(minBound, maxBound);
+        buffer->setData(QByteArray(12 * sizeof(float), 2));
+
+        // THEN
+        QVERIFY(dAttribute->m_hasBounds);
+
+        // WHEN -> the layout changes
+        attribute.setByteOffset(4);
+        renderAttribute.syncFromFrontEnd(&attribute, false);
+
+        // THEN
+        QVERIFY(!renderAttribute.hasBounds());
+    }
 };
 
 
@@ -296,6 +296,55 @@ private Q_SLOTS:
         QCOMPARE(renderBuffer.pendingBufferUpdates().back().data, QByteArray("345"));
         QCOMPARE(renderBuffer.data(), QByteArray("012345"));
     }
+
+    void checkDirtyBuffersAreQueued()
+    {
+        // GIVEN
+        Qt3DRender::Render::Buffer renderBuffer;
+        Qt3DCore::QBuffer buffer;
+        Qt3DRender::Render::BufferManager bufferManager;
+        TestRenderer renderer;
+        std::vector<Qt3DRender::Render::Buffer *> queuedBuffers;
+        const auto takeQueuedBuffers = [&] {
+            queuedBuffers.clear();
+            bufferManager.dirtyNodeQueue().consume([&] (Qt3DRender::Render::Buffer *b) {
+                queuedBuffers.push_back(b);
+            });
+        };
+
+        buffer.setData(QByteArrayLiteral("000000"));
+        renderBuffer.setRenderer(&renderer);
+        renderBuffer.setManager(&bufferManager);
+
+        // THEN
+        QVERIFY(bufferManager.dirtyNodeQueue().isEmpty());
+
+        // WHEN
+        simulateInitializationSync(&buffer, &renderBuffer);
+        takeQueuedBuffers();
+
+        // THEN
+        QCOMPARE(queuedBuffers, std::vector<Qt3DRender::Render::Buffer *>({ &renderBuffer }));
+        QVERIFY(bufferManager.dirtyNodeQueue().isEmpty());
+
+        // WHEN
+        renderBuffer.unsetDirty();
+        renderBuffer.syncFromFrontEnd(&buffer, false);
+        takeQueuedBuffers();
+
+        // THEN -> nothing changed
+        QVERIFY(queuedBuffers.empty());
+
+        // WHEN
+        buffer.updateData(0, QByteArray("012"));
+        renderBuffer.syncFromFrontEnd(&buffer, false);
+        buffer.setUsage(Qt3DCore::QBuffer::DynamicCopy);
+        renderBuffer.syncFromFrontEnd(&buffer, false);
+        takeQueuedBuffers();
+
+        // THEN -> only queued once
+        QCOMPARE(queuedBuffers, std::vector<Qt3DRender::Render::Buffer *>({ &renderBuffer }));
+    }
 };
 
 
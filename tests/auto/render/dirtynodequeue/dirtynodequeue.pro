@@ -0,0 +1,11 @@
+TEMPLATE = app
+
+TARGET = tst_dirtynodequeue
+
+QT += core-private 3dcore 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_dirtynodequeue.cpp
+
+include(../commons/commons.pri)
@@ -0,0 +1,134 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <QThread>
+#include <Qt3DRender/private/dirtynodequeue_p.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+struct TestNode
+{
+    int value = 0;
+    DirtyNodeQueueLink<TestNode> link;
+
+    DirtyNodeQueueLink<TestNode> &dirtyNodeQueueLink() noexcept { return link; }
+};
+
+std::vector<TestNode *> takeQueuedNodes(DirtyNodeQueue<TestNode> &queue)
+{
+    std::vector<TestNode *> nodes;
+    queue.consume([&nodes] (TestNode *node) { nodes.push_back(node); });
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+} // anonymous
+
+class tst_DirtyNodeQueue : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        DirtyNodeQueue<TestNode> queue;
+
+        // THEN
+        QVERIFY(queue.isEmpty());
+        QVERIFY(takeQueuedNodes(queue).empty());
+    }
+
+    void checkNodesAreQueuedOnce()
+    {
+        // GIVEN
+        DirtyNodeQueue<TestNode> queue;
+        TestNode nodes[3];
+
+        // WHEN
+        const bool pushed0 = queue.push(&nodes[0]);
+        const bool pushed2 = queue.push(&nodes[2]);
+        const bool pushedAgain = queue.push(&nodes[0]);
+
+        // THEN
+        QVERIFY(pushed0);
+        QVERIFY(pushed2);
+        QVERIFY(!pushedAgain);
+        QVERIFY(!queue.isEmpty());
+
+        // WHEN
+        const std::vector<TestNode *> queued = takeQueuedNodes(queue);
+
+        // THEN
+        std::vector<TestNode *> expected = { &nodes[0], &nodes[2] };
+        std::sort(expected.begin(), expected.end());
+        QCOMPARE(queued, expected);
+        QVERIFY(queue.isEmpty());
+
+        // WHEN -> can be queued again once consumed
+        const bool pushedAfterConsume = queue.push(&nodes[2]);
+
+        // THEN
+        QVERIFY(pushedAfterConsume);
+        QCOMPARE(takeQueuedNodes(queue), std::vector<TestNode *>({ &nodes[2] }));
+    }
+
+    void checkNodesPushedWhileConsuming()
+    {
+        // GIVEN
+        DirtyNodeQueue<TestNode> queue;
+        TestNode nodes[2];
+        queue.push(&nodes[0]);
+
+        // WHEN
+        std::vector<TestNode *> consumed;
+        queue.consume([&] (TestNode *node) {
+            consumed.push_back(node);
+            queue.push(&nodes[0]);
+            queue.push(&nodes[1]);
+        });
+
+        // THEN
+        QCOMPARE(consumed, std::vector<TestNode *>({ &nodes[0] }));
+        std::vector<TestNode *> expected = { &nodes[0], &nodes[1] };
+        std::sort(expected.begin(), expected.end());
+        QCOMPARE(takeQueuedNodes(queue), expected);
+    }
+
+    void checkConcurrentPushes()
+    {
+        // GIVEN
+        const int threadCount = 4;
+        const int nodesPerThread = 1000;
+        DirtyNodeQueue<TestNode> queue;
+        std::vector<TestNode> nodes(threadCount * nodesPerThread);
+
+        // WHEN -> each thread pushes all the nodes
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([&queue, &nodes] {
+                for (TestNode &node : nodes)
+                    queue.push(&node);
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+
+        // THEN -> each node was queued once
+        std::vector<TestNode *> expected;
+        for (TestNode &node : nodes)
+            expected.push_back(&node);
+        QCOMPARE(takeQueuedNodes(queue), expected);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_DirtyNodeQueue)
+
+#include "tst_dirtynodequeue.moc"
@@ -0,0 +1,248 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
+
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/geometry_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/material_p.h>
+#include <Qt3DRender/private/dirtyrendercommandtracker_p.h>
+#include <Qt3DRender/private/renderercache_p.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmaterial.h>
+#include "testaspect.h"
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+struct TestCommand
+{
+    int value = 0;
+};
+
+std::vector<Entity *> sortedEntities(NodeManagers *managers, const QList<Qt3DCore::QEntity *> &entities)
+{
+    std::vector<Entity *> backendEntities;
+    for (Qt3DCore::QEntity *e : entities)
+        backendEntities.push_back(managers->renderNodesManager()->lookupResource(e->id()));
+    std::sort(backendEntities.begin(), backendEntities.end());
+    return backendEntities;
+}
+
+} // anonymous
+
+class tst_DirtyRenderCommandTracker : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        DirtyRenderCommandTracker tracker;
+
+        // THEN
+        QVERIFY(tracker.isEmpty());
+        QVERIFY(!tracker.canRebuildPartially());
+    }
+
+    void checkDirtyEntities()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QEntity *entity1 = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *entity2 = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *entity3 = new Qt3DCore::QEntity(rootEntity);
+
+        Qt3DRender::QGeometryRenderer *geometryRenderer1 = new Qt3DRender::QGeometryRenderer(rootEntity);
+        Qt3DRender::QGeometryRenderer *geometryRenderer2 = new Qt3DRender::QGeometryRenderer(rootEntity);
+        Qt3DRender::QGeometryRenderer *geometryRenderer3 = new Qt3DRender::QGeometryRenderer(rootEntity);
+        Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry(geometryRenderer2);
+        geometryRenderer2->setGeometry(geometry);
+        Qt3DRender::QMaterial *material1 = new Qt3DRender::QMaterial(rootEntity);
+        Qt3DRender::QMaterial *material2 = new Qt3DRender::QMaterial(rootEntity);
+
+        entity1->addComponent(geometryRenderer1);
+        entity1->addComponent(material1);
+        entity2->addComponent(geometryRenderer2);
+        entity2->addComponent(material1);
+        entity3->addComponent(geometryRenderer3);
+        entity3->addComponent(material2);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        NodeManagers *managers = aspect->nodeManagers();
+        const std::vector<Entity *> entities = sortedEntities(managers, { entity1, entity2, entity3 });
+        Entity *backendEntity1 = managers->renderNodesManager()->lookupResource(entity1->id());
+        Entity *backendEntity2 = managers->renderNodesManager()->lookupResource(entity2->id());
+        Entity *backendEntity3 = managers->renderNodesManager()->lookupResource(entity3->id());
+
+        DirtyRenderCommandTracker tracker;
+        tracker.setManagers(managers);
+
+        {
+            // WHEN
+            tracker.markDirty(AbstractRenderer::GeometryDirty,
+                              managers->geometryRendererManager()->lookupResource(geometryRenderer1->id()));
+
+            // THEN
+            QVERIFY(tracker.canRebuildPartially());
+            QCOMPARE(tracker.dirtyEntities(entities), std::vector<Entity *>({ backendEntity1 }));
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::GeometryDirty,
+                              managers->geometryManager()->lookupResource(geometry->id()));
+
+            // THEN
+            QVERIFY(tracker.canRebuildPartially());
+            QCOMPARE(tracker.dirtyEntities(entities), std::vector<Entity *>({ backendEntity2 }));
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::MaterialDirty,
+                              managers->materialManager()->lookupResource(material1->id()));
+
+            // THEN
+            QVERIFY(tracker.canRebuildPartially());
+            std::vector<Entity *> expected = { backendEntity1, backendEntity2 };
+            std::sort(expected.begin(), expected.end());
+            QCOMPARE(tracker.dirtyEntities(entities), expected);
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::MaterialDirty,
+                              managers->materialManager()->lookupResource(material2->id()));
+            tracker.markDirty(AbstractRenderer::GeometryDirty,
+                              managers->geometryRendererManager()->lookupResource(geometryRenderer1->id()));
+
+            // THEN
+            QVERIFY(tracker.canRebuildPartially());
+            std::vector<Entity *> expected = { backendEntity1, backendEntity3 };
+            std::sort(expected.begin(), expected.end());
+            QCOMPARE(tracker.dirtyEntities(entities), expected);
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::TransformDirty,
+                              managers->geometryRendererManager()->lookupResource(geometryRenderer1->id()));
+
+            // THEN
+            QVERIFY(tracker.isEmpty());
+            QVERIFY(!tracker.canRebuildPartially());
+        }
+    }
+
+    void checkUnattributedChangesRequireFullRebuild()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(rootEntity);
+        Qt3DRender::QGeometryRenderer *geometryRenderer = new Qt3DRender::QGeometryRenderer(rootEntity);
+        Qt3DRender::QMaterial *material = new Qt3DRender::QMaterial(rootEntity);
+        entity->addComponent(geometryRenderer);
+        entity->addComponent(material);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        NodeManagers *managers = aspect->nodeManagers();
+        GeometryRenderer *backendGeometryRenderer = managers->geometryRendererManager()->lookupResource(geometryRenderer->id());
+        Material *backendMaterial = managers->materialManager()->lookupResource(material->id());
+
+        DirtyRenderCommandTracker tracker;
+        tracker.setManagers(managers);
+
+        {
+            // WHEN
+            tracker.markDirty(AbstractRenderer::GeometryDirty, nullptr);
+
+            // THEN
+            QVERIFY(!tracker.isEmpty());
+            QVERIFY(!tracker.canRebuildPartially());
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::GeometryDirty, backendGeometryRenderer);
+            tracker.markDirty(AbstractRenderer::AllDirty, backendMaterial);
+
+            // THEN
+            QVERIFY(!tracker.canRebuildPartially());
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            // Node not matching the change
+            tracker.markDirty(AbstractRenderer::MaterialDirty, backendGeometryRenderer);
+
+            // THEN
+            QVERIFY(!tracker.canRebuildPartially());
+        }
+
+        {
+            // WHEN
+            tracker.clear();
+            tracker.markDirty(AbstractRenderer::FrameGraphDirty, backendMaterial);
+
+            // THEN
+            QVERIFY(!tracker.canRebuildPartially());
+        }
+    }
+
+    void checkPatchedCommandData()
+    {
+        // GIVEN
+        Entity entities[4];
+        std::vector<Entity *> sorted = { &entities[0], &entities[1], &entities[2], &entities[3] };
+        std::sort(sorted.begin(), sorted.end());
+        Entity *e0 = sorted[0];
+        Entity *e1 = sorted[1];
+        Entity *e2 = sorted[2];
+        Entity *e3 = sorted[3];
+
+        // e0 and e2 have two commands, e1 and e3 none
+        EntityRenderCommandData<TestCommand> data;
+        data.push_back(e0, TestCommand{ 0 }, RenderPassParameterData());
+        data.push_back(e0, TestCommand{ 1 }, RenderPassParameterData());
+        data.push_back(e2, TestCommand{ 2 }, RenderPassParameterData());
+        data.push_back(e2, TestCommand{ 3 }, RenderPassParameterData());
+
+        // WHEN e0 loses a command, e1 and e3 gain some and e2 is untouched
+        EntityRenderCommandData<TestCommand> rebuiltData;
+        rebuiltData.push_back(e0, TestCommand{ 10 }, RenderPassParameterData());
+        rebuiltData.push_back(e1, TestCommand{ 11 }, RenderPassParameterData());
+        rebuiltData.push_back(e3, TestCommand{ 13 }, RenderPassParameterData());
+        rebuiltData.push_back(e3, TestCommand{ 14 }, RenderPassParameterData());
+
+        const EntityRenderCommandData<TestCommand> patched =
+                data.patched(std::move(rebuiltData), { e0, e1, e3 });
+
+        // THEN
+        QCOMPARE(patched.size(), 6U);
+        QCOMPARE(patched.entities, std::vector<const Entity *>({ e0, e1, e2, e2, e3, e3 }));
+        std::vector<int> values;
+        for (const TestCommand &command : patched.commands)
+            values.push_back(command.value);
+        QCOMPARE(values, std::vector<int>({ 10, 11, 2, 3, 13, 14 }));
+        QCOMPARE(patched.passesData.size(), 6U);
+        QCOMPARE(data.size(), 4U);
+    }
+};
+
+QTEST_MAIN(tst_DirtyRenderCommandTracker)
+
+#include "tst_dirtyrendercommandtracker.moc"
@@ -484,6 +484,48 @@ private slots:
         QCOMPARE(visitCount, 3);
     }
 
+    void checkComponentHandleCaching()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        Qt3DCore::QTransform transform;
+        QLayer layer;
+        const HTransform transformHandle = nodeManagers.transformManager()->getOrAcquireHandle(transform.id());
+        const HLayer layerHandle = nodeManagers.layerManager()->getOrAcquireHandle(layer.id());
+        Qt3DRender::Render::Entity entity;
+        entity.setRenderer(&renderer);
+        entity.setNodeManagers(&nodeManagers);
+
+        // WHEN
+        EntityPrivate::get(&entity)->componentAdded(&transform);
+        EntityPrivate::get(&entity)->componentAdded(&layer);
+
+        // THEN
+        QCOMPARE(entity.componentHandle<Transform>(), transformHandle);
+        QCOMPARE(entity.renderComponent<Transform>(), transformHandle.data());
+        QCOMPARE(entity.componentsHandle<Layer>(), QList<HLayer>() << layerHandle);
+        QCOMPARE(entity.renderComponents<Layer>(), std::vector<Layer *>{ layerHandle.data() });
+
+        // WHEN -> backend nodes are destroyed
+        nodeManagers.transformManager()->releaseResource(transform.id());
+        nodeManagers.layerManager()->releaseResource(layer.id());
+
+        // THEN -> stale cached handles aren't used
+        QVERIFY(entity.componentHandle<Transform>().isNull());
+        QVERIFY(entity.renderComponent<Transform>() == nullptr);
+        QCOMPARE(entity.renderComponents<Layer>(), std::vector<Layer *>{ nullptr });
+
+        // WHEN
+        EntityPrivate::get(&entity)->componentRemoved(&transform);
+        EntityPrivate::get(&entity)->componentRemoved(&layer);
+
+        // THEN
+        QVERIFY(entity.componentUuid<Transform>().isNull());
+        QVERIFY(entity.componentsUuid<Layer>().isEmpty());
+        QVERIFY(entity.renderComponents<Layer>().empty());
+    }
+
     void visitor()
     {
         // GIVEN
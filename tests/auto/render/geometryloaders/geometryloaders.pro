@@ -2,11 +2,16 @@ TEMPLATE = app
 
 TARGET = tst_geometryloaders
 
-QT += 3dcore 3dcore-private 3drender 3drender-private testlib 3dextras
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib 3dextras concurrent core-private
 
 CONFIG += testcase
 
-SOURCES += tst_geometryloaders.cpp
+SOURCES += \
+    tst_geometryloaders.cpp \
+    ../../../../src/plugins/geometryloaders/default/basegeometryloader.cpp
+
+HEADERS += \
+    ../../../../src/plugins/geometryloaders/default/basegeometryloader_p.h
 
 RESOURCES += \
     geometryloaders.qrc
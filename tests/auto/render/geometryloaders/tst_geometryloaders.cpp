@@ -3,16 +3,24 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/QBuffer>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
 #include <QtCore/private/qfactoryloader_p.h>
 
 #include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qgeometry.h>
 
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
 #include <Qt3DRender/private/qgeometryloaderinterface_p.h>
 
 #include "../../../../src/plugins/geometryloaders/qtgeometryloaders-config.h"
+#include "../../../../src/plugins/geometryloaders/default/basegeometryloader_p.h"
+
+#include <limits>
+#include <vector>
 
 using namespace Qt3DCore;
 using namespace Qt3DRender;
@@ -20,6 +28,152 @@ using namespace Qt3DRender;
 Q_GLOBAL_STATIC_WITH_ARGS(QFactoryLoader, geometryLoader,
     (QGeometryLoaderFactory_iid, QLatin1String("/geometryloaders"), Qt::CaseInsensitive))
 
+namespace {
+
+// Grid of size x size quads, large enough for the loaders to parse it in
+// several chunks
+struct GridMesh
+{
+    explicit GridMesh(int size)
+    {
+        for (int y = 0; y <= size; ++y) {
+            for (int x = 0; x <= size; ++x)
+                vertices.emplace_back(float(x) * 0.25f, float(y) * 0.5f, float((x * y) % 7) * 0.125f);
+        }
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const quint32 i = quint32(y * (size + 1) + x);
+                const quint32 quad[] = { i, i + 1, i + quint32(size) + 2, i, i + quint32(size) + 2, i + quint32(size) + 1 };
+                indices.insert(indices.end(), std::begin(quad), std::end(quad));
+            }
+        }
+    }
+
+    std::vector<QVector3D> corners() const
+    {
+        std::vector<QVector3D> result;
+        for (quint32 index : indices)
+            result.push_back(vertices[index]);
+        return result;
+    }
+
+    QByteArray toObj() const
+    {
+        QByteArray obj("o Grid\r\n");
+        for (const QVector3D &v : vertices)
+            obj += "v " + QByteArray::number(v.x()) + ' ' + QByteArray::number(v.y()) + ' ' + QByteArray::number(v.z()) + "\r\n";
+        obj += "vn 0 0 1\r\n";
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            obj += "f " + QByteArray::number(indices[i] + 1) + "//1 "
+                    + QByteArray::number(indices[i + 1] + 1) + "//1 "
+                    + QByteArray::number(indices[i + 2] + 1) + "//1\r\n";
+        }
+        return obj;
+    }
+
+    QByteArray toPly() const
+    {
+        QByteArray ply("ply\nformat ascii 1.0\n");
+        ply += "element vertex " + QByteArray::number(qsizetype(vertices.size())) + '\n';
+        ply += "property float x\nproperty float y\nproperty float z\n";
+        ply += "element face " + QByteArray::number(qsizetype(indices.size() / 3)) + '\n';
+        ply += "property list uchar uint vertex_indices\nend_header\n";
+        for (const QVector3D &v : vertices)
+            ply += QByteArray::number(v.x()) + ' ' + QByteArray::number(v.y()) + ' ' + QByteArray::number(v.z()) + '\n';
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            ply += "3 " + QByteArray::number(indices[i]) + ' ' + QByteArray::number(indices[i + 1])
+                    + ' ' + QByteArray::number(indices[i + 2]) + '\n';
+        }
+        return ply;
+    }
+
+    QByteArray toAsciiStl() const
+    {
+        QByteArray stl("solid Grid\n");
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            stl += "facet normal 0 0 1\nouter loop\n";
+            for (size_t j = i; j < i + 3; ++j) {
+                const QVector3D &v = vertices[indices[j]];
+                stl += "vertex " + QByteArray::number(v.x()) + ' ' + QByteArray::number(v.y()) + ' ' + QByteArray::number(v.z()) + '\n';
+            }
+            stl += "endloop\nendfacet\n";
+        }
+        stl += "endsolid Grid\n";
+        return stl;
+    }
+
+    QByteArray toBinaryStl() const
+    {
+        const quint32 triangleCount = quint32(indices.size() / 3);
+        QByteArray stl(80 + sizeof(quint32) + triangleCount * 50, '\0');
+        uchar *p = reinterpret_cast<uchar *>(stl.data()) + 80;
+        qToLittleEndian(triangleCount, p);
+        p += sizeof(quint32);
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            qToLittleEndian(1.0f, p + 2 * sizeof(float));
+            p += 3 * sizeof(float);
+            for (size_t j = i; j < i + 3; ++j) {
+                const QVector3D &v = vertices[indices[j]];
+                qToLittleEndian(v.x(), p);
+                qToLittleEndian(v.y(), p + sizeof(float));
+                qToLittleEndian(v.z(), p + 2 * sizeof(float));
+                p += 3 * sizeof(float);
+            }
+            p += sizeof(quint16);
+        }
+        return stl;
+    }
+
+    std::vector<QVector3D> vertices;
+    std::vector<quint32> indices;
+};
+
+QAttribute *indexAttribute(QGeometry *geometry)
+{
+    const auto attributes = geometry->attributes();
+    for (QAttribute *attr : attributes) {
+        if (attr->attributeType() == QAttribute::IndexAttribute)
+            return attr;
+    }
+    return nullptr;
+}
+
+QAttribute *positionAttribute(QGeometry *geometry)
+{
+    const auto attributes = geometry->attributes();
+    for (QAttribute *attr : attributes) {
+        if (attr->name() == QAttribute::defaultPositionAttributeName())
+            return attr;
+    }
+    return nullptr;
+}
+
+// Positions of the corners of the triangles of the geometry
+std::vector<QVector3D> triangleCorners(QGeometry *geometry)
+{
+    QAttribute *position = positionAttribute(geometry);
+    QAttribute *index = indexAttribute(geometry);
+    if (position == nullptr || index == nullptr)
+        return {};
+
+    const QByteArray vertexData = position->buffer()->data();
+    const QByteArray indexData = index->buffer()->data();
+    std::vector<QVector3D> corners;
+    for (uint i = 0; i < index->count(); ++i) {
+        const uint vertex = index->vertexBaseType() == QAttribute::UnsignedInt
+                ? reinterpret_cast<const quint32 *>(indexData.constData())[i]
+                : reinterpret_cast<const quint16 *>(indexData.constData())[i];
+        if (vertex >= position->count())
+            return {};
+        const float *p = reinterpret_cast<const float *>(vertexData.constData() + position->byteOffset()
+                                                         + vertex * position->byteStride());
+        corners.emplace_back(p[0], p[1], p[2]);
+    }
+    return corners;
+}
+
+} // anonymous
+
 class tst_geometryloaders : public QObject
 {
     Q_OBJECT
@@ -27,6 +181,15 @@ class tst_geometryloaders : public QObject
 private Q_SLOTS:
     void testOBJLoader_data();
     void testOBJLoader();
+    void testOBJLoaderWithoutFaces_data();
+    void testOBJLoaderWithoutFaces();
+    void testOBJLoaderSubMesh();
+    void testLargeMeshes_data();
+    void testLargeMeshes();
+    void testParseFloat_data();
+    void testParseFloat();
+    void testParseInt_data();
+    void testParseInt();
     void testPLYLoader();
     void testSTLLoader();
     void testGLTFLoader();
@@ -84,6 +247,200 @@ void tst_geometryloaders::testOBJLoader()
     file.close();
 }
 
+void tst_geometryloaders::testOBJLoaderWithoutFaces_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("subMesh");
+    QTest::newRow("empty") << QByteArray() << QString();
+    QTest::newRow("no faces") << QByteArray("o Points\nv 0 0 0\nv 1 0 0\nvn 0 0 1\n") << QString();
+    QTest::newRow("no matching sub mesh") << QByteArray("o Cube\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n")
+                                          << QStringLiteral("Sphere");
+}
+
+void tst_geometryloaders::testOBJLoaderWithoutFaces()
+{
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), QStringLiteral("obj")));
+    QVERIFY(loader);
+
+    // GIVEN
+    QFETCH(QByteArray, data);
+    QFETCH(QString, subMesh);
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QVERIFY(loader->load(&buffer, subMesh));
+
+    // THEN
+    QGeometry *geometry = loader->geometry();
+    QVERIFY(geometry);
+    QVERIFY(positionAttribute(geometry));
+    QCOMPARE(positionAttribute(geometry)->count(), 0u);
+    QVERIFY(indexAttribute(geometry));
+    QCOMPARE(indexAttribute(geometry)->count(), 0u);
+}
+
+void tst_geometryloaders::testOBJLoaderSubMesh()
+{
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), QStringLiteral("obj")));
+    QVERIFY(loader);
+
+    // GIVEN
+    QByteArray data("o A\r\nv 0 0 0\r\nv 1 0 0\r\nv 0 1 0\r\nf 1 2 3\r\n"
+                    "o B\r\nv 0 0 2\r\nv 2 0 2\r\nv 0 2 2\r\nf 4 5 6\r\n");
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QVERIFY(loader->load(&buffer, QStringLiteral("B")));
+
+    // THEN -> indices are relative to the first value of the sub mesh
+    const std::vector<QVector3D> expected = { { 0, 0, 2 }, { 2, 0, 2 }, { 0, 2, 2 } };
+    QVERIFY(triangleCorners(loader->geometry()) == expected);
+}
+
+void tst_geometryloaders::testLargeMeshes_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<uint>("vertexCount");
+
+    // More than 16384 vertices and faces
+    const GridMesh grid(130);
+    const uint cornerCount = uint(grid.indices.size());
+    QTest::newRow("obj") << QStringLiteral("obj") << grid.toObj() << uint(grid.vertices.size());
+    QTest::newRow("ply") << QStringLiteral("ply") << grid.toPly() << uint(grid.vertices.size());
+    QTest::newRow("ascii stl") << QStringLiteral("stl") << grid.toAsciiStl() << cornerCount;
+    QTest::newRow("binary stl") << QStringLiteral("stl") << grid.toBinaryStl() << cornerCount;
+}
+
+void tst_geometryloaders::testLargeMeshes()
+{
+    QFETCH(QString, format);
+    QFETCH(QByteArray, data);
+    QFETCH(uint, vertexCount);
+
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), format));
+    QVERIFY(loader);
+
+    // GIVEN -> a file, so that it is memory mapped
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QFile file(dir.filePath(QStringLiteral("grid.") + format));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QVERIFY(loader->load(&file, QString()));
+
+    // THEN
+    QGeometry *geometry = loader->geometry();
+    QVERIFY(geometry);
+    QVERIFY(positionAttribute(geometry));
+    QCOMPARE(positionAttribute(geometry)->count(), vertexCount);
+    QVERIFY(triangleCorners(geometry) == GridMesh(130).corners());
+}
+
+void tst_geometryloaders::testParseFloat_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<float>("expected");
+    QTest::addColumn<int>("length");
+
+    const auto fallback = [] (const char *input) {
+        return float(qstrntod(input, qstrlen(input), nullptr, nullptr));
+    };
+
+    QTest::newRow("integer") << QByteArray("42") << 42.0f << 2;
+    QTest::newRow("zero") << QByteArray("0.000") << 0.0f << 5;
+    QTest::newRow("negative") << QByteArray("-2.5") << -2.5f << 4;
+    QTest::newRow("positive") << QByteArray("+3.25") << 3.25f << 5;
+    QTest::newRow("no integral part") << QByteArray(".5") << 0.5f << 2;
+    QTest::newRow("negative, no integral part") << QByteArray("-.5") << -0.5f << 3;
+    QTest::newRow("no fractional part") << QByteArray("1.") << 1.0f << 2;
+    QTest::newRow("exponent") << QByteArray("1e3") << 1000.0f << 3;
+    QTest::newRow("negative exponent") << QByteArray("1E-3") << 0.001f << 4;
+    QTest::newRow("positive exponent") << QByteArray("2.5e+2") << 250.0f << 6;
+    QTest::newRow("exponent without digits") << QByteArray("1e") << 1.0f << 1;
+    QTest::newRow("signed exponent without digits") << QByteArray("1e+") << 1.0f << 1;
+    QTest::newRow("largest exact power") << QByteArray("1e22") << 1e22f << 4;
+    QTest::newRow("smallest exact power") << QByteArray("1e-22") << 1e-22f << 5;
+    QTest::newRow("large power") << QByteArray("1.5e23") << 1.5e23f << 6;
+    QTest::newRow("small power") << QByteArray("1.5e-23") << 1.5e-23f << 7;
+    QTest::newRow("float overflow") << QByteArray("3.5e38") << fallback("3.5e38") << 6;
+    QTest::newRow("denormal") << QByteArray("1e-45") << fallback("1e-45") << 5;
+    QTest::newRow("15 digits") << QByteArray("1.23456789012345") << 1.23456789012345f << 16;
+    QTest::newRow("20 digits") << QByteArray("12345678901234567890") << 12345678901234567890.0f << 20;
+    QTest::newRow("20 fractional digits") << QByteArray("0.12345678901234567890") << 0.12345678901234567890f << 22;
+    QTest::newRow("leading zeros") << QByteArray("0000000000000000001.5") << 1.5f << 21;
+    QTest::newRow("infinity") << QByteArray("inf") << std::numeric_limits<float>::infinity() << 3;
+    QTest::newRow("negative infinity") << QByteArray("-inf") << -std::numeric_limits<float>::infinity() << 4;
+    QTest::newRow("nan") << QByteArray("nan") << std::numeric_limits<float>::quiet_NaN() << 3;
+    QTest::newRow("exponent overflow") << QByteArray("1e4294967297") << fallback("1e4294967297") << 12;
+    QTest::newRow("exponent underflow") << QByteArray("1e-4294967297") << fallback("1e-4294967297") << 13;
+    QTest::newRow("crlf") << QByteArray("1.5\r\n") << 1.5f << 3;
+    QTest::newRow("exponent, crlf") << QByteArray("2e3\r\n") << 2000.0f << 3;
+    QTest::newRow("face index") << QByteArray("7/8") << 7.0f << 1;
+}
+
+void tst_geometryloaders::testParseFloat()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(float, expected);
+    QFETCH(int, length);
+
+    // WHEN
+    const char *next = nullptr;
+    const float value = parseFloat(input.constBegin(), input.constEnd(), &next);
+
+    // THEN
+    if (qIsNaN(expected))
+        QVERIFY(qIsNaN(value));
+    else
+        QCOMPARE(value, expected);
+    QCOMPARE(int(next - input.constBegin()), length);
+}
+
+void tst_geometryloaders::testParseInt_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<int>("expected");
+    QTest::addColumn<int>("length");
+
+    QTest::newRow("empty") << QByteArray() << 0 << 0;
+    QTest::newRow("zero") << QByteArray("0") << 0 << 1;
+    QTest::newRow("positive") << QByteArray("+42") << 42 << 3;
+    QTest::newRow("negative") << QByteArray("-42") << -42 << 3;
+    QTest::newRow("largest") << QByteArray("2147483647") << std::numeric_limits<int>::max() << 10;
+    QTest::newRow("smallest") << QByteArray("-2147483648") << std::numeric_limits<int>::min() << 11;
+    QTest::newRow("overflow") << QByteArray("2147483648") << std::numeric_limits<int>::max() << 10;
+    QTest::newRow("underflow") << QByteArray("-2147483649") << std::numeric_limits<int>::min() << 11;
+    QTest::newRow("wrapping overflow") << QByteArray("4294967297") << std::numeric_limits<int>::max() << 10;
+    QTest::newRow("long overflow") << QByteArray("99999999999999999999999") << std::numeric_limits<int>::max() << 23;
+    QTest::newRow("crlf") << QByteArray("12\r\n") << 12 << 2;
+    QTest::newRow("face index") << QByteArray("3/4/5") << 3 << 1;
+}
+
+void tst_geometryloaders::testParseInt()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(int, expected);
+    QFETCH(int, length);
+
+    // WHEN
+    const char *next = nullptr;
+    const int value = parseInt(input.constBegin(), input.constEnd(), &next);
+
+    // THEN
+    QCOMPARE(value, expected);
+    QCOMPARE(int(next - input.constBegin()), length);
+}
+
 void tst_geometryloaders::testPLYLoader()
 {
     QScopedPointer<QGeometryLoaderInterface> loader;
@@ -6,15 +6,123 @@
 QT_WARNING_DISABLE_DEPRECATED
 
 #include <QtTest/QTest>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QFile>
+#include <QtCore/QBuffer>
+#include <QtCore/qendian.h>
 #include <Qt3DRender/qtextureimagedata.h>
 #include <Qt3DRender/private/qtexture_p.h>
 
+namespace {
+
+void appendUInt32(QByteArray &data, quint32 value)
+{
+    value = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void appendUInt64(QByteArray &data, quint64 value)
+{
+    value = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void setUInt32(QByteArray &data, int offset, quint32 value)
+{
+    value = qToLittleEndian(value);
+    memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+// Fills each image with the byte value (level * 16 + layer * 6 + face + 1)
+QByteArray imageContent(int level, int layer, int face, int size)
+{
+    return QByteArray(size, char(level * 16 + layer * 6 + face + 1));
+}
+
+// Uncompressed RGBA8 KTX 1.1 file
+QByteArray createKtx1(int width, int height, int layers, int faces, int levels)
+{
+    QByteArray data("\xAB" "KTX 11" "\xBB" "\r\n\x1A\n", 12);
+    appendUInt32(data, 0x04030201); // endianness
+    appendUInt32(data, 0x1401); // GL_UNSIGNED_BYTE
+    appendUInt32(data, 1); // glTypeSize
+    appendUInt32(data, 0x1908); // GL_RGBA
+    appendUInt32(data, 0x8058); // GL_RGBA8
+    appendUInt32(data, 0x1908); // GL_RGBA
+    appendUInt32(data, width);
+    appendUInt32(data, height);
+    appendUInt32(data, 0); // depth
+    appendUInt32(data, layers);
+    appendUInt32(data, faces);
+    appendUInt32(data, levels);
+    appendUInt32(data, 0); // key value data
+
+    for (int level = 0; level < levels; ++level) {
+        const int imageSize = qMax(width >> level, 1) * qMax(height >> level, 1) * 4;
+        if (layers == 0 && faces == 6) {
+            appendUInt32(data, imageSize);
+            for (int face = 0; face < faces; ++face)
+                data += imageContent(level, 0, face, imageSize);
+        } else {
+            appendUInt32(data, imageSize * qMax(layers, 1) * faces);
+            for (int layer = 0; layer < qMax(layers, 1); ++layer)
+                for (int face = 0; face < faces; ++face)
+                    data += imageContent(level, layer, face, imageSize);
+        }
+    }
+    return data;
+}
+
+// Uncompressed VK_FORMAT_R8G8B8A8_UNORM KTX 2.0 file
+QByteArray createKtx2(int width, int height, int layers, int faces, int levels)
+{
+    QByteArray data("\xAB" "KTX 20" "\xBB" "\r\n\x1A\n", 12);
+    appendUInt32(data, 37); // VK_FORMAT_R8G8B8A8_UNORM
+    appendUInt32(data, 1); // typeSize
+    appendUInt32(data, width);
+    appendUInt32(data, height);
+    appendUInt32(data, 0); // depth
+    appendUInt32(data, layers);
+    appendUInt32(data, faces);
+    appendUInt32(data, levels);
+    appendUInt32(data, 0); // supercompression
+    for (int i = 0; i < 4; ++i)
+        appendUInt32(data, 0); // dfd and kvd
+    appendUInt64(data, 0); // sgd offset
+    appendUInt64(data, 0); // sgd length
+
+    // Levels are stored from the smallest to the largest one
+    QByteArray levelData;
+    std::vector<std::pair<quint64, quint64>> levelIndex(levels);
+    const quint64 dataStart = data.size() + levels * 3 * sizeof(quint64);
+    for (int level = levels - 1; level >= 0; --level) {
+        const int imageSize = qMax(width >> level, 1) * qMax(height >> level, 1) * 4;
+        levelIndex[level] = { dataStart + levelData.size(), quint64(imageSize * qMax(layers, 1) * faces) };
+        for (int layer = 0; layer < qMax(layers, 1); ++layer)
+            for (int face = 0; face < faces; ++face)
+                levelData += imageContent(level, layer, face, imageSize);
+    }
+
+    for (const auto &entry : levelIndex) {
+        appendUInt64(data, entry.first);
+        appendUInt64(data, entry.second);
+        appendUInt64(data, entry.second);
+    }
+    return data + levelData;
+}
+
+} // anonymous
+
 class tst_KtxTextures : public QObject
 {
     Q_OBJECT
 
 private slots:
     void ktxImageData();
+    void uncompressedKtxImageData_data();
+    void uncompressedKtxImageData();
+    void invalidKtxImageData_data();
+    void invalidKtxImageData();
 };
 
 void tst_KtxTextures::ktxImageData()
@@ -49,6 +157,121 @@ void tst_KtxTextures::ktxImageData()
     }
 }
 
+void tst_KtxTextures::uncompressedKtxImageData_data()
+{
+    QTest::addColumn<QByteArray>("fileContent");
+    QTest::addColumn<QString>("suffix");
+    QTest::addColumn<int>("layers");
+    QTest::addColumn<int>("faces");
+    QTest::addColumn<int>("mipLevels");
+    QTest::addColumn<int>("target");
+
+    QTest::newRow("ktx1-2d") << createKtx1(8, 4, 0, 1, 4) << QStringLiteral("ktx") << 1 << 1 << 4 << int(QOpenGLTexture::Target2D);
+    QTest::newRow("ktx1-2d-array") << createKtx1(8, 8, 3, 1, 4) << QStringLiteral("ktx") << 3 << 1 << 4 << int(QOpenGLTexture::Target2DArray);
+    QTest::newRow("ktx1-cube") << createKtx1(4, 4, 0, 6, 3) << QStringLiteral("ktx") << 1 << 6 << 3 << int(QOpenGLTexture::TargetCubeMap);
+    QTest::newRow("ktx1-cube-array") << createKtx1(4, 4, 2, 6, 3) << QStringLiteral("ktx") << 2 << 6 << 3 << int(QOpenGLTexture::TargetCubeMapArray);
+    QTest::newRow("ktx2-2d") << createKtx2(8, 4, 0, 1, 4) << QStringLiteral("ktx2") << 1 << 1 << 4 << int(QOpenGLTexture::Target2D);
+    QTest::newRow("ktx2-2d-array") << createKtx2(8, 8, 3, 1, 4) << QStringLiteral("ktx2") << 3 << 1 << 4 << int(QOpenGLTexture::Target2DArray);
+    QTest::newRow("ktx2-cube") << createKtx2(4, 4, 0, 6, 3) << QStringLiteral("ktx2") << 1 << 6 << 3 << int(QOpenGLTexture::TargetCubeMap);
+}
+
+void tst_KtxTextures::uncompressedKtxImageData()
+{
+    // GIVEN
+    QFETCH(QByteArray, fileContent);
+    QFETCH(QString, suffix);
+    QFETCH(int, layers);
+    QFETCH(int, faces);
+    QFETCH(int, mipLevels);
+    QFETCH(int, target);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("texture.") + suffix);
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(fileContent), fileContent.size());
+    }
+
+    // WHEN
+    // Both through a memory mapped file and through a device
+    Qt3DRender::QTextureImageDataPtr mappedData = Qt3DRender::TextureLoadingHelper::loadTextureData(QUrl::fromLocalFile(fileName), true, false);
+    QBuffer buffer(&fileContent);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    Qt3DRender::QTextureImageDataPtr readData = Qt3DRender::TextureLoadingHelper::loadTextureData(&buffer, suffix, true, false);
+
+    // THEN
+    for (const Qt3DRender::QTextureImageDataPtr &data : { mappedData, readData }) {
+        QVERIFY(data);
+        QCOMPARE(int(data->target()), target);
+        QCOMPARE(data->format(), QOpenGLTexture::RGBA8_UNorm);
+        QCOMPARE(data->pixelFormat(), QOpenGLTexture::RGBA);
+        QCOMPARE(data->pixelType(), QOpenGLTexture::UInt8);
+        QVERIFY(!data->isCompressed());
+        QCOMPARE(data->layers(), layers);
+        QCOMPARE(data->faces(), faces);
+        QCOMPARE(data->mipLevels(), mipLevels);
+
+        for (int level = 0; level < mipLevels; ++level) {
+            const int imageSize = qMax(data->width() >> level, 1) * qMax(data->height() >> level, 1) * 4;
+            for (int layer = 0; layer < layers; ++layer) {
+                for (int face = 0; face < faces; ++face)
+                    QCOMPARE(data->data(layer, face, level), imageContent(level, layer, face, imageSize));
+            }
+        }
+    }
+}
+
+void tst_KtxTextures::invalidKtxImageData_data()
+{
+    QTest::addColumn<QByteArray>("fileContent");
+    QTest::addColumn<QString>("suffix");
+
+    QByteArray truncated = createKtx2(8, 8, 2, 1, 4);
+    truncated.chop(16);
+    QTest::newRow("ktx2-truncated") << truncated << QStringLiteral("ktx2");
+
+    // Counts of layers, faces and levels the file can't hold
+    const int ktx1LayersOffset = 48;
+    QByteArray ktx1 = createKtx1(8, 8, 0, 1, 1);
+    setUInt32(ktx1, ktx1LayersOffset + 8, 0xFFFFFFFF);
+    QTest::newRow("ktx1-levels") << ktx1 << QStringLiteral("ktx");
+    ktx1 = createKtx1(8, 8, 0, 1, 1);
+    setUInt32(ktx1, ktx1LayersOffset, 0x7FFFFFFF);
+    setUInt32(ktx1, ktx1LayersOffset + 4, 6);
+    setUInt32(ktx1, ktx1LayersOffset + 8, 0x7FFFFFFF);
+    QTest::newRow("ktx1-overflow") << ktx1 << QStringLiteral("ktx");
+    ktx1 = createKtx1(8, 8, 0, 1, 1);
+    setUInt32(ktx1, ktx1LayersOffset + 4, 0);
+    QTest::newRow("ktx1-no-faces") << ktx1 << QStringLiteral("ktx");
+
+    const int ktx2LayersOffset = 32;
+    QByteArray ktx2 = createKtx2(8, 8, 0, 1, 1);
+    setUInt32(ktx2, ktx2LayersOffset + 8, 0x10000000);
+    QTest::newRow("ktx2-levels") << ktx2 << QStringLiteral("ktx2");
+    ktx2 = createKtx2(8, 8, 0, 1, 1);
+    setUInt32(ktx2, ktx2LayersOffset, 0xFFFFFFFF);
+    setUInt32(ktx2, ktx2LayersOffset + 4, 0xFFFFFFFF);
+    QTest::newRow("ktx2-overflow") << ktx2 << QStringLiteral("ktx2");
+}
+
+void tst_KtxTextures::invalidKtxImageData()
+{
+    // GIVEN
+    QFETCH(QByteArray, fileContent);
+    QFETCH(QString, suffix);
+    QBuffer buffer(&fileContent);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QTest::ignoreMessage(QtWarningMsg, "Invalid or truncated ktx data");
+    Qt3DRender::QTextureImageDataPtr data = Qt3DRender::TextureLoadingHelper::loadTextureData(&buffer, suffix, true, false);
+
+    // THEN
+    QVERIFY(!data);
+}
+
 QTEST_APPLESS_MAIN(tst_KtxTextures)
 
 #include "tst_ktxtextures.moc"
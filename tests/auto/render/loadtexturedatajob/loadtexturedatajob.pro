@@ -0,0 +1,13 @@
+TEMPLATE = app
+
+TARGET = tst_loadtexturedatajob
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_loadtexturedatajob.cpp
+
+include(../../core/common/common.pri)
+include(../commons/commons.pri)
@@ -0,0 +1,248 @@
+// Copyright (C) 2022 Klaralvdalens Datakonsult AB (KDAB).
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DRender/private/loadtexturedatajob_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
+#include <Qt3DRender/qtextureimagedatagenerator.h>
+#include "testrenderer.h"
+
+namespace {
+
+class TestImageDataGenerator : public Qt3DRender::QTextureImageDataGenerator
+{
+public:
+    explicit TestImageDataGenerator(int id, bool shouldFail = false)
+        : m_id(id)
+        , m_shouldFail(shouldFail)
+    {}
+
+    Qt3DRender::QTextureImageDataPtr operator ()() override
+    {
+        ++m_executionCount;
+        if (m_shouldFail)
+            return {};
+        Qt3DRender::QTextureImageDataPtr data = Qt3DRender::QTextureImageDataPtr::create();
+        data->setWidth(m_id);
+        return data;
+    }
+
+    bool operator ==(const Qt3DRender::QTextureImageDataGenerator &other) const override
+    {
+        const TestImageDataGenerator *otherFunctor = Qt3DCore::functor_cast<TestImageDataGenerator>(&other);
+        return otherFunctor != nullptr && otherFunctor->m_id == m_id;
+    }
+
+    int executionCount() const { return m_executionCount.loadRelaxed(); }
+
+    QT3D_FUNCTOR(TestImageDataGenerator)
+
+private:
+    int m_id;
+    bool m_shouldFail;
+    QAtomicInt m_executionCount;
+};
+
+} // anonymous
+
+class tst_LoadTextureDataJob : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkDataManagerRequestAndRelease()
+    {
+        // GIVEN
+        Qt3DRender::Render::TextureImageDataManager manager;
+        auto generator = QSharedPointer<TestImageDataGenerator>::create(1);
+        auto sameGenerator = QSharedPointer<TestImageDataGenerator>::create(1);
+        int a = 0;
+        int b = 0;
+
+        // THEN
+        QVERIFY(!manager.hasPendingGenerators());
+
+        // WHEN
+        const bool created = manager.requestData(generator, &a);
+        const bool createdAgain = manager.requestData(sameGenerator, &b);
+
+        // THEN
+        QVERIFY(created);
+        QVERIFY(!createdAgain);
+        QVERIFY(manager.hasPendingGenerators());
+        QCOMPARE(manager.pendingGenerators().size(), 1);
+        QVERIFY(!manager.isDataReady(sameGenerator));
+        QVERIFY(manager.getData(generator).isNull());
+
+        // WHEN
+        manager.releaseData(generator, &a);
+
+        // THEN
+        QVERIFY(manager.contains(generator));
+
+        // WHEN
+        manager.releaseData(sameGenerator, &b);
+
+        // THEN
+        QVERIFY(!manager.contains(generator));
+        QVERIFY(!manager.hasPendingGenerators());
+    }
+
+    void checkDataManagerAssignData()
+    {
+        // GIVEN
+        Qt3DRender::Render::TextureImageDataManager manager;
+        auto generator = QSharedPointer<TestImageDataGenerator>::create(1);
+        auto failingGenerator = QSharedPointer<TestImageDataGenerator>::create(2, true);
+        int a = 0;
+        manager.requestData(generator, &a);
+        manager.requestData(failingGenerator, &a);
+
+        // WHEN
+        manager.assignData(generator, generator->operator()());
+        manager.assignData(failingGenerator, failingGenerator->operator()());
+
+        // THEN
+        QVERIFY(manager.isDataReady(generator));
+        QVERIFY(manager.isDataReady(failingGenerator));
+        QCOMPARE(manager.getData(generator)->width(), 1);
+        QVERIFY(manager.getData(failingGenerator).isNull());
+        QVERIFY(!manager.hasPendingGenerators());
+
+        // WHEN -> assigning data to a released generator
+        manager.releaseData(generator, &a);
+        manager.assignData(generator, generator->operator()());
+
+        // THEN
+        QVERIFY(!manager.contains(generator));
+    }
+
+    void checkDataIsDroppedOnceTaken()
+    {
+        // GIVEN
+        Qt3DRender::Render::TextureImageDataManager manager;
+        auto generator = QSharedPointer<TestImageDataGenerator>::create(1);
+        auto sameGenerator = QSharedPointer<TestImageDataGenerator>::create(1);
+        int a = 0;
+        int b = 0;
+        manager.requestData(generator, &a);
+        manager.requestData(sameGenerator, &b);
+        manager.assignData(generator, generator->operator()());
+
+        // WHEN
+        manager.markDataTaken(generator, &a);
+
+        // THEN -> b still needs the data
+        QVERIFY(!manager.getData(sameGenerator).isNull());
+
+        // WHEN
+        manager.markDataTaken(sameGenerator, &b);
+
+        // THEN
+        QVERIFY(manager.contains(generator));
+        QVERIFY(manager.isDataReady(generator));
+        QVERIFY(manager.getData(generator).isNull());
+        QVERIFY(!manager.hasPendingGenerators());
+
+        // WHEN -> requesting the data again
+        manager.requestData(sameGenerator, &b);
+
+        // THEN
+        QVERIFY(manager.hasPendingGenerators());
+        QVERIFY(!manager.isDataReady(generator));
+        QCOMPARE(manager.pendingGenerators().size(), 1);
+
+        // WHEN
+        manager.assignData(generator, generator->operator()());
+
+        // THEN -> a already took it, only b has to
+        QVERIFY(!manager.hasPendingGenerators());
+        QCOMPARE(manager.getData(generator)->width(), 1);
+
+        // WHEN
+        manager.releaseData(sameGenerator, &b);
+
+        // THEN
+        QVERIFY(manager.contains(generator));
+        QVERIFY(manager.getData(generator).isNull());
+    }
+
+    void checkManyGenerators()
+    {
+        // GIVEN
+        Qt3DRender::Render::TextureImageDataManager manager;
+        QList<QSharedPointer<TestImageDataGenerator>> generators;
+        int owner = 0;
+        for (int i = 0; i < 100; ++i) {
+            generators.push_back(QSharedPointer<TestImageDataGenerator>::create(i));
+            manager.requestData(generators.last(), &owner);
+        }
+
+        // WHEN -> releasing entries in the middle
+        for (int i = 0; i < 100; i += 3)
+            manager.releaseData(generators[i], &owner);
+        for (int i = 1; i < 100; i += 3)
+            manager.assignData(generators[i], generators[i]->operator()());
+
+        // THEN
+        QCOMPARE(manager.pendingGenerators().size(), 33);
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(manager.contains(generators[i]), i % 3 != 0);
+            // Equal generators find the same entry
+            const auto sameGenerator = QSharedPointer<TestImageDataGenerator>::create(i);
+            QCOMPARE(manager.isDataReady(sameGenerator), i % 3 == 1);
+            if (i % 3 == 1)
+                QCOMPARE(manager.getData(sameGenerator)->width(), i);
+        }
+    }
+
+    void checkRunExecutesPendingGenerators()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        TestRenderer renderer;
+        Qt3DRender::Render::LoadTextureDataJob job;
+        job.setNodeManagers(&nodeManagers);
+        job.setRenderer(&renderer);
+        Qt3DRender::Render::TextureImageDataManager *manager = nodeManagers.textureImageDataManager();
+
+        QList<QSharedPointer<TestImageDataGenerator>> generators;
+        int owner = 0;
+        for (int i = 0; i < 16; ++i) {
+            generators.push_back(QSharedPointer<TestImageDataGenerator>::create(i + 1));
+            manager->requestData(generators.last(), &owner);
+        }
+
+        // THEN
+        QVERIFY(job.hasPendingGenerators());
+
+        // WHEN
+        job.run();
+        Qt3DCore::QAspectJobPrivate::get(&job)->postFrame(nullptr);
+
+        // THEN
+        QVERIFY(!job.hasPendingGenerators());
+        for (const auto &generator : qAsConst(generators)) {
+            QCOMPARE(generator->executionCount(), 1);
+            QVERIFY(manager->isDataReady(generator));
+            QCOMPARE(manager->getData(generator)->width(), generators.indexOf(generator) + 1);
+        }
+        QVERIFY(renderer.dirtyBits() & Qt3DRender::Render::AbstractRenderer::TexturesDirty);
+
+        // WHEN
+        renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        job.run();
+        Qt3DCore::QAspectJobPrivate::get(&job)->postFrame(nullptr);
+
+        // THEN -> generators are never executed twice
+        for (const auto &generator : qAsConst(generators))
+            QCOMPARE(generator->executionCount(), 1);
+        QVERIFY(!renderer.dirtyBits());
+    }
+};
+
+QTEST_MAIN(tst_LoadTextureDataJob)
+
+#include "tst_loadtexturedatajob.moc"
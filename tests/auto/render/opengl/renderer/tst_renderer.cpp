@@ -13,6 +13,13 @@
 #include <Qt3DRender/private/offscreensurfacehelper_p.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/qmaterial.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DRender/private/buffer_p.h>
+#include <Qt3DRender/private/buffermanager_p.h>
+#include <QOffscreenSurface>
+#include <submissioncontext_p.h>
+#include <glbuffer_p.h>
+#include <qbackendnodetester.h>
 
 #include "testaspect.h"
 
@@ -79,6 +86,185 @@ private Q_SLOTS:
         renderer.shutdown();
     }
 
+    void checkNeedsNextFrame()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Qt3DRender::Render::OpenGL::Renderer renderer;
+        Qt3DRender::Render::OffscreenSurfaceHelper offscreenHelper(&renderer);
+        Qt3DRender::Render::RenderSettings settings;
+        // owned by FG manager
+        Qt3DRender::Render::ViewportNode *fgRoot = new Qt3DRender::Render::ViewportNode();
+        const Qt3DCore::QNodeId fgRootId = Qt3DCore::QNodeId::createId();
+
+        nodeManagers.frameGraphManager()->appendNode(fgRootId, fgRoot);
+        settings.setActiveFrameGraphId(fgRootId);
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderer.setSettings(&settings);
+        renderer.setOffscreenSurfaceHelper(&offscreenHelper);
+        renderer.initialize();
+
+        // Ensure invoke calls are performed
+        QCoreApplication::processEvents();
+
+        // WHEN (nothing dirty, last frame rendered correctly)
+        renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        renderer.m_lastFrameCorrect.storeRelaxed(1);
+
+        // THEN
+        QVERIFY(!renderer.shouldRender());
+        QVERIFY(!renderer.needsNextFrame());
+
+        // WHEN
+        renderer.m_sendBufferCaptureJob->addRequest({Qt3DCore::QNodeId(), {}});
+
+        // THEN -> the captured buffer is only sent by the next frame
+        QVERIFY(!renderer.shouldRender());
+        QVERIFY(renderer.needsNextFrame());
+
+        // WHEN
+        renderer.m_sendBufferCaptureJob->run();
+
+        // THEN
+        QVERIFY(!renderer.needsNextFrame());
+
+        // Properly shutdown command thread
+        renderer.shutdown();
+    }
+
+    void checkPendingReadbacksDontForceRendering()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Qt3DRender::Render::OpenGL::Renderer renderer;
+        Qt3DRender::Render::OffscreenSurfaceHelper offscreenHelper(&renderer);
+        Qt3DRender::Render::RenderSettings settings;
+        // owned by FG manager
+        Qt3DRender::Render::ViewportNode *fgRoot = new Qt3DRender::Render::ViewportNode();
+        const Qt3DCore::QNodeId fgRootId = Qt3DCore::QNodeId::createId();
+
+        nodeManagers.frameGraphManager()->appendNode(fgRootId, fgRoot);
+        settings.setActiveFrameGraphId(fgRootId);
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderer.setSettings(&settings);
+        renderer.setOffscreenSurfaceHelper(&offscreenHelper);
+        renderer.initialize();
+
+        // Ensure invoke calls are performed
+        QCoreApplication::processEvents();
+
+        renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        renderer.m_lastFrameCorrect.storeRelaxed(1);
+
+        // WHEN
+        renderer.m_pendingBufferDownloadCount.storeRelaxed(1);
+
+        // THEN -> the fences are polled without rendering
+        QVERIFY(!renderer.shouldRender());
+        QVERIFY(renderer.needsNextFrame());
+
+        // WHEN
+        renderer.m_pendingBufferDownloadCount.storeRelaxed(0);
+        renderer.m_pendingRenderCaptureReadCount.storeRelaxed(1);
+
+        // THEN
+        QVERIFY(!renderer.shouldRender());
+        QVERIFY(renderer.needsNextFrame());
+
+        // WHEN
+        renderer.m_pendingRenderCaptureReadCount.storeRelaxed(0);
+
+        // THEN
+        QVERIFY(!renderer.needsNextFrame());
+
+        // Properly shutdown command thread
+        renderer.shutdown();
+    }
+
+    void checkBufferDownloadsRecycleStagingBuffers()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Qt3DRender::Render::OpenGL::Renderer renderer;
+        Qt3DRender::Render::OffscreenSurfaceHelper offscreenHelper(&renderer);
+        Qt3DRender::Render::RenderSettings settings;
+        // owned by FG manager
+        Qt3DRender::Render::ViewportNode *fgRoot = new Qt3DRender::Render::ViewportNode();
+        const Qt3DCore::QNodeId fgRootId = Qt3DCore::QNodeId::createId();
+
+        nodeManagers.frameGraphManager()->appendNode(fgRootId, fgRoot);
+        settings.setActiveFrameGraphId(fgRootId);
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderer.setSettings(&settings);
+        renderer.setOffscreenSurfaceHelper(&offscreenHelper);
+        renderer.initialize();
+
+        // Ensure invoke calls are performed
+        QCoreApplication::processEvents();
+
+        Qt3DRender::Render::OpenGL::SubmissionContext *context = renderer.submissionContext();
+        QOffscreenSurface *surface = offscreenHelper.offscreenSurface();
+        if (!surface || !context->makeCurrent(surface)) {
+            renderer.shutdown();
+            QSKIP("Requires an OpenGL context");
+        }
+
+        const QByteArray content = QByteArrayLiteral("0123456789abcdef");
+        Qt3DCore::QBuffer frontendBuffer;
+        frontendBuffer.setData(content);
+        frontendBuffer.setAccessType(Qt3DCore::QBuffer::ReadWrite);
+        Qt3DRender::Render::Buffer *buffer = nodeManagers.bufferManager()->getOrCreateResource(frontendBuffer.id());
+        buffer->setRenderer(&renderer);
+        buffer->setManager(nodeManagers.bufferManager());
+        Qt3DCore::QBackendNodeTester().simulateInitializationSync(&frontendBuffer, buffer);
+
+        Qt3DRender::Render::OpenGL::GLBuffer *glBuffer = context->glBufferForRenderBuffer(buffer);
+        glBuffer->bind(context, Qt3DRender::Render::OpenGL::GLBuffer::ArrayBuffer);
+        glBuffer->allocate(context, content.constData(), uint(content.size()), false);
+        glBuffer->release(context);
+
+        // WHEN
+        const bool asyncDownload = context->downloadBufferContentAsync(buffer);
+        if (!asyncDownload) {
+            context->doneCurrent();
+            renderer.shutdown();
+            QSKIP("Requires fences and copy buffers");
+        }
+        context->openGLContext()->functions()->glFinish();
+        std::vector<QPair<Qt3DCore::QNodeId, QByteArray>> downloads = context->takeCompletedBufferDownloads();
+
+        // THEN
+        QCOMPARE(downloads.size(), 1U);
+        QCOMPARE(downloads.front().first, frontendBuffer.id());
+        QCOMPARE(downloads.front().second, content);
+        QCOMPARE(context->pendingBufferDownloadCount(), 0U);
+        QCOMPARE(context->freeStagingBufferCount(), 1U);
+
+        // WHEN
+        QVERIFY(context->downloadBufferContentAsync(buffer));
+
+        // THEN -> the staging buffer was reused
+        QCOMPARE(context->pendingBufferDownloadCount(), 1U);
+        QCOMPARE(context->freeStagingBufferCount(), 0U);
+
+        // WHEN
+        context->openGLContext()->functions()->glFinish();
+        downloads = context->takeCompletedBufferDownloads();
+
+        // THEN
+        QCOMPARE(downloads.size(), 1U);
+        QCOMPARE(downloads.front().second, content);
+        QCOMPARE(context->freeStagingBufferCount(), 1U);
+
+        // Properly shutdown command thread
+        context->releaseBufferDownloads();
+        context->doneCurrent();
+        renderer.shutdown();
+    }
+
     void checkRenderBinJobs()
     {
         // GIVEN
@@ -22,6 +22,7 @@ private Q_SLOTS:
     void checkTimeToSubmit();
     void concurrentQueueAccess();
     void resetQueue();
+    void takeFrameQueue();
 };
 
 
@@ -214,6 +215,41 @@ void tst_RenderQueue::resetQueue()
     }
 }
 
+void tst_RenderQueue::takeFrameQueue()
+{
+    // GIVEN
+    Qt3DRender::Render::RenderQueue<Qt3DRender::Render::OpenGL::RenderView> renderQueue;
+    renderQueue.setTargetRenderViewCount(3);
+
+    std::vector<Qt3DRender::Render::OpenGL::RenderView *> renderViews;
+    for (int i = 0; i < 3; ++i) {
+        renderViews.push_back(new Qt3DRender::Render::OpenGL::RenderView());
+        renderQueue.queueRenderView(renderViews.back(), i);
+    }
+
+    // WHEN
+    std::vector<Qt3DRender::Render::OpenGL::RenderView *> frameQueue;
+    renderQueue.takeFrameQueue(frameQueue);
+
+    // THEN
+    QCOMPARE(frameQueue, renderViews);
+    QCOMPARE(renderQueue.wasReset(), true);
+    QCOMPARE(renderQueue.currentRenderViewCount(), 0);
+    QCOMPARE(renderQueue.targetRenderViewCount(), 0);
+    QVERIFY(renderQueue.nextFrameQueue().empty());
+
+    // WHEN
+    renderQueue.setTargetRenderViewCount(1);
+    renderQueue.queueRenderView(new Qt3DRender::Render::OpenGL::RenderView(), 0);
+
+    // THEN
+    QVERIFY(renderQueue.isFrameQueueComplete());
+    renderQueue.reset();
+
+    // Views taken out are still alive and owned by the caller
+    qDeleteAll(frameQueue);
+}
+
 QTEST_APPLESS_MAIN(tst_RenderQueue)
 
 #include "tst_renderqueue.moc"
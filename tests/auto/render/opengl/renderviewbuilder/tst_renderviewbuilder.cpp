@@ -428,6 +428,127 @@ private Q_SLOTS:
         }
     }
 
+    void checkJobHierarchyIsKeptAcrossFrames()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QClearBuffers *clearBuffer = new Qt3DRender::QClearBuffers(viewport);
+        Qt3DRender::TestAspect testAspect(buildSimpleScene(viewport));
+
+        Qt3DRender::Render::FrameGraphNode *leafNode = testAspect.nodeManagers()->frameGraphManager()->lookupNode(clearBuffer->id());
+        QVERIFY(leafNode != nullptr);
+
+        Qt3DRender::Render::OpenGL::RenderViewBuilder renderViewBuilder(leafNode, 0, testAspect.renderer());
+        renderViewBuilder.setOptimalJobCount(2);
+        renderViewBuilder.setLayerCacheNeedsToBeRebuilt(true);
+        renderViewBuilder.setMaterialGathererCacheNeedsToBeRebuilt(true);
+        renderViewBuilder.setRenderCommandCacheNeedsToBeRebuilt(true);
+
+        // WHEN
+        renderViewBuilder.prepareJobs();
+        const std::vector<Qt3DCore::QAspectJobPtr> firstFrameJobs = renderViewBuilder.buildJobHierachy();
+        const size_t preCommandUpdateDependencyCount = renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies().size();
+        const size_t postCommandUpdateDependencyCount = renderViewBuilder.syncRenderViewPostCommandUpdateJob()->dependencies().size();
+
+        // THEN
+        QCOMPARE(firstFrameJobs.size(), 8U + 2U + 3U + 2U + 3U);
+        QCOMPARE(renderViewBuilder.materialGathererJobs().size(), 2U);
+
+        // WHEN
+        renderViewBuilder.prepareJobs();
+        const std::vector<Qt3DCore::QAspectJobPtr> secondFrameJobs = renderViewBuilder.buildJobHierachy();
+
+        // THEN -> same jobs, no dependency added
+        QVERIFY(secondFrameJobs == firstFrameJobs);
+        QCOMPARE(renderViewBuilder.renderViewJob()->dependencies().size(), 1U);
+        QCOMPARE(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies().size(), preCommandUpdateDependencyCount);
+        QCOMPARE(renderViewBuilder.syncRenderViewPostCommandUpdateJob()->dependencies().size(), postCommandUpdateDependencyCount);
+        QCOMPARE(renderViewBuilder.syncMaterialGathererJob()->dependencies().size(), 2U);
+        for (const auto &materialGatherer : renderViewBuilder.materialGathererJobs())
+            QCOMPARE(materialGatherer->dependencies().size(), 3U);
+        for (const auto &renderViewCommandBuilder : renderViewBuilder.renderViewCommandBuilderJobs())
+            QCOMPARE(renderViewCommandBuilder->dependencies().size(), 1U);
+
+        // WHEN
+        renderViewBuilder.setLayerCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.setMaterialGathererCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.setRenderCommandCacheNeedsToBeRebuilt(false);
+        renderViewBuilder.prepareJobs();
+        const std::vector<Qt3DCore::QAspectJobPtr> thirdFrameJobs = renderViewBuilder.buildJobHierachy();
+
+        // THEN -> only the jobs that always run are scheduled, all reused
+        QCOMPARE(thirdFrameJobs.size(), 8U + 2U);
+        for (const Qt3DCore::QAspectJobPtr &job : thirdFrameJobs)
+            QVERIFY(std::find(firstFrameJobs.begin(), firstFrameJobs.end(), job) != firstFrameJobs.end());
+        QCOMPARE(renderViewBuilder.syncRenderViewPreCommandUpdateJob()->dependencies().size(), preCommandUpdateDependencyCount);
+    }
+
+    void checkPipelinedCommandViewsAreSwapped()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QClearBuffers *clearBuffer = new Qt3DRender::QClearBuffers(viewport);
+        Qt3DRender::TestAspect testAspect(buildEntityFilterTestScene(viewport, new Qt3DRender::QLayer()));
+        Qt3DRender::Render::OpenGL::Renderer *renderer = testAspect.renderer();
+        Qt3DRender::Render::RendererCache<Qt3DRender::Render::OpenGL::RenderCommand> *cache = renderer->cache();
+
+        Qt3DRender::Render::FrameGraphNode *leafNode = testAspect.nodeManagers()->frameGraphManager()->lookupNode(clearBuffer->id());
+        QVERIFY(leafNode != nullptr);
+
+        cache->pipelinedFrames = true;
+        cache->leafNodeCache[leafNode] = {};
+        renderer->renderableEntityFilterJob()->run();
+
+        const auto runFrame = [&] (bool rebuild) {
+            Qt3DRender::Render::OpenGL::RenderViewBuilder renderViewBuilder(leafNode, 0, renderer);
+            renderViewBuilder.setLayerCacheNeedsToBeRebuilt(rebuild);
+            renderViewBuilder.setRenderCommandCacheNeedsToBeRebuilt(rebuild);
+            renderViewBuilder.prepareJobs();
+            renderViewBuilder.buildJobHierachy();
+            renderViewBuilder.renderViewJob()->run();
+            renderViewBuilder.syncRenderViewPostInitializationJob()->run();
+            renderViewBuilder.syncRenderViewPreCommandUpdateJob()->run();
+        };
+        const auto &cacheForLeaf = cache->leafNodeCache[leafNode];
+
+        // WHEN
+        runFrame(true);
+        const auto firstView = cacheForLeaf.filteredRenderCommandDataViews;
+
+        // THEN
+        QVERIFY(!firstView.isNull());
+        QVERIFY(cacheForLeaf.submittedRenderCommandDataViews.isNull());
+
+        // WHEN -> commands are copied once into the other buffer
+        runFrame(false);
+        const auto secondView = cacheForLeaf.filteredRenderCommandDataViews;
+
+        // THEN
+        QVERIFY(secondView != firstView);
+        QCOMPARE(cacheForLeaf.submittedRenderCommandDataViews, firstView);
+        QCOMPARE(secondView->data.size(), firstView->data.size());
+        QCOMPARE(secondView->indices, firstView->indices);
+
+        // WHEN -> then the buffers are only swapped
+        const auto *firstCommands = firstView->data.commands.data();
+        const auto *secondCommands = secondView->data.commands.data();
+        runFrame(false);
+
+        // THEN
+        QCOMPARE(cacheForLeaf.filteredRenderCommandDataViews, firstView);
+        QCOMPARE(cacheForLeaf.submittedRenderCommandDataViews, secondView);
+        QCOMPARE(firstView->data.commands.data(), firstCommands);
+        QCOMPARE(secondView->data.commands.data(), secondCommands);
+
+        // WHEN -> a rebuild drops the other buffer
+        runFrame(true);
+
+        // THEN
+        QVERIFY(cacheForLeaf.filteredRenderCommandDataViews != firstView);
+        QVERIFY(cacheForLeaf.filteredRenderCommandDataViews != secondView);
+        QVERIFY(cacheForLeaf.submittedRenderCommandDataViews.isNull());
+    }
+
     void checkRenderViewJobExecution()
     {
         // GIVEN
@@ -10,6 +10,9 @@
 #include <Qt3DRender/qshaderprogram.h>
 #include <renderview_p.h>
 #include <Qt3DRender/private/renderviewjobutils_p.h>
+#include <Qt3DRender/private/renderviewpool_p.h>
+#include <Qt3DRender/private/renderstates_p.h>
+#include <QtGui/qopengl.h>
 #include <rendercommand_p.h>
 #include <renderer_p.h>
 #include <glresourcemanagers_p.h>
@@ -109,6 +112,96 @@ private Q_SLOTS:
         // TO DO: Complete tests for other framegraph node types
     }
 
+    void checkResetRestoresInitialState()
+    {
+        // GIVEN
+        RenderView renderView;
+        renderView.setMemoryBarrier(QMemoryBarrier::All);
+        renderView.setNoDraw(true);
+        renderView.setCompute(true);
+        renderView.setComputeWorkgroups(4, 8, 16);
+        renderView.setFrustumCulling(true);
+        renderView.setGamma(1.0f);
+        renderView.setViewport(QRectF(0.0f, 0.0f, 0.5f, 0.5f));
+        renderView.appendLayerFilter(Qt3DCore::QNodeId::createId());
+        renderView.appendInsertFenceId(Qt3DCore::QNodeId::createId());
+        renderView.addSortType(QList<QSortPolicy::SortType> { QSortPolicy::BackToFront });
+        renderView.setRenderCommandDataView(EntityRenderCommandDataViewPtr::create());
+        RenderStateSet *stateSet = renderView.getOrCreateStateSet();
+        stateSet->addState(StateVariant::createState<DepthTest>(GL_LESS));
+
+        // WHEN
+        renderView.reset();
+
+        // THEN
+        QCOMPARE(renderView.memoryBarrier(), QMemoryBarrier::None);
+        QVERIFY(!renderView.noDraw());
+        QVERIFY(!renderView.isCompute());
+        QCOMPARE(renderView.computeWorkGroups()[0], 1);
+        QCOMPARE(renderView.computeWorkGroups()[1], 1);
+        QCOMPARE(renderView.computeWorkGroups()[2], 1);
+        QVERIFY(!renderView.frustumCulling());
+        QCOMPARE(renderView.gamma(), 2.2f);
+        QCOMPARE(renderView.viewport(), QRectF(0.0f, 0.0f, 1.0f, 1.0f));
+        QVERIFY(renderView.layerFilters().isEmpty());
+        QVERIFY(renderView.insertFenceIds().isEmpty());
+        QVERIFY(renderView.renderCommandDataView().isNull());
+        QVERIFY(renderView.stateSet() == nullptr);
+
+        // WHEN
+        RenderStateSet *recycledStateSet = renderView.getOrCreateStateSet();
+
+        // THEN -> same storage, without any state
+        QCOMPARE(recycledStateSet, stateSet);
+        QVERIFY(recycledStateSet->states().empty());
+        QCOMPARE(recycledStateSet->stateMask(), StateMaskSet(0));
+    }
+
+    void checkRenderViewPoolRecyclesRenderViews()
+    {
+        // GIVEN
+        RenderViewPool<RenderView> pool;
+
+        // WHEN
+        std::vector<RenderView *> renderViews = { pool.acquire(), pool.acquire() };
+        renderViews.front()->setNoDraw(true);
+        const std::vector<RenderView *> submittedRenderViews = renderViews;
+
+        // THEN
+        QCOMPARE(pool.freeRenderViewCount(), 0U);
+
+        // WHEN
+        pool.release(renderViews);
+
+        // THEN
+        QVERIFY(renderViews.empty());
+        QCOMPARE(pool.freeRenderViewCount(), 2U);
+
+        // WHEN
+        RenderView *recycled1 = pool.acquire();
+        RenderView *recycled2 = pool.acquire();
+
+        // THEN
+        QVERIFY(std::find(submittedRenderViews.begin(), submittedRenderViews.end(), recycled1) != submittedRenderViews.end());
+        QVERIFY(std::find(submittedRenderViews.begin(), submittedRenderViews.end(), recycled2) != submittedRenderViews.end());
+        QVERIFY(!recycled1->noDraw());
+        QVERIFY(!recycled2->noDraw());
+        QCOMPARE(pool.freeRenderViewCount(), 0U);
+
+        // WHEN
+        RenderView *newRenderView = pool.acquire();
+
+        // THEN
+        QVERIFY(std::find(submittedRenderViews.begin(), submittedRenderViews.end(), newRenderView) == submittedRenderViews.end());
+
+        // WHEN
+        renderViews = { recycled1, recycled2, newRenderView };
+        pool.release(renderViews);
+
+        // THEN -> deleted by the pool
+        QCOMPARE(pool.freeRenderViewCount(), 3U);
+    }
+
     void checkDoesntCrashWhenNoCommandsToSort()
     {
         // GIVEN
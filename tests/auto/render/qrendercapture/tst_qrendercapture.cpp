@@ -47,6 +47,37 @@ private Q_SLOTS:
         arbiter.clear();
     }
 
+    void checkRawCaptureRequest()
+    {
+        // GIVEN
+        TestArbiter arbiter;
+        QScopedPointer<Qt3DRender::QRenderCapture> renderCapture(new Qt3DRender::QRenderCapture());
+        arbiter.setArbiterOnNode(renderCapture.data());
+        Qt3DRender::QRenderCapturePrivate *d = static_cast<Qt3DRender::QRenderCapturePrivate *>(Qt3DCore::QNodePrivate::get(renderCapture.data()));
+
+        // WHEN
+        QScopedPointer<Qt3DRender::QRenderCaptureReply> reply(renderCapture->requestRawCapture(QRect(10, 15, 20, 50)));
+
+        // THEN
+        QCOMPARE(arbiter.dirtyNodes().size(), 1);
+        QCOMPARE(d->m_pendingRequests.size(), 1);
+        QCOMPARE(d->m_pendingRequests.first().rect, QRect(10, 15, 20, 50));
+        QVERIFY(d->m_pendingRequests.first().rawData);
+        QVERIFY(!reply->isComplete());
+
+        // WHEN
+        const QByteArray data(20 * 50 * 4, 0x7f);
+        d->setRawData(reply.data(), data, QRect(10, 15, 20, 50));
+
+        // THEN
+        QVERIFY(reply->isComplete());
+        QCOMPARE(reply->rawData(), data);
+        QCOMPARE(reply->rect(), QRect(10, 15, 20, 50));
+        QVERIFY(reply->image().isNull());
+
+        arbiter.clear();
+    }
+
     void crashOnRenderCaptureDeletion()
     {
         // GIVEN
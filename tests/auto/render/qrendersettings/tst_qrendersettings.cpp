@@ -5,6 +5,7 @@
 #include <QtTest/QTest>
 #include <Qt3DRender/qrendersettings.h>
 #include <Qt3DRender/qviewport.h>
+#include <Qt3DCore/qentity.h>
 #include <Qt3DRender/private/qrendersettings_p.h>
 #include <QObject>
 #include <QSignalSpy>
@@ -205,6 +206,61 @@ private Q_SLOTS:
 
     }
 
+    void checkPrewarmedEntitiesUpdate()
+    {
+        // GIVEN
+        TestArbiter arbiter;
+        Qt3DRender::QRenderSettings renderSettings;
+        arbiter.setArbiterOnNode(&renderSettings);
+        Qt3DCore::QEntity entity;
+
+        {
+            // WHEN
+            renderSettings.addPrewarmedEntity(&entity);
+            QCoreApplication::processEvents();
+
+            // THEN
+            QCOMPARE(renderSettings.prewarmedEntities(), QList<Qt3DCore::QEntity *>{ &entity });
+            QCOMPARE(arbiter.dirtyNodes().size(), 1);
+            QCOMPARE(arbiter.dirtyNodes().front(), &renderSettings);
+
+            arbiter.clear();
+        }
+
+        {
+            // WHEN
+            renderSettings.addPrewarmedEntity(&entity);
+            QCoreApplication::processEvents();
+
+            // THEN
+            QCOMPARE(renderSettings.prewarmedEntities().size(), 1);
+            QCOMPARE(arbiter.dirtyNodes().size(), 0);
+        }
+
+        {
+            // WHEN
+            renderSettings.removePrewarmedEntity(&entity);
+            QCoreApplication::processEvents();
+
+            // THEN
+            QVERIFY(renderSettings.prewarmedEntities().isEmpty());
+            QCOMPARE(arbiter.dirtyNodes().size(), 1);
+            QCOMPARE(arbiter.dirtyNodes().front(), &renderSettings);
+
+            arbiter.clear();
+        }
+
+        {
+            // WHEN
+            Qt3DCore::QEntity *destroyedEntity = new Qt3DCore::QEntity();
+            renderSettings.addPrewarmedEntity(destroyedEntity);
+            delete destroyedEntity;
+
+            // THEN -> the destruction helper removes it
+            QVERIFY(renderSettings.prewarmedEntities().isEmpty());
+        }
+    }
+
     void checkPickMethodUpdate()
     {
         // GIVEN
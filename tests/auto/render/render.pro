@@ -10,6 +10,8 @@ qtConfig(private_tests) {
         computecommand \
         coordinatereader \
         ddstextures \
+        dirtynodequeue \
+        dirtyrendercommandtracker \
         effect \
         entity \
         filterentitybycomponent \
@@ -24,6 +26,7 @@ qtConfig(private_tests) {
         layerfiltering \
         levelofdetail \
         loadscenejob \
+        loadtexturedatajob \
         material \
         memorybarrier \
         meshfunctors \
@@ -100,6 +103,7 @@ qtConfig(private_tests) {
         technique \
         texture \
         transform \
+        transformhierarchy \
         trianglevisitor \
         uniform \
         vsyncframeadvanceservice \
@@ -67,6 +67,30 @@ private Q_SLOTS:
         QCOMPARE(renderCapture.wasCaptureRequested(), true);
     }
 
+    void checkReceiveRawRenderCaptureRequest()
+    {
+        // GIVEN
+        Qt3DRender::QRenderCapture frontend;
+        Qt3DRender::Render::RenderCapture renderCapture;
+        TestRenderer renderer;
+        renderCapture.setRenderer(&renderer);
+        simulateInitializationSync(&frontend, &renderCapture);
+
+        // WHEN
+        frontend.requestCapture();
+        frontend.requestRawCapture(QRect(5, 5, 10, 10));
+        renderCapture.syncFromFrontEnd(&frontend, false);
+
+        // THEN
+        QCOMPARE(renderCapture.wasCaptureRequested(), true);
+        const Qt3DRender::QRenderCaptureRequest r1 = renderCapture.takeCaptureRequest();
+        QCOMPARE(r1.rawData, false);
+        const Qt3DRender::QRenderCaptureRequest r2 = renderCapture.takeCaptureRequest();
+        QCOMPARE(r2.rawData, true);
+        QCOMPARE(r2.rect, QRect(5, 5, 10, 10));
+        QCOMPARE(renderCapture.wasCaptureRequested(), false);
+    }
+
     void checkTakeCaptureRequest()
     {
         // GIVEN
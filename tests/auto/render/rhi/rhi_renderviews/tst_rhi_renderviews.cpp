@@ -15,6 +15,18 @@
 #include <renderer_p.h>
 #include <rhiresourcemanagers_p.h>
 #include <private/shader_p.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qrenderpass.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/geometry_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/attribute_p.h>
+#include <Qt3DRender/private/renderpass_p.h>
+#include <Qt3DRender/private/managers_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -571,6 +583,116 @@ private Q_SLOTS:
         QCOMPARE(sortedCommands.at(sortedCommandIndices[6]), b);
         // RenderCommands are deleted by RenderView dtor
     }
+
+    void checkDeclaredDrawRenderCommands()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Renderer renderer;
+        TestRenderer testRenderer;
+        renderer.setNodeManagers(&nodeManagers);
+
+        Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry();
+        Qt3DCore::QAttribute *positionAttribute = new Qt3DCore::QAttribute();
+        positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+        positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+        positionAttribute->setVertexSize(3);
+        positionAttribute->setCount(3);
+        positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+        geometry->addAttribute(positionAttribute);
+
+        QGeometryRenderer geometryRenderer;
+        geometryRenderer.setGeometry(geometry);
+        geometryRenderer.setEnabled(false);
+
+        QMaterial material;
+        QShaderProgram shaderProgram;
+        QRenderPass renderPass;
+        renderPass.setShaderProgram(&shaderProgram);
+
+        Attribute *backendAttribute = nodeManagers.attributeManager()->getOrCreateResource(positionAttribute->id());
+        backendAttribute->setRenderer(&testRenderer);
+        simulateInitializationSync(positionAttribute, backendAttribute);
+
+        Geometry *backendGeometry = nodeManagers.geometryManager()->getOrCreateResource(geometry->id());
+        backendGeometry->setRenderer(&testRenderer);
+        simulateInitializationSync(geometry, backendGeometry);
+
+        GeometryRenderer *backendGeometryRenderer = nodeManagers.geometryRendererManager()->getOrCreateResource(geometryRenderer.id());
+        backendGeometryRenderer->setRenderer(&testRenderer);
+        backendGeometryRenderer->setManager(nodeManagers.geometryRendererManager());
+        simulateInitializationSync(&geometryRenderer, backendGeometryRenderer);
+
+        RenderPass backendRenderPass;
+        backendRenderPass.setRenderer(&testRenderer);
+        simulateInitializationSync(&renderPass, &backendRenderPass);
+
+        Entity entity;
+        entity.setNodeManagers(&nodeManagers);
+        entity.addComponent(Qt3DCore::QNodeIdTypePair(geometryRenderer.id(), &QGeometryRenderer::staticMetaObject));
+        entity.addComponent(Qt3DCore::QNodeIdTypePair(material.id(), &QMaterial::staticMetaObject));
+        const Entity *entities[] = { &entity };
+
+        RenderView renderView;
+        renderView.setRenderer(&renderer);
+        MaterialParameterGathererData parameters;
+        parameters.insert(material.id(), { RenderPassParameterData{ &backendRenderPass, {} } });
+        renderView.setMaterialParameterTable(parameters);
+
+        // WHEN
+        const EntityRenderCommandData drawnCommands = renderView.buildDrawRenderCommands(entities, 0, 1);
+        const EntityRenderCommandData declaredCommands = renderView.buildDrawRenderCommands(entities, 0, 1, true);
+
+        // THEN -> disabled GeometryRenderers are only used to prewarm pipelines
+        QCOMPARE(drawnCommands.size(), size_t(0));
+        QCOMPARE(declaredCommands.size(), size_t(1));
+        QCOMPARE(declaredCommands.commands.front().m_shaderId, shaderProgram.id());
+        QCOMPARE(declaredCommands.commands.front().m_attributeInfo.size(), size_t(1));
+
+        // WHEN
+        geometryRenderer.setEnabled(true);
+        backendGeometryRenderer->syncFromFrontEnd(&geometryRenderer, false);
+
+        // THEN
+        QCOMPARE(renderView.buildDrawRenderCommands(entities, 0, 1).size(), size_t(1));
+        QCOMPARE(renderView.buildDrawRenderCommands(entities, 0, 1, true).size(), size_t(1));
+
+        renderer.shutdown();
+    }
+
+    void checkPipelinePrewarmBudget_data()
+    {
+        QTest::addColumn<QByteArray>("budgetVariable");
+        QTest::addColumn<int>("expectedBudget");
+
+        QTest::newRow("unset") << QByteArray() << int(Renderer::DefaultPipelinePrewarmBudget);
+        QTest::newRow("disabled") << QByteArray("0") << 0;
+        QTest::newRow("negative") << QByteArray("-4") << 0;
+        QTest::newRow("custom") << QByteArray("32") << 32;
+    }
+
+    void checkPipelinePrewarmBudget()
+    {
+        // GIVEN
+        QFETCH(QByteArray, budgetVariable);
+        QFETCH(int, expectedBudget);
+
+        if (budgetVariable.isNull())
+            qunsetenv("QT3D_RHI_PIPELINE_PREWARM_BUDGET");
+        else
+            qputenv("QT3D_RHI_PIPELINE_PREWARM_BUDGET", budgetVariable);
+
+        // WHEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Renderer renderer;
+        renderer.setNodeManagers(&nodeManagers);
+        qunsetenv("QT3D_RHI_PIPELINE_PREWARM_BUDGET");
+
+        // THEN -> pre-warming culled commands is off unless explicitly enabled
+        QCOMPARE(renderer.pipelinePrewarmBudget(), expectedBudget);
+
+        renderer.shutdown();
+    }
 private:
 };
 
@@ -0,0 +1,167 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/transformhierarchy_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+#include "testaspect.h"
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+Qt3DCore::QTransform *createTransform(const QVector3D &translation, float angle)
+{
+    Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+    transform->setTranslation(translation);
+    transform->setRotationY(angle);
+    return transform;
+}
+
+bool fuzzyCompare(const Sphere &a, const Sphere &b)
+{
+    return qFuzzyCompare(a.radius(), b.radius())
+            && qFuzzyCompare(convertToQVector3D(a.center()), convertToQVector3D(b.center()));
+}
+
+} // anonymous
+
+class tst_TransformHierarchy : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkComputeWorldTransforms()
+    {
+        // GIVEN
+        QMatrix4x4 rootParent;
+        rootParent.scale(2.0f);
+        QMatrix4x4 local0;
+        local0.translate(1.0f, 2.0f, 3.0f);
+        QMatrix4x4 local1;
+        local1.rotate(45.0f, 0.0f, 1.0f, 0.0f);
+
+        const std::vector<int> parents = { -1, 0, 1, 0 };
+        const std::vector<bool> hasLocal = { true, true, false, false };
+        const std::vector<Matrix4x4> locals = { Matrix4x4(local0), Matrix4x4(local1), Matrix4x4(), Matrix4x4() };
+        std::vector<Matrix4x4> worlds(parents.size());
+
+        // WHEN
+        computeWorldTransforms(parents.data(), locals.data(), hasLocal, worlds.data(),
+                               worlds.size(), Matrix4x4(rootParent));
+
+        // THEN
+        const Matrix4x4 world0 = Matrix4x4(rootParent) * Matrix4x4(local0);
+        const Matrix4x4 world1 = world0 * Matrix4x4(local1);
+        QCOMPARE(convertToQMatrix4x4(worlds[0]), convertToQMatrix4x4(world0));
+        QCOMPARE(convertToQMatrix4x4(worlds[1]), convertToQMatrix4x4(world1));
+        QCOMPARE(convertToQMatrix4x4(worlds[2]), convertToQMatrix4x4(world1));
+        QCOMPARE(convertToQMatrix4x4(worlds[3]), convertToQMatrix4x4(world0));
+    }
+
+    void checkHierarchyFollowsEnabledEntities()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QEntity *child1 = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *child2 = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *grandChild = new Qt3DCore::QEntity(child1);
+        Qt3DCore::QEntity *disabledChild = new Qt3DCore::QEntity(child2);
+        Qt3DCore::QEntity *hiddenGrandChild = new Qt3DCore::QEntity(disabledChild);
+        disabledChild->setEnabled(false);
+
+        rootEntity->addComponent(createTransform(QVector3D(1.0f, 0.0f, 0.0f), 0.0f));
+        child1->addComponent(createTransform(QVector3D(0.0f, 2.0f, 0.0f), 30.0f));
+        grandChild->addComponent(createTransform(QVector3D(0.0f, 0.0f, 3.0f), 60.0f));
+        hiddenGrandChild->addComponent(createTransform(QVector3D(4.0f, 0.0f, 0.0f), 0.0f));
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        EntityManager *entityManager = aspect->nodeManagers()->renderNodesManager();
+        Entity *backendRoot = entityManager->lookupResource(rootEntity->id());
+
+        // WHEN
+        TransformHierarchy hierarchy;
+        hierarchy.rebuild(aspect->nodeManagers(), backendRoot);
+
+        // THEN
+        QVERIFY(hierarchy.isValid());
+        QCOMPARE(hierarchy.size(), 4U);
+        QCOMPARE(hierarchy.entities().front(), backendRoot);
+        for (size_t i = 0; i < hierarchy.size(); ++i) {
+            const int parentIndex = hierarchy.parentIndices()[i];
+            QVERIFY(parentIndex < int(i));
+            if (parentIndex >= 0)
+                QCOMPARE(hierarchy.entities()[i]->parent(), hierarchy.entities()[parentIndex]);
+        }
+        const std::vector<Entity *> &entities = hierarchy.entities();
+        QVERIFY(std::find(entities.begin(), entities.end(),
+                          entityManager->lookupResource(disabledChild->id())) == entities.end());
+        QVERIFY(std::find(entities.begin(), entities.end(),
+                          entityManager->lookupResource(hiddenGrandChild->id())) == entities.end());
+
+        // WHEN
+        hierarchy.updateWorldTransforms(Matrix4x4());
+
+        // THEN
+        for (size_t i = 0; i < hierarchy.size(); ++i) {
+            Entity *entity = entities[i];
+            Matrix4x4 expected;
+            for (Entity *e = entity; e != nullptr; e = e->parent()) {
+                const Transform *transform = e->renderComponent<Transform>();
+                if (transform)
+                    expected = transform->transformMatrix() * expected;
+            }
+            QVERIFY(qFuzzyCompare(convertToQMatrix4x4(hierarchy.worldTransforms()[i]),
+                                  convertToQMatrix4x4(expected)));
+        }
+    }
+
+    void checkWorldBoundingVolumes()
+    {
+        // GIVEN
+        Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+        Qt3DCore::QEntity *child = new Qt3DCore::QEntity(rootEntity);
+        Qt3DCore::QEntity *emptyChild = new Qt3DCore::QEntity(rootEntity);
+        rootEntity->addComponent(createTransform(QVector3D(1.0f, 2.0f, 3.0f), 0.0f));
+        Qt3DCore::QTransform *childTransform = createTransform(QVector3D(0.0f, -2.0f, 0.0f), 90.0f);
+        childTransform->setScale(3.0f);
+        child->addComponent(childTransform);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(rootEntity));
+        EntityManager *entityManager = aspect->nodeManagers()->renderNodesManager();
+        Entity *backendRoot = entityManager->lookupResource(rootEntity->id());
+        Entity *backendChild = entityManager->lookupResource(child->id());
+        Entity *backendEmptyChild = entityManager->lookupResource(emptyChild->id());
+        *backendRoot->localBoundingVolume() = Sphere(Vector3D(0.0f, 0.0f, 0.0f), 1.0f);
+        *backendChild->localBoundingVolume() = Sphere(Vector3D(1.0f, 1.0f, 0.0f), 2.0f);
+        backendEmptyChild->localBoundingVolume()->clear();
+
+        UpdateWorldTransformJob transformJob;
+        transformJob.setRoot(backendRoot);
+        transformJob.setManagers(aspect->nodeManagers());
+
+        // WHEN
+        transformJob.run();
+        transformJob.hierarchy().updateWorldBoundingVolumes();
+
+        // THEN
+        for (Entity *entity : { backendRoot, backendChild }) {
+            const Sphere expected = entity->localBoundingVolume()->transformed(*entity->worldTransform());
+            QVERIFY(fuzzyCompare(*entity->worldBoundingVolume(), expected));
+            QVERIFY(fuzzyCompare(*entity->worldBoundingVolumeWithChildren(), expected));
+        }
+        QVERIFY(backendEmptyChild->worldBoundingVolume()->isNull());
+    }
+};
+
+QTEST_MAIN(tst_TransformHierarchy)
+
+#include "tst_transformhierarchy.moc"
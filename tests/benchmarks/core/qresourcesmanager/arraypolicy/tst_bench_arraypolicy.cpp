@@ -4,6 +4,7 @@
 #include <QtTest/QtTest>
 #include <QMatrix4x4>
 #include <Qt3DCore/private/qresourcemanager_p.h>
+#include <random>
 
 class tst_ArrayPolicy : public QObject
 {
@@ -13,6 +14,8 @@ private Q_SLOTS:
     void benchmarkDynamicReleaseSmallResources();
     void benchmarkDynamicAllocateBigResources();
     void benchmarkDynamicReleaseBigResources();
+    void benchmarkDynamicMassReleaseSmallResources();
+    void benchmarkDynamicMassReleaseBigResources();
 };
 
 struct SmallType
@@ -56,6 +59,28 @@ void benchmarkReleaseResources()
     }
 }
 
+template<typename T>
+void benchmarkMassReleaseResources()
+{
+    Qt3DCore::ArrayAllocatingPolicy<T> allocator;
+
+    const int max = (1 << 18) - 1;
+    std::vector<Qt3DCore::QHandle<T>> resources(max);
+    for (size_t i = 0; i < max; i++) {
+        resources[i] = allocator.allocateResource();
+    }
+
+    // Release in random order, as happens when tearing down a scene
+    std::mt19937 g(883);
+    std::shuffle(resources.begin(), resources.end(), g);
+
+    QBENCHMARK_ONCE {
+        for (auto ptr : qAsConst(resources)) {
+            allocator.releaseResource(ptr);
+        }
+    }
+}
+
 void tst_ArrayPolicy::benchmarkDynamicAllocateSmallResources()
 {
     benchmarkAllocateResources<SmallType>();
@@ -76,6 +101,16 @@ void tst_ArrayPolicy::benchmarkDynamicReleaseBigResources()
     benchmarkReleaseResources<BigType>();
 }
 
+void tst_ArrayPolicy::benchmarkDynamicMassReleaseSmallResources()
+{
+    benchmarkMassReleaseResources<SmallType>();
+}
+
+void tst_ArrayPolicy::benchmarkDynamicMassReleaseBigResources()
+{
+    benchmarkMassReleaseResources<BigType>();
+}
+
 QTEST_APPLESS_MAIN(tst_ArrayPolicy)
 
 #include "tst_bench_arraypolicy.moc"
@@ -19,12 +19,14 @@ private Q_SLOTS:
     void benchmarRandomAccessSmallResources();
     void benchmarkRandomLookupSmallResources();
     void benchmarkReleaseSmallResources();
+    void benchmarkMassReleaseSmallResources();
     void benchmarkAllocateBigResources();
     void benchmarkAccessBigResources();
     void benchmarRandomAccessBigResources();
     void benchmarkLookupBigResources();
     void benchmarkRandomLookupBigResources();
     void benchmarkReleaseBigResources();
+    void benchmarkMassReleaseBigResources();
 };
 
 class tst_SmallArrayResource
@@ -151,6 +153,26 @@ void benchmarkReleaseResources()
     }
 }
 
+template<typename Resource>
+void benchmarkMassReleaseResources()
+{
+    Qt3DCore::QResourceManager<Resource, int> manager;
+    const int max = (1 << 16) - 1;
+    QVector<int> resourcesIndices(max);
+    for (int i = 0; i < max; i++) {
+        manager.getOrCreateResource(i);
+        resourcesIndices[i] = i;
+    }
+
+    std::mt19937 g(883);
+    std::shuffle(resourcesIndices.begin(), resourcesIndices.end(), g);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < max; i++)
+            manager.releaseResource(resourcesIndices[i]);
+    }
+}
+
 void tst_QResourceManager::benchmarkAllocateSmallResources()
 {
     benchmarkAllocateResources<tst_SmallArrayResource>();
@@ -181,6 +203,11 @@ void tst_QResourceManager::benchmarkReleaseSmallResources()
     benchmarkReleaseResources<tst_SmallArrayResource>();
 }
 
+void tst_QResourceManager::benchmarkMassReleaseSmallResources()
+{
+    benchmarkMassReleaseResources<tst_SmallArrayResource>();
+}
+
 void tst_QResourceManager::benchmarkAllocateBigResources()
 {
     benchmarkAllocateResources<tst_BigArrayResource>();
@@ -211,6 +238,11 @@ void tst_QResourceManager::benchmarkReleaseBigResources()
     benchmarkReleaseResources<tst_BigArrayResource>();
 }
 
+void tst_QResourceManager::benchmarkMassReleaseBigResources()
+{
+    benchmarkMassReleaseResources<tst_BigArrayResource>();
+}
+
 QTEST_APPLESS_MAIN(tst_QResourceManager)
 
 #include "tst_bench_qresourcesmanager.moc"
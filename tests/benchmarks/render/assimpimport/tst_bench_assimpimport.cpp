@@ -0,0 +1,90 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/private/qsceneimporter_p.h>
+#include <Qt3DRender/private/qsceneimportfactory_p.h>
+
+namespace {
+
+// Writes an OBJ file with meshCount objects, each of them being a grid of
+// resolution x resolution vertices
+void writeScene(const QString &path, int meshCount, int resolution)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream stream(&file);
+
+    int firstVertex = 1;
+    for (int mesh = 0; mesh < meshCount; ++mesh) {
+        stream << "o mesh" << mesh << "\n";
+        const float offset = float(mesh);
+        for (int j = 0; j < resolution; ++j) {
+            for (int i = 0; i < resolution; ++i)
+                stream << "v " << offset + float(i) / float(resolution) << " 0 " << float(j) / float(resolution) << "\n";
+        }
+        for (int j = 0; j + 1 < resolution; ++j) {
+            for (int i = 0; i + 1 < resolution; ++i) {
+                const int v = firstVertex + j * resolution + i;
+                stream << "f " << v << ' ' << v + resolution << ' ' << v + 1 << "\n";
+                stream << "f " << v + 1 << ' ' << v + resolution << ' ' << v + resolution + 1 << "\n";
+            }
+        }
+        firstVertex += resolution * resolution;
+    }
+}
+
+} // anonymous
+
+class tst_BenchAssimpImport : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void importScene_data()
+    {
+        QTest::addColumn<int>("meshCount");
+        QTest::addColumn<int>("resolution");
+
+        QTest::newRow("1000 meshes") << 1000 << 16;
+        QTest::newRow("4000 meshes") << 4000 << 16;
+        QTest::newRow("250 large meshes") << 250 << 128;
+    }
+
+    void importScene()
+    {
+        // GIVEN
+        QFETCH(int, meshCount);
+        QFETCH(int, resolution);
+
+        QScopedPointer<Qt3DRender::QSceneImporter> importer(
+                    Qt3DRender::QSceneImportFactory::create(QStringLiteral("assimp"), QStringList()));
+        if (importer.isNull())
+            QSKIP("The Assimp scene import plugin is not available");
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath(QStringLiteral("scene.obj"));
+        writeScene(path, meshCount, resolution);
+        if (QTest::currentTestFailed())
+            return;
+        const QUrl source = QUrl::fromLocalFile(path);
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QEntity> scene;
+        QBENCHMARK {
+            importer->setSource(source);
+            scene.reset(importer->scene());
+        }
+
+        // THEN
+        QVERIFY(!scene.isNull());
+        QCOMPARE(scene->findChildren<Qt3DRender::QGeometryRenderer *>().size(), meshCount);
+    }
+};
+
+QTEST_MAIN(tst_BenchAssimpImport)
+
+#include "tst_bench_assimpimport.moc"
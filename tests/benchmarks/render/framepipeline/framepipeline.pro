@@ -0,0 +1,7 @@
+TEMPLATE = app
+
+TARGET = tst_bench_framepipeline
+
+QT += testlib core-private 3dcore 3dcore-private 3drender 3drender-private 3dextras
+
+SOURCES += tst_bench_framepipeline.cpp
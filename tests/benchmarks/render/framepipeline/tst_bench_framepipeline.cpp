@@ -0,0 +1,359 @@
+// Copyright (C) 2022 Klaralvdalens Datakonsult AB (KDAB).
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QWindow>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QElapsedTimer>
+#include <qmath.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DCore/private/qaspectengine_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qservicelocator_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QPointLight>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DRender/private/qrenderaspect_p.h>
+#include <Qt3DRender/private/abstractrenderer_p.h>
+
+#include <Qt3DExtras/QForwardRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+#include <Qt3DExtras/QSphereMesh>
+
+// Drives the whole frame pipeline, from the aspect jobs to the submission of
+// the render commands, without requiring a GPU. Unless overridden through the
+// environment, the RHI renderer is used with its Null backend on the offscreen
+// platform.
+//
+// Besides the regular QTest benchmark results, the per job type timings
+// gathered by the QSystemInformationService are reported as JSON, either on
+// stdout or in the file QT3D_BENCH_REPORT points to, along with the number of
+// heap allocations made per frame.
+
+namespace {
+
+// Counts the calls to the global operator new, which covers the standard
+// containers but not the Qt ones allocating through malloc
+std::atomic<qint64> allocationCount { 0 };
+
+} // anonymous
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    Q_CHECK_PTR(ptr);
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+using JobRunStats = Qt3DCore::QSystemInformationServicePrivate::JobRunStats;
+
+struct ScenePreset
+{
+    int entities;
+    int materials;
+    int depth;
+    int lights;
+    int animated;
+};
+
+class HeadlessEngine
+{
+public:
+    HeadlessEngine()
+        : m_aspectEngine(new Qt3DCore::QAspectEngine())
+        , m_renderAspect(new Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Manual))
+    {
+        m_window.resize(512, 512);
+        m_window.create();
+
+        m_aspectEngine->registerAspect(m_renderAspect);
+        m_aspectEngine->setRunMode(Qt3DCore::QAspectEngine::Manual);
+
+        m_renderer = Qt3DRender::QRenderAspectPrivate::get(m_renderAspect)->m_renderer;
+        m_renderer->initialize();
+
+        auto *aspectManager = Qt3DCore::QAspectEnginePrivate::get(m_aspectEngine)->m_aspectManager;
+        m_systemInformation = aspectManager->serviceLocator()->systemInformation();
+        m_systemInformation->setTraceEnabled(true);
+        Qt3DCore::QSystemInformationServicePrivate::get(m_systemInformation)->setFrameStatsHandler(
+                    [this] (quint32, const QList<JobRunStats> &jobStats, const QList<JobRunStats> &submissionStats) {
+            if (!m_recording)
+                return;
+            for (const JobRunStats &stats : jobStats)
+                m_jobTimes[stats.jobId.typeAndInstance[0]] += stats.endTime - stats.startTime;
+            for (const JobRunStats &stats : submissionStats)
+                m_submissionTimes[stats.jobId.typeAndInstance[0]] += stats.endTime - stats.startTime;
+        });
+    }
+
+    ~HeadlessEngine()
+    {
+        Qt3DCore::QSystemInformationServicePrivate::get(m_systemInformation)->setFrameStatsHandler({});
+        m_aspectEngine->setRootEntity(Qt3DCore::QEntityPtr());
+        m_aspectEngine->unregisterAspect(m_renderAspect);
+        delete m_renderAspect;
+        delete m_aspectEngine;
+    }
+
+    void setScene(const ScenePreset &preset)
+    {
+        m_animatedTransforms.clear();
+        m_frame = 0;
+        m_rootEntity.reset(buildScene(preset));
+        m_aspectEngine->setRootEntity(m_rootEntity);
+    }
+
+    void processFrame()
+    {
+        // Simulate animations updating the frontend nodes
+        const float angle = float(m_frame++ % 360);
+        for (Qt3DCore::QTransform *transform : m_animatedTransforms)
+            transform->setRotationY(angle);
+
+        QElapsedTimer timer;
+        timer.start();
+        const qint64 allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        m_aspectEngine->processFrame();
+        m_renderer->render(true);
+        const qint64 allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        // Flush the job stats of this frame rather than waiting for the next one
+        m_systemInformation->writePreviousFrameTraces();
+        if (m_recording) {
+            m_frameTime += timer.nsecsElapsed();
+            m_allocations += allocations;
+            ++m_recordedFrames;
+        }
+    }
+
+    void startRecording()
+    {
+        m_jobTimes.clear();
+        m_submissionTimes.clear();
+        m_frameTime = 0;
+        m_allocations = 0;
+        m_recordedFrames = 0;
+        m_recording = true;
+    }
+
+    QJsonObject stopRecording()
+    {
+        m_recording = false;
+        const qint64 frames = qMax(m_recordedFrames, qint64(1));
+        auto averages = [frames] (const QHash<quint32, qint64> &times) {
+            QJsonObject result;
+            for (auto it = times.cbegin(), end = times.cend(); it != end; ++it)
+                result.insert(QString::number(it.key()), double(it.value() / frames));
+            return result;
+        };
+        return {
+            { QStringLiteral("frames"), double(m_recordedFrames) },
+            { QStringLiteral("frameTimeNs"), double(m_frameTime / frames) },
+            { QStringLiteral("allocationsPerFrame"), double(m_allocations / frames) },
+            { QStringLiteral("jobTimesNs"), averages(m_jobTimes) },
+            { QStringLiteral("submissionTimesNs"), averages(m_submissionTimes) },
+        };
+    }
+
+private:
+    Qt3DCore::QEntity *buildScene(const ScenePreset &preset)
+    {
+        auto *root = new Qt3DCore::QEntity();
+
+        auto *camera = new Qt3DRender::QCamera(root);
+        camera->lens()->setPerspectiveProjection(45.0f, 1.0f, 0.1f, 1000.0f);
+        camera->setPosition(QVector3D(0.0f, 0.0f, 200.0f));
+        camera->setViewCenter(QVector3D(0.0f, 0.0f, 0.0f));
+
+        auto *forwardRenderer = new Qt3DExtras::QForwardRenderer();
+        forwardRenderer->setSurface(&m_window);
+        forwardRenderer->setCamera(camera);
+
+        // Render continuously so that every frame goes through the whole pipeline
+        auto *renderSettings = new Qt3DRender::QRenderSettings();
+        renderSettings->setActiveFrameGraph(forwardRenderer);
+        renderSettings->setRenderPolicy(Qt3DRender::QRenderSettings::Always);
+        root->addComponent(renderSettings);
+
+        for (int i = 0; i < preset.lights; ++i) {
+            auto *lightEntity = new Qt3DCore::QEntity(root);
+            auto *light = new Qt3DRender::QPointLight();
+            auto *lightTransform = new Qt3DCore::QTransform();
+            lightTransform->setTranslation(QVector3D(qCos(i), qSin(i), 1.0f) * 100.0f);
+            lightEntity->addComponent(light);
+            lightEntity->addComponent(lightTransform);
+        }
+
+        // Geometry is shared, only its generation would otherwise be measured
+        auto *mesh = new Qt3DExtras::QSphereMesh(root);
+        mesh->setRings(16);
+        mesh->setSlices(16);
+
+        std::vector<Qt3DExtras::QPhongMaterial *> materials;
+        for (int i = 0; i < qMax(preset.materials, 1); ++i) {
+            auto *material = new Qt3DExtras::QPhongMaterial(root);
+            material->setDiffuse(QColor::fromHsv((i * 37) % 360, 200, 200));
+            materials.push_back(material);
+        }
+
+        // Entities are laid out as chains of preset.depth nested entities
+        Qt3DCore::QEntity *parent = root;
+        for (int i = 0; i < preset.entities; ++i) {
+            if (preset.depth <= 1 || i % preset.depth == 0)
+                parent = root;
+
+            auto *entity = new Qt3DCore::QEntity(parent);
+            auto *transform = new Qt3DCore::QTransform();
+            transform->setTranslation(parent == root
+                                      ? QVector3D(float(i % 32) - 16.0f, float((i / 32) % 32) - 16.0f, -float(i / 1024)) * 4.0f
+                                      : QVector3D(0.5f, 0.0f, 0.0f));
+            transform->setScale(0.8f);
+            entity->addComponent(transform);
+            entity->addComponent(mesh);
+            entity->addComponent(materials[size_t(i) % materials.size()]);
+
+            if (i < preset.animated)
+                m_animatedTransforms.push_back(transform);
+            parent = entity;
+        }
+
+        return root;
+    }
+
+    QWindow m_window;
+    Qt3DCore::QAspectEngine *m_aspectEngine;
+    Qt3DRender::QRenderAspect *m_renderAspect;
+    Qt3DRender::Render::AbstractRenderer *m_renderer = nullptr;
+    Qt3DCore::QSystemInformationService *m_systemInformation = nullptr;
+    Qt3DCore::QEntityPtr m_rootEntity;
+    std::vector<Qt3DCore::QTransform *> m_animatedTransforms;
+    int m_frame = 0;
+
+    bool m_recording = false;
+    qint64 m_frameTime = 0;
+    qint64 m_allocations = 0;
+    qint64 m_recordedFrames = 0;
+    QHash<quint32, qint64> m_jobTimes;
+    QHash<quint32, qint64> m_submissionTimes;
+};
+
+} // anonymous
+
+class tst_Bench_FramePipeline : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_engine.reset(new HeadlessEngine());
+    }
+
+    void processFrame_data()
+    {
+        QTest::addColumn<int>("entities");
+        QTest::addColumn<int>("materials");
+        QTest::addColumn<int>("depth");
+        QTest::addColumn<int>("lights");
+        QTest::addColumn<int>("animated");
+
+        QTest::newRow("1k-flat") << 1000 << 10 << 1 << 1 << 0;
+        QTest::newRow("1k-deep") << 1000 << 10 << 8 << 1 << 0;
+        QTest::newRow("1k-animated") << 1000 << 10 << 1 << 1 << 1000;
+        QTest::newRow("1k-lights") << 1000 << 10 << 1 << 8 << 0;
+        QTest::newRow("10k-flat") << 10000 << 50 << 1 << 1 << 0;
+        QTest::newRow("10k-deep-animated") << 10000 << 50 << 16 << 4 << 1000;
+    }
+
+    void processFrame()
+    {
+        QFETCH(int, entities);
+        QFETCH(int, materials);
+        QFETCH(int, depth);
+        QFETCH(int, lights);
+        QFETCH(int, animated);
+
+        m_engine->setScene({ entities, materials, depth, lights, animated });
+
+        // Let the initial loading of the scene settle
+        for (int i = 0; i < 5; ++i)
+            m_engine->processFrame();
+
+        m_engine->startRecording();
+        QBENCHMARK {
+            m_engine->processFrame();
+        }
+
+        QJsonObject result = m_engine->stopRecording();
+        result.insert(QStringLiteral("preset"), QString::fromLatin1(QTest::currentDataTag()));
+        result.insert(QStringLiteral("entities"), entities);
+        result.insert(QStringLiteral("materials"), materials);
+        result.insert(QStringLiteral("depth"), depth);
+        result.insert(QStringLiteral("lights"), lights);
+        result.insert(QStringLiteral("animated"), animated);
+        m_report.append(result);
+    }
+
+    void cleanupTestCase()
+    {
+        m_engine.reset();
+
+        const QByteArray report = QJsonDocument(m_report).toJson(QJsonDocument::Indented);
+        const QString reportPath = qEnvironmentVariable("QT3D_BENCH_REPORT");
+        if (reportPath.isEmpty()) {
+            fprintf(stdout, "%s\n", report.constData());
+            return;
+        }
+
+        QFile reportFile(reportPath);
+        QVERIFY(reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        reportFile.write(report);
+    }
+
+private:
+    std::unique_ptr<HeadlessEngine> m_engine;
+    QJsonArray m_report;
+};
+
+int main(int argc, char *argv[])
+{
+    // Run without a GPU nor a display unless told otherwise
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    if (!qEnvironmentVariableIsSet("QT3D_RENDERER"))
+        qputenv("QT3D_RENDERER", "rhi");
+    if (!qEnvironmentVariableIsSet("QSG_RHI_BACKEND"))
+        qputenv("QSG_RHI_BACKEND", "null");
+
+    QGuiApplication app(argc, argv);
+    tst_Bench_FramePipeline tc;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tst_bench_framepipeline.moc"
@@ -1,7 +1,9 @@
 TEMPLATE=subdirs
 
 qtConfig(private_tests) {
-    SUBDIRS += layerfiltering \
+    SUBDIRS += assimpimport \
+               framepipeline \
+               layerfiltering \
                materialparametergathering \
                opengl
 